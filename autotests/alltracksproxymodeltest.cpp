@@ -416,6 +416,56 @@ private Q_SLOTS:
         QCOMPARE(proxyTracksModel.data(changedIndex, DataTypes::ColumnsRoles::RatingRole).toInt(), 5);
     }
 
+    void filterWithSearchIndex()
+    {
+        DatabaseInterface musicDb;
+        DataModel tracksModel;
+        AllTracksProxyModel proxyTracksModel;
+        QAbstractItemModelTester proxyTestModel(&proxyTracksModel);
+        proxyTracksModel.setSourceModel(&tracksModel);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        if (!musicDb.hasSearchIndex()) {
+            QSKIP("SQLite was built without the fts5 module");
+        }
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        tracksModel.initialize(nullptr, &musicDb, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0);
+
+        QCOMPARE(proxyTracksModel.rowCount(), 23);
+
+        // the regular expression matches inside words until the search index answers with whole word prefixes
+        proxyTracksModel.setFilterText(QStringLiteral("rack1"));
+
+        QVERIFY(proxyTracksModel.rowCount() > 0);
+        QTRY_COMPARE(proxyTracksModel.rowCount(), 0);
+
+        proxyTracksModel.setFilterText(QStringLiteral("track23"));
+        QCoreApplication::processEvents();
+
+        QCOMPARE(proxyTracksModel.rowCount(), 0);
+
+        auto newTrack = DataTypes::TrackDataType{true, QStringLiteral("$23"), QStringLiteral("0"), QStringLiteral("track23"),
+                QStringLiteral("artist2"), QStringLiteral("album4"), QStringLiteral("artist2"), 23, 1, QTime::fromMSecsSinceStartOfDay(23),
+        {QUrl::fromLocalFile(QStringLiteral("/$23"))},
+                QDateTime::fromMSecsSinceEpoch(23),
+        {QUrl::fromLocalFile(QStringLiteral("file://image$23"))}, 5, true,
+        {}, QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+        auto newTracks = DataTypes::ListTrackDataType();
+        newTracks.push_back(newTrack);
+
+        musicDb.insertTracksList(newTracks, mNewCovers);
+
+        QCOMPARE(tracksModel.rowCount(), 24);
+        QTRY_COMPARE(proxyTracksModel.rowCount(), 1);
+
+        proxyTracksModel.setFilterText({});
+
+        QCOMPARE(proxyTracksModel.rowCount(), 24);
+    }
+
     void addEmptyTracksList()
     {
         DataModel tracksModel;
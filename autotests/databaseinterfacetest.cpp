@@ -19,6 +19,7 @@
 
 #include "databaseinterface.h"
 #include "datatypes.h"
+#include "modelsnapshot.h"
 
 #include "config-upnp-qt.h"
 
@@ -31,13 +32,19 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QTemporaryFile>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+#include <QSqlDatabase>
+#include <QSqlQuery>
 
 #include <QDebug>
 
 #include <QtTest>
 
 #include <algorithm>
+#include <memory>
 
 class DatabaseInterfaceTests: public QObject, public DatabaseTestData
 {
@@ -49,6 +56,97 @@ public:
     {
     }
 
+private:
+
+    // rebuilds the v15 layout: full file names, no integer references in Tracks and none of the later tables
+    static bool downgradeToV15Layout(const QString &databaseFileName, int storedVersion, const QStringList &extraTexts = {})
+    {
+        auto result = true;
+
+        {
+            auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+            rawDatabase.setDatabaseName(databaseFileName);
+            result = rawDatabase.open();
+
+            const auto downgradeTexts = QStringList{
+                    QStringLiteral("CREATE TABLE `OldTracksData` ("
+                                   "`FileName` VARCHAR(255) NOT NULL, "
+                                   "`FileModifiedTime` DATETIME NOT NULL, "
+                                   "`ImportDate` INTEGER NOT NULL, "
+                                   "`FirstPlayDate` INTEGER, "
+                                   "`LastPlayDate` INTEGER, "
+                                   "`PlayCounter` INTEGER NOT NULL, "
+                                   "PRIMARY KEY (`FileName`))"),
+                    QStringLiteral("INSERT INTO `OldTracksData` "
+                                   "SELECT directory.`Path` || trackData.`BaseName`, trackData.`FileModifiedTime`, trackData.`ImportDate`, "
+                                   "trackData.`FirstPlayDate`, trackData.`LastPlayDate`, trackData.`PlayCounter` "
+                                   "FROM `TracksData` trackData, `Directories` directory "
+                                   "WHERE directory.`ID` = trackData.`DirectoryID`"),
+                    QStringLiteral("CREATE TABLE `OldTracks` ("
+                                   "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
+                                   "`FileName` VARCHAR(255) NOT NULL, "
+                                   "`Priority` INTEGER NOT NULL, "
+                                   "`Title` VARCHAR(85) NOT NULL, "
+                                   "`ArtistName` VARCHAR(55), "
+                                   "`AlbumTitle` VARCHAR(55), "
+                                   "`AlbumArtistName` VARCHAR(55), "
+                                   "`AlbumPath` VARCHAR(255), "
+                                   "`TrackNumber` INTEGER, "
+                                   "`DiscNumber` INTEGER, "
+                                   "`Duration` INTEGER NOT NULL, "
+                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
+                                   "`Genre` VARCHAR(55), "
+                                   "`Composer` VARCHAR(55), "
+                                   "`Lyricist` VARCHAR(55), "
+                                   "`Comment` VARCHAR(255), "
+                                   "`Year` INTEGER, "
+                                   "`Channels` INTEGER, "
+                                   "`BitRate` INTEGER, "
+                                   "`SampleRate` INTEGER, "
+                                   "`HasEmbeddedCover` BOOLEAN NOT NULL, "
+                                   "UNIQUE (`FileName`))"),
+                    QStringLiteral("INSERT INTO `OldTracks` "
+                                   "SELECT tracks.`ID`, directory.`Path` || trackData.`BaseName`, tracks.`Priority`, tracks.`Title`, "
+                                   "tracks.`ArtistName`, tracks.`AlbumTitle`, tracks.`AlbumArtistName`, tracks.`AlbumPath`, "
+                                   "tracks.`TrackNumber`, tracks.`DiscNumber`, tracks.`Duration`, tracks.`Rating`, genre.`Name`, "
+                                   "composer.`Name`, lyricist.`Name`, tracks.`Comment`, tracks.`Year`, tracks.`Channels`, "
+                                   "tracks.`BitRate`, tracks.`SampleRate`, tracks.`HasEmbeddedCover` "
+                                   "FROM `Tracks` tracks "
+                                   "JOIN `TracksData` trackData ON trackData.`ID` = tracks.`FileID` "
+                                   "JOIN `Directories` directory ON directory.`ID` = trackData.`DirectoryID` "
+                                   "LEFT JOIN `Genre` genre ON genre.`ID` = tracks.`GenreID` "
+                                   "LEFT JOIN `Composer` composer ON composer.`ID` = tracks.`ComposerID` "
+                                   "LEFT JOIN `Lyricist` lyricist ON lyricist.`ID` = tracks.`LyricistID`"),
+                    QStringLiteral("DROP TABLE `TracksPlayScore`"),
+                    QStringLiteral("DROP TABLE `PlayScoreReference`"),
+                    QStringLiteral("DROP TABLE `AlbumSummary`"),
+                    QStringLiteral("DROP TABLE `DatabaseGeneration`"),
+                    QStringLiteral("DROP TABLE `DatabaseChangesJournal`"),
+                    QStringLiteral("DROP TABLE `DirectoriesState`"),
+                    QStringLiteral("DROP TABLE `PlayStatisticsJournalState`"),
+                    QStringLiteral("DROP TABLE IF EXISTS `TracksSearch`"),
+                    QStringLiteral("DROP TABLE IF EXISTS `AlbumsSearch`"),
+                    QStringLiteral("DROP INDEX `AlbumsTitleIndex`"),
+                    QStringLiteral("DROP TABLE `Tracks`"),
+                    QStringLiteral("DROP TABLE `TracksData`"),
+                    QStringLiteral("DROP TABLE `Directories`"),
+                    QStringLiteral("ALTER TABLE `OldTracksData` RENAME TO `TracksData`"),
+                    QStringLiteral("ALTER TABLE `OldTracks` RENAME TO `Tracks`"),
+                    QStringLiteral("UPDATE `DatabaseVersion` SET `Version` = %1").arg(storedVersion),
+            };
+
+            QSqlQuery downgradeQuery(rawDatabase);
+            for (const auto &oneText : downgradeTexts + extraTexts) {
+                result = result && downgradeQuery.exec(oneText);
+            }
+
+            rawDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+
+        return result;
+    }
+
 private Q_SLOTS:
 
     void initTestCase()
@@ -63,9 +161,11 @@ private Q_SLOTS:
         qRegisterMetaType<DataTypes::ListArtistDataType>("ListArtistDataType");
         qRegisterMetaType<DataTypes::ListGenreDataType>("ListGenreDataType");
         qRegisterMetaType<DataTypes::TrackDataType>("TrackDataType");
+        qRegisterMetaType<DataTypes::DirectoriesStateType>("DataTypes::DirectoriesStateType");
         qRegisterMetaType<DataTypes::AlbumDataType>("AlbumDataType");
         qRegisterMetaType<DataTypes::ArtistDataType>("ArtistDataType");
         qRegisterMetaType<DataTypes::GenreDataType>("GenreDataType");
+        qRegisterMetaType<DataTypes::DatabaseChanges>("DatabaseChanges");
     }
 
     void avoidCrashInTrackIdFromTitleAlbumArtist()
@@ -2448,262 +2548,1600 @@ private Q_SLOTS:
         QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
     }
 
-    void addOneTrack()
+    void readTracksAndAlbumsByPages()
     {
         DatabaseInterface musicDb;
 
         musicDb.init(QStringLiteral("testDb"));
 
-        QSignalSpy musicDbArtistAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
-        QSignalSpy musicDbAlbumAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
         QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
-        QSignalSpy musicDbArtistRemovedSpy(&musicDb, &DatabaseInterface::artistRemoved);
-        QSignalSpy musicDbAlbumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
-        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
-        QSignalSpy musicDbAlbumModifiedSpy(&musicDb, &DatabaseInterface::albumModified);
-        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
         QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
 
-        QCOMPARE(musicDb.allAlbumsData().count(), 0);
-        QCOMPARE(musicDb.allArtistsData().count(), 0);
-        QCOMPARE(musicDb.allTracksData().count(), 0);
-        QCOMPARE(musicDbArtistAddedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumAddedSpy.count(), 0);
-        QCOMPARE(musicDbTrackAddedSpy.count(), 0);
-        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
-        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 0);
-        QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
-        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
-
         musicDb.insertTracksList(mNewTracks, mNewCovers);
 
         musicDbTrackAddedSpy.wait(300);
 
-        QCOMPARE(musicDb.allAlbumsData().count(), 5);
-        QCOMPARE(musicDb.allArtistsData().count(), 7);
         QCOMPARE(musicDb.allTracksData().count(), 22);
-        QCOMPARE(musicDbArtistAddedSpy.count(), 1);
-        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
-        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
-        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
-        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 0);
-        QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
-        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDb.allAlbumsData().count(), 5);
 
-        auto newTrack = DataTypes::TrackDataType{true, QStringLiteral("$23"), QStringLiteral("0"), QStringLiteral("track6"),
-                QStringLiteral("artist2"), QStringLiteral("album3"), QStringLiteral("artist2"),
-                6, 1, QTime::fromMSecsSinceStartOfDay(23), {QUrl::fromLocalFile(QStringLiteral("/$23"))},
-                QDateTime::fromMSecsSinceEpoch(23),
-                QUrl::fromLocalFile(QStringLiteral("album3")), 5, true,
-                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
-        auto newTracks = DataTypes::ListTrackDataType();
-        newTracks.push_back(newTrack);
+        auto pagedTracks = DataTypes::ListTrackDataType{};
+        auto lastFileName = QString{};
+        while (true) {
+            const auto &onePage = musicDb.allTracksDataAfter(lastFileName, 5);
+            QVERIFY(onePage.count() <= 5);
+            pagedTracks.append(onePage);
+            if (onePage.count() < 5) {
+                break;
+            }
+            lastFileName = onePage.last()[DataTypes::ResourceRole].toString();
+        }
 
-        auto newCovers = mNewCovers;
-        newCovers[QStringLiteral("file:///$23")] = QUrl::fromLocalFile(QStringLiteral("album3"));
+        QCOMPARE(pagedTracks.count(), 22);
 
-        musicDb.insertTracksList(newTracks, newCovers);
+        auto pagedTrackIds = QSet<qulonglong>{};
+        for (const auto &oneTrack : pagedTracks) {
+            pagedTrackIds.insert(oneTrack.databaseId());
+        }
+        QCOMPARE(pagedTrackIds.count(), 22);
+
+        auto pagedAlbums = DataTypes::ListAlbumDataType{};
+        auto lastTitle = QString{};
+        auto lastAlbumId = qulonglong{0};
+        while (true) {
+            const auto &onePage = musicDb.allAlbumsDataAfter(lastTitle, lastAlbumId, 2);
+            QVERIFY(onePage.count() <= 2);
+            pagedAlbums.append(onePage);
+            if (onePage.count() < 2) {
+                break;
+            }
+            lastTitle = onePage.last().title();
+            lastAlbumId = onePage.last().databaseId();
+        }
 
-        musicDbTrackAddedSpy.wait(300);
+        const auto &allAlbums = musicDb.allAlbumsData();
+
+        QCOMPARE(pagedAlbums.count(), allAlbums.count());
+        for (int i = 0; i < allAlbums.count(); ++i) {
+            QCOMPARE(pagedAlbums[i].title().toLower(), allAlbums[i].title().toLower());
+        }
+
+        auto tracksPagesCount = 0;
+        auto tracksByPages = DataTypes::ListTrackDataType{};
+        const auto tracksGeneration = musicDb.allTracksDataByPages(5, [&tracksPagesCount, &tracksByPages](const DataTypes::ListTrackDataType &onePage) {
+            ++tracksPagesCount;
+            tracksByPages.append(onePage);
+        });
+
+        // the views skip the additions published up to the generation they loaded
+        QCOMPARE(tracksGeneration, musicDb.databaseGeneration());
+        QCOMPARE(tracksPagesCount, 5);
+        QCOMPARE(tracksByPages, pagedTracks);
+
+        auto albumsPagesCount = 0;
+        auto albumsByPages = DataTypes::ListAlbumDataType{};
+        const auto albumsGeneration = musicDb.allAlbumsDataByPages(2, [&albumsPagesCount, &albumsByPages](const DataTypes::ListAlbumDataType &onePage) {
+            ++albumsPagesCount;
+            albumsByPages.append(onePage);
+        });
+
+        QCOMPARE(albumsGeneration, musicDb.databaseGeneration());
+        QCOMPARE(albumsPagesCount, 3);
+        QCOMPARE(albumsByPages, pagedAlbums);
 
-        QCOMPARE(musicDb.allAlbumsData().count(), 5);
-        QCOMPARE(musicDb.allArtistsData().count(), 7);
-        QCOMPARE(musicDb.allTracksData().count(), 23);
-        QCOMPARE(musicDbArtistAddedSpy.count(), 1);
-        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
-        QCOMPARE(musicDbTrackAddedSpy.count(), 2);
-        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
-        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 1);
-        QCOMPARE(musicDbTrackModifiedSpy.count(), 3);
         QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
     }
 
-    void addTwoTracksSameAlbumSameTitle()
+    void albumsPagesStartInTheTitleIndex()
     {
-        QTemporaryFile databaseFile;
-        databaseFile.open();
+        QTemporaryDir databaseDirectory;
+        QVERIFY(databaseDirectory.isValid());
 
-        qDebug() << "addTwoTracksSameAlbumSameTitle" << databaseFile.fileName();
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+        }
+
+        {
+            auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+            rawDatabase.setDatabaseName(databaseFileName);
+            QVERIFY(rawDatabase.open());
+
+            QSqlQuery planQuery(rawDatabase);
+            QVERIFY(planQuery.exec(QStringLiteral("EXPLAIN QUERY PLAN "
+                                                  "SELECT album.`ID` "
+                                                  "FROM `Albums` album, `AlbumSummary` summary "
+                                                  "WHERE summary.`AlbumID` = album.`ID` AND "
+                                                  "(album.`Title` COLLATE NOCASE, album.`ID`) > ('album', 3) "
+                                                  "ORDER BY album.`Title` COLLATE NOCASE, album.`ID` "
+                                                  "LIMIT 2")));
+
+            auto planDetails = QStringList{};
+            while (planQuery.next()) {
+                planDetails.push_back(planQuery.value(3).toString());
+            }
+
+            qDebug() << "DatabaseInterfaceTests::albumsPagesStartInTheTitleIndex" << planDetails;
+
+            QVERIFY(planDetails.join(QLatin1Char('\n')).contains(QStringLiteral("AlbumsTitleIndex")));
+            QVERIFY(!planDetails.join(QLatin1Char('\n')).contains(QStringLiteral("TEMP B-TREE")));
+
+            rawDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+    }
+
+    void removeTrackDefiningTheAlbumArtist()
+    {
+        QTemporaryDir databaseDirectory;
+        QVERIFY(databaseDirectory.isValid());
+
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
 
         DatabaseInterface musicDb;
 
-        musicDb.init(QStringLiteral("testDb"), databaseFile.fileName());
+        musicDb.init(QStringLiteral("testDb"), databaseFileName);
 
-        QSignalSpy musicDbArtistAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
-        QSignalSpy musicDbAlbumAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
         QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
-        QSignalSpy musicDbArtistRemovedSpy(&musicDb, &DatabaseInterface::artistRemoved);
-        QSignalSpy musicDbAlbumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
-        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
         QSignalSpy musicDbAlbumModifiedSpy(&musicDb, &DatabaseInterface::albumModified);
-        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
         QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
 
-        QCOMPARE(musicDb.allAlbumsData().count(), 0);
-        QCOMPARE(musicDb.allArtistsData().count(), 0);
-        QCOMPARE(musicDb.allTracksData().count(), 0);
-        QCOMPARE(musicDbArtistAddedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumAddedSpy.count(), 0);
-        QCOMPARE(musicDbTrackAddedSpy.count(), 0);
-        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
-        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 0);
-        QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
-        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
-
-        auto newTrack = DataTypes::TrackDataType{true, QStringLiteral("$23"), QStringLiteral("0"), QStringLiteral("track6"),
-                QStringLiteral("artist2"), QStringLiteral("album3"), QStringLiteral("artist2"),
-                6, 1, QTime::fromMSecsSinceStartOfDay(23), {QUrl::fromLocalFile(QStringLiteral("/$23"))},
-                QDateTime::fromMSecsSinceEpoch(23),
-        {QUrl::fromLocalFile(QStringLiteral("album3"))}, 5, true,
-                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
-        auto newTracks = DataTypes::ListTrackDataType();
-        newTracks.push_back(newTrack);
+        auto newTracks = DataTypes::ListTrackDataType{
+                {true, QStringLiteral("$19"), QStringLiteral("0"), QStringLiteral("track6"),
+                 QStringLiteral("artist2"), QStringLiteral("album3"), {}, 6, 1,
+                 QTime::fromMSecsSinceStartOfDay(19), {QUrl::fromLocalFile(QStringLiteral("/$19"))},
+                 QDateTime::fromMSecsSinceEpoch(19),
+                 {QUrl::fromLocalFile(QStringLiteral("album3"))}, 5, true,
+                 QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false},
+                {true, QStringLiteral("$20"), QStringLiteral("0"), QStringLiteral("track7"),
+                 QStringLiteral("artist3"), QStringLiteral("album3"), {}, 7, 1,
+                 QTime::fromMSecsSinceStartOfDay(20), {QUrl::fromLocalFile(QStringLiteral("/$20"))},
+                 QDateTime::fromMSecsSinceEpoch(20),
+                 {QUrl::fromLocalFile(QStringLiteral("album3"))}, 5, true,
+                 QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false},
+                {true, QStringLiteral("$21"), QStringLiteral("0"), QStringLiteral("track8"),
+                 QStringLiteral("artist3"), QStringLiteral("album3"), {QStringLiteral("artist4")}, 8, 1,
+                 QTime::fromMSecsSinceStartOfDay(21), {QUrl::fromLocalFile(QStringLiteral("/$21"))},
+                 QDateTime::fromMSecsSinceEpoch(21),
+                 {QUrl::fromLocalFile(QStringLiteral("album3"))}, 5, true,
+                 QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false}};
 
         auto newCovers = mNewCovers;
-        newCovers[QStringLiteral("file:///$23")] = QUrl::fromLocalFile(QStringLiteral("album3"));
+        newCovers[QStringLiteral("file:///$19")] = QUrl::fromLocalFile(QStringLiteral("album3"));
+        newCovers[QStringLiteral("file:///$20")] = QUrl::fromLocalFile(QStringLiteral("album3"));
+        newCovers[QStringLiteral("file:///$21")] = QUrl::fromLocalFile(QStringLiteral("album3"));
 
-        musicDb.insertTracksList(newTracks, newCovers);
+        musicDb.insertTracksList({newTracks[0], newTracks[1]}, newCovers);
 
         musicDbTrackAddedSpy.wait(300);
 
-        QCOMPARE(musicDb.allAlbumsData().count(), 1);
-        QCOMPARE(musicDb.allArtistsData().count(), 1);
-        QCOMPARE(musicDb.allTracksData().count(), 1);
-        QCOMPARE(musicDbArtistAddedSpy.count(), 1);
-        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
-        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
-        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
-        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumModifiedSpy.count(), 0);
-        QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
-        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        auto albumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album3"), {}, QStringLiteral("/"));
+        auto album = musicDb.albumDataFromDatabaseId(albumId);
 
-        auto firstTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track6"), QStringLiteral("artist2"),
-                                                                         QStringLiteral("album3"), 6, 1);
-        auto firstTrack = musicDb.trackDataFromDatabaseId(firstTrackId);
+        QCOMPARE(album.isValid(), true);
+        QCOMPARE(album.artist(), QStringLiteral("Various Artists"));
+        QCOMPARE(album[DataTypes::IsValidAlbumArtistRole].toBool(), false);
 
-        auto firstTrackTitle = firstTrack.title();
-        auto firstTrackArtist = firstTrack.artist();
-        auto firstTrackAlbumArtist = firstTrack.albumArtist();
-        auto firstTrackAlbum = firstTrack.album();
-        auto firstTrackImage = firstTrack.albumCover();
-        auto firstTrackDuration = firstTrack.duration();
-        auto firstTrackMilliSecondsDuration = firstTrack.duration().msecsSinceStartOfDay();
-        auto firstTrackTrackNumber = firstTrack.trackNumber();
-        auto firstTrackDiscNumber = firstTrack.discNumber();
-        const auto &firstTrackResource = firstTrack.resourceURI();
-        auto firstTrackRating = firstTrack.rating();
-        auto firstIsSingleDiscAlbum = firstTrack.isSingleDiscAlbum();
+        /* the only track by another artist defines the artist of the album */
+        musicDb.removeTracksList({newTracks[1].resourceURI()});
 
-        QCOMPARE(firstTrack.isValid(), true);
-        QCOMPARE(firstTrackTitle, QStringLiteral("track6"));
-        QCOMPARE(firstTrackArtist, QStringLiteral("artist2"));
-        QCOMPARE(firstTrackAlbumArtist, QStringLiteral("artist2"));
-        QCOMPARE(firstTrackAlbum, QStringLiteral("album3"));
-        QCOMPARE(firstTrackImage.isValid(), true);
-        QCOMPARE(firstTrackImage, QUrl::fromLocalFile(QStringLiteral("album3")));
-        QCOMPARE(firstTrackDuration, QTime::fromMSecsSinceStartOfDay(23));
-        QCOMPARE(firstTrackMilliSecondsDuration, 23);
-        QCOMPARE(firstTrackTrackNumber, 6);
-        QCOMPARE(firstTrackDiscNumber, 1);
-        QCOMPARE(firstTrackResource.isValid(), true);
-        QCOMPARE(firstTrackResource, QUrl::fromLocalFile(QStringLiteral("/$23")));
-        QCOMPARE(firstTrackRating, 5);
-        QCOMPARE(firstIsSingleDiscAlbum, true);
+        album = musicDb.albumDataFromDatabaseId(albumId);
 
-        auto allAlbums = musicDb.allAlbumsData();
+        QCOMPARE(album.isValid(), true);
+        QCOMPARE(album.artist(), QStringLiteral("artist2"));
+        QCOMPARE(musicDb.albumData(albumId).count(), 1);
 
-        auto firstAlbumData = musicDb.albumData(allAlbums[0].databaseId());
-        auto firstAlbumTitle = allAlbums[0].title();
-        auto firstAlbumArtist = allAlbums[0].artist();
-        auto firstAlbumImage = allAlbums[0].albumArtURI();
-        auto firstAlbumTracksCount = firstAlbumData.count();
-        auto firstAlbumIsSingleDiscAlbum = allAlbums[0].isSingleDiscAlbum();
+        musicDb.insertTracksList({newTracks[1], newTracks[2]}, newCovers);
 
-        QCOMPARE(firstAlbumTitle, QStringLiteral("album3"));
-        QCOMPARE(firstAlbumArtist, QStringLiteral("artist2"));
-        QCOMPARE(firstAlbumImage.isValid(), true);
-        QCOMPARE(firstAlbumImage, QUrl::fromLocalFile(QStringLiteral("album3")));
-        QCOMPARE(firstAlbumTracksCount, 1);
-        QCOMPARE(firstAlbumIsSingleDiscAlbum, true);
+        album = musicDb.albumDataFromDatabaseId(albumId);
 
-        auto newTrack2 = DataTypes::TrackDataType{true, QStringLiteral("$23"), QStringLiteral("0"), QStringLiteral("track6"),
-                QStringLiteral("artist9"), QStringLiteral("album3"), QStringLiteral("artist2"), 6, 1,
-                QTime::fromMSecsSinceStartOfDay(23), {QUrl::fromLocalFile(QStringLiteral("/$23"))},
-                QDateTime::fromMSecsSinceEpoch(23),
-                QUrl::fromLocalFile(QStringLiteral("album3")), 5, true,
-                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
-        auto newTracks2 = DataTypes::ListTrackDataType();
-        newTracks2.push_back(newTrack2);
+        QCOMPARE(album.artist(), QStringLiteral("artist4"));
+        QCOMPARE(album[DataTypes::IsValidAlbumArtistRole].toBool(), true);
 
-        auto newCovers2 = mNewCovers;
-        newCovers2[QStringLiteral("file:///$23")] = QUrl::fromLocalFile(QStringLiteral("image$19"));
+        {
+            auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+            rawDatabase.setDatabaseName(databaseFileName);
+            QVERIFY(rawDatabase.open());
 
-        musicDb.insertTracksList(newTracks2, newCovers2);
+            // the album artist was only known through the tag of a track that is gone
+            QSqlQuery clearArtistQuery(rawDatabase);
+            QVERIFY(clearArtistQuery.exec(QStringLiteral("UPDATE `Albums` SET `ArtistName` = NULL")));
 
-        musicDbTrackAddedSpy.wait(50);
+            rawDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
 
-        QCOMPARE(musicDb.allAlbumsData().count(), 1);
-        QCOMPARE(musicDb.allArtistsData().count(), 2);
-        QCOMPARE(musicDb.allTracksData().count(), 1);
-        QCOMPARE(musicDbArtistAddedSpy.count(), 2);
-        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
-        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
-        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
-        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
-        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        musicDbAlbumModifiedSpy.clear();
+
+        musicDb.removeTracksList({newTracks[2].resourceURI()});
+
+        album = musicDb.albumDataFromDatabaseId(albumId);
+
+        QCOMPARE(album.isValid(), true);
+        QCOMPARE(album.artist(), QStringLiteral("artist4"));
+        QCOMPARE(album[DataTypes::IsValidAlbumArtistRole].toBool(), true);
+        QCOMPARE(musicDb.albumData(albumId).count(), 2);
         QCOMPARE(musicDbAlbumModifiedSpy.count(), 1);
-        QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
         QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
 
-        auto secondTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track6"), QStringLiteral("artist9"),
-                                                                          QStringLiteral("album3"), 6, 1);
-        auto secondTrack = musicDb.trackDataFromDatabaseId(secondTrackId);
+    void unusedDirectoriesAreRemoved()
+    {
+        QTemporaryDir databaseDirectory;
+        QVERIFY(databaseDirectory.isValid());
 
-        auto secondTrackTitle = secondTrack.title();
-        auto secondTrackArtist = secondTrack.artist();
-        auto secondTrackAlbumArtist = secondTrack.albumArtist();
-        auto secondTrackAlbum = secondTrack.album();
-        auto secondTrackImage = secondTrack.albumCover();
-        auto secondTrackDuration = secondTrack.duration();
-        auto secondTrackMilliSecondsDuration = secondTrack.duration().msecsSinceStartOfDay();
-        auto secondTrackTrackNumber = secondTrack.trackNumber();
-        auto secondTrackDiscNumber = secondTrack.discNumber();
-        const auto &secondTrackResource = secondTrack.resourceURI();
-        auto secondTrackRating = secondTrack.rating();
-        auto secondIsSingleDiscAlbum = secondTrack.isSingleDiscAlbum();
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
 
-        QCOMPARE(secondTrack.isValid(), true);
-        QCOMPARE(secondTrackTitle, QStringLiteral("track6"));
-        QCOMPARE(secondTrackArtist, QStringLiteral("artist9"));
-        QCOMPARE(secondTrackAlbumArtist, QStringLiteral("artist2"));
-        QCOMPARE(secondTrackAlbum, QStringLiteral("album3"));
-        QCOMPARE(secondTrackImage.isValid(), true);
-        QCOMPARE(secondTrackImage, QUrl::fromLocalFile(QStringLiteral("album3")));
-        QCOMPARE(secondTrackDuration, QTime::fromMSecsSinceStartOfDay(23));
-        QCOMPARE(secondTrackMilliSecondsDuration, 23);
-        QCOMPARE(secondTrackTrackNumber, 6);
-        QCOMPARE(secondTrackDiscNumber, 1);
-        QCOMPARE(secondTrackResource.isValid(), true);
-        QCOMPARE(secondTrackResource, QUrl::fromLocalFile(QStringLiteral("/$23")));
-        QCOMPARE(secondTrackRating, 5);
-        QCOMPARE(secondIsSingleDiscAlbum, true);
+        DatabaseInterface musicDb;
 
-        auto allAlbums2 = musicDb.allAlbumsData();
+        musicDb.init(QStringLiteral("testDb"), databaseFileName);
 
-        auto firstAlbumData2 = musicDb.albumData(allAlbums2[0].databaseId());
-        auto firstAlbumTitle2 = allAlbums2[0].title();
-        auto firstAlbumArtist2 = allAlbums2[0].artist();
-        auto firstAlbumImage2 = allAlbums2[0].albumArtURI();
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto newTracks = DataTypes::ListTrackDataType{
+                {true, QStringLiteral("$19"), QStringLiteral("0"), QStringLiteral("track6"),
+                 QStringLiteral("artist2"), QStringLiteral("album3"), {}, 6, 1,
+                 QTime::fromMSecsSinceStartOfDay(19), {QUrl::fromLocalFile(QStringLiteral("/directory1/$19"))},
+                 QDateTime::fromMSecsSinceEpoch(19),
+                 {QUrl::fromLocalFile(QStringLiteral("album3"))}, 5, true,
+                 QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false},
+                {true, QStringLiteral("$20"), QStringLiteral("0"), QStringLiteral("track7"),
+                 QStringLiteral("artist2"), QStringLiteral("album3"), {}, 7, 1,
+                 QTime::fromMSecsSinceStartOfDay(20), {QUrl::fromLocalFile(QStringLiteral("/directory1/$20"))},
+                 QDateTime::fromMSecsSinceEpoch(20),
+                 {QUrl::fromLocalFile(QStringLiteral("album3"))}, 5, true,
+                 QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false},
+                {true, QStringLiteral("$21"), QStringLiteral("0"), QStringLiteral("track8"),
+                 QStringLiteral("artist2"), QStringLiteral("album4"), {}, 8, 1,
+                 QTime::fromMSecsSinceStartOfDay(21), {QUrl::fromLocalFile(QStringLiteral("/directory2/$21"))},
+                 QDateTime::fromMSecsSinceEpoch(21),
+                 {QUrl::fromLocalFile(QStringLiteral("album4"))}, 5, true,
+                 QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false}};
+
+        musicDb.insertTracksList(newTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 3);
+
+        auto storedDirectories = [&databaseFileName]() {
+            auto directories = QStringList{};
+
+            {
+                auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+                rawDatabase.setDatabaseName(databaseFileName);
+
+                if (rawDatabase.open()) {
+                    QSqlQuery directoriesQuery(rawDatabase);
+
+                    if (directoriesQuery.exec(QStringLiteral("SELECT `Path` FROM `Directories` ORDER BY `Path`"))) {
+                        while (directoriesQuery.next()) {
+                            directories.push_back(directoriesQuery.value(0).toString());
+                        }
+                    }
+                }
+
+                rawDatabase.close();
+            }
+            QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+
+            return directories;
+        };
+
+        QCOMPARE(storedDirectories(), (QStringList{QStringLiteral("file:///directory1/"), QStringLiteral("file:///directory2/")}));
+
+        /* a directory still holding a file is kept */
+        musicDb.removeTracksList({newTracks[0].resourceURI(), newTracks[2].resourceURI()});
+
+        QCOMPARE(musicDb.allTracksData().count(), 1);
+        QCOMPARE(storedDirectories(), QStringList{QStringLiteral("file:///directory1/")});
+
+        musicDb.removeTracksList({newTracks[1].resourceURI()});
+
+        QCOMPARE(musicDb.allTracksData().count(), 0);
+        QCOMPARE(storedDirectories(), QStringList{});
+
+        musicDb.insertTracksList(newTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(storedDirectories().count(), 2);
+
+        musicDb.clearData();
+
+        QCOMPARE(storedDirectories(), QStringList{});
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void removeAllTracksInOneBatch()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbArtistRemovedSpy(&musicDb, &DatabaseInterface::artistRemoved);
+        QSignalSpy musicDbAlbumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy musicDbAlbumModifiedSpy(&musicDb, &DatabaseInterface::albumModified);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 5);
+        QCOMPARE(musicDb.allArtistsData().count(), 7);
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+
+        auto allFiles = QList<QUrl>{};
+        for (const auto &oneTrack : musicDb.allTracksData()) {
+            allFiles.push_back(oneTrack.resourceURI());
+        }
+
+        musicDb.removeTracksList(allFiles);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 0);
+        QCOMPARE(musicDb.allArtistsData().count(), 0);
+        QCOMPARE(musicDb.allTracksData().count(), 0);
+        QCOMPARE(musicDbArtistRemovedSpy.count(), 7);
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 5);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 22);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void searchTracksAndAlbumsByPrefix()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        if (!musicDb.hasSearchIndex()) {
+            QSKIP("SQLite is built without the fts5 module");
+        }
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+
+        auto firstAlbumTrackIds = QList<qulonglong>{};
+        auto firstAlbumFiles = QList<QUrl>{};
+        for (const auto &oneTrack : musicDb.allTracksData()) {
+            if (oneTrack.album() == QLatin1String("album1")) {
+                firstAlbumTrackIds.push_back(oneTrack.databaseId());
+                firstAlbumFiles.push_back(oneTrack.resourceURI());
+            }
+        }
+
+        auto foundTrackIds = musicDb.searchTracks(QStringLiteral("album1"));
+        std::sort(foundTrackIds.begin(), foundTrackIds.end());
+        std::sort(firstAlbumTrackIds.begin(), firstAlbumTrackIds.end());
+
+        QCOMPARE(foundTrackIds, firstAlbumTrackIds);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("TRA")).count(), 22);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("tra"), 3).count(), 3);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("track1 artist1")).count(), 2);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("\"track1 OR")).count(), 0);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("  ")).count(), 0);
+
+        const auto secondAlbumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album2"), QStringLiteral("artist1"), QStringLiteral("/"));
+
+        QCOMPARE(musicDb.searchAlbums(QStringLiteral("album2")), QList<qulonglong>{secondAlbumId});
+        QCOMPARE(musicDb.searchAlbums(QStringLiteral("genre1")).isEmpty(), false);
+
+        musicDb.removeTracksList(firstAlbumFiles);
+
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("album1")).count(), 0);
+        QCOMPARE(musicDb.searchAlbums(QStringLiteral("album1")).count(), 0);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("tra")).count(), 22 - firstAlbumFiles.count());
+
+        musicDb.clearData();
+
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("tra")).count(), 0);
+        QCOMPARE(musicDb.searchAlbums(QStringLiteral("alb")).count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void albumAggregatesFollowTrackChanges()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        const auto secondAlbumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album2"), QStringLiteral("artist1"), QStringLiteral("/"));
+
+        auto secondAlbum = musicDb.albumDataFromDatabaseId(secondAlbumId);
+
+        QCOMPARE(secondAlbum[DataTypes::HighestTrackRating].toInt(), 5);
+        QCOMPARE(secondAlbum.isSingleDiscAlbum(), true);
+        QCOMPARE(secondAlbum.genres().contains(QStringLiteral("genre1")), true);
+        QCOMPARE(secondAlbum.genres().contains(QStringLiteral("genre2")), true);
+
+        auto modifiedTrack = mNewTracks[10];
+
+        QCOMPARE(modifiedTrack.resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$10")));
+
+        modifiedTrack[DataTypes::DiscNumberRole] = 2;
+        modifiedTrack[DataTypes::RatingRole] = 10;
+
+        musicDb.insertTracksList({modifiedTrack}, mNewCovers);
+
+        secondAlbum = musicDb.albumDataFromDatabaseId(secondAlbumId);
+
+        QCOMPARE(secondAlbum[DataTypes::HighestTrackRating].toInt(), 10);
+        QCOMPARE(secondAlbum.isSingleDiscAlbum(), false);
+
+        musicDb.removeTracksList({modifiedTrack.resourceURI()});
+
+        secondAlbum = musicDb.albumDataFromDatabaseId(secondAlbumId);
+
+        QCOMPARE(secondAlbum[DataTypes::HighestTrackRating].toInt(), 5);
+        QCOMPARE(secondAlbum.isSingleDiscAlbum(), true);
+
+        auto allAlbums = musicDb.allAlbumsData();
+        auto itSecondAlbum = std::find_if(allAlbums.begin(), allAlbums.end(), [secondAlbumId](const auto &oneAlbum) {
+            return oneAlbum.databaseId() == secondAlbumId;
+        });
+
+        QVERIFY(itSecondAlbum != allAlbums.end());
+        QCOMPARE((*itSecondAlbum)[DataTypes::HighestTrackRating].toInt(), 5);
+        QCOMPARE(itSecondAlbum->isSingleDiscAlbum(), true);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void databaseGenerationAndModelSnapshot()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        QCOMPARE(musicDb.databaseGeneration(), 0ULL);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        const auto generationAfterInsertion = musicDb.databaseGeneration();
+        QVERIFY(generationAfterInsertion > 0);
+
+        musicDb.insertTracksList({}, mNewCovers);
+
+        QCOMPARE(musicDb.databaseGeneration(), generationAfterInsertion);
+
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$1")), QDateTime::currentDateTime());
+
+        QVERIFY(musicDb.databaseGeneration() > generationAfterInsertion);
+
+        auto snapshot = ModelSnapshot{};
+        snapshot.setGeneration(musicDb.databaseGeneration());
+        snapshot.setAlbums(musicDb.allAlbumsData());
+        snapshot.setArtists(musicDb.allArtistsData());
+        snapshot.setGenres(musicDb.allGenresData());
+        snapshot.setTracks(musicDb.allTracksData());
+
+        QTemporaryDir snapshotDirectory;
+        const auto snapshotFileName = ModelSnapshot::fileNameForDatabase(snapshotDirectory.filePath(QStringLiteral("elisaDatabase.db")));
+
+        QVERIFY(snapshot.write(snapshotFileName));
+
+        auto readSnapshot = ModelSnapshot{};
+
+        QVERIFY(readSnapshot.read(snapshotFileName));
+        QCOMPARE(readSnapshot.generation(), musicDb.databaseGeneration());
+        QCOMPARE(readSnapshot.albums().count(), snapshot.albums().count());
+        QCOMPARE(readSnapshot.artists().count(), snapshot.artists().count());
+        QCOMPARE(readSnapshot.genres().count(), snapshot.genres().count());
+        QCOMPARE(readSnapshot.tracks(), snapshot.tracks());
+        QVERIFY(readSnapshot.hasData(ElisaUtils::Album));
+        QVERIFY(!readSnapshot.hasData(ElisaUtils::Radio));
+
+        QVERIFY(!readSnapshot.read(snapshotDirectory.filePath(QStringLiteral("missing.snapshot"))));
+        QCOMPARE(readSnapshot.tracks().count(), snapshot.tracks().count());
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void modelSnapshotIsWrittenWhenIdleOrOnQuit()
+    {
+        QTemporaryDir databaseDirectory;
+        QVERIFY(databaseDirectory.isValid());
+
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+        const auto snapshotFileName = ModelSnapshot::fileNameForDatabase(databaseFileName);
+
+        auto generationAfterInsertion = qulonglong{0};
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+            generationAfterInsertion = musicDb.databaseGeneration();
+
+            // the snapshot waits for the changes to stop
+            QVERIFY(!QFileInfo::exists(snapshotFileName));
+
+            musicDb.applicationAboutToQuit();
+
+            QVERIFY(QFileInfo::exists(snapshotFileName));
+        }
+
+        auto readSnapshot = ModelSnapshot{};
+        QVERIFY(readSnapshot.read(snapshotFileName));
+        QCOMPARE(readSnapshot.generation(), generationAfterInsertion);
+        QCOMPARE(readSnapshot.tracks().count(), mNewTracks.count());
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$1")), QDateTime::currentDateTime());
+
+            musicDb.applicationAboutToQuit();
+
+            // play statistics make the snapshot outdated too
+            QVERIFY(musicDb.databaseGeneration() > generationAfterInsertion);
+            QVERIFY(readSnapshot.read(snapshotFileName));
+            QCOMPARE(readSnapshot.generation(), musicDb.databaseGeneration());
+        }
+    }
+
+    void journaledChangesBringSnapshotUpToDate()
+    {
+        QTemporaryDir databaseDirectory;
+        QVERIFY(databaseDirectory.isValid());
+
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+        const auto trackFileName = QUrl::fromLocalFile(QStringLiteral("/$3"));
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        const auto snapshotGeneration = musicDb.databaseGeneration();
+        const auto removedTrackId = musicDb.trackIdFromFileName(trackFileName);
+
+        auto missedChanges = DataTypes::DatabaseChanges{};
+
+        QVERIFY(musicDb.journaledChangesSince(snapshotGeneration, missedChanges));
+        QVERIFY(missedChanges.isEmpty());
+
+        musicDb.removeTracksList({trackFileName});
+
+        QVERIFY(musicDb.journaledChangesSince(snapshotGeneration, missedChanges));
+        QCOMPARE(missedChanges.mSequenceNumber, musicDb.databaseGeneration());
+        QCOMPARE(missedChanges.mRemovedTracks, QList<qulonglong>{removedTrackId});
+
+        QVERIFY(musicDb.journaledChangesSince(0, missedChanges));
+        QCOMPARE(missedChanges.mAddedTracks.count(), 21);
+        QVERIFY(missedChanges.mRemovedTracks.isEmpty());
+
+        musicDb.clearData();
+
+        // the journal cannot replay a cleared database
+        QVERIFY(!musicDb.journaledChangesSince(snapshotGeneration, missedChanges));
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void statementStatisticsReport()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+
+        musicDb.setStatisticsEnabled(true);
+        musicDb.resetStatistics();
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+
+        const auto reportLines = musicDb.statisticsReport().split(QLatin1Char('\n'), QString::SkipEmptyParts);
+
+        QVERIFY(reportLines.count() > 2);
+        QVERIFY(reportLines.first().startsWith(QLatin1String("count\t")));
+
+        auto transactionLine = std::find_if(reportLines.begin(), reportLines.end(), [](const auto &oneLine) {
+            return oneLine.endsWith(QLatin1String("<transaction>"));
+        });
+        QVERIFY(transactionLine != reportLines.end());
+        QVERIFY(transactionLine->split(QLatin1Char('\t')).first().toInt() >= 2);
+
+        auto allTracksLine = std::find_if(reportLines.begin(), reportLines.end(), [](const auto &oneLine) {
+            return oneLine.split(QLatin1Char('\t')).value(5).toInt() == 22;
+        });
+        QVERIFY(allTracksLine != reportLines.end());
+
+        musicDb.setStatisticsEnabled(false);
+        musicDb.resetStatistics();
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDb.statisticsReport().split(QLatin1Char('\n'), QString::SkipEmptyParts).count(), 1);
+    }
+
+    void trackDataCacheIsInvalidatedByModifications()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        const auto trackFileName = QUrl::fromLocalFile(QStringLiteral("/$3"));
+        const auto trackId = musicDb.trackIdFromFileName(trackFileName);
+
+        QVERIFY(trackId != 0);
+
+        const auto transactionsCount = [&musicDb]() {
+            const auto reportLines = musicDb.statisticsReport().split(QLatin1Char('\n'), QString::SkipEmptyParts);
+            for (const auto &oneLine : reportLines) {
+                if (oneLine.endsWith(QLatin1String("<transaction>"))) {
+                    return oneLine.split(QLatin1Char('\t')).first().toInt();
+                }
+            }
+            return 0;
+        };
+
+        musicDb.setStatisticsEnabled(true);
+        musicDb.resetStatistics();
+
+        auto track = musicDb.trackDataFromDatabaseId(trackId);
+        auto cachedTrack = musicDb.trackDataFromDatabaseId(trackId);
+
+        QCOMPARE(cachedTrack, track);
+        QCOMPARE(track[DataTypes::PlayCounter].toInt(), 0);
+        QCOMPARE(transactionsCount(), 1);
+
+        auto trackByUrl = musicDb.trackDataFromDatabaseIdAndUrl(trackId, trackFileName);
+        auto cachedTrackByUrl = musicDb.trackDataFromDatabaseIdAndUrl(trackId, trackFileName);
+
+        QCOMPARE(cachedTrackByUrl, trackByUrl);
+        QCOMPARE(transactionsCount(), 2);
+
+        musicDb.trackHasStartedPlaying(trackFileName, QDateTime::currentDateTime());
+
+        track = musicDb.trackDataFromDatabaseId(trackId);
+        trackByUrl = musicDb.trackDataFromDatabaseIdAndUrl(trackId, trackFileName);
+
+        QCOMPARE(track[DataTypes::PlayCounter].toInt(), 1);
+        QCOMPARE(trackByUrl[DataTypes::PlayCounter].toInt(), 1);
+
+        musicDb.removeTracksList({trackFileName});
+
+        QVERIFY(musicDb.trackDataFromDatabaseId(trackId).isEmpty());
+        QVERIFY(musicDb.trackDataFromDatabaseIdAndUrl(trackId, trackFileName).isEmpty());
+
+        musicDb.setStatisticsEnabled(false);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void committedPlaysAreNotReplayed()
+    {
+        QTemporaryDir databaseDirectory;
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+        const auto journalFileName = databaseFileName + QStringLiteral(".plays");
+        const auto trackFileName = QUrl::fromLocalFile(QStringLiteral("/$1"));
+
+        auto journalContent = QByteArray{};
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+
+            musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+            musicDbTrackAddedSpy.wait(300);
+
+            musicDb.trackHasStartedPlaying(trackFileName, QDateTime::fromMSecsSinceEpoch(1000));
+            musicDb.trackHasStartedPlaying(trackFileName, QDateTime::fromMSecsSinceEpoch(2000));
+
+            QFile journalFile(journalFileName);
+            QVERIFY(journalFile.open(QIODevice::ReadOnly));
+            journalContent = journalFile.readAll();
+            QVERIFY(!journalContent.isEmpty());
+
+            musicDb.applicationAboutToQuit();
+
+            QCOMPARE(QFileInfo(journalFileName).size(), 0LL);
+        }
+
+        // a crash between the commit of the plays and the truncation of the journal
+        {
+            QFile journalFile(journalFileName);
+            QVERIFY(journalFile.open(QIODevice::WriteOnly));
+            QCOMPARE(journalFile.write(journalContent), journalContent.size());
+        }
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            const auto trackId = musicDb.trackIdFromFileName(trackFileName);
+
+            QCOMPARE(musicDb.trackDataFromDatabaseId(trackId)[DataTypes::PlayCounter].toInt(), 2);
+            QCOMPARE(QFileInfo(journalFileName).size(), 0LL);
+
+            // the sequence goes on after the plays already applied
+            musicDb.trackHasStartedPlaying(trackFileName, QDateTime::fromMSecsSinceEpoch(3000));
+            musicDb.applicationAboutToQuit();
+
+            QCOMPARE(musicDb.trackDataFromDatabaseId(trackId)[DataTypes::PlayCounter].toInt(), 3);
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        }
+    }
+
+    void movedTrackKeepsItsPlayStatistics()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbTracksRemovedSpy(&musicDb, &DatabaseInterface::tracksRemoved);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        const auto trackFileName = QUrl::fromLocalFile(QStringLiteral("/$3"));
+        const auto movedTrackFileName = QUrl::fromLocalFile(QStringLiteral("/moved/$3"));
+        const auto trackId = musicDb.trackIdFromFileName(trackFileName);
+
+        QVERIFY(trackId != 0);
+
+        musicDb.trackHasStartedPlaying(trackFileName, QDateTime::currentDateTime());
+
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId)[DataTypes::PlayCounter].toInt(), 1);
+
+        musicDb.moveTrackFile(trackFileName, movedTrackFileName);
+
+        QCOMPARE(musicDb.trackIdFromFileName(trackFileName), qulonglong(0));
+        QCOMPARE(musicDb.trackIdFromFileName(movedTrackFileName), trackId);
+
+        const auto movedTrack = musicDb.trackDataFromDatabaseId(trackId);
+
+        QCOMPARE(movedTrack.resourceURI(), movedTrackFileName);
+        QCOMPARE(movedTrack[DataTypes::PlayCounter].toInt(), 1);
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbTracksRemovedSpy.count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void playStatisticsJournalIsReplayed()
+    {
+        QTemporaryDir databaseDirectory;
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+        const auto trackFileName = QUrl::fromLocalFile(QStringLiteral("/$1"));
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+            QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
+
+            musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+            musicDbTrackAddedSpy.wait(300);
+
+            musicDb.trackHasStartedPlaying(trackFileName, QDateTime::fromMSecsSinceEpoch(1000));
+            musicDb.trackHasStartedPlaying(trackFileName, QDateTime::fromMSecsSinceEpoch(2000));
+
+            const auto trackId = musicDb.trackIdFromFileName(trackFileName);
+            QCOMPARE(musicDb.trackDataFromDatabaseId(trackId)[DataTypes::PlayCounter].toInt(), 0);
+            QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
+            QVERIFY(QFileInfo(databaseFileName + QStringLiteral(".plays")).size() > 0);
+        }
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            const auto trackId = musicDb.trackIdFromFileName(trackFileName);
+            auto track = musicDb.trackDataFromDatabaseId(trackId);
+
+            QCOMPARE(track[DataTypes::PlayCounter].toInt(), 2);
+            QCOMPARE(track[DataTypes::FirstPlayDate].toLongLong(), 1000LL);
+            QCOMPARE(track[DataTypes::LastPlayDate].toLongLong(), 2000LL);
+            QCOMPARE(QFileInfo(databaseFileName + QStringLiteral(".plays")).size(), 0LL);
+
+            musicDb.trackHasStartedPlaying(trackFileName, QDateTime::fromMSecsSinceEpoch(3000));
+            musicDb.applicationAboutToQuit();
+
+            track = musicDb.trackDataFromDatabaseId(trackId);
+
+            QCOMPARE(track[DataTypes::PlayCounter].toInt(), 3);
+            QCOMPARE(track[DataTypes::FirstPlayDate].toLongLong(), 1000LL);
+            QCOMPARE(track[DataTypes::LastPlayDate].toLongLong(), 3000LL);
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        }
+
+        {
+            QThread databaseThread;
+            databaseThread.start();
+
+            DatabaseInterface musicDb;
+            musicDb.moveToThread(&databaseThread);
+
+            QMetaObject::invokeMethod(&musicDb, [&musicDb, &databaseFileName, &trackFileName]() {
+                musicDb.init(QStringLiteral("testDb"), databaseFileName);
+                musicDb.trackHasStartedPlaying(trackFileName, QDateTime::fromMSecsSinceEpoch(4000));
+            }, Qt::BlockingQueuedConnection);
+
+            QVERIFY(QFileInfo(databaseFileName + QStringLiteral(".plays")).size() > 0);
+
+            // the database thread is stopped as soon as the application is told to quit
+            musicDb.applicationAboutToQuit();
+
+            databaseThread.quit();
+            databaseThread.wait();
+
+            QCOMPARE(QFileInfo(databaseFileName + QStringLiteral(".plays")).size(), 0LL);
+        }
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            const auto track = musicDb.trackDataFromDatabaseId(musicDb.trackIdFromFileName(trackFileName));
+
+            QCOMPARE(track[DataTypes::PlayCounter].toInt(), 4);
+            QCOMPARE(track[DataTypes::LastPlayDate].toLongLong(), 4000LL);
+        }
+    }
+
+    void writesAreDelayedWhileAnotherProcessWrites()
+    {
+        QTemporaryDir databaseDirectory;
+        QVERIFY(databaseDirectory.isValid());
+
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+        QSignalSpy musicDbFinishInsertingSpy(&musicDb, &DatabaseInterface::finishInsertingTracksList);
+        QSignalSpy musicDbFinishRemovingSpy(&musicDb, &DatabaseInterface::finishRemovingTracksList);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        {
+            auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+            rawDatabase.setDatabaseName(databaseFileName);
+            QVERIFY(rawDatabase.open());
+
+            // elisaImport keeps the write lock longer than the busy timeout
+            QSqlQuery lockQuery(rawDatabase);
+            QVERIFY(lockQuery.exec(QStringLiteral("BEGIN IMMEDIATE")));
+
+            auto lockedTimer = QElapsedTimer{};
+            lockedTimer.start();
+
+            musicDb.insertTracksList(mNewTracks, mNewCovers);
+            musicDb.removeTracksList({mNewTracks.first().resourceURI()});
+
+            // the writes do not wait for the lock
+            QVERIFY(lockedTimer.elapsed() < 5000);
+            QCOMPARE(musicDbFinishInsertingSpy.count(), 0);
+            QCOMPARE(musicDbFinishRemovingSpy.count(), 0);
+
+            QVERIFY(lockQuery.exec(QStringLiteral("COMMIT")));
+
+            rawDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+
+        QVERIFY(musicDbFinishRemovingSpy.wait(15000));
+
+        QCOMPARE(musicDbFinishInsertingSpy.count(), 1);
+        QCOMPARE(musicDbFinishRemovingSpy.count(), 1);
+        QCOMPARE(musicDb.allTracksData().count(), 21);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void storageSettingsAreApplied_data()
+    {
+        QTest::addColumn<qlonglong>("cacheSize");
+        QTest::addColumn<qlonglong>("memoryMapSize");
+        QTest::addColumn<int>("tempStore");
+        QTest::addColumn<qlonglong>("expectedCacheSize");
+        QTest::addColumn<qlonglong>("expectedMemoryMapSize");
+
+        // an empty database gets the minimum automatic sizes: 2 MiB of cache and 16 MiB of memory map
+        QTest::newRow("automatic") << qlonglong{-1} << qlonglong{-1} << -1 << qlonglong{2 * 1024} << qlonglong{16 * 1024 * 1024};
+        QTest::newRow("explicit") << qlonglong{4 * 1024} << qlonglong{32 * 1024 * 1024} << 2 << qlonglong{4 * 1024} << qlonglong{32 * 1024 * 1024};
+    }
+
+    void storageSettingsAreApplied()
+    {
+        QFETCH(qlonglong, cacheSize);
+        QFETCH(qlonglong, memoryMapSize);
+        QFETCH(int, tempStore);
+        QFETCH(qlonglong, expectedCacheSize);
+        QFETCH(qlonglong, expectedMemoryMapSize);
+
+        QTemporaryDir databaseDirectory;
+        QVERIFY(databaseDirectory.isValid());
+
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+
+        auto storageSettings = DatabaseInterface::StorageSettings{};
+        storageSettings.mCacheSize = cacheSize;
+        storageSettings.mMemoryMapSize = memoryMapSize;
+        storageSettings.mTempStore = tempStore;
+
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.init(QStringLiteral("testDb"), databaseFileName, storageSettings);
+
+        {
+            // cache_size, mmap_size and temp_store only apply to the connection they were set on
+            auto tracksDatabase = QSqlDatabase::database(QStringLiteral("testDb"), false);
+            QVERIFY(tracksDatabase.isOpen());
+
+            QSqlQuery pragmaQuery(tracksDatabase);
+
+            QVERIFY(pragmaQuery.exec(QStringLiteral("PRAGMA cache_size")));
+            QVERIFY(pragmaQuery.next());
+            QCOMPARE(pragmaQuery.value(0).toLongLong(), -expectedCacheSize);
+            pragmaQuery.finish();
+
+            QVERIFY(pragmaQuery.exec(QStringLiteral("PRAGMA mmap_size")));
+            QVERIFY(pragmaQuery.next());
+            QCOMPARE(pragmaQuery.value(0).toLongLong(), expectedMemoryMapSize);
+            pragmaQuery.finish();
+
+            if (tempStore >= 0) {
+                QVERIFY(pragmaQuery.exec(QStringLiteral("PRAGMA temp_store")));
+                QVERIFY(pragmaQuery.next());
+                QCOMPARE(pragmaQuery.value(0).toInt(), tempStore);
+                pragmaQuery.finish();
+            }
+
+            QVERIFY(pragmaQuery.exec(QStringLiteral("PRAGMA journal_mode")));
+            QVERIFY(pragmaQuery.next());
+            QCOMPARE(pragmaQuery.value(0).toString(), QStringLiteral("wal"));
+        }
+
+        {
+            // the journal mode is stored in the database file, other connections see it too
+            auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+            rawDatabase.setDatabaseName(databaseFileName);
+            QVERIFY(rawDatabase.open());
+
+            QSqlQuery journalModeQuery(rawDatabase);
+            QVERIFY(journalModeQuery.exec(QStringLiteral("PRAGMA journal_mode")));
+            QVERIFY(journalModeQuery.next());
+            QCOMPARE(journalModeQuery.value(0).toString(), QStringLiteral("wal"));
+            journalModeQuery.finish();
+
+            rawDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void albumQueriesStorageSettingsBenchmark_data()
+    {
+        QTest::addColumn<qlonglong>("cacheSize");
+        QTest::addColumn<qlonglong>("memoryMapSize");
+        QTest::addColumn<int>("tempStore");
+
+        // the automatic settings of a database as small as the test data are the minimum sizes
+        QTest::newRow("SQLite defaults") << qlonglong{2000} << qlonglong{0} << 0;
+        QTest::newRow("automatic") << qlonglong{-1} << qlonglong{-1} << -1;
+        QTest::newRow("large cache and memory map") << qlonglong{64 * 1024} << qlonglong{256 * 1024 * 1024} << 2;
+    }
+
+    void albumQueriesStorageSettingsBenchmark()
+    {
+        QFETCH(qlonglong, cacheSize);
+        QFETCH(qlonglong, memoryMapSize);
+        QFETCH(int, tempStore);
+
+        QTemporaryDir databaseDirectory;
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+
+        auto storageSettings = DatabaseInterface::StorageSettings{};
+        storageSettings.mCacheSize = cacheSize;
+        storageSettings.mMemoryMapSize = memoryMapSize;
+        storageSettings.mTempStore = tempStore;
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"), databaseFileName, storageSettings);
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        const auto albumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album1"), QStringLiteral("Various Artists"), QStringLiteral("/"));
+
+        auto allAlbums = DataTypes::ListAlbumDataType{};
+        auto albumTracks = DataTypes::ListTrackDataType{};
+
+        QBENCHMARK {
+            allAlbums = musicDb.allAlbumsData();
+            albumTracks = musicDb.albumData(albumId);
+        }
+
+        QCOMPARE(allAlbums.count(), 5);
+        QVERIFY(!albumTracks.isEmpty());
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void idleMaintenanceIsInterruptible()
+    {
+        QTemporaryDir databaseDirectory;
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+
+        // enough tracks for their removal to leave whole pages free
+        auto newTracks = DataTypes::ListTrackDataType();
+
+        for (int i = 0; i < 1000; ++i) {
+            newTracks.push_back(DataTypes::TrackDataType{true, QStringLiteral("$maintenance%1").arg(i), QStringLiteral("0"), QStringLiteral("maintenance track %1").arg(i),
+                                                         QStringLiteral("maintenance artist %1").arg(i % 80), QStringLiteral("maintenance album %1").arg(i % 50),
+                                                         QStringLiteral("maintenance album artist %1").arg(i % 50),
+                                                         i / 50 + 1, 1, QTime::fromMSecsSinceStartOfDay(i + 1), {QUrl::fromLocalFile(QStringLiteral("/maintenance/$%1").arg(i))},
+                                                         QDateTime::fromMSecsSinceEpoch(i + 1),
+                                                         {}, 5, true,
+                                                         QStringLiteral("maintenance genre %1").arg(i % 20), QStringLiteral("composer %1").arg(i % 50),
+                                                         QStringLiteral("lyricist %1").arg(i % 30), false});
+        }
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+            QSignalSpy musicDbMaintenanceFinishedSpy(&musicDb, &DatabaseInterface::maintenanceFinished);
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.insertTracksList(newTracks, mNewCovers);
+
+            musicDbTrackAddedSpy.wait(300);
+
+            auto removedTracks = QList<QUrl>{};
+            for (const auto &oneTrack : musicDb.allTracksData()) {
+                removedTracks.push_back(oneTrack.resourceURI());
+            }
+            QCOMPARE(removedTracks.count(), 1000);
+
+            musicDb.removeTracksList(removedTracks);
+
+            musicDb.startMaintenance();
+
+            QVERIFY(!musicDbMaintenanceFinishedSpy.wait(300));
+
+            musicDb.setMaintenanceAllowed(true);
+            musicDb.startMaintenance();
+            musicDb.setMaintenanceAllowed(false);
+
+            QVERIFY(!musicDbMaintenanceFinishedSpy.wait(300));
+
+            musicDb.setMaintenanceAllowed(true);
+            musicDb.startMaintenance();
+
+            QVERIFY(musicDbMaintenanceFinishedSpy.wait(3000));
+            QCOMPARE(musicDbMaintenanceFinishedSpy.count(), 1);
+            QVERIFY(musicDbMaintenanceFinishedSpy.at(0).at(0).toLongLong() > 0);
+
+            // a new database has no statistics for the query planner yet
+            QCOMPARE(musicDbMaintenanceFinishedSpy.at(0).at(2).toBool(), true);
+
+            musicDb.startMaintenance();
+
+            QVERIFY(!musicDbMaintenanceFinishedSpy.wait(300));
+            QCOMPARE(musicDbMaintenanceFinishedSpy.count(), 1);
+            QCOMPARE(musicDb.allTracksData().count(), 0);
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        }
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            QSignalSpy musicDbMaintenanceFinishedSpy(&musicDb, &DatabaseInterface::maintenanceFinished);
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.setMaintenanceAllowed(true);
+            musicDb.startMaintenance();
+
+            QVERIFY(musicDbMaintenanceFinishedSpy.wait(3000));
+            QCOMPARE(musicDbMaintenanceFinishedSpy.count(), 1);
+
+            // statistics gathered by the previous run are only refreshed
+            QCOMPARE(musicDbMaintenanceFinishedSpy.at(0).at(2).toBool(), false);
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        }
+    }
+
+    void olderDatabaseIsConvertedToIncrementalVacuum()
+    {
+        QTemporaryDir databaseDirectory;
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            musicDb.insertTracksList(mNewTracks, mNewCovers);
+        }
+
+        // files created before the auto vacuum mode was set kept the default one
+        {
+            auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+            rawDatabase.setDatabaseName(databaseFileName);
+            QVERIFY(rawDatabase.open());
+
+            QSqlQuery rawQuery(rawDatabase);
+            QVERIFY(rawQuery.exec(QStringLiteral("PRAGMA auto_vacuum = NONE")));
+            QVERIFY(rawQuery.exec(QStringLiteral("VACUUM")));
+            QVERIFY(rawQuery.exec(QStringLiteral("UPDATE `DatabaseVersion` SET `Version` = 24")));
+
+            QVERIFY(rawQuery.exec(QStringLiteral("PRAGMA auto_vacuum")));
+            QVERIFY(rawQuery.next());
+            QCOMPARE(rawQuery.value(0).toInt(), 0);
+            rawQuery.finish();
+
+            rawDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            QCOMPARE(musicDb.allTracksData().count(), mNewTracks.count());
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        }
+
+        {
+            auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+            rawDatabase.setDatabaseName(databaseFileName);
+            QVERIFY(rawDatabase.open());
+
+            QSqlQuery checkQuery(rawDatabase);
+            QVERIFY(checkQuery.exec(QStringLiteral("PRAGMA auto_vacuum")));
+            QVERIFY(checkQuery.next());
+            QCOMPARE(checkQuery.value(0).toInt(), 2);
+
+            QVERIFY(checkQuery.exec(QStringLiteral("SELECT `Version` FROM `DatabaseVersion`")));
+            QVERIFY(checkQuery.next());
+            QCOMPARE(checkQuery.value(0).toInt(), static_cast<int>(DatabaseInterface::V26));
+            checkQuery.finish();
+
+            rawDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+    }
+
+    void removeOneArtistAndInsertItAgain()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbArtistAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbArtistRemovedSpy(&musicDb, &DatabaseInterface::artistRemoved);
+        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 5);
+        QCOMPARE(musicDb.allArtistsData().count(), 7);
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 1);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto trackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track3"), QStringLiteral("artist3"),
+                                                                    QStringLiteral("album1"), 3, 3);
+        auto track = musicDb.trackDataFromDatabaseId(trackId);
+
+        musicDb.removeTracksList({track.resourceURI()});
+
+        QCOMPARE(musicDb.allArtistsData().count(), 6);
+        QCOMPARE(musicDb.allTracksData().count(), 21);
+        QCOMPARE(musicDbArtistRemovedSpy.count(), 1);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 1);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto removedTrack = std::find_if(mNewTracks.cbegin(), mNewTracks.cend(), [&track](const auto &oneTrack) {
+            return oneTrack.resourceURI() == track.resourceURI();
+        });
+        QVERIFY(removedTrack != mNewTracks.cend());
+
+        musicDb.insertTracksList({*removedTrack}, mNewCovers);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 5);
+        QCOMPARE(musicDb.allArtistsData().count(), 7);
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 2);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 2);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto newTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track3"), QStringLiteral("artist3"),
+                                                                       QStringLiteral("album1"), 3, 3);
+        QVERIFY(newTrackId != 0);
+
+        auto newTrack = musicDb.trackDataFromDatabaseId(newTrackId);
+
+        QCOMPARE(newTrack.artist(), QStringLiteral("artist3"));
+        QCOMPARE(newTrack.album(), QStringLiteral("album1"));
+    }
+
+    void addOneTrack()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbArtistAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
+        QSignalSpy musicDbAlbumAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbArtistRemovedSpy(&musicDb, &DatabaseInterface::artistRemoved);
+        QSignalSpy musicDbAlbumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy musicDbAlbumModifiedSpy(&musicDb, &DatabaseInterface::albumModified);
+        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 0);
+        QCOMPARE(musicDb.allArtistsData().count(), 0);
+        QCOMPARE(musicDb.allTracksData().count(), 0);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumAddedSpy.count(), 0);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 0);
+        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 0);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 5);
+        QCOMPARE(musicDb.allArtistsData().count(), 7);
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
+        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 0);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto newTrack = DataTypes::TrackDataType{true, QStringLiteral("$23"), QStringLiteral("0"), QStringLiteral("track6"),
+                QStringLiteral("artist2"), QStringLiteral("album3"), QStringLiteral("artist2"),
+                6, 1, QTime::fromMSecsSinceStartOfDay(23), {QUrl::fromLocalFile(QStringLiteral("/$23"))},
+                QDateTime::fromMSecsSinceEpoch(23),
+                QUrl::fromLocalFile(QStringLiteral("album3")), 5, true,
+                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+        auto newTracks = DataTypes::ListTrackDataType();
+        newTracks.push_back(newTrack);
+
+        auto newCovers = mNewCovers;
+        newCovers[QStringLiteral("file:///$23")] = QUrl::fromLocalFile(QStringLiteral("album3"));
+
+        musicDb.insertTracksList(newTracks, newCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 5);
+        QCOMPARE(musicDb.allArtistsData().count(), 7);
+        QCOMPARE(musicDb.allTracksData().count(), 23);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 2);
+        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 1);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 3);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void addManyTracksInOneBatch()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbArtistAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
+        QSignalSpy musicDbAlbumAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbGenreAddedSpy(&musicDb, &DatabaseInterface::genresAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto newTracks = DataTypes::ListTrackDataType();
+
+        for (int i = 0; i < 450; ++i) {
+            newTracks.push_back(DataTypes::TrackDataType{true, QStringLiteral("$bulk%1").arg(i), QStringLiteral("0"), QStringLiteral("bulk track %1").arg(i),
+                                                         QStringLiteral("bulk artist %1").arg(i % 300), QStringLiteral("bulk album %1").arg(i % 5),
+                                                         QStringLiteral("bulk album artist %1").arg(i % 5),
+                                                         i / 5 + 1, 1, QTime::fromMSecsSinceStartOfDay(i + 1), {QUrl::fromLocalFile(QStringLiteral("/bulk/$%1").arg(i))},
+                                                         QDateTime::fromMSecsSinceEpoch(i + 1),
+                                                         {}, 5, true,
+                                                         QStringLiteral("bulk genre %1").arg(i % 7), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false});
+        }
+
+        musicDb.insertTracksList(newTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 450);
+        QCOMPARE(musicDb.allAlbumsData().count(), 5);
+        QCOMPARE(musicDb.allGenresData().count(), 7);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
+        QCOMPARE(musicDbTrackAddedSpy.at(0).at(0).value<DataTypes::ListTrackDataType>().count(), 450);
+        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumAddedSpy.at(0).at(0).value<DataTypes::ListAlbumDataType>().count(), 5);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 1);
+        QCOMPARE(musicDbArtistAddedSpy.at(0).at(0).value<DataTypes::ListArtistDataType>().count(), 305);
+        QCOMPARE(musicDbGenreAddedSpy.count(), 1);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        musicDb.insertTracksList(newTracks, mNewCovers);
+
+        QCOMPARE(musicDb.allTracksData().count(), 450);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 1);
+        QCOMPARE(musicDbGenreAddedSpy.count(), 1);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void addTwoTracksSameAlbumSameTitle()
+    {
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        qDebug() << "addTwoTracksSameAlbumSameTitle" << databaseFile.fileName();
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"), databaseFile.fileName());
+
+        QSignalSpy musicDbArtistAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
+        QSignalSpy musicDbAlbumAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbArtistRemovedSpy(&musicDb, &DatabaseInterface::artistRemoved);
+        QSignalSpy musicDbAlbumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy musicDbAlbumModifiedSpy(&musicDb, &DatabaseInterface::albumModified);
+        QSignalSpy musicDbTrackModifiedSpy(&musicDb, &DatabaseInterface::trackModified);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 0);
+        QCOMPARE(musicDb.allArtistsData().count(), 0);
+        QCOMPARE(musicDb.allTracksData().count(), 0);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumAddedSpy.count(), 0);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 0);
+        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 0);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto newTrack = DataTypes::TrackDataType{true, QStringLiteral("$23"), QStringLiteral("0"), QStringLiteral("track6"),
+                QStringLiteral("artist2"), QStringLiteral("album3"), QStringLiteral("artist2"),
+                6, 1, QTime::fromMSecsSinceStartOfDay(23), {QUrl::fromLocalFile(QStringLiteral("/$23"))},
+                QDateTime::fromMSecsSinceEpoch(23),
+        {QUrl::fromLocalFile(QStringLiteral("album3"))}, 5, true,
+                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+        auto newTracks = DataTypes::ListTrackDataType();
+        newTracks.push_back(newTrack);
+
+        auto newCovers = mNewCovers;
+        newCovers[QStringLiteral("file:///$23")] = QUrl::fromLocalFile(QStringLiteral("album3"));
+
+        musicDb.insertTracksList(newTracks, newCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 1);
+        QCOMPARE(musicDb.allArtistsData().count(), 1);
+        QCOMPARE(musicDb.allTracksData().count(), 1);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
+        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 0);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto firstTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track6"), QStringLiteral("artist2"),
+                                                                         QStringLiteral("album3"), 6, 1);
+        auto firstTrack = musicDb.trackDataFromDatabaseId(firstTrackId);
+
+        auto firstTrackTitle = firstTrack.title();
+        auto firstTrackArtist = firstTrack.artist();
+        auto firstTrackAlbumArtist = firstTrack.albumArtist();
+        auto firstTrackAlbum = firstTrack.album();
+        auto firstTrackImage = firstTrack.albumCover();
+        auto firstTrackDuration = firstTrack.duration();
+        auto firstTrackMilliSecondsDuration = firstTrack.duration().msecsSinceStartOfDay();
+        auto firstTrackTrackNumber = firstTrack.trackNumber();
+        auto firstTrackDiscNumber = firstTrack.discNumber();
+        const auto &firstTrackResource = firstTrack.resourceURI();
+        auto firstTrackRating = firstTrack.rating();
+        auto firstIsSingleDiscAlbum = firstTrack.isSingleDiscAlbum();
+
+        QCOMPARE(firstTrack.isValid(), true);
+        QCOMPARE(firstTrackTitle, QStringLiteral("track6"));
+        QCOMPARE(firstTrackArtist, QStringLiteral("artist2"));
+        QCOMPARE(firstTrackAlbumArtist, QStringLiteral("artist2"));
+        QCOMPARE(firstTrackAlbum, QStringLiteral("album3"));
+        QCOMPARE(firstTrackImage.isValid(), true);
+        QCOMPARE(firstTrackImage, QUrl::fromLocalFile(QStringLiteral("album3")));
+        QCOMPARE(firstTrackDuration, QTime::fromMSecsSinceStartOfDay(23));
+        QCOMPARE(firstTrackMilliSecondsDuration, 23);
+        QCOMPARE(firstTrackTrackNumber, 6);
+        QCOMPARE(firstTrackDiscNumber, 1);
+        QCOMPARE(firstTrackResource.isValid(), true);
+        QCOMPARE(firstTrackResource, QUrl::fromLocalFile(QStringLiteral("/$23")));
+        QCOMPARE(firstTrackRating, 5);
+        QCOMPARE(firstIsSingleDiscAlbum, true);
+
+        auto allAlbums = musicDb.allAlbumsData();
+
+        auto firstAlbumData = musicDb.albumData(allAlbums[0].databaseId());
+        auto firstAlbumTitle = allAlbums[0].title();
+        auto firstAlbumArtist = allAlbums[0].artist();
+        auto firstAlbumImage = allAlbums[0].albumArtURI();
+        auto firstAlbumTracksCount = firstAlbumData.count();
+        auto firstAlbumIsSingleDiscAlbum = allAlbums[0].isSingleDiscAlbum();
+
+        QCOMPARE(firstAlbumTitle, QStringLiteral("album3"));
+        QCOMPARE(firstAlbumArtist, QStringLiteral("artist2"));
+        QCOMPARE(firstAlbumImage.isValid(), true);
+        QCOMPARE(firstAlbumImage, QUrl::fromLocalFile(QStringLiteral("album3")));
+        QCOMPARE(firstAlbumTracksCount, 1);
+        QCOMPARE(firstAlbumIsSingleDiscAlbum, true);
+
+        auto newTrack2 = DataTypes::TrackDataType{true, QStringLiteral("$23"), QStringLiteral("0"), QStringLiteral("track6"),
+                QStringLiteral("artist9"), QStringLiteral("album3"), QStringLiteral("artist2"), 6, 1,
+                QTime::fromMSecsSinceStartOfDay(23), {QUrl::fromLocalFile(QStringLiteral("/$23"))},
+                QDateTime::fromMSecsSinceEpoch(23),
+                QUrl::fromLocalFile(QStringLiteral("album3")), 5, true,
+                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+        auto newTracks2 = DataTypes::ListTrackDataType();
+        newTracks2.push_back(newTrack2);
+
+        auto newCovers2 = mNewCovers;
+        newCovers2[QStringLiteral("file:///$23")] = QUrl::fromLocalFile(QStringLiteral("image$19"));
+
+        musicDb.insertTracksList(newTracks2, newCovers2);
+
+        musicDbTrackAddedSpy.wait(50);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 1);
+        QCOMPARE(musicDb.allArtistsData().count(), 2);
+        QCOMPARE(musicDb.allTracksData().count(), 1);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 2);
+        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
+        QCOMPARE(musicDbArtistRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumModifiedSpy.count(), 1);
+        QCOMPARE(musicDbTrackModifiedSpy.count(), 1);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto secondTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track6"), QStringLiteral("artist9"),
+                                                                          QStringLiteral("album3"), 6, 1);
+        auto secondTrack = musicDb.trackDataFromDatabaseId(secondTrackId);
+
+        auto secondTrackTitle = secondTrack.title();
+        auto secondTrackArtist = secondTrack.artist();
+        auto secondTrackAlbumArtist = secondTrack.albumArtist();
+        auto secondTrackAlbum = secondTrack.album();
+        auto secondTrackImage = secondTrack.albumCover();
+        auto secondTrackDuration = secondTrack.duration();
+        auto secondTrackMilliSecondsDuration = secondTrack.duration().msecsSinceStartOfDay();
+        auto secondTrackTrackNumber = secondTrack.trackNumber();
+        auto secondTrackDiscNumber = secondTrack.discNumber();
+        const auto &secondTrackResource = secondTrack.resourceURI();
+        auto secondTrackRating = secondTrack.rating();
+        auto secondIsSingleDiscAlbum = secondTrack.isSingleDiscAlbum();
+
+        QCOMPARE(secondTrack.isValid(), true);
+        QCOMPARE(secondTrackTitle, QStringLiteral("track6"));
+        QCOMPARE(secondTrackArtist, QStringLiteral("artist9"));
+        QCOMPARE(secondTrackAlbumArtist, QStringLiteral("artist2"));
+        QCOMPARE(secondTrackAlbum, QStringLiteral("album3"));
+        QCOMPARE(secondTrackImage.isValid(), true);
+        QCOMPARE(secondTrackImage, QUrl::fromLocalFile(QStringLiteral("album3")));
+        QCOMPARE(secondTrackDuration, QTime::fromMSecsSinceStartOfDay(23));
+        QCOMPARE(secondTrackMilliSecondsDuration, 23);
+        QCOMPARE(secondTrackTrackNumber, 6);
+        QCOMPARE(secondTrackDiscNumber, 1);
+        QCOMPARE(secondTrackResource.isValid(), true);
+        QCOMPARE(secondTrackResource, QUrl::fromLocalFile(QStringLiteral("/$23")));
+        QCOMPARE(secondTrackRating, 5);
+        QCOMPARE(secondIsSingleDiscAlbum, true);
+
+        auto allAlbums2 = musicDb.allAlbumsData();
+
+        auto firstAlbumData2 = musicDb.albumData(allAlbums2[0].databaseId());
+        auto firstAlbumTitle2 = allAlbums2[0].title();
+        auto firstAlbumArtist2 = allAlbums2[0].artist();
+        auto firstAlbumImage2 = allAlbums2[0].albumArtURI();
         auto firstAlbumTracksCount2 = firstAlbumData2.count();
         auto firstAlbumIsSingleDiscAlbum2 = allAlbums2[0].isSingleDiscAlbum();
 
@@ -3559,6 +4997,55 @@ private Q_SLOTS:
         QCOMPARE(musicDbDatabaseErrorSpy2.count(), 0);
     }
 
+    void readFromAnotherThreadWithDatabaseFile()
+    {
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        qDebug() << "readFromAnotherThreadWithDatabaseFile" << databaseFile.fileName();
+
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.init(QStringLiteral("testDb"), databaseFile.fileName());
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        auto readerAlbumsCount = 0;
+        auto readerArtistsCount = 0;
+        auto readerTracksCount = 0;
+        auto readerAlbumTracksCount = 0;
+
+        auto firstAlbumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album1"), QStringLiteral("Various Artists"), QStringLiteral("/"));
+
+        std::unique_ptr<QThread> readerThread{QThread::create([&]() {
+            readerAlbumsCount = musicDb.allAlbumsData().count();
+            readerArtistsCount = musicDb.allArtistsData().count();
+            readerTracksCount = musicDb.allTracksData().count();
+            readerAlbumTracksCount = musicDb.albumData(firstAlbumId).count();
+        })};
+
+        readerThread->start();
+        QVERIFY(readerThread->wait(5000));
+
+        QCOMPARE(readerAlbumsCount, musicDb.allAlbumsData().count());
+        QCOMPARE(readerArtistsCount, musicDb.allArtistsData().count());
+        QCOMPARE(readerTracksCount, musicDb.allTracksData().count());
+        QCOMPARE(readerAlbumTracksCount, musicDb.albumData(firstAlbumId).count());
+        QCOMPARE(readerTracksCount, 22);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        /* the connection of the reader thread was closed when it finished */
+        const auto allConnectionNames = QSqlDatabase::connectionNames();
+        QVERIFY(std::none_of(allConnectionNames.begin(), allConnectionNames.end(), [](const QString &connectionName) {
+            return connectionName.startsWith(QStringLiteral("testDb-reader-"));
+        }));
+    }
+
 
     void testAddAlbumsSameName()
     {
@@ -4705,6 +6192,241 @@ private Q_SLOTS:
         QCOMPARE(frequentlyPlayedTracksData[4].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$9")));
     }
 
+    void frequentlyPlayedTracksUseDecayedPlayScore()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        const auto now = QDateTime::currentDateTime();
+
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$3")), now.addDays(-60));
+        for (int i = 0; i < 9; ++i) {
+            musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$3")), now.addSecs(-3600));
+        }
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$4")), now.addDays(-1));
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$5")), now.addDays(-400));
+
+        auto frequentlyPlayedTracksData = musicDb.frequentlyPlayedTracksData(5);
+
+        QCOMPARE(frequentlyPlayedTracksData.count(), 3);
+        QCOMPARE(frequentlyPlayedTracksData[0].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$3")));
+        QCOMPARE(frequentlyPlayedTracksData[1].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$4")));
+        QCOMPARE(frequentlyPlayedTracksData[2].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$5")));
+
+        musicDb.removeTracksList({QUrl::fromLocalFile(QStringLiteral("/$3"))});
+
+        frequentlyPlayedTracksData = musicDb.frequentlyPlayedTracksData(5);
+
+        QCOMPARE(frequentlyPlayedTracksData.count(), 2);
+        QCOMPARE(frequentlyPlayedTracksData[0].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$4")));
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void changeFeedSequenceNumbers()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseChangedSpy(&musicDb, &DatabaseInterface::databaseChanged);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDbDatabaseChangedSpy.count(), 1);
+
+        auto insertChanges = musicDbDatabaseChangedSpy.at(0).at(0).value<DataTypes::DatabaseChanges>();
+        const auto firstSequenceNumber = insertChanges.mSequenceNumber;
+
+        QCOMPARE(firstSequenceNumber, musicDb.databaseGeneration());
+        QCOMPARE(insertChanges.mAddedTracks.count(), 22);
+        QCOMPARE(insertChanges.mAddedAlbums.count(), 5);
+        QCOMPARE(insertChanges.mModifiedTracks.count(), 0);
+
+        const auto playedTrackId = musicDb.trackIdFromFileName(QUrl::fromLocalFile(QStringLiteral("/$3")));
+
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$3")), QDateTime::currentDateTime());
+
+        QCOMPARE(musicDbDatabaseChangedSpy.count(), 2);
+
+        auto playChanges = musicDbDatabaseChangedSpy.at(1).at(0).value<DataTypes::DatabaseChanges>();
+
+        QCOMPARE(playChanges.mSequenceNumber, firstSequenceNumber + 1);
+        QCOMPARE(playChanges.mModifiedTracks, QList<qulonglong>{playedTrackId});
+
+        musicDb.removeTracksList({QUrl::fromLocalFile(QStringLiteral("/$3"))});
+
+        QCOMPARE(musicDbDatabaseChangedSpy.count(), 3);
+
+        auto removeChanges = musicDbDatabaseChangedSpy.at(2).at(0).value<DataTypes::DatabaseChanges>();
+
+        QCOMPARE(removeChanges.mSequenceNumber, firstSequenceNumber + 2);
+        QCOMPARE(removeChanges.mRemovedTracks, QList<qulonglong>{playedTrackId});
+
+        auto missedChanges = DataTypes::DatabaseChanges{};
+
+        QVERIFY(musicDb.changesSince(firstSequenceNumber, missedChanges));
+        QCOMPARE(missedChanges.mSequenceNumber, firstSequenceNumber + 2);
+        QCOMPARE(missedChanges.mModifiedTracks.count(), 0);
+        QCOMPARE(missedChanges.mRemovedTracks, QList<qulonglong>{playedTrackId});
+
+        QVERIFY(musicDb.changesSince(firstSequenceNumber - 1, missedChanges));
+        QCOMPARE(missedChanges.mAddedTracks.count(), 21);
+        QCOMPARE(missedChanges.mRemovedTracks.count(), 0);
+
+        QVERIFY(musicDb.changesSince(firstSequenceNumber + 2, missedChanges));
+        QVERIFY(missedChanges.isEmpty());
+
+        musicDb.clearData();
+
+        QVERIFY(!musicDb.changesSince(firstSequenceNumber + 2, missedChanges));
+        QVERIFY(musicDb.changesSince(musicDb.databaseGeneration(), missedChanges));
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void changesCommittedByAnotherProcessArePublished()
+    {
+        QTemporaryDir databaseDirectory;
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+        const auto trackFileName = QUrl::fromLocalFile(QStringLiteral("/$3"));
+
+        DatabaseInterface importDb;
+
+        importDb.init(QStringLiteral("testImportDb"), databaseFileName);
+
+        DatabaseInterface viewDb;
+
+        viewDb.init(QStringLiteral("testViewDb"), databaseFileName);
+
+        QSignalSpy viewDbTracksAddedSpy(&viewDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy viewDbDatabaseChangedSpy(&viewDb, &DatabaseInterface::databaseChanged);
+        QSignalSpy viewDbDatabaseErrorSpy(&viewDb, &DatabaseInterface::databaseError);
+        QSignalSpy importDbDatabaseChangedSpy(&importDb, &DatabaseInterface::databaseChanged);
+        QSignalSpy importDbDatabaseErrorSpy(&importDb, &DatabaseInterface::databaseError);
+
+        importDb.insertTracksList(mNewTracks, mNewCovers);
+
+        QVERIFY(viewDbDatabaseChangedSpy.wait(5000));
+
+        QCOMPARE(viewDbTracksAddedSpy.count(), 1);
+        QCOMPARE(viewDbTracksAddedSpy.at(0).at(0).value<DataTypes::ListTrackDataType>().count(), 22);
+
+        auto insertChanges = viewDbDatabaseChangedSpy.at(0).at(0).value<DataTypes::DatabaseChanges>();
+
+        QCOMPARE(insertChanges.mSequenceNumber, importDb.databaseGeneration());
+        QCOMPARE(insertChanges.mAddedTracks.count(), 22);
+        QCOMPARE(viewDb.databaseGeneration(), importDb.databaseGeneration());
+        QCOMPARE(viewDb.allTracksData().count(), 22);
+
+        const auto removedTrackId = importDb.trackIdFromFileName(trackFileName);
+
+        importDb.removeTracksList({trackFileName});
+
+        QVERIFY(viewDbDatabaseChangedSpy.wait(5000));
+
+        auto removeChanges = viewDbDatabaseChangedSpy.at(1).at(0).value<DataTypes::DatabaseChanges>();
+
+        QCOMPARE(removeChanges.mRemovedTracks, QList<qulonglong>{removedTrackId});
+        QCOMPARE(viewDb.trackIdFromFileName(trackFileName), 0ULL);
+
+        viewDb.insertTracksList(mNewTracks, mNewCovers);
+
+        const auto addedTrackId = viewDb.trackIdFromFileName(trackFileName);
+
+        QVERIFY(addedTrackId != 0);
+
+        QCOMPARE(importDbDatabaseChangedSpy.count(), 2);
+        QVERIFY(importDbDatabaseChangedSpy.wait(5000));
+
+        auto addChanges = importDbDatabaseChangedSpy.at(2).at(0).value<DataTypes::DatabaseChanges>();
+
+        QCOMPARE(addChanges.mAddedTracks, QList<qulonglong>{addedTrackId});
+        QCOMPARE(importDb.databaseGeneration(), viewDb.databaseGeneration());
+        QCOMPARE(importDb.allTracksData().count(), 22);
+
+        QCOMPARE(viewDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(importDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void directoriesStateIsRestored()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy restoredDirectoriesStateSpy(&musicDb, &DatabaseInterface::restoredDirectoriesState);
+        QSignalSpy databaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        const auto modifiedTime = QDateTime::fromMSecsSinceEpoch(1590000000000);
+
+        musicDb.updateDirectoriesState({{QStringLiteral("/music"), {modifiedTime, 3}},
+                                        {QStringLiteral("/music/album"), {modifiedTime, 12}}}, {});
+
+        musicDb.askRestoredTracks();
+
+        QCOMPARE(restoredDirectoriesStateSpy.count(), 1);
+
+        auto restoredDirectories = restoredDirectoriesStateSpy.at(0).at(0).value<DataTypes::DirectoriesStateType>();
+
+        QCOMPARE(restoredDirectories.count(), 2);
+        QCOMPARE(restoredDirectories[QStringLiteral("/music/album")].mModifiedTime, modifiedTime);
+        QCOMPARE(restoredDirectories[QStringLiteral("/music/album")].mEntriesCount, 12);
+        QCOMPARE(restoredDirectories[QStringLiteral("/music")].mEntriesCount, 3);
+
+        musicDb.updateDirectoriesState({}, {QStringLiteral("/music")});
+
+        musicDb.askRestoredTracks();
+
+        QCOMPARE(restoredDirectoriesStateSpy.count(), 2);
+
+        restoredDirectories = restoredDirectoriesStateSpy.at(1).at(0).value<DataTypes::DirectoriesStateType>();
+
+        QCOMPARE(restoredDirectories.keys(), QList<QString>{QStringLiteral("/music/album")});
+
+        musicDb.clearData();
+
+        musicDb.askRestoredTracks();
+
+        QCOMPARE(restoredDirectoriesStateSpy.count(), 3);
+        QVERIFY(restoredDirectoriesStateSpy.at(2).at(0).value<DataTypes::DirectoriesStateType>().isEmpty());
+
+        musicDb.updateDirectoriesState({{QStringLiteral("/music"), {modifiedTime, 3}}}, {});
+
+        // the tracks of the scan are not stored, their directories must be scanned again
+        musicDb.applicationAboutToQuit();
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        QCOMPARE(musicDb.allTracksData().count(), 0);
+
+        musicDb.updateDirectoriesState({{QStringLiteral("/music/album"), {modifiedTime, 12}}}, {QStringLiteral("/music")});
+
+        musicDb.askRestoredTracks();
+
+        QCOMPARE(restoredDirectoriesStateSpy.count(), 4);
+        QVERIFY(restoredDirectoriesStateSpy.at(3).at(0).value<DataTypes::DirectoriesStateType>().isEmpty());
+
+        musicDb.updateDirectoriesState({{QStringLiteral("/music/album"), {modifiedTime, 12}}}, {});
+
+        musicDb.askRestoredTracks();
+
+        QCOMPARE(restoredDirectoriesStateSpy.count(), 5);
+        QCOMPARE(restoredDirectoriesStateSpy.at(4).at(0).value<DataTypes::DirectoriesStateType>().keys(), QList<QString>{QStringLiteral("/music/album")});
+
+        QCOMPARE(databaseErrorSpy.count(), 0);
+    }
+
     void readAllGenresData()
     {
         DatabaseInterface musicDb;
@@ -4862,6 +6584,233 @@ private Q_SLOTS:
         QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
     }
 
+    void upgradeToIntegerForeignKeys_data()
+    {
+        QTest::addColumn<int>("storedVersion");
+        QTest::addColumn<bool>("firstUpgradeFails");
+
+        QTest::newRow("v15") << 15 << false;
+        // v16 used to be stored by databases that still have the v15 layout
+        QTest::newRow("v16 with v15 layout") << 16 << false;
+        QTest::newRow("v15 with a failing first upgrade") << 15 << true;
+    }
+
+    void upgradeToIntegerForeignKeys()
+    {
+        QFETCH(int, storedVersion);
+        QFETCH(bool, firstUpgradeFails);
+
+        QTemporaryDir databaseDirectory;
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+
+        auto newTracks = DataTypes::ListTrackDataType();
+
+        for (int i = 0; i < 5000; ++i) {
+            newTracks.push_back(DataTypes::TrackDataType{true, QStringLiteral("$upgrade%1").arg(i), QStringLiteral("0"), QStringLiteral("upgrade track %1").arg(i),
+                                                         QStringLiteral("upgrade artist %1").arg(i % 400), QStringLiteral("upgrade album %1").arg(i % 250),
+                                                         QStringLiteral("upgrade album artist %1").arg(i % 250),
+                                                         i / 250 + 1, 1, QTime::fromMSecsSinceStartOfDay(i + 1), {QUrl::fromLocalFile(QStringLiteral("/upgrade/$%1").arg(i))},
+                                                         QDateTime::fromMSecsSinceEpoch(i + 1),
+                                                         {}, 5, true,
+                                                         QStringLiteral("upgrade genre %1").arg(i % 20), QStringLiteral("composer %1").arg(i % 50),
+                                                         QStringLiteral("lyricist %1").arg(i % 30), false});
+        }
+
+        auto sortedTracks = [](DataTypes::ListTrackDataType tracks) {
+            std::sort(tracks.begin(), tracks.end(), [](const auto &left, const auto &right) {
+                return left.databaseId() < right.databaseId();
+            });
+            return tracks;
+        };
+
+        auto tracksBeforeUpgrade = DataTypes::ListTrackDataType{};
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+
+            musicDb.insertTracksList(newTracks, mNewCovers);
+
+            musicDbTrackAddedSpy.wait(300);
+
+            tracksBeforeUpgrade = sortedTracks(musicDb.allTracksData());
+        }
+
+        QCOMPARE(tracksBeforeUpgrade.count(), 5000);
+
+        QVERIFY(downgradeToV15Layout(databaseFileName, storedVersion));
+
+        if (firstUpgradeFails) {
+            {
+                auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+                rawDatabase.setDatabaseName(databaseFileName);
+                QVERIFY(rawDatabase.open());
+
+                // the v16 update cannot create its new table
+                QSqlQuery blockingQuery(rawDatabase);
+                QVERIFY(blockingQuery.exec(QStringLiteral("CREATE TABLE `NewTracks` (`ID` INTEGER)")));
+
+                rawDatabase.close();
+            }
+            QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+
+            {
+                DatabaseInterface musicDb;
+
+                QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+                musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+                QVERIFY(musicDbDatabaseErrorSpy.count() > 0);
+            }
+
+            {
+                auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+                rawDatabase.setDatabaseName(databaseFileName);
+                QVERIFY(rawDatabase.open());
+
+                // the library is kept with its old layout and the update is tried again at the next start
+                QSqlQuery checkQuery(rawDatabase);
+                QVERIFY(checkQuery.exec(QStringLiteral("SELECT COUNT(*) FROM `Tracks` WHERE `FileName` IS NOT NULL")));
+                QVERIFY(checkQuery.next());
+                QCOMPARE(checkQuery.value(0).toInt(), 5000);
+                checkQuery.finish();
+
+                QVERIFY(checkQuery.exec(QStringLiteral("SELECT `Version` FROM `DatabaseVersion`")));
+                QVERIFY(checkQuery.next());
+                QCOMPARE(checkQuery.value(0).toInt(), 15);
+                checkQuery.finish();
+
+                QVERIFY(checkQuery.exec(QStringLiteral("DROP TABLE `NewTracks`")));
+
+                rawDatabase.close();
+            }
+            QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+        }
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            auto upgradeTimer = QElapsedTimer{};
+            upgradeTimer.start();
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            qInfo() << "DatabaseInterfaceTests::upgradeToIntegerForeignKeys" << storedVersion << tracksBeforeUpgrade.count() << "tracks upgraded in"
+                    << upgradeTimer.elapsed() << "ms";
+
+            QCOMPARE(sortedTracks(musicDb.allTracksData()), tracksBeforeUpgrade);
+            QCOMPARE(musicDb.allAlbumsData().count(), 250);
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        }
+
+        {
+            auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+            rawDatabase.setDatabaseName(databaseFileName);
+            QVERIFY(rawDatabase.open());
+
+            QSqlQuery checkQuery(rawDatabase);
+            QVERIFY(checkQuery.exec(QStringLiteral("SELECT "
+                                                   "COUNT(*) "
+                                                   "FROM `Tracks` "
+                                                   "WHERE `ArtistID` IS NULL OR `AlbumID` IS NULL OR `GenreID` IS NULL OR "
+                                                   "`ComposerID` IS NULL OR `LyricistID` IS NULL")));
+            QVERIFY(checkQuery.next());
+            QCOMPARE(checkQuery.value(0).toInt(), 0);
+
+            QVERIFY(checkQuery.exec(QStringLiteral("SELECT COUNT(*) FROM `Directories`")));
+            QVERIFY(checkQuery.next());
+            QCOMPARE(checkQuery.value(0).toInt(), 1);
+
+            QVERIFY(checkQuery.exec(QStringLiteral("SELECT `Version` FROM `DatabaseVersion`")));
+            QVERIFY(checkQuery.next());
+            QCOMPARE(checkQuery.value(0).toInt(), static_cast<int>(DatabaseInterface::V26));
+
+            rawDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+    }
+
+    void upgradeKeepsSameTitledAlbumsApart()
+    {
+        QTemporaryDir databaseDirectory;
+        const auto databaseFileName = databaseDirectory.filePath(QStringLiteral("elisaDatabase.db"));
+
+        auto newTracks = DataTypes::ListTrackDataType{
+                {true, QStringLiteral("$1"), QStringLiteral("0"), QStringLiteral("track1"),
+                 QStringLiteral("artist1"), QStringLiteral("same album"), QStringLiteral("album artist1"), 1, 1,
+                 QTime::fromMSecsSinceStartOfDay(1), {QUrl::fromLocalFile(QStringLiteral("/same/$1"))},
+                 QDateTime::fromMSecsSinceEpoch(1),
+                 {}, 5, true,
+                 QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false},
+                {true, QStringLiteral("$2"), QStringLiteral("0"), QStringLiteral("track2"),
+                 QStringLiteral("artist2"), QStringLiteral("same album"), QStringLiteral("album artist2"), 1, 1,
+                 QTime::fromMSecsSinceStartOfDay(2), {QUrl::fromLocalFile(QStringLiteral("/same/$2"))},
+                 QDateTime::fromMSecsSinceEpoch(2),
+                 {}, 5, true,
+                 QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false}};
+
+        {
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+
+            musicDb.insertTracksList(newTracks, mNewCovers);
+
+            musicDbTrackAddedSpy.wait(300);
+
+            QCOMPARE(musicDb.allAlbumsData().count(), 2);
+        }
+
+        // the second album, created last, has no album artist: its track must not be bound to the first one
+        QVERIFY(downgradeToV15Layout(databaseFileName, 15, {
+                                         QStringLiteral("UPDATE `Albums` SET `ArtistName` = NULL WHERE `ArtistName` = 'album artist2'"),
+                                         QStringLiteral("UPDATE `Tracks` SET `AlbumArtistName` = NULL WHERE `AlbumArtistName` = 'album artist2'"),
+                                     }));
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.init(QStringLiteral("testDb"), databaseFileName);
+
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        }
+
+        {
+            auto rawDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("rawTestDb"));
+            rawDatabase.setDatabaseName(databaseFileName);
+            QVERIFY(rawDatabase.open());
+
+            QSqlQuery checkQuery(rawDatabase);
+            QVERIFY(checkQuery.exec(QStringLiteral("SELECT "
+                                                   "tracks.`Title`, "
+                                                   "album.`ArtistName` "
+                                                   "FROM `Tracks` tracks, `Albums` album "
+                                                   "WHERE tracks.`AlbumID` = album.`ID` "
+                                                   "ORDER BY tracks.`Title`")));
+            QVERIFY(checkQuery.next());
+            QCOMPARE(checkQuery.value(0).toString(), QStringLiteral("track1"));
+            QCOMPARE(checkQuery.value(1).toString(), QStringLiteral("album artist1"));
+            QVERIFY(checkQuery.next());
+            QCOMPARE(checkQuery.value(0).toString(), QStringLiteral("track2"));
+            QVERIFY(checkQuery.value(1).isNull());
+            QVERIFY(!checkQuery.next());
+            checkQuery.finish();
+
+            rawDatabase.close();
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("rawTestDb"));
+    }
+
     void addMultipleDifferentTracksWithSameTitle()
     {
         QTemporaryFile databaseFile;
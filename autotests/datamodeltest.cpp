@@ -1580,6 +1580,58 @@ private Q_SLOTS:
         QCOMPARE(beginInsertRowsSpy.at(1).at(1).toInt(), 2);
         QCOMPARE(beginInsertRowsSpy.at(1).at(2).toInt(), 2);
     }
+
+    void dataHotRolesBenchmark_data()
+    {
+        QTest::addColumn<ElisaUtils::PlayListEntryType>("dataType");
+        QTest::addColumn<QList<int>>("roles");
+
+        QTest::newRow("tracks") << ElisaUtils::Track
+                                << QList<int>{Qt::DisplayRole, DataTypes::TitleRole, DataTypes::SecondaryTextRole,
+                                              DataTypes::ImageUrlRole, DataTypes::DatabaseIdRole, DataTypes::ArtistRole,
+                                              DataTypes::AlbumRole, DataTypes::DurationRole, DataTypes::RatingRole,
+                                              DataTypes::ResourceRole};
+        QTest::newRow("albums") << ElisaUtils::Album
+                                << QList<int>{Qt::DisplayRole, DataTypes::TitleRole, DataTypes::SecondaryTextRole,
+                                              DataTypes::ImageUrlRole, DataTypes::DatabaseIdRole, DataTypes::ArtistRole,
+                                              DataTypes::IsValidAlbumArtistRole};
+    }
+
+    void dataHotRolesBenchmark()
+    {
+        QFETCH(ElisaUtils::PlayListEntryType, dataType);
+        QFETCH(QList<int>, roles);
+
+        DatabaseInterface musicDb;
+        DataModel dataModel;
+
+        connect(&musicDb, &DatabaseInterface::tracksAdded,
+                &dataModel, &DataModel::tracksAdded);
+        connect(&musicDb, &DatabaseInterface::albumsAdded,
+                &dataModel, &DataModel::albumsAdded);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        dataModel.initialize(nullptr, nullptr, dataType, ElisaUtils::NoFilter, {}, {}, 0);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        QVERIFY(dataModel.rowCount() > 0);
+
+        auto validValues = 0;
+
+        QBENCHMARK {
+            for (int row = 0; row < dataModel.rowCount(); ++row) {
+                const auto &currentIndex = dataModel.index(row, 0);
+
+                for (auto oneRole : roles) {
+                    validValues += dataModel.data(currentIndex, oneRole).isValid() ? 1 : 0;
+                }
+            }
+        }
+
+        QVERIFY(validValues > 0);
+    }
 };
 
 QTEST_GUILESS_MAIN(DataModelTests)
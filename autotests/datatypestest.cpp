@@ -0,0 +1,203 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "datatypes.h"
+
+#include <QObject>
+#include <QMap>
+#include <QVector>
+#include <QVariant>
+
+#include <QtTest>
+
+class DataTypesTests: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    using RolesMap = QMap<DataTypes::ColumnsRoles, QVariant>;
+
+    explicit DataTypesTests(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static DataTypes::TrackDataType newTrack()
+    {
+        auto track = DataTypes::TrackDataType{true, QStringLiteral("$1"), QStringLiteral("0"), QStringLiteral("track1"),
+                QStringLiteral("artist1"), QStringLiteral("album1"), QStringLiteral("Various Artists"),
+                1, 1, QTime::fromMSecsSinceStartOfDay(1), {QUrl::fromLocalFile(QStringLiteral("/$1"))},
+                QDateTime::fromMSecsSinceEpoch(1), {QUrl::fromLocalFile(QStringLiteral("album1"))}, 1, true,
+                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+
+        track[DataTypes::DatabaseIdRole] = 1ULL;
+        track[DataTypes::AlbumIdRole] = 1ULL;
+        track[DataTypes::IsValidAlbumArtistRole] = true;
+        track[DataTypes::YearRole] = 2020;
+        track[DataTypes::PlayCounter] = 0;
+        track[DataTypes::PlayFrequency] = 0;
+
+        return track;
+    }
+
+    static RolesMap newTrackMap(const DataTypes::TrackDataType &track)
+    {
+        auto result = RolesMap{};
+
+        for (auto itValue = track.constBegin(); itValue != track.constEnd(); ++itValue) {
+            result[itValue.key()] = itValue.value();
+        }
+
+        return result;
+    }
+
+    static QVector<DataTypes::ColumnsRoles> allRoles()
+    {
+        auto result = QVector<DataTypes::ColumnsRoles>{};
+
+        for (int role = DataTypes::TitleRole; role <= DataTypes::FullDataRole; ++role) {
+            result.push_back(static_cast<DataTypes::ColumnsRoles>(role));
+        }
+
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<DataTypes::TrackDataType>("DataTypes::TrackDataType");
+    }
+
+    void trackDataBehavesLikeMap()
+    {
+        auto track = newTrack();
+        const auto tracksCount = track.count();
+
+        QCOMPARE(track.title(), QStringLiteral("track1"));
+        QCOMPARE(track.databaseId(), 1ULL);
+        QVERIFY(track.hasTrackNumber());
+        QVERIFY(!track.hasChannels());
+        QVERIFY(track.find(DataTypes::ChannelsRole) == track.end());
+
+        auto copiedTrack = track;
+        copiedTrack.remove(DataTypes::TrackNumberRole);
+
+        QVERIFY(!copiedTrack.hasTrackNumber());
+        QVERIFY(track.hasTrackNumber());
+        QCOMPARE(copiedTrack.count(), tracksCount - 1);
+        QVERIFY(copiedTrack != track);
+
+        copiedTrack[DataTypes::TrackNumberRole] = 1;
+
+        QCOMPARE(copiedTrack, track);
+
+        copiedTrack[DataTypes::HighestTrackRating] = 5;
+
+        QCOMPARE(copiedTrack.count(), tracksCount + 1);
+        QCOMPARE(copiedTrack[DataTypes::HighestTrackRating].toInt(), 5);
+        QVERIFY(copiedTrack.find(DataTypes::HighestTrackRating) != copiedTrack.end());
+        QCOMPARE(copiedTrack.find(DataTypes::HighestTrackRating).key(), DataTypes::HighestTrackRating);
+
+        auto iteratedRoles = 0;
+        for (auto itValue = copiedTrack.constBegin(); itValue != copiedTrack.constEnd(); ++itValue) {
+            QCOMPARE(itValue.value(), copiedTrack[itValue.key()]);
+            ++iteratedRoles;
+        }
+        QCOMPARE(iteratedRoles, copiedTrack.count());
+
+        auto trackFromList = DataTypes::TrackDataType{{DataTypes::DatabaseIdRole, 12ULL}, {DataTypes::TitleRole, QStringLiteral("title")}};
+
+        QCOMPARE(trackFromList.count(), 2);
+        QCOMPARE(trackFromList.databaseId(), 12ULL);
+
+        trackFromList.clear();
+
+        QVERIFY(trackFromList.isEmpty());
+        QCOMPARE(trackFromList, DataTypes::TrackDataType{});
+    }
+
+    void databaseChangesMerge()
+    {
+        auto changes = DataTypes::DatabaseChanges{};
+        changes.mSequenceNumber = 3;
+        changes.mAddedTracks = {1, 2};
+        changes.mModifiedTracks = {3, 4};
+        changes.mAddedAlbums = {10};
+
+        auto otherChanges = DataTypes::DatabaseChanges{};
+        otherChanges.mSequenceNumber = 4;
+        otherChanges.mAddedTracks = {2, 5};
+        otherChanges.mModifiedTracks = {1, 4, 6, 6};
+        otherChanges.mRemovedTracks = {2, 3, 7, 7};
+        otherChanges.mModifiedAlbums = {10, 11};
+        otherChanges.mRemovedArtists = {20};
+
+        changes.merge(otherChanges);
+
+        QCOMPARE(changes.mSequenceNumber, 4ULL);
+        QCOMPARE(changes.mAddedTracks, (QList<qulonglong>{1, 2, 5}));
+        QCOMPARE(changes.mModifiedTracks, (QList<qulonglong>{4, 6}));
+        QCOMPARE(changes.mRemovedTracks, (QList<qulonglong>{3, 7}));
+        QCOMPARE(changes.mAddedAlbums, QList<qulonglong>{10});
+        QCOMPARE(changes.mModifiedAlbums, QList<qulonglong>{11});
+        QCOMPARE(changes.mRemovedArtists, QList<qulonglong>{20});
+    }
+
+    void trackDataRoleLookupBenchmark_data()
+    {
+        QTest::addColumn<bool>("useMap");
+
+        QTest::newRow("QMap") << true;
+        QTest::newRow("TrackDataType") << false;
+    }
+
+    void trackDataRoleLookupBenchmark()
+    {
+        QFETCH(bool, useMap);
+
+        const auto track = newTrack();
+        const auto trackMap = newTrackMap(track);
+        const auto roles = allRoles();
+
+        auto validValues = 0;
+
+        if (useMap) {
+            QBENCHMARK {
+                for (auto oneRole : roles) {
+                    validValues += trackMap[oneRole].isValid() ? 1 : 0;
+                }
+            }
+        } else {
+            QBENCHMARK {
+                for (auto oneRole : roles) {
+                    validValues += track[oneRole].isValid() ? 1 : 0;
+                }
+            }
+        }
+
+        QVERIFY(validValues > 0);
+    }
+
+};
+
+QTEST_GUILESS_MAIN(DataTypesTests)
+
+
+#include "datatypestest.moc"
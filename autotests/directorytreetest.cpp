@@ -0,0 +1,305 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "abstractfile/directorytree.h"
+
+#include <QObject>
+#include <QList>
+#include <QHash>
+#include <QVector>
+#include <QSet>
+#include <QPair>
+#include <QUrl>
+#include <QString>
+#include <QStringList>
+
+#include <QtTest>
+
+#include <algorithm>
+
+class DirectoryTreeTests: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DirectoryTreeTests(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static constexpr int ArtistsCount = 100;
+
+    static constexpr int AlbumsCount = 10;
+
+    static constexpr int TracksCount = 100;
+
+    static QString albumPath(int artist, int album)
+    {
+        return QStringLiteral("/home/user/Music/artist%1/album%2").arg(artist).arg(album);
+    }
+
+    static QString trackPath(int artist, int album, int track)
+    {
+        return QStringLiteral("/home/user/Music/artist%1/album%2/track%3.ogg").arg(artist).arg(album).arg(track);
+    }
+
+    static void addEntry(DirectoryTree &tree, const QString &directory, const QString &entry, bool isFile)
+    {
+        tree.addEntry(tree.listDirectory(directory), tree.insert(entry), isFile);
+    }
+
+    static void buildMusicTree(DirectoryTree &tree)
+    {
+        const auto rootPath = QStringLiteral("/home/user/Music");
+
+        for (int artist = 0; artist < ArtistsCount; ++artist) {
+            const auto artistPath = QStringLiteral("/home/user/Music/artist%1").arg(artist);
+            addEntry(tree, rootPath, artistPath, false);
+
+            for (int album = 0; album < AlbumsCount; ++album) {
+                addEntry(tree, artistPath, albumPath(artist, album), false);
+
+                for (int track = 0; track < TracksCount; ++track) {
+                    addEntry(tree, albumPath(artist, album), trackPath(artist, album, track), true);
+                }
+            }
+        }
+    }
+
+private Q_SLOTS:
+
+    void insertAndFindPaths()
+    {
+        DirectoryTree tree;
+
+        const auto trackNode = tree.insert(QStringLiteral("/home/user/Music/album/track.ogg"));
+
+        QVERIFY(trackNode != DirectoryTree::InvalidNode);
+        QCOMPARE(tree.find(QStringLiteral("/home/user/Music/album/track.ogg")), trackNode);
+        QCOMPARE(tree.insert(QStringLiteral("/home/user/Music/album/track.ogg")), trackNode);
+        QCOMPARE(tree.path(trackNode), QStringLiteral("/home/user/Music/album/track.ogg"));
+        QCOMPARE(tree.url(trackNode), QUrl::fromLocalFile(QStringLiteral("/home/user/Music/album/track.ogg")));
+        QCOMPARE(tree.nodesCount(), 6);
+
+        QVERIFY(tree.find(QStringLiteral("/home/user")) != DirectoryTree::InvalidNode);
+        QCOMPARE(tree.find(QStringLiteral("/home/user/Music/album/")), tree.find(QStringLiteral("/home/user/Music/album")));
+        QCOMPARE(tree.find(QStringLiteral("/home/user/Videos")), DirectoryTree::InvalidNode);
+        QCOMPARE(tree.find(QString()), DirectoryTree::InvalidNode);
+        QVERIFY(!tree.isListedDirectory(QStringLiteral("/home/user/Music/album")));
+
+        const auto rootNode = tree.insert(QStringLiteral("/"));
+
+        QCOMPARE(tree.path(rootNode), QStringLiteral("/"));
+    }
+
+    void listDirectoryEntries()
+    {
+        DirectoryTree tree;
+
+        const auto albumNode = tree.listDirectory(QStringLiteral("/Music/album"));
+        const auto trackNode = tree.insert(QStringLiteral("/Music/album/track.ogg"));
+        const auto subDirectoryNode = tree.insert(QStringLiteral("/Music/album/CD1"));
+
+        tree.addEntry(albumNode, trackNode, true);
+        tree.addEntry(albumNode, subDirectoryNode, false);
+
+        QVERIFY(tree.isListedDirectory(QStringLiteral("/Music/album")));
+        QCOMPARE(tree.listedDirectoriesCount(), 1);
+        QCOMPARE(tree.entries(albumNode).count(), 2);
+        QVERIFY(tree.hasEntry(albumNode, trackNode, true));
+        QVERIFY(!tree.hasEntry(albumNode, trackNode, false));
+        QVERIFY(tree.hasEntry(albumNode, subDirectoryNode, false));
+        QVERIFY(!tree.hasEntry(albumNode, tree.find(QStringLiteral("/Music")), false));
+
+        tree.removeEntry(albumNode, trackNode);
+
+        QVERIFY(!tree.hasEntry(albumNode, trackNode, true));
+        QCOMPARE(tree.find(QStringLiteral("/Music/album/track.ogg")), DirectoryTree::InvalidNode);
+        QCOMPARE(tree.entries(albumNode).count(), 1);
+        QCOMPARE(tree.nodesCount(), 4);
+    }
+
+    void removeDirectoryReportsNestedFiles()
+    {
+        DirectoryTree tree;
+
+        addEntry(tree, QStringLiteral("/Music"), QStringLiteral("/Music/album"), false);
+        addEntry(tree, QStringLiteral("/Music"), QStringLiteral("/Music/track1.ogg"), true);
+        addEntry(tree, QStringLiteral("/Music/album"), QStringLiteral("/Music/album/track2.ogg"), true);
+        addEntry(tree, QStringLiteral("/Music/album"), QStringLiteral("/Music/album/CD1"), false);
+
+        QCOMPARE(tree.listedDirectoriesCount(), 2);
+
+        auto allRemovedFiles = QList<QUrl>();
+        tree.removeFile(tree.find(QStringLiteral("/Music/track1.ogg")), allRemovedFiles);
+
+        QVERIFY(allRemovedFiles.isEmpty());
+
+        tree.removeDirectory(tree.find(QStringLiteral("/Music")), allRemovedFiles);
+
+        std::sort(allRemovedFiles.begin(), allRemovedFiles.end());
+
+        QCOMPARE(allRemovedFiles, (QList<QUrl>{QUrl::fromLocalFile(QStringLiteral("/Music/album/track2.ogg")),
+                                               QUrl::fromLocalFile(QStringLiteral("/Music/track1.ogg"))}));
+        QCOMPARE(tree.listedDirectoriesCount(), 0);
+        QCOMPARE(tree.nodesCount(), 0);
+    }
+
+    void removeDirectoryWithSymbolicLinksLoop()
+    {
+        DirectoryTree tree;
+
+        addEntry(tree, QStringLiteral("/Music/a"), QStringLiteral("/Music/b"), false);
+        addEntry(tree, QStringLiteral("/Music/a"), QStringLiteral("/Music/a/track1.ogg"), true);
+        addEntry(tree, QStringLiteral("/Music/b"), QStringLiteral("/Music/a"), false);
+        addEntry(tree, QStringLiteral("/Music/b"), QStringLiteral("/Music/b/track2.ogg"), true);
+
+        auto allRemovedFiles = QList<QUrl>();
+        tree.removeDirectory(tree.find(QStringLiteral("/Music/a")), allRemovedFiles);
+
+        QCOMPARE(allRemovedFiles.count(), 2);
+        QCOMPARE(tree.listedDirectoriesCount(), 0);
+        QCOMPARE(tree.nodesCount(), 0);
+    }
+
+    void buildLargeTreeBenchmark()
+    {
+        QBENCHMARK {
+            DirectoryTree tree;
+
+            buildMusicTree(tree);
+
+            QCOMPARE(tree.listedDirectoriesCount(), 1 + ArtistsCount + ArtistsCount * AlbumsCount);
+        }
+    }
+
+    void removeLargeTreeBenchmark()
+    {
+        auto allRemovedFiles = QList<QUrl>();
+
+        QBENCHMARK {
+            DirectoryTree tree;
+            buildMusicTree(tree);
+
+            allRemovedFiles.clear();
+            tree.removeDirectory(tree.find(QStringLiteral("/home/user/Music")), allRemovedFiles);
+        }
+
+        QCOMPARE(allRemovedFiles.count(), ArtistsCount * AlbumsCount * TracksCount);
+    }
+
+    void diffDirectoryListingBenchmark_data()
+    {
+        QTest::addColumn<bool>("useHashOfUrls");
+
+        QTest::newRow("QHash of QSet<QPair<QUrl, bool>>") << true;
+        QTest::newRow("DirectoryTree") << false;
+    }
+
+    void diffDirectoryListingBenchmark()
+    {
+        QFETCH(bool, useHashOfUrls);
+
+        const auto entriesCount = 2000;
+        const auto directoryPath = QStringLiteral("/home/user/Music/album");
+
+        auto diskEntries = QStringList{};
+        for (int i = 0; i < entriesCount; ++i) {
+            diskEntries.push_back(QStringLiteral("/home/user/Music/album/track%1.ogg").arg(i));
+        }
+
+        auto newEntries = 0;
+        auto removedEntries = 0;
+
+        if (useHashOfUrls) {
+            auto discoveredFiles = QHash<QUrl, QSet<QPair<QUrl, bool>>>{};
+            auto &listing = discoveredFiles[QUrl::fromLocalFile(directoryPath)];
+            for (int i = 1; i < entriesCount; ++i) {
+                listing.insert({QUrl::fromLocalFile(diskEntries[i]), true});
+            }
+            listing.insert({QUrl::fromLocalFile(QStringLiteral("/home/user/Music/album/removed.ogg")), true});
+
+            QBENCHMARK {
+                newEntries = 0;
+                removedEntries = 0;
+
+                auto currentFilesList = QSet<QUrl>{};
+                for (const auto &oneEntry : diskEntries) {
+                    currentFilesList.insert(QUrl::fromLocalFile(oneEntry));
+                }
+
+                for (const auto &oneListedFile : listing) {
+                    if (std::find(currentFilesList.begin(), currentFilesList.end(), oneListedFile.first) == currentFilesList.end()) {
+                        ++removedEntries;
+                    }
+                }
+
+                for (const auto &oneFile : currentFilesList) {
+                    if (std::find(listing.begin(), listing.end(), QPair<QUrl, bool>{oneFile, true}) == listing.end()) {
+                        ++newEntries;
+                    }
+                }
+            }
+        } else {
+            DirectoryTree tree;
+            for (int i = 1; i < entriesCount; ++i) {
+                addEntry(tree, directoryPath, diskEntries[i], true);
+            }
+            addEntry(tree, directoryPath, QStringLiteral("/home/user/Music/album/removed.ogg"), true);
+
+            const auto directoryNode = tree.find(directoryPath);
+
+            QBENCHMARK {
+                newEntries = 0;
+                removedEntries = 0;
+
+                auto currentEntries = QSet<int>{};
+                auto currentNodes = QVector<int>{};
+                for (const auto &oneEntry : diskEntries) {
+                    const auto entryNode = tree.find(oneEntry);
+                    currentNodes.push_back(entryNode);
+                    if (entryNode != DirectoryTree::InvalidNode) {
+                        currentEntries.insert(entryNode);
+                    }
+                }
+
+                for (const auto oneListedFile : tree.entries(directoryNode)) {
+                    if (!currentEntries.contains(oneListedFile)) {
+                        ++removedEntries;
+                    }
+                }
+
+                for (const auto oneNode : currentNodes) {
+                    if (!tree.hasEntry(directoryNode, oneNode, true)) {
+                        ++newEntries;
+                    }
+                }
+            }
+        }
+
+        QCOMPARE(newEntries, 1);
+        QCOMPARE(removedEntries, 1);
+    }
+
+};
+
+QTEST_GUILESS_MAIN(DirectoryTreeTests)
+
+
+#include "directorytreetest.moc"
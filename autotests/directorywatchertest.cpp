@@ -0,0 +1,311 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "abstractfile/directorywatcher.h"
+
+#include "config-upnp-qt.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <QTemporaryDir>
+
+#include <QtTest>
+
+class DirectoryWatcherTests: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DirectoryWatcherTests(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static bool writeFile(const QString &path, const QByteArray &content)
+    {
+        QFile newFile(path);
+        if (!newFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            return false;
+        }
+
+        return newFile.write(content) == content.size();
+    }
+
+    static void skipWithoutInotify()
+    {
+#if !defined HAVE_SYS_INOTIFY_H || !HAVE_SYS_INOTIFY_H
+        QSKIP("file moves and modifications are only reported by the inotify backend");
+#endif
+    }
+
+private Q_SLOTS:
+
+    void newFileChangesItsDirectory()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        DirectoryWatcher watcher;
+        QSignalSpy directoryChangedSpy(&watcher, &DirectoryWatcher::directoryChanged);
+
+        QVERIFY(watcher.addDirectory(musicDirectory.path()));
+        QCOMPARE(watcher.directories(), QStringList{musicDirectory.path()});
+        QVERIFY(watcher.polledDirectories().isEmpty());
+
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("track.ogg")), "data"));
+
+        QVERIFY(directoryChangedSpy.wait());
+        QCOMPARE(directoryChangedSpy.at(0).at(0).toString(), musicDirectory.path());
+
+        watcher.removeDirectory(musicDirectory.path());
+
+        QVERIFY(watcher.directories().isEmpty());
+    }
+
+    void renamedFileIsReportedAsMove()
+    {
+        skipWithoutInotify();
+
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+        QVERIFY(QDir(musicDirectory.path()).mkpath(QStringLiteral("album")));
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("track.ogg")), "data"));
+
+        DirectoryWatcher watcher;
+        QSignalSpy fileMovedSpy(&watcher, &DirectoryWatcher::fileMoved);
+        QSignalSpy directoryChangedSpy(&watcher, &DirectoryWatcher::directoryChanged);
+
+        QVERIFY(watcher.addDirectory(musicDirectory.path()));
+        QVERIFY(watcher.addDirectory(musicDirectory.filePath(QStringLiteral("album"))));
+
+        QVERIFY(QFile::rename(musicDirectory.filePath(QStringLiteral("track.ogg")),
+                              musicDirectory.filePath(QStringLiteral("album/track.ogg"))));
+
+        QVERIFY(fileMovedSpy.wait());
+        QCOMPARE(fileMovedSpy.count(), 1);
+        QCOMPARE(fileMovedSpy.at(0).at(0).toString(), musicDirectory.filePath(QStringLiteral("track.ogg")));
+        QCOMPARE(fileMovedSpy.at(0).at(1).toString(), musicDirectory.filePath(QStringLiteral("album/track.ogg")));
+        QCOMPARE(directoryChangedSpy.count(), 2);
+    }
+
+    void fileMovedOutChangesItsDirectory()
+    {
+        skipWithoutInotify();
+
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("track.ogg")), "data"));
+
+        QTemporaryDir otherDirectory;
+        QVERIFY(otherDirectory.isValid());
+
+        DirectoryWatcher watcher;
+        QSignalSpy fileMovedSpy(&watcher, &DirectoryWatcher::fileMoved);
+        QSignalSpy directoryChangedSpy(&watcher, &DirectoryWatcher::directoryChanged);
+
+        QVERIFY(watcher.addDirectory(musicDirectory.path()));
+
+        QVERIFY(QFile::rename(musicDirectory.filePath(QStringLiteral("track.ogg")),
+                              otherDirectory.filePath(QStringLiteral("track.ogg"))));
+
+        // the other half of the move is waited for before the directory is reported
+        QVERIFY(directoryChangedSpy.wait());
+        QCOMPARE(directoryChangedSpy.count(), 1);
+        QCOMPARE(directoryChangedSpy.at(0).at(0).toString(), musicDirectory.path());
+        QCOMPARE(fileMovedSpy.count(), 0);
+    }
+
+    void renamedDirectoryIsStillWatched()
+    {
+        skipWithoutInotify();
+
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+        QVERIFY(QDir(musicDirectory.path()).mkpath(QStringLiteral("album")));
+
+        DirectoryWatcher watcher;
+        QSignalSpy fileMovedSpy(&watcher, &DirectoryWatcher::fileMoved);
+        QSignalSpy directoryChangedSpy(&watcher, &DirectoryWatcher::directoryChanged);
+
+        QVERIFY(watcher.addDirectory(musicDirectory.path()));
+        QVERIFY(watcher.addDirectory(musicDirectory.filePath(QStringLiteral("album"))));
+
+        QVERIFY(QDir(musicDirectory.path()).rename(QStringLiteral("album"), QStringLiteral("renamed album")));
+
+        QVERIFY(fileMovedSpy.wait());
+
+        auto allDirectories = watcher.directories();
+        allDirectories.sort();
+
+        QCOMPARE(allDirectories, (QStringList{musicDirectory.path(), musicDirectory.filePath(QStringLiteral("renamed album"))}));
+
+        directoryChangedSpy.clear();
+
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("renamed album/track.ogg")), "data"));
+
+        QVERIFY(directoryChangedSpy.wait());
+        QCOMPARE(directoryChangedSpy.at(0).at(0).toString(), musicDirectory.filePath(QStringLiteral("renamed album")));
+    }
+
+    void modifiedFileIsReportedOnce()
+    {
+        skipWithoutInotify();
+
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("track.ogg")), "data"));
+
+        DirectoryWatcher watcher;
+        QSignalSpy fileChangedSpy(&watcher, &DirectoryWatcher::fileChanged);
+        QSignalSpy directoryChangedSpy(&watcher, &DirectoryWatcher::directoryChanged);
+
+        QVERIFY(watcher.addDirectory(musicDirectory.path()));
+
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("track.ogg")), "more data"));
+
+        QVERIFY(fileChangedSpy.wait());
+        QCOMPARE(fileChangedSpy.count(), 1);
+        QCOMPARE(fileChangedSpy.at(0).at(0).toString(), musicDirectory.filePath(QStringLiteral("track.ogg")));
+        QCOMPARE(directoryChangedSpy.count(), 0);
+    }
+
+    void directoriesBeyondTheLimitArePolled()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+        QVERIFY(QDir(musicDirectory.path()).mkpath(QStringLiteral("album")));
+
+        const auto albumPath = musicDirectory.filePath(QStringLiteral("album"));
+
+        DirectoryWatcher watcher;
+        watcher.setWatchesLimit(1);
+        watcher.setPollingInterval(100);
+
+        QSignalSpy watchLimitReachedSpy(&watcher, &DirectoryWatcher::watchLimitReached);
+        QSignalSpy directoryChangedSpy(&watcher, &DirectoryWatcher::directoryChanged);
+
+        QVERIFY(watcher.addDirectory(musicDirectory.path()));
+        QCOMPARE(watchLimitReachedSpy.count(), 0);
+
+        QVERIFY(watcher.addDirectory(albumPath));
+        QCOMPARE(watchLimitReachedSpy.count(), 1);
+        QCOMPARE(watcher.polledDirectories(), QStringList{albumPath});
+        QCOMPARE(watcher.directories().count(), 2);
+
+        QVERIFY(!watcher.addDirectory(musicDirectory.filePath(QStringLiteral("does not exist"))));
+
+        // the modification time of a directory may have a one second resolution
+        QTest::qWait(1100);
+
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("album/track.ogg")), "data"));
+
+        QTRY_VERIFY(directoryChangedSpy.count() > 0);
+        QCOMPARE(directoryChangedSpy.at(0).at(0).toString(), albumPath);
+        QCOMPARE(watchLimitReachedSpy.count(), 1);
+    }
+
+    void modifiedFileInPolledDirectoryIsReported()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("track.ogg")), "data"));
+
+        DirectoryWatcher watcher;
+        watcher.setWatchesLimit(0);
+        watcher.setPollingInterval(100);
+
+        QSignalSpy fileChangedSpy(&watcher, &DirectoryWatcher::fileChanged);
+        QSignalSpy directoryChangedSpy(&watcher, &DirectoryWatcher::directoryChanged);
+
+        QVERIFY(watcher.addDirectory(musicDirectory.path()));
+        QCOMPARE(watcher.polledDirectories(), QStringList{musicDirectory.path()});
+        QVERIFY(watcher.addFile(musicDirectory.filePath(QStringLiteral("track.ogg"))));
+
+        // writing to a file changes its size but not the modification time of its directory
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("track.ogg")), "more data"));
+
+        QTRY_VERIFY(fileChangedSpy.count() > 0);
+        QCOMPARE(fileChangedSpy.at(0).at(0).toString(), musicDirectory.filePath(QStringLiteral("track.ogg")));
+        QCOMPARE(directoryChangedSpy.count(), 0);
+    }
+
+    void watcherRunsOnItsOwnThread()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+        QVERIFY(QDir(musicDirectory.path()).mkpath(QStringLiteral("album")));
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("album/track.ogg")), "data"));
+
+        const auto albumPath = musicDirectory.filePath(QStringLiteral("album"));
+
+        // the watcher is used from the thread of the file listing, its signals are counted on this thread
+        QThread watcherThread;
+        watcherThread.start();
+
+        DirectoryWatcher watcher;
+        watcher.setWatchesLimit(1);
+        watcher.setPollingInterval(100);
+        watcher.moveToThread(&watcherThread);
+
+        auto changedDirectories = QStringList{};
+        auto changedFiles = QStringList{};
+
+        connect(&watcher, &DirectoryWatcher::directoryChanged, this,
+                [&changedDirectories](const QString &path) {changedDirectories.push_back(path);}, Qt::QueuedConnection);
+        connect(&watcher, &DirectoryWatcher::fileChanged, this,
+                [&changedFiles](const QString &path) {changedFiles.push_back(path);}, Qt::QueuedConnection);
+
+        auto allDirectoriesAdded = false;
+        auto polledDirectories = QStringList{};
+        QMetaObject::invokeMethod(&watcher, [&]() {
+            allDirectoriesAdded = watcher.addDirectory(musicDirectory.path()) && watcher.addDirectory(albumPath) &&
+                    watcher.addFile(musicDirectory.filePath(QStringLiteral("album/track.ogg")));
+            polledDirectories = watcher.polledDirectories();
+        }, Qt::BlockingQueuedConnection);
+
+        QVERIFY(allDirectoriesAdded);
+        QCOMPARE(polledDirectories, QStringList{albumPath});
+
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("track.ogg")), "data"));
+
+        QTRY_VERIFY(changedDirectories.contains(musicDirectory.path()));
+
+        QVERIFY(writeFile(musicDirectory.filePath(QStringLiteral("album/track.ogg")), "more data"));
+
+        QTRY_VERIFY(changedFiles.contains(musicDirectory.filePath(QStringLiteral("album/track.ogg"))));
+
+        auto mainThread = QThread::currentThread();
+        QMetaObject::invokeMethod(&watcher, [&watcher, mainThread]() {
+            watcher.moveToThread(mainThread);
+        }, Qt::BlockingQueuedConnection);
+
+        watcherThread.quit();
+        watcherThread.wait();
+    }
+
+};
+
+QTEST_GUILESS_MAIN(DirectoryWatcherTests)
+
+
+#include "directorywatchertest.moc"
@@ -31,6 +31,8 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
 
 
 #include <QtTest>
@@ -57,6 +59,8 @@ private Q_SLOTS:
         qRegisterMetaType<QVector<qlonglong>>("QVector<qlonglong>");
         qRegisterMetaType<QHash<qlonglong,int>>("QHash<qlonglong,int>");
         qRegisterMetaType<QList<QUrl>>("QList<QUrl>");
+        qRegisterMetaType<DataTypes::DirectoriesStateType>("DataTypes::DirectoriesStateType");
+        qRegisterMetaType<DataTypes::ListTrackDataType>("DataTypes::ListTrackDataType");
     }
 
     void initialTestWithNoTrack()
@@ -126,6 +130,80 @@ private Q_SLOTS:
         QCOMPARE(newCovers.count(), 5);
     }
 
+    void unchangedDirectoriesAreSkippedAtStartup()
+    {
+        QString musicPath = QFileInfo(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music")).canonicalFilePath();
+
+        auto allDirectories = DataTypes::DirectoriesStateType{};
+        auto allFiles = QHash<QUrl, QDateTime>{};
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+            QSignalSpy directoriesStateChangedSpy(&myListing, &LocalFileListing::directoriesStateChanged);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicPath});
+            myListing.refreshContent();
+
+            QCOMPARE(directoriesStateChangedSpy.count(), 1);
+
+            allDirectories = directoriesStateChangedSpy.at(0).at(0).value<DataTypes::DirectoriesStateType>();
+
+            QCOMPARE(allDirectories.count(), 1);
+            QCOMPARE(allDirectories[musicPath].mEntriesCount, 6);
+            QCOMPARE(allDirectories[musicPath].mModifiedTime, QFileInfo(musicPath).lastModified());
+
+            // files older than on disk would be scanned again if their directory is listed
+            for (const auto &oneSignal : tracksListSpy) {
+                const auto newTracks = oneSignal.at(0).value<DataTypes::ListTrackDataType>();
+                for (const auto &oneTrack : newTracks) {
+                    allFiles[oneTrack.resourceURI()] = QDateTime::fromMSecsSinceEpoch(0);
+                }
+            }
+
+            QCOMPARE(allFiles.count(), 5);
+        }
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+            QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+            QSignalSpy directoriesStateChangedSpy(&myListing, &LocalFileListing::directoriesStateChanged);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicPath});
+            myListing.restoredDirectoriesState(allDirectories);
+            myListing.restoredTracks(allFiles);
+
+            QCOMPARE(tracksListSpy.count(), 0);
+            QCOMPARE(removedTracksListSpy.count(), 0);
+            QCOMPARE(directoriesStateChangedSpy.count(), 0);
+        }
+
+        allDirectories[musicPath].mEntriesCount = 1;
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+            QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+            QSignalSpy directoriesStateChangedSpy(&myListing, &LocalFileListing::directoriesStateChanged);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicPath});
+            myListing.restoredDirectoriesState(allDirectories);
+            myListing.restoredTracks(allFiles);
+
+            QCOMPARE(tracksListSpy.count(), 2);
+            QCOMPARE(removedTracksListSpy.count(), 0);
+            QCOMPARE(directoriesStateChangedSpy.count(), 1);
+            QCOMPARE(directoriesStateChangedSpy.at(0).at(0).value<DataTypes::DirectoriesStateType>()[musicPath].mEntriesCount, 6);
+        }
+    }
+
     void addAndRemoveTracks()
     {
         LocalFileListing myListing;
@@ -418,6 +496,75 @@ private Q_SLOTS:
         QCOMPARE(newCoversLast.count(), 1);
     }
 
+    void copiedAlbumIsScannedOnce()
+    {
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music4");
+        QString musicPath = musicParentPath + QStringLiteral("/album");
+        QDir musicParentDirectory(musicParentPath);
+
+        musicParentDirectory.removeRecursively();
+        QCOMPARE(musicParentDirectory.mkpath(musicPath), true);
+
+        // the listing runs on its own thread like in the application, its signals are counted on this thread
+        QThread listingThread;
+        listingThread.start();
+
+        LocalFileListing myListing;
+        myListing.moveToThread(&listingThread);
+
+        auto newTracksCount = 0;
+        auto indexingStartedCount = 0;
+        auto indexingFinishedCount = 0;
+        auto errorWatchingFileSystemChangesCount = 0;
+
+        connect(&myListing, &LocalFileListing::tracksList, this,
+                [&newTracksCount](const DataTypes::ListTrackDataType &tracks) {newTracksCount += tracks.count();}, Qt::QueuedConnection);
+        connect(&myListing, &LocalFileListing::indexingStarted, this,
+                [&indexingStartedCount]() {++indexingStartedCount;}, Qt::QueuedConnection);
+        connect(&myListing, &LocalFileListing::indexingFinished, this,
+                [&indexingFinishedCount]() {++indexingFinishedCount;}, Qt::QueuedConnection);
+        connect(&myListing, &LocalFileListing::errorWatchingFileSystemChanges, this,
+                [&errorWatchingFileSystemChangesCount]() {++errorWatchingFileSystemChangesCount;}, Qt::QueuedConnection);
+
+        QMetaObject::invokeMethod(&myListing, [&myListing, &musicParentPath]() {
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.refreshContent();
+        }, Qt::BlockingQueuedConnection);
+
+        QTRY_COMPARE(indexingFinishedCount, 1);
+        QCOMPARE(newTracksCount, 0);
+
+        const auto allMusicFiles = QDir(musicOriginPath).entryList(QDir::Files);
+        for (const auto &oneFile : allMusicFiles) {
+            QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/") + oneFile, musicPath + QStringLiteral("/") + oneFile), true);
+        }
+
+        QTRY_VERIFY_WITH_TIMEOUT(indexingFinishedCount == 2 || errorWatchingFileSystemChangesCount > 0, 10000);
+
+        if (indexingFinishedCount != 2) {
+            QEXPECT_FAIL("", "Impossible watching file system for changes", Abort);
+        }
+        QCOMPARE(indexingFinishedCount, 2);
+
+        QCOMPARE(indexingStartedCount, 2);
+        QCOMPARE(newTracksCount, 5);
+
+        QTest::qWait(1000);
+
+        QCOMPARE(indexingStartedCount, 2);
+
+        auto mainThread = QThread::currentThread();
+        QMetaObject::invokeMethod(&myListing, [&myListing, mainThread]() {
+            myListing.moveToThread(mainThread);
+        }, Qt::BlockingQueuedConnection);
+
+        listingThread.quit();
+        listingThread.wait();
+    }
+
     void restoreRemovedTracks()
     {
         LocalFileListing myListing;
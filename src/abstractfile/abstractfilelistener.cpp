@@ -54,11 +54,16 @@ void AbstractFileListener::setDatabaseInterface(DatabaseInterface *model)
         connect(this, &AbstractFileListener::newTrackFile, d->mFileListing, &AbstractFileListing::newTrackFile);
         connect(d->mFileListing, &AbstractFileListing::tracksList, model, &DatabaseInterface::insertTracksList);
         connect(d->mFileListing, &AbstractFileListing::removedTracksList, model, &DatabaseInterface::removeTracksList);
+        connect(d->mFileListing, &AbstractFileListing::trackMoved, model, &DatabaseInterface::moveTrackFile);
         connect(d->mFileListing, &AbstractFileListing::modifyTracksList, model, &DatabaseInterface::insertTracksList);
         connect(d->mFileListing, &AbstractFileListing::askRestoredTracks,
                 model, &DatabaseInterface::askRestoredTracks);
+        connect(model, &DatabaseInterface::restoredDirectoriesState,
+                d->mFileListing, &AbstractFileListing::restoredDirectoriesState);
         connect(model, &DatabaseInterface::restoredTracks,
                 d->mFileListing, &AbstractFileListing::restoredTracks);
+        connect(d->mFileListing, &AbstractFileListing::directoriesStateChanged,
+                model, &DatabaseInterface::updateDirectoriesState);
         connect(model, &DatabaseInterface::cleanedDatabase,
                 d->mFileListing, &AbstractFileListing::refreshContent);
         connect(model, &DatabaseInterface::finishRemovingTracksList,
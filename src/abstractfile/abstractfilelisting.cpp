@@ -22,37 +22,109 @@
 #include "abstractfile/indexercommon.h"
 
 #include "filescanner.h"
+#include "directorytree.h"
+#include "directorywatcher.h"
 
 #include <QThread>
+#include <QTimer>
 #include <QHash>
 #include <QFileInfo>
 #include <QFile>
 #include <QDir>
-#include <QFileSystemWatcher>
+#include <QDirIterator>
 #include <QSet>
 #include <QPair>
 #include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QFuture>
+#include <QtConcurrent>
 
 
 #include <algorithm>
+#include <deque>
 #include <utility>
+#include <vector>
+
+class PendingFileScan
+{
+public:
+
+    QUrl mFile;
+
+    QUrl mDirectory;
+
+    QFuture<DataTypes::TrackDataType> mTrack;
+
+};
 
 class AbstractFileListingPrivate
 {
 public:
 
+    std::unique_ptr<FileScanner> takeIdleScanner()
+    {
+        QMutexLocker locker(&mIdleScannersMutex);
+
+        if (mIdleScanners.empty()) {
+            return std::make_unique<FileScanner>();
+        }
+
+        auto scanner = std::move(mIdleScanners.back());
+        mIdleScanners.pop_back();
+
+        return scanner;
+    }
+
+    void releaseIdleScanner(std::unique_ptr<FileScanner> scanner)
+    {
+        QMutexLocker locker(&mIdleScannersMutex);
+
+        mIdleScanners.push_back(std::move(scanner));
+    }
+
     QStringList mAllRootPaths;
 
-    QFileSystemWatcher mFileSystemWatcher;
+    // the watcher and the timer are children of the listing to follow it to its thread
+    DirectoryWatcher *mDirectoryWatcher = nullptr;
 
     QHash<QString, QUrl> mAllAlbumCover;
 
-    QHash<QUrl, QSet<QPair<QUrl, bool>>> mDiscoveredFiles;
+    DirectoryTree mDiscoveredFiles;
 
     FileScanner mFileScanner;
 
+    QMutex mIdleScannersMutex;
+
+    // each worker of the scan thread pool uses its own scanner, they are kept between two scans
+    std::vector<std::unique_ptr<FileScanner>> mIdleScanners;
+
+    // files being scanned, in the order of the directory walk
+    std::deque<PendingFileScan> mPendingScans;
+
+    QThreadPool mScanThreadPool;
+
     QHash<QUrl, QDateTime> mAllFiles;
 
+    static constexpr int MinimumChangesDelay = 200;
+
+    static constexpr int MaximumChangesDelay = 5000;
+
+    // directories changed since their last scan with the size of their files when they were last checked
+    QHash<QString, QHash<QString, qint64>> mChangedDirectories;
+
+    QTimer *mChangedDirectoriesTimer = nullptr;
+
+    int mChangedDirectoriesDelay = MinimumChangesDelay;
+
+    bool mNewChanges = false;
+
+    // state of the directories when their content was last imported, consumed by the first scan
+    DataTypes::DirectoriesStateType mRestoredDirectoriesState;
+
+    DataTypes::DirectoriesStateType mModifiedDirectoriesState;
+
     QAtomicInt mStopRequest = 0;
 
     int mImportedTracksCount = 0;
@@ -71,10 +143,18 @@ public:
 
 AbstractFileListing::AbstractFileListing(QObject *parent) : QObject(parent), d(std::make_unique<AbstractFileListingPrivate>())
 {
-    connect(&d->mFileSystemWatcher, &QFileSystemWatcher::directoryChanged,
+    d->mDirectoryWatcher = new DirectoryWatcher(this);
+    connect(d->mDirectoryWatcher, &DirectoryWatcher::directoryChanged,
             this, &AbstractFileListing::directoryChanged);
-    connect(&d->mFileSystemWatcher, &QFileSystemWatcher::fileChanged,
+    connect(d->mDirectoryWatcher, &DirectoryWatcher::fileChanged,
             this, &AbstractFileListing::fileChanged);
+    connect(d->mDirectoryWatcher, &DirectoryWatcher::fileMoved,
+            this, &AbstractFileListing::fileMoved);
+
+    d->mChangedDirectoriesTimer = new QTimer(this);
+    d->mChangedDirectoriesTimer->setSingleShot(true);
+    connect(d->mChangedDirectoriesTimer, &QTimer::timeout,
+            this, &AbstractFileListing::checkChangedDirectories);
 }
 
 AbstractFileListing::~AbstractFileListing()
@@ -113,6 +193,11 @@ void AbstractFileListing::restoredTracks(QHash<QUrl, QDateTime> allFiles)
     refreshContent();
 }
 
+void AbstractFileListing::restoredDirectoriesState(const DataTypes::DirectoriesStateType &allDirectories)
+{
+    d->mRestoredDirectoriesState = allDirectories;
+}
+
 void AbstractFileListing::setAllRootPaths(const QStringList &allRootPaths)
 {
     d->mAllRootPaths = allRootPaths;
@@ -158,42 +243,64 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
         watchPath(path.toLocalFile());
     }
 
-    auto &currentDirectoryListingFiles = d->mDiscoveredFiles[path];
+    const auto directoryNode = d->mDiscoveredFiles.listDirectory(path.toLocalFile());
 
-    auto currentFilesList = QSet<QUrl>();
+    auto currentState = DataTypes::DirectoryState{QFileInfo(path.toLocalFile()).lastModified(), 0};
+
+    const auto itRestoredState = d->mRestoredDirectoriesState.find(path.toLocalFile());
+    if (itRestoredState != d->mRestoredDirectoriesState.end()) {
+        const auto restoredState = *itRestoredState;
+        d->mRestoredDirectoriesState.erase(itRestoredState);
+
+        if (d->mHandleNewFiles && restoredState.mModifiedTime == currentState.mModifiedTime &&
+                scanUnchangedDirectory(newFiles, path, restoredState)) {
+            return;
+        }
+    }
+
+    auto currentFilesList = QVector<QPair<QString, QFileInfo>>();
+    auto currentFilesPaths = QSet<QString>();
+    auto currentEntries = QSet<int>();
 
     rootDirectory.refresh();
     const auto entryList = rootDirectory.entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+    currentState.mEntriesCount = entryList.count();
     for (const auto &oneEntry : entryList) {
-        auto newFilePath = QUrl::fromLocalFile(oneEntry.canonicalFilePath());
+        if (!oneEntry.isDir() && !oneEntry.isFile()) {
+            continue;
+        }
 
-        if (oneEntry.isDir() || oneEntry.isFile()) {
-            currentFilesList.insert(newFilePath);
+        const auto newFilePath = oneEntry.canonicalFilePath();
+        if (currentFilesPaths.contains(newFilePath)) {
+            continue;
         }
-    }
 
-    auto removedTracks = QVector<QPair<QUrl, bool>>();
-    for (const auto &removedFilePath : currentDirectoryListingFiles) {
-        auto itFilePath = std::find(currentFilesList.begin(), currentFilesList.end(), removedFilePath.first);
+        currentFilesPaths.insert(newFilePath);
+        currentFilesList.push_back({newFilePath, oneEntry});
 
-        if (itFilePath != currentFilesList.end()) {
-            continue;
+        const auto entryNode = d->mDiscoveredFiles.find(newFilePath);
+        if (entryNode != DirectoryTree::InvalidNode) {
+            currentEntries.insert(entryNode);
         }
+    }
 
-        removedTracks.push_back(removedFilePath);
+    auto removedTracks = QVector<int>();
+    for (const auto oneEntry : d->mDiscoveredFiles.entries(directoryNode)) {
+        if (!currentEntries.contains(oneEntry)) {
+            removedTracks.push_back(oneEntry);
+        }
     }
 
     auto allRemovedTracks = QList<QUrl>();
-    for (const auto &oneRemovedTrack : removedTracks) {
-        if (oneRemovedTrack.second) {
-            allRemovedTracks.push_back(oneRemovedTrack.first);
+    for (const auto oneRemovedTrack : removedTracks) {
+        if (d->mDiscoveredFiles.isFile(oneRemovedTrack)) {
+            allRemovedTracks.push_back(d->mDiscoveredFiles.url(oneRemovedTrack));
         } else {
-            removeFile(oneRemovedTrack.first, allRemovedTracks);
+            d->mDiscoveredFiles.removeFile(oneRemovedTrack, allRemovedTracks);
         }
     }
-    for (const auto &oneRemovedTrack : removedTracks) {
-        currentDirectoryListingFiles.remove(oneRemovedTrack);
-        currentDirectoryListingFiles.remove(oneRemovedTrack);
+    for (const auto oneRemovedTrack : removedTracks) {
+        d->mDiscoveredFiles.removeEntry(directoryNode, oneRemovedTrack);
     }
 
     if (!allRemovedTracks.isEmpty()) {
@@ -204,12 +311,12 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
         return;
     }
 
-    for (const auto &newFilePath : currentFilesList) {
-        QFileInfo oneEntry(newFilePath.toLocalFile());
+    for (const auto &oneFile : currentFilesList) {
+        const auto &oneEntry = oneFile.second;
+        const auto newFilePath = QUrl::fromLocalFile(oneFile.first);
 
-        auto itFilePath = std::find(currentDirectoryListingFiles.begin(), currentDirectoryListingFiles.end(), QPair<QUrl, bool>{newFilePath, oneEntry.isFile()});
-
-        if (itFilePath != currentDirectoryListingFiles.end()) {
+        const auto entryNode = d->mDiscoveredFiles.find(oneFile.first);
+        if (d->mDiscoveredFiles.hasEntry(directoryNode, entryNode, oneEntry.isFile())) {
             continue;
         }
 
@@ -236,47 +343,214 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
             }
         }
 
-        auto newTrack = scanOneFile(newFilePath, oneEntry);
+        queueFileScan(newFiles, newFilePath, path);
+
+        if (d->mStopRequest == 1) {
+            break;
+        }
+    }
+
+    if (rootDirectory.exists() && d->mStopRequest == 0) {
+        d->mModifiedDirectoriesState[path.toLocalFile()] = currentState;
+    }
+}
+
+bool AbstractFileListing::scanUnchangedDirectory(DataTypes::ListTrackDataType &newFiles, const QUrl &path, const DataTypes::DirectoryState &currentState)
+{
+    const auto directoryPath = path.toLocalFile();
+
+    // the paths of the entries are built without resolving them, this needs a canonical directory without links
+    if (QFileInfo(directoryPath).canonicalFilePath() != directoryPath) {
+        return false;
+    }
+
+    auto unchangedEntries = QVector<QFileInfo>();
+    QDirIterator itEntry(directoryPath, QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+    while (itEntry.hasNext()) {
+        itEntry.next();
+
+        const auto oneEntry = itEntry.fileInfo();
+        if (oneEntry.isSymLink()) {
+            return false;
+        }
+
+        unchangedEntries.push_back(oneEntry);
+    }
+
+    if (unchangedEntries.count() != currentState.mEntriesCount) {
+        return false;
+    }
 
-        if (newTrack.isValid() && d->mStopRequest == 0) {
-            addCover(newTrack);
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanUnchangedDirectory" << path << "directory not modified since last scan";
 
-            addFileInDirectory(newTrack.resourceURI(), path);
-            newFiles.push_back(newTrack);
+    const auto directoryNode = d->mDiscoveredFiles.find(directoryPath);
+    for (const auto &oneEntry : unchangedEntries) {
+        const auto newFilePath = QUrl::fromLocalFile(oneEntry.absoluteFilePath());
 
-            ++d->mImportedTracksCount;
+        if (oneEntry.isDir()) {
+            addFileInDirectory(newFilePath, path);
+            scanDirectory(newFiles, newFilePath);
 
-            if (newFiles.size() > d->mNewFilesEmitInterval && d->mStopRequest == 0) {
-                d->mNewFilesEmitInterval = std::min(50, 1 + d->mNewFilesEmitInterval * d->mNewFilesEmitInterval);
-                emitNewFiles(newFiles);
-                newFiles.clear();
+            if (d->mStopRequest == 1) {
+                break;
             }
-        } else {
-            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << newFilePath << "is not a valid track";
+
+            continue;
+        }
+
+        // only the tracks stored in the database are part of the tree, as after a full scan
+        auto itExistingFile = allFiles().find(newFilePath);
+        if (itExistingFile == allFiles().end()) {
+            continue;
         }
 
+        allFiles().erase(itExistingFile);
+        d->mDiscoveredFiles.addEntry(directoryNode, d->mDiscoveredFiles.insert(oneEntry.absoluteFilePath()), true);
+        watchFile(oneEntry.absoluteFilePath());
+    }
+
+    return true;
+}
+
+DataTypes::TrackDataType AbstractFileListing::scanOneFileMetaData(FileScanner &scanner, const QUrl &scanFile, const QFileInfo &scanFileInfo) const
+{
+    return scanner.scanOneFile(scanFile, scanFileInfo);
+}
+
+void AbstractFileListing::queueFileScan(DataTypes::ListTrackDataType &newFiles, const QUrl &scanFile, const QUrl &directory)
+{
+    // the walk of the directories goes on while at most two files per worker are waiting to be scanned
+    while (static_cast<int>(d->mPendingScans.size()) >= 2 * d->mScanThreadPool.maxThreadCount()) {
+        collectFileScan(newFiles);
+    }
+
+    auto scanResult = QtConcurrent::run(&d->mScanThreadPool, [this, scanFile]() -> DataTypes::TrackDataType {
         if (d->mStopRequest == 1) {
-            break;
+            return {};
+        }
+
+        const auto localFileName = scanFile.toLocalFile();
+
+        auto scanner = d->takeIdleScanner();
+        auto newTrack = DataTypes::TrackDataType{};
+
+        if (scanner->shouldScanFile(localFileName)) {
+            newTrack = scanOneFileMetaData(*scanner, scanFile, QFileInfo(localFileName));
+        } else {
+            qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::queueFileScan" << scanFile << "invalid mime type";
         }
+
+        d->releaseIdleScanner(std::move(scanner));
+
+        return newTrack;
+    });
+
+    d->mPendingScans.push_back({scanFile, directory, scanResult});
+}
+
+void AbstractFileListing::collectFileScan(DataTypes::ListTrackDataType &newFiles)
+{
+    auto pendingScan = std::move(d->mPendingScans.front());
+    d->mPendingScans.pop_front();
+
+    const auto newTrack = pendingScan.mTrack.result();
+
+    if (newTrack.isValid() && d->mStopRequest == 0) {
+        watchFile(newTrack.resourceURI().toLocalFile());
+
+        addCover(newTrack);
+
+        addFileInDirectory(newTrack.resourceURI(), pendingScan.mDirectory);
+        newFiles.push_back(newTrack);
+
+        ++d->mImportedTracksCount;
+
+        if (newFiles.size() > d->mNewFilesEmitInterval && d->mStopRequest == 0) {
+            d->mNewFilesEmitInterval = std::min(50, 1 + d->mNewFilesEmitInterval * d->mNewFilesEmitInterval);
+            emitNewFiles(newFiles);
+            newFiles.clear();
+        }
+    } else if (d->mStopRequest == 0) {
+        qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::collectFileScan" << pendingScan.mFile << "is not a valid track";
     }
 }
 
 void AbstractFileListing::directoryChanged(const QString &path)
 {
-    const auto directoryEntry = d->mDiscoveredFiles.find(QUrl::fromLocalFile(path));
-    if (directoryEntry == d->mDiscoveredFiles.end()) {
+    if (!d->mDiscoveredFiles.isListedDirectory(path)) {
         return;
     }
 
+    if (!d->mChangedDirectories.contains(path)) {
+        d->mChangedDirectories[path] = {};
+    }
+
+    d->mNewChanges = true;
+
+    if (!d->mChangedDirectoriesTimer->isActive()) {
+        d->mChangedDirectoriesTimer->start(d->mChangedDirectoriesDelay);
+    }
+}
+
+void AbstractFileListing::checkChangedDirectories()
+{
+    auto isStable = !d->mNewChanges;
+    d->mNewChanges = false;
+
+    for (auto itDirectory = d->mChangedDirectories.begin(); itDirectory != d->mChangedDirectories.end(); ++itDirectory) {
+        auto filesSize = QHash<QString, qint64>{};
+
+        const auto entryList = QDir(itDirectory.key()).entryInfoList(QDir::NoDotAndDotDot | QDir::Files);
+        for (const auto &oneEntry : entryList) {
+            filesSize[oneEntry.fileName()] = oneEntry.size();
+        }
+
+        if (filesSize != *itDirectory) {
+            isStable = false;
+            *itDirectory = std::move(filesSize);
+        }
+    }
+
+    if (!isStable) {
+        d->mChangedDirectoriesDelay = std::min(2 * d->mChangedDirectoriesDelay, AbstractFileListingPrivate::MaximumChangesDelay);
+        d->mChangedDirectoriesTimer->start(d->mChangedDirectoriesDelay);
+
+        return;
+    }
+
+    d->mChangedDirectoriesDelay = AbstractFileListingPrivate::MinimumChangesDelay;
+
+    // a parent directory is sorted before its children
+    auto allChangedDirectories = d->mChangedDirectories.keys();
+    d->mChangedDirectories.clear();
+    std::sort(allChangedDirectories.begin(), allChangedDirectories.end());
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::checkChangedDirectories" << allChangedDirectories;
+
     Q_EMIT indexingStarted();
 
-    scanDirectoryTree(path);
+    auto newFiles = DataTypes::ListTrackDataType();
+
+    for (const auto &oneDirectory : allChangedDirectories) {
+        if (!d->mDiscoveredFiles.isListedDirectory(oneDirectory)) {
+            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::checkChangedDirectories" << oneDirectory << "removed by the scan of its parent";
+            continue;
+        }
+
+        scanDirectory(newFiles, QUrl::fromLocalFile(oneDirectory));
+    }
+
+    finishDirectoriesScan(newFiles);
 
     Q_EMIT indexingFinished();
 }
 
 void AbstractFileListing::fileChanged(const QString &modifiedFileName)
 {
+    if (!d->mDiscoveredFiles.isFile(d->mDiscoveredFiles.find(modifiedFileName))) {
+        return;
+    }
+
     QFileInfo modifiedFileInfo(modifiedFileName);
     auto modifiedFile = QUrl::fromLocalFile(modifiedFileName);
 
@@ -287,6 +561,36 @@ void AbstractFileListing::fileChanged(const QString &modifiedFileName)
     }
 }
 
+void AbstractFileListing::fileMoved(const QString &oldFileName, const QString &newFileName)
+{
+    // renamed directories and files moved out of the listed directories are handled by the scan of their directories
+    const auto oldFileNode = d->mDiscoveredFiles.find(oldFileName);
+    if (!d->mDiscoveredFiles.isFile(oldFileNode)) {
+        return;
+    }
+
+    const auto oldDirectory = QFileInfo(oldFileName).absolutePath();
+    const auto newDirectory = QFileInfo(newFileName).absolutePath();
+
+    if (!d->mDiscoveredFiles.isListedDirectory(newDirectory)) {
+        return;
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::fileMoved" << oldFileName << newFileName;
+
+    // the track keeps its data, the scan of both directories then finds nothing new
+    d->mDiscoveredFiles.removeEntry(d->mDiscoveredFiles.find(oldDirectory), oldFileNode);
+    addFileInDirectory(QUrl::fromLocalFile(newFileName), QUrl::fromLocalFile(newDirectory));
+    watchFile(newFileName);
+
+    Q_EMIT trackMoved(QUrl::fromLocalFile(oldFileName), QUrl::fromLocalFile(newFileName));
+
+    // the album of a track depends on its directory
+    if (oldDirectory != newDirectory) {
+        fileChanged(newFileName);
+    }
+}
+
 void AbstractFileListing::executeInit(QHash<QUrl, QDateTime> allFiles)
 {
     d->mAllFiles = std::move(allFiles);
@@ -333,7 +637,7 @@ DataTypes::TrackDataType AbstractFileListing::scanOneFile(const QUrl &scanFile,
     newTrack = d->mFileScanner.scanOneFile(scanFile, scanFileInfo);
 
     if (newTrack.isValid() && scanFileInfo.exists()) {
-        watchPath(scanFile.toLocalFile());
+        watchFile(scanFile.toLocalFile());
     }
 
     return newTrack;
@@ -341,7 +645,7 @@ DataTypes::TrackDataType AbstractFileListing::scanOneFile(const QUrl &scanFile,
 
 void AbstractFileListing::watchPath(const QString &pathName)
 {
-    if (!d->mFileSystemWatcher.addPath(pathName)) {
+    if (!d->mDirectoryWatcher->addDirectory(pathName)) {
         qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::watchPath" << "fail for" << pathName;
 
         if (!d->mErrorWatchingFileSystemChanges) {
@@ -351,30 +655,40 @@ void AbstractFileListing::watchPath(const QString &pathName)
     }
 }
 
+void AbstractFileListing::watchFile(const QString &fileName)
+{
+    if (!d->mDirectoryWatcher->addFile(fileName)) {
+        qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::watchFile" << "fail for" << fileName;
+
+        if (!d->mErrorWatchingFileSystemChanges) {
+            d->mErrorWatchingFileSystemChanges = true;
+            Q_EMIT errorWatchingFileSystemChanges();
+        }
+    }
+}
+
 void AbstractFileListing::addFileInDirectory(const QUrl &newFile, const QUrl &directoryName)
 {
-    const auto directoryEntry = d->mDiscoveredFiles.find(directoryName);
-    if (directoryEntry == d->mDiscoveredFiles.end()) {
-        watchPath(directoryName.toLocalFile());
+    const auto directoryPath = directoryName.toLocalFile();
 
-        QDir currentDirectory(directoryName.toLocalFile());
+    if (!d->mDiscoveredFiles.isListedDirectory(directoryPath)) {
+        watchPath(directoryPath);
+
+        QDir currentDirectory(directoryPath);
         if (currentDirectory.cdUp()) {
             const auto parentDirectoryName = currentDirectory.absolutePath();
-            const auto parentDirectory = QUrl::fromLocalFile(parentDirectoryName);
-            const auto parentDirectoryEntry = d->mDiscoveredFiles.find(parentDirectory);
-            if (parentDirectoryEntry == d->mDiscoveredFiles.end()) {
+            if (!d->mDiscoveredFiles.isListedDirectory(parentDirectoryName)) {
                 watchPath(parentDirectoryName);
             }
 
-            auto &parentCurrentDirectoryListingFiles = d->mDiscoveredFiles[parentDirectory];
-
-            parentCurrentDirectoryListingFiles.insert({directoryName, false});
+            const auto parentDirectoryNode = d->mDiscoveredFiles.listDirectory(parentDirectoryName);
+            d->mDiscoveredFiles.addEntry(parentDirectoryNode, d->mDiscoveredFiles.insert(directoryPath), false);
         }
     }
-    auto &currentDirectoryListingFiles = d->mDiscoveredFiles[directoryName];
+    const auto directoryNode = d->mDiscoveredFiles.listDirectory(directoryPath);
 
     QFileInfo isAFile(newFile.toLocalFile());
-    currentDirectoryListingFiles.insert({newFile, isAFile.isFile()});
+    d->mDiscoveredFiles.addEntry(directoryNode, d->mDiscoveredFiles.insert(newFile.toLocalFile()), isAFile.isFile());
 }
 
 void AbstractFileListing::scanDirectoryTree(const QString &path)
@@ -385,9 +699,24 @@ void AbstractFileListing::scanDirectoryTree(const QString &path)
 
     scanDirectory(newFiles, QUrl::fromLocalFile(path));
 
+    finishDirectoriesScan(newFiles);
+}
+
+void AbstractFileListing::finishDirectoriesScan(DataTypes::ListTrackDataType &newFiles)
+{
+    while (!d->mPendingScans.empty()) {
+        collectFileScan(newFiles);
+    }
+
     if (!newFiles.isEmpty() && d->mStopRequest == 0) {
         emitNewFiles(newFiles);
     }
+
+    if (!d->mModifiedDirectoriesState.isEmpty() && d->mStopRequest == 0) {
+        Q_EMIT directoriesStateChanged(d->mModifiedDirectoriesState, {});
+    }
+
+    d->mModifiedDirectoriesState.clear();
 }
 
 void AbstractFileListing::setHandleNewFiles(bool handleThem)
@@ -415,31 +744,12 @@ void AbstractFileListing::addCover(const DataTypes::TrackDataType &newTrack)
 
 void AbstractFileListing::removeDirectory(const QUrl &removedDirectory, QList<QUrl> &allRemovedFiles)
 {
-    const auto itRemovedDirectory = d->mDiscoveredFiles.find(removedDirectory);
-
-    if (itRemovedDirectory == d->mDiscoveredFiles.end()) {
-        return;
-    }
-
-    const auto &currentRemovedDirectory = *itRemovedDirectory;
-    for (const auto &itFile : currentRemovedDirectory) {
-        if (itFile.first.isValid() && !itFile.first.isEmpty()) {
-            removeFile(itFile.first, allRemovedFiles);
-            if (itFile.second) {
-                allRemovedFiles.push_back(itFile.first);
-            }
-        }
-    }
-
-    d->mDiscoveredFiles.erase(itRemovedDirectory);
+    d->mDiscoveredFiles.removeDirectory(d->mDiscoveredFiles.find(removedDirectory.toLocalFile()), allRemovedFiles);
 }
 
 void AbstractFileListing::removeFile(const QUrl &oneRemovedTrack, QList<QUrl> &allRemovedFiles)
 {
-    auto itRemovedDirectory = d->mDiscoveredFiles.find(oneRemovedTrack);
-    if (itRemovedDirectory != d->mDiscoveredFiles.end()) {
-        removeDirectory(oneRemovedTrack, allRemovedFiles);
-    }
+    d->mDiscoveredFiles.removeFile(d->mDiscoveredFiles.find(oneRemovedTrack.toLocalFile()), allRemovedFiles);
 }
 
 QHash<QUrl, QDateTime> &AbstractFileListing::allFiles()
@@ -463,6 +773,19 @@ void AbstractFileListing::checkFilesToRemove()
     }
 }
 
+void AbstractFileListing::checkDirectoriesToRemove()
+{
+    const QStringList removedDirectories = d->mRestoredDirectoriesState.keys();
+
+    d->mRestoredDirectoriesState.clear();
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::checkDirectoriesToRemove" << removedDirectories.size();
+
+    if (!removedDirectories.isEmpty()) {
+        Q_EMIT directoriesStateChanged({}, removedDirectories);
+    }
+}
+
 FileScanner &AbstractFileListing::fileScanner()
 {
     return d->mFileScanner;
@@ -56,6 +56,8 @@ Q_SIGNALS:
 
     void removedTracksList(const QList<QUrl> &removedTracks);
 
+    void trackMoved(const QUrl &oldFileName, const QUrl &newFileName);
+
     void modifyTracksList(const DataTypes::ListTrackDataType &modifiedTracks, const QHash<QString, QUrl> &covers);
 
     void indexingStarted();
@@ -64,6 +66,8 @@ Q_SIGNALS:
 
     void askRestoredTracks();
 
+    void directoriesStateChanged(const DataTypes::DirectoriesStateType &modifiedDirectories, const QStringList &removedDirectories);
+
     void errorWatchingFileSystemChanges();
 
 public Q_SLOTS:
@@ -78,6 +82,8 @@ public Q_SLOTS:
 
     void restoredTracks(QHash<QUrl, QDateTime> allFiles);
 
+    void restoredDirectoriesState(const DataTypes::DirectoriesStateType &allDirectories);
+
     void setAllRootPaths(const QStringList &allRootPaths);
 
     void databaseFinishedInsertingTracksList();
@@ -90,6 +96,8 @@ protected Q_SLOTS:
 
     void fileChanged(const QString &modifiedFileName);
 
+    void fileMoved(const QString &oldFileName, const QString &newFileName);
+
 protected:
 
     virtual void executeInit(QHash<QUrl, QDateTime> allFiles);
@@ -102,8 +110,13 @@ protected:
 
     virtual DataTypes::TrackDataType scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo);
 
+    /* called from the scan worker threads by scanDirectory */
+    virtual DataTypes::TrackDataType scanOneFileMetaData(FileScanner &scanner, const QUrl &scanFile, const QFileInfo &scanFileInfo) const;
+
     void watchPath(const QString &pathName);
 
+    void watchFile(const QString &fileName);
+
     void addFileInDirectory(const QUrl &newFile, const QUrl &directoryName);
 
     void scanDirectoryTree(const QString &path);
@@ -122,6 +135,8 @@ protected:
 
     void checkFilesToRemove();
 
+    void checkDirectoriesToRemove();
+
     FileScanner& fileScanner();
 
     bool waitEndTrackRemoval() const;
@@ -132,6 +147,17 @@ protected:
 
 private:
 
+    void queueFileScan(DataTypes::ListTrackDataType &newFiles, const QUrl &scanFile, const QUrl &directory);
+
+    void collectFileScan(DataTypes::ListTrackDataType &newFiles);
+
+    bool scanUnchangedDirectory(DataTypes::ListTrackDataType &newFiles, const QUrl &path, const DataTypes::DirectoryState &currentState);
+
+    /* scans at once the directories changed since the last check, once the size of their files stopped changing */
+    void checkChangedDirectories();
+
+    void finishDirectoriesScan(DataTypes::ListTrackDataType &newFiles);
+
     std::unique_ptr<AbstractFileListingPrivate> d;
 
 };
@@ -0,0 +1,346 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "directorytree.h"
+
+#include <QHash>
+#include <QStringList>
+
+#include <vector>
+
+class DirectoryTreeNode
+{
+public:
+
+    enum NodeFlag {
+        IsFile = 0x1,
+        Listed = 0x2,
+    };
+
+    QString mName;
+
+    int mParent = DirectoryTree::InvalidNode;
+
+    int mFlags = 0;
+
+    int mListingReferences = 0;
+
+    QHash<QString, int> mChildren;
+
+    QSet<int> mListing;
+
+};
+
+class DirectoryTreePrivate
+{
+public:
+
+    DirectoryTreePrivate()
+    {
+        mNodes.emplace_back();
+    }
+
+    static constexpr int RootNode = 0;
+
+    std::vector<DirectoryTreeNode> mNodes;
+
+    std::vector<int> mFreeNodes;
+
+    QSet<QString> mNames;
+
+    int mListedDirectoriesCount = 0;
+
+    static QStringList splitPath(const QString &path)
+    {
+        auto result = QStringList{};
+
+        auto firstSeparator = path.indexOf(QLatin1Char('/'));
+        if (firstSeparator == -1) {
+            if (!path.isEmpty()) {
+                result.push_back(path);
+            }
+
+            return result;
+        }
+
+        result.push_back(path.left(firstSeparator + 1));
+        const auto otherComponents = path.midRef(firstSeparator + 1).split(QLatin1Char('/'), QString::SkipEmptyParts);
+        for (const auto &oneComponent : otherComponents) {
+            result.push_back(oneComponent.toString());
+        }
+
+        return result;
+    }
+
+    bool isValid(int node) const
+    {
+        return node > RootNode && node < static_cast<int>(mNodes.size()) && mNodes[node].mParent != DirectoryTree::InvalidNode;
+    }
+
+    const QString& internName(const QString &name)
+    {
+        return *mNames.insert(name);
+    }
+
+    int newNode(int parent, const QString &name)
+    {
+        auto node = DirectoryTree::InvalidNode;
+
+        if (mFreeNodes.empty()) {
+            node = static_cast<int>(mNodes.size());
+            mNodes.emplace_back();
+        } else {
+            node = mFreeNodes.back();
+            mFreeNodes.pop_back();
+        }
+
+        auto &currentNode = mNodes[node];
+        currentNode.mName = internName(name);
+        currentNode.mParent = parent;
+        currentNode.mFlags = 0;
+        currentNode.mListingReferences = 0;
+
+        mNodes[parent].mChildren.insert(currentNode.mName, node);
+
+        return node;
+    }
+
+    void pruneNode(int node)
+    {
+        while (isValid(node)) {
+            auto &currentNode = mNodes[node];
+
+            if ((currentNode.mFlags & DirectoryTreeNode::Listed) || currentNode.mListingReferences > 0 ||
+                    !currentNode.mChildren.isEmpty() || !currentNode.mListing.isEmpty()) {
+                return;
+            }
+
+            const auto parent = currentNode.mParent;
+
+            mNodes[parent].mChildren.remove(currentNode.mName);
+            currentNode = DirectoryTreeNode{};
+            mFreeNodes.push_back(node);
+
+            node = parent;
+        }
+    }
+
+};
+
+DirectoryTree::DirectoryTree() : d(std::make_unique<DirectoryTreePrivate>())
+{
+}
+
+DirectoryTree::~DirectoryTree()
+= default;
+
+int DirectoryTree::find(const QString &path) const
+{
+    auto node = static_cast<int>(DirectoryTreePrivate::RootNode);
+
+    const auto components = DirectoryTreePrivate::splitPath(path);
+    if (components.isEmpty()) {
+        return InvalidNode;
+    }
+
+    for (const auto &oneComponent : components) {
+        const auto &children = d->mNodes[node].mChildren;
+        const auto itChild = children.find(oneComponent);
+        if (itChild == children.end()) {
+            return InvalidNode;
+        }
+
+        node = *itChild;
+    }
+
+    return node;
+}
+
+int DirectoryTree::insert(const QString &path)
+{
+    auto node = static_cast<int>(DirectoryTreePrivate::RootNode);
+
+    const auto components = DirectoryTreePrivate::splitPath(path);
+    if (components.isEmpty()) {
+        return InvalidNode;
+    }
+
+    for (const auto &oneComponent : components) {
+        const auto &children = d->mNodes[node].mChildren;
+        const auto itChild = children.find(oneComponent);
+        if (itChild == children.end()) {
+            node = d->newNode(node, oneComponent);
+        } else {
+            node = *itChild;
+        }
+    }
+
+    return node;
+}
+
+QString DirectoryTree::path(int node) const
+{
+    if (!d->isValid(node)) {
+        return {};
+    }
+
+    auto components = QStringList{};
+    for (auto currentNode = node; currentNode != DirectoryTreePrivate::RootNode; currentNode = d->mNodes[currentNode].mParent) {
+        components.push_front(d->mNodes[currentNode].mName);
+    }
+
+    auto result = components.takeFirst();
+    if (!components.isEmpty()) {
+        result += components.join(QLatin1Char('/'));
+    }
+
+    return result;
+}
+
+QUrl DirectoryTree::url(int node) const
+{
+    return QUrl::fromLocalFile(path(node));
+}
+
+bool DirectoryTree::isListedDirectory(int node) const
+{
+    return d->isValid(node) && (d->mNodes[node].mFlags & DirectoryTreeNode::Listed);
+}
+
+bool DirectoryTree::isListedDirectory(const QString &path) const
+{
+    return isListedDirectory(find(path));
+}
+
+int DirectoryTree::listDirectory(const QString &path)
+{
+    const auto node = insert(path);
+    if (node == InvalidNode) {
+        return node;
+    }
+
+    auto &currentNode = d->mNodes[node];
+    if (!(currentNode.mFlags & DirectoryTreeNode::Listed)) {
+        currentNode.mFlags |= DirectoryTreeNode::Listed;
+        ++d->mListedDirectoriesCount;
+    }
+
+    return node;
+}
+
+const QSet<int>& DirectoryTree::entries(int directory) const
+{
+    static const QSet<int> noEntries;
+
+    if (!d->isValid(directory)) {
+        return noEntries;
+    }
+
+    return d->mNodes[directory].mListing;
+}
+
+bool DirectoryTree::hasEntry(int directory, int entry, bool isFile) const
+{
+    if (!d->isValid(directory) || !d->isValid(entry)) {
+        return false;
+    }
+
+    return d->mNodes[directory].mListing.contains(entry) && this->isFile(entry) == isFile;
+}
+
+void DirectoryTree::addEntry(int directory, int entry, bool isFile)
+{
+    if (!d->isValid(directory) || !d->isValid(entry)) {
+        return;
+    }
+
+    auto &entryNode = d->mNodes[entry];
+    if (isFile) {
+        entryNode.mFlags |= DirectoryTreeNode::IsFile;
+    } else {
+        entryNode.mFlags &= ~DirectoryTreeNode::IsFile;
+    }
+
+    auto &listing = d->mNodes[directory].mListing;
+    if (!listing.contains(entry)) {
+        listing.insert(entry);
+        ++entryNode.mListingReferences;
+    }
+}
+
+void DirectoryTree::removeEntry(int directory, int entry)
+{
+    if (!d->isValid(directory) || !d->isValid(entry)) {
+        return;
+    }
+
+    if (!d->mNodes[directory].mListing.remove(entry)) {
+        return;
+    }
+
+    --d->mNodes[entry].mListingReferences;
+    d->pruneNode(entry);
+}
+
+bool DirectoryTree::isFile(int node) const
+{
+    return d->isValid(node) && (d->mNodes[node].mFlags & DirectoryTreeNode::IsFile);
+}
+
+void DirectoryTree::removeDirectory(int directory, QList<QUrl> &allRemovedFiles)
+{
+    if (!isListedDirectory(directory)) {
+        return;
+    }
+
+    auto &directoryNode = d->mNodes[directory];
+    const auto listing = std::move(directoryNode.mListing);
+    directoryNode.mListing.clear();
+    directoryNode.mFlags &= ~DirectoryTreeNode::Listed;
+    --d->mListedDirectoriesCount;
+
+    for (const auto oneEntry : listing) {
+        removeFile(oneEntry, allRemovedFiles);
+        if (isFile(oneEntry)) {
+            allRemovedFiles.push_back(url(oneEntry));
+        }
+    }
+
+    for (const auto oneEntry : listing) {
+        --d->mNodes[oneEntry].mListingReferences;
+        d->pruneNode(oneEntry);
+    }
+
+    d->pruneNode(directory);
+}
+
+void DirectoryTree::removeFile(int entry, QList<QUrl> &allRemovedFiles)
+{
+    if (isListedDirectory(entry)) {
+        removeDirectory(entry, allRemovedFiles);
+    }
+}
+
+int DirectoryTree::nodesCount() const
+{
+    return static_cast<int>(d->mNodes.size() - d->mFreeNodes.size()) - 1;
+}
+
+int DirectoryTree::listedDirectoriesCount() const
+{
+    return d->mListedDirectoriesCount;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIRECTORYTREE_H
+#define DIRECTORYTREE_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QUrl>
+#include <QList>
+#include <QSet>
+
+#include <memory>
+
+class DirectoryTreePrivate;
+
+/* the directories seen by a file listing and the entries found in each of them
+ *
+ * each path is stored once as a node of a tree of interned path components, the nodes are designated by their index
+ */
+class ELISALIB_EXPORT DirectoryTree
+{
+public:
+
+    static constexpr int InvalidNode = -1;
+
+    DirectoryTree();
+
+    ~DirectoryTree();
+
+    int find(const QString &path) const;
+
+    int insert(const QString &path);
+
+    QString path(int node) const;
+
+    QUrl url(int node) const;
+
+    bool isListedDirectory(int node) const;
+
+    bool isListedDirectory(const QString &path) const;
+
+    int listDirectory(const QString &path);
+
+    const QSet<int>& entries(int directory) const;
+
+    bool hasEntry(int directory, int entry, bool isFile) const;
+
+    void addEntry(int directory, int entry, bool isFile);
+
+    void removeEntry(int directory, int entry);
+
+    bool isFile(int node) const;
+
+    void removeDirectory(int directory, QList<QUrl> &allRemovedFiles);
+
+    void removeFile(int entry, QList<QUrl> &allRemovedFiles);
+
+    int nodesCount() const;
+
+    int listedDirectoriesCount() const;
+
+private:
+
+    std::unique_ptr<DirectoryTreePrivate> d;
+
+};
+
+#endif // DIRECTORYTREE_H
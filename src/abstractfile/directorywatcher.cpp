@@ -0,0 +1,546 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "directorywatcher.h"
+
+#include "config-upnp-qt.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QPair>
+#include <QDir>
+#include <QTimer>
+#include <QFileSystemWatcher>
+
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+#include <QSocketNotifier>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include <algorithm>
+#include <utility>
+
+class PolledDirectory
+{
+public:
+
+    QDateTime mModifiedTime;
+
+    // writing to a file does not change the modification time of its directory
+    QHash<QString, QPair<QDateTime, qint64>> mFiles;
+
+};
+
+class DirectoryWatcherPrivate
+{
+public:
+
+    static constexpr int DefaultPollingInterval = 30000;
+
+    static PolledDirectory readDirectory(const QFileInfo &directoryInfo)
+    {
+        auto result = PolledDirectory{directoryInfo.lastModified(), {}};
+
+        const auto entryList = QDir(directoryInfo.filePath()).entryInfoList(QDir::NoDotAndDotDot | QDir::Files);
+        for (const auto &oneEntry : entryList) {
+            result.mFiles[oneEntry.fileName()] = {oneEntry.lastModified(), oneEntry.size()};
+        }
+
+        return result;
+    }
+
+    QHash<QString, PolledDirectory> mPolledDirectories;
+
+    // the timer, the notifier and the watcher are children of the watcher to follow it to the thread using it
+    QTimer *mPollingTimer = nullptr;
+
+    QFileSystemWatcher *mFileSystemWatcher = nullptr;
+
+    int mWatchesLimit = -1;
+
+    bool mWatchLimitReached = false;
+
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+    static constexpr uint32_t WatchMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_MODIFY | IN_CLOSE_WRITE |
+            IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+    int mInotifyDescriptor = -1;
+
+    QSocketNotifier *mInotifyNotifier = nullptr;
+
+    QHash<int, QString> mWatchedPaths;
+
+    QHash<QString, int> mWatchDescriptors;
+
+    // files written to and not yet closed, a file is reported once its writer is done with it
+    QSet<QString> mModifiedFiles;
+
+    static constexpr int PendingMoveTimeout = 500;
+
+    class PendingMove
+    {
+    public:
+
+        QString mPath;
+
+        QString mDirectory;
+
+        bool mIsDirectory = false;
+
+    };
+
+    // the two halves of a rename share a cookie and may come in two reads, a half still alone one read later
+    // moved from or to an unwatched directory
+    QHash<uint32_t, PendingMove> mPendingMoves;
+
+    QTimer *mPendingMovesTimer = nullptr;
+#endif
+
+    int watchesCount() const
+    {
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+        if (mInotifyDescriptor != -1) {
+            return mWatchDescriptors.size();
+        }
+#endif
+
+        return mFileSystemWatcher->directories().size();
+    }
+
+};
+
+DirectoryWatcher::DirectoryWatcher(QObject *parent) : QObject(parent), d(std::make_unique<DirectoryWatcherPrivate>())
+{
+    d->mPollingTimer = new QTimer(this);
+    d->mPollingTimer->setInterval(DirectoryWatcherPrivate::DefaultPollingInterval);
+    connect(d->mPollingTimer, &QTimer::timeout, this, &DirectoryWatcher::pollDirectories);
+
+    d->mFileSystemWatcher = new QFileSystemWatcher(this);
+    connect(d->mFileSystemWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &DirectoryWatcher::directoryChanged);
+    connect(d->mFileSystemWatcher, &QFileSystemWatcher::fileChanged,
+            this, &DirectoryWatcher::fileChanged);
+
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+    d->mInotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (d->mInotifyDescriptor == -1) {
+        qCDebug(orgKdeElisaIndexer) << "DirectoryWatcher::DirectoryWatcher" << "inotify is unavailable" << strerror(errno);
+        return;
+    }
+
+    d->mInotifyNotifier = new QSocketNotifier(d->mInotifyDescriptor, QSocketNotifier::Read, this);
+    connect(d->mInotifyNotifier, &QSocketNotifier::activated, this, &DirectoryWatcher::readEvents);
+
+    d->mPendingMovesTimer = new QTimer(this);
+    d->mPendingMovesTimer->setSingleShot(true);
+    d->mPendingMovesTimer->setInterval(DirectoryWatcherPrivate::PendingMoveTimeout);
+    connect(d->mPendingMovesTimer, &QTimer::timeout, this, &DirectoryWatcher::readEvents);
+#endif
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+    delete d->mInotifyNotifier;
+
+    if (d->mInotifyDescriptor != -1) {
+        close(d->mInotifyDescriptor);
+    }
+#endif
+}
+
+bool DirectoryWatcher::addDirectory(const QString &path)
+{
+    if (d->mPolledDirectories.contains(path)) {
+        return true;
+    }
+
+    const auto isBelowLimit = d->mWatchesLimit < 0 || d->watchesCount() < d->mWatchesLimit;
+
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+    if (d->mInotifyDescriptor != -1) {
+        if (d->mWatchDescriptors.contains(path)) {
+            return true;
+        }
+
+        if (isBelowLimit) {
+            const auto watchDescriptor = inotify_add_watch(d->mInotifyDescriptor, QFile::encodeName(path).constData(),
+                                                           DirectoryWatcherPrivate::WatchMask);
+
+            if (watchDescriptor != -1) {
+                // the same directory may already be watched under its previous name
+                d->mWatchDescriptors.remove(d->mWatchedPaths.value(watchDescriptor));
+                d->mWatchedPaths[watchDescriptor] = path;
+                d->mWatchDescriptors[path] = watchDescriptor;
+
+                return true;
+            }
+
+            if (errno != ENOSPC) {
+                qCDebug(orgKdeElisaIndexer) << "DirectoryWatcher::addDirectory" << path << strerror(errno);
+
+                return false;
+            }
+        }
+
+        return pollDirectory(path);
+    }
+#endif
+
+    if (d->mFileSystemWatcher->directories().contains(path)) {
+        return true;
+    }
+
+    if (isBelowLimit && d->mFileSystemWatcher->addPath(path)) {
+        return true;
+    }
+
+    return pollDirectory(path);
+}
+
+bool DirectoryWatcher::addFile(const QString &path)
+{
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+    if (d->mInotifyDescriptor != -1) {
+        return true;
+    }
+#endif
+
+    if (d->mPolledDirectories.contains(QFileInfo(path).path())) {
+        return true;
+    }
+
+    if (d->mFileSystemWatcher->files().contains(path)) {
+        return true;
+    }
+
+    return d->mFileSystemWatcher->addPath(path);
+}
+
+void DirectoryWatcher::removeDirectory(const QString &path)
+{
+    d->mPolledDirectories.remove(path);
+
+    if (d->mPolledDirectories.isEmpty()) {
+        d->mPollingTimer->stop();
+    }
+
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+    const auto itWatchDescriptor = d->mWatchDescriptors.find(path);
+    if (itWatchDescriptor != d->mWatchDescriptors.end()) {
+        inotify_rm_watch(d->mInotifyDescriptor, *itWatchDescriptor);
+
+        d->mWatchedPaths.remove(*itWatchDescriptor);
+        d->mWatchDescriptors.erase(itWatchDescriptor);
+    }
+#endif
+
+    if (d->mFileSystemWatcher->directories().contains(path)) {
+        d->mFileSystemWatcher->removePath(path);
+    }
+}
+
+QStringList DirectoryWatcher::directories() const
+{
+    auto result = d->mFileSystemWatcher->directories();
+
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+    result += d->mWatchDescriptors.keys();
+#endif
+
+    result += d->mPolledDirectories.keys();
+
+    return result;
+}
+
+QStringList DirectoryWatcher::polledDirectories() const
+{
+    return d->mPolledDirectories.keys();
+}
+
+void DirectoryWatcher::setWatchesLimit(int limit)
+{
+    d->mWatchesLimit = limit;
+}
+
+void DirectoryWatcher::setPollingInterval(int interval)
+{
+    d->mPollingTimer->setInterval(interval);
+}
+
+void DirectoryWatcher::readEvents()
+{
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+    auto changedDirectories = QStringList{};
+    auto changedFiles = QStringList{};
+    auto movedFiles = QList<std::pair<QString, QString>>{};
+
+    const auto previousPendingMoves = d->mPendingMoves.keys();
+
+    d->mPendingMovesTimer->stop();
+
+    auto addChangedPath = [](QStringList &paths, const QString &path) {
+        if (!paths.contains(path)) {
+            paths.push_back(path);
+        }
+    };
+
+    alignas(inotify_event) char buffer[16 * 1024];
+
+    while (true) {
+        const auto readBytes = read(d->mInotifyDescriptor, buffer, sizeof(buffer));
+
+        if (readBytes <= 0) {
+            if (readBytes == -1 && errno != EAGAIN && errno != EINTR) {
+                qCDebug(orgKdeElisaIndexer) << "DirectoryWatcher::readEvents" << strerror(errno);
+            }
+
+            break;
+        }
+
+        for (auto eventPosition = buffer; eventPosition < buffer + readBytes; ) {
+            const auto event = reinterpret_cast<const inotify_event*>(eventPosition);
+            eventPosition += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                qCDebug(orgKdeElisaIndexer) << "DirectoryWatcher::readEvents" << "events queue overflow";
+
+                for (const auto &oneDirectory : qAsConst(d->mWatchedPaths)) {
+                    addChangedPath(changedDirectories, oneDirectory);
+                }
+
+                continue;
+            }
+
+            const auto itWatchedPath = d->mWatchedPaths.find(event->wd);
+            if (itWatchedPath == d->mWatchedPaths.end()) {
+                continue;
+            }
+
+            const auto directoryPath = *itWatchedPath;
+
+            if (event->mask & IN_IGNORED) {
+                d->mWatchDescriptors.remove(directoryPath);
+                d->mWatchedPaths.erase(itWatchedPath);
+
+                continue;
+            }
+
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                addChangedPath(changedDirectories, directoryPath);
+
+                continue;
+            }
+
+            if (event->len == 0) {
+                continue;
+            }
+
+            const auto entryPath = directoryPath + QLatin1Char('/') + QFile::decodeName(event->name);
+            const auto isDirectory = (event->mask & IN_ISDIR) != 0;
+
+            if (event->mask & IN_MOVED_FROM) {
+                // the directory is reported with the other half, a rename must not be seen as a removal
+                d->mPendingMoves[event->cookie] = {entryPath, directoryPath, isDirectory};
+            } else if (event->mask & IN_MOVED_TO) {
+                addChangedPath(changedDirectories, directoryPath);
+
+                const auto itPendingMove = d->mPendingMoves.find(event->cookie);
+                if (itPendingMove != d->mPendingMoves.end()) {
+                    if (itPendingMove->mIsDirectory) {
+                        renameDirectories(itPendingMove->mPath, entryPath);
+                    }
+
+                    addChangedPath(changedDirectories, itPendingMove->mDirectory);
+                    movedFiles.push_back({itPendingMove->mPath, entryPath});
+                    d->mPendingMoves.erase(itPendingMove);
+                }
+            } else if (event->mask & (IN_CREATE | IN_DELETE)) {
+                d->mModifiedFiles.remove(entryPath);
+                addChangedPath(changedDirectories, directoryPath);
+            } else if ((event->mask & IN_MODIFY) && !isDirectory) {
+                d->mModifiedFiles.insert(entryPath);
+            } else if ((event->mask & IN_CLOSE_WRITE) && d->mModifiedFiles.remove(entryPath)) {
+                addChangedPath(changedFiles, entryPath);
+            }
+        }
+    }
+
+    for (const auto oneCookie : previousPendingMoves) {
+        const auto itPendingMove = d->mPendingMoves.find(oneCookie);
+        if (itPendingMove == d->mPendingMoves.end()) {
+            continue;
+        }
+
+        const auto oneMove = *itPendingMove;
+        d->mPendingMoves.erase(itPendingMove);
+
+        addChangedPath(changedDirectories, oneMove.mDirectory);
+
+        if (!oneMove.mIsDirectory) {
+            continue;
+        }
+
+        // directories moved out of the watched ones are still watched by the kernel under their old name
+        const auto removedDirectories = directories();
+        for (const auto &oneDirectory : removedDirectories) {
+            if (oneDirectory == oneMove.mPath || oneDirectory.startsWith(oneMove.mPath + QLatin1Char('/'))) {
+                removeDirectory(oneDirectory);
+            }
+        }
+    }
+
+    // the moves without their other half are done once no event came for a while
+    if (!d->mPendingMoves.isEmpty()) {
+        d->mPendingMovesTimer->start();
+    }
+
+    for (const auto &oneMove : qAsConst(movedFiles)) {
+        Q_EMIT fileMoved(oneMove.first, oneMove.second);
+    }
+
+    for (const auto &oneDirectory : qAsConst(changedDirectories)) {
+        Q_EMIT directoryChanged(oneDirectory);
+    }
+
+    for (const auto &oneFile : qAsConst(changedFiles)) {
+        Q_EMIT fileChanged(oneFile);
+    }
+#endif
+}
+
+void DirectoryWatcher::pollDirectories()
+{
+    auto changedDirectories = QStringList{};
+    auto changedFiles = QStringList{};
+
+    for (auto itDirectory = d->mPolledDirectories.begin(); itDirectory != d->mPolledDirectories.end(); ) {
+        const auto directoryInfo = QFileInfo(itDirectory.key());
+
+        if (!directoryInfo.isDir()) {
+            changedDirectories.push_back(itDirectory.key());
+            itDirectory = d->mPolledDirectories.erase(itDirectory);
+
+            continue;
+        }
+
+        auto currentState = DirectoryWatcherPrivate::readDirectory(directoryInfo);
+
+        if (currentState.mModifiedTime != itDirectory->mModifiedTime) {
+            changedDirectories.push_back(itDirectory.key());
+        } else {
+            for (auto itFile = currentState.mFiles.cbegin(); itFile != currentState.mFiles.cend(); ++itFile) {
+                if (itDirectory->mFiles.value(itFile.key()) != *itFile) {
+                    changedFiles.push_back(itDirectory.key() + QLatin1Char('/') + itFile.key());
+                }
+            }
+        }
+
+        *itDirectory = std::move(currentState);
+
+        ++itDirectory;
+    }
+
+    if (d->mPolledDirectories.isEmpty()) {
+        d->mPollingTimer->stop();
+    }
+
+    for (const auto &oneDirectory : qAsConst(changedDirectories)) {
+        Q_EMIT directoryChanged(oneDirectory);
+    }
+
+    for (const auto &oneFile : qAsConst(changedFiles)) {
+        Q_EMIT fileChanged(oneFile);
+    }
+}
+
+bool DirectoryWatcher::pollDirectory(const QString &path)
+{
+    const auto directoryInfo = QFileInfo(path);
+
+    if (!directoryInfo.isDir()) {
+        return false;
+    }
+
+    if (!d->mWatchLimitReached) {
+        qCInfo(orgKdeElisaIndexer) << "DirectoryWatcher::pollDirectory" << "limit of watches reached, polling new directories every"
+                                   << d->mPollingTimer->interval() << "ms";
+
+        d->mWatchLimitReached = true;
+        Q_EMIT watchLimitReached();
+    }
+
+    d->mPolledDirectories[path] = DirectoryWatcherPrivate::readDirectory(directoryInfo);
+
+    if (!d->mPollingTimer->isActive()) {
+        d->mPollingTimer->start();
+    }
+
+    return true;
+}
+
+void DirectoryWatcher::renameDirectories(const QString &oldPath, const QString &newPath)
+{
+    auto renamePath = [&oldPath, &newPath](const QString &path) {
+        if (path == oldPath) {
+            return newPath;
+        }
+
+        if (path.startsWith(oldPath + QLatin1Char('/'))) {
+            return newPath + path.mid(oldPath.size());
+        }
+
+        return QString{};
+    };
+
+#if defined HAVE_SYS_INOTIFY_H && HAVE_SYS_INOTIFY_H
+    for (auto itWatchedPath = d->mWatchedPaths.begin(); itWatchedPath != d->mWatchedPaths.end(); ++itWatchedPath) {
+        const auto renamedPath = renamePath(*itWatchedPath);
+        if (renamedPath.isEmpty()) {
+            continue;
+        }
+
+        d->mWatchDescriptors.remove(*itWatchedPath);
+        d->mWatchDescriptors[renamedPath] = itWatchedPath.key();
+        *itWatchedPath = renamedPath;
+    }
+#endif
+
+    const auto allPolledDirectories = d->mPolledDirectories.keys();
+    for (const auto &oneDirectory : allPolledDirectories) {
+        const auto renamedPath = renamePath(oneDirectory);
+        if (renamedPath.isEmpty()) {
+            continue;
+        }
+
+        d->mPolledDirectories[renamedPath] = d->mPolledDirectories.take(oneDirectory);
+    }
+}
+
+
+#include "moc_directorywatcher.cpp"
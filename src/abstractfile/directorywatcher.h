@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIRECTORYWATCHER_H
+#define DIRECTORYWATCHER_H
+
+#include "elisaLib_export.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+class DirectoryWatcherPrivate;
+
+/* watches the directories of a file listing and the files they contain
+ *
+ * uses inotify when available, one watch per directory then reports the changes of its files, other platforms
+ * also need one watch per file; directories beyond the watches limit are polled
+ */
+class ELISALIB_EXPORT DirectoryWatcher : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    explicit DirectoryWatcher(QObject *parent = nullptr);
+
+    ~DirectoryWatcher() override;
+
+    bool addDirectory(const QString &path);
+
+    void removeDirectory(const QString &path);
+
+    bool addFile(const QString &path);
+
+    QStringList directories() const;
+
+    QStringList polledDirectories() const;
+
+    void setWatchesLimit(int limit);
+
+    void setPollingInterval(int interval);
+
+Q_SIGNALS:
+
+    void directoryChanged(const QString &path);
+
+    void fileChanged(const QString &path);
+
+    void fileMoved(const QString &oldPath, const QString &newPath);
+
+    void watchLimitReached();
+
+private:
+
+    void readEvents();
+
+    void pollDirectories();
+
+    bool pollDirectory(const QString &path);
+
+    void renameDirectories(const QString &oldPath, const QString &newPath);
+
+    std::unique_ptr<DirectoryWatcherPrivate> d;
+
+};
+
+#endif // DIRECTORYWATCHER_H
@@ -465,4 +465,15 @@ DataTypes::TrackDataType LocalBalooFileListing::scanOneFile(const QUrl &scanFile
     return trackData;
 }
 
+DataTypes::TrackDataType LocalBalooFileListing::scanOneFileMetaData(FileScanner &scanner, const QUrl &scanFile, const QFileInfo &scanFileInfo) const
+{
+    auto trackData = scanner.scanOneBalooFile(scanFile, scanFileInfo);
+
+    if (!trackData.isValid()) {
+        trackData = AbstractFileListing::scanOneFileMetaData(scanner, scanFile, scanFileInfo);
+    }
+
+    return trackData;
+}
+
 #include "moc_localbaloofilelisting.cpp"
@@ -77,6 +77,8 @@ private:
 
     DataTypes::TrackDataType scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo) override;
 
+    DataTypes::TrackDataType scanOneFileMetaData(FileScanner &scanner, const QUrl &scanFile, const QFileInfo &scanFileInfo) const override;
+
     std::unique_ptr<LocalBalooFileListingPrivate> d;
 
 };
@@ -17,7 +17,10 @@
 
 #include "databaseinterface.h"
 
+#include "modelsnapshot.h"
+
 #include "databaseLogging.h"
+#include "databaseStatisticsLogging.h"
 
 #include <KI18n/KLocalizedString>
 
@@ -31,3874 +34,7752 @@
 
 #include <QDateTime>
 #include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QTimer>
+#include <QFileInfo>
+#include <QFile>
+#include <QLockFile>
 #include <QVariant>
+#include <QRegularExpression>
 #include <QAtomicInt>
+#include <QTextStream>
 #include <QElapsedTimer>
+#include <QMetaMethod>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 #include <QDebug>
 
-#include <algorithm>
+#if defined Q_OS_UNIX
+#include <unistd.h>
+#endif
 
-class DatabaseInterfacePrivate
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class DatabaseStatistics
 {
 public:
 
-    DatabaseInterfacePrivate(const QSqlDatabase &tracksDatabase)
-        : mTracksDatabase(tracksDatabase), mSelectAlbumQuery(mTracksDatabase),
-          mSelectTrackQuery(mTracksDatabase), mSelectAlbumIdFromTitleQuery(mTracksDatabase),
-          mInsertAlbumQuery(mTracksDatabase), mSelectTrackIdFromTitleAlbumIdArtistQuery(mTracksDatabase),
-          mInsertTrackQuery(mTracksDatabase), mSelectTracksFromArtist(mTracksDatabase),
-          mSelectTracksFromGenre(mTracksDatabase),
-          mSelectTrackFromIdQuery(mTracksDatabase), mSelectRadioFromIdQuery(mTracksDatabase),
-          mSelectCountAlbumsForArtistQuery(mTracksDatabase),
-          mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery(mTracksDatabase),
-          mSelectAllAlbumsFromArtistQuery(mTracksDatabase), mSelectAllArtistsQuery(mTracksDatabase),
-          mInsertArtistsQuery(mTracksDatabase), mSelectArtistByNameQuery(mTracksDatabase),
-          mSelectArtistQuery(mTracksDatabase), mUpdateTrackStatistics(mTracksDatabase),
-          mRemoveTrackQuery(mTracksDatabase), mRemoveAlbumQuery(mTracksDatabase),
-          mRemoveArtistQuery(mTracksDatabase), mSelectAllTracksQuery(mTracksDatabase),
-          mSelectAllRadiosQuery(mTracksDatabase),
-          mInsertTrackMapping(mTracksDatabase), mUpdateTrackFirstPlayStatistics(mTracksDatabase),
-          mInsertMusicSource(mTracksDatabase), mSelectMusicSource(mTracksDatabase),
-          mUpdateTrackPriority(mTracksDatabase), mUpdateTrackFileModifiedTime(mTracksDatabase),
-          mSelectTracksMapping(mTracksDatabase), mSelectTracksMappingPriority(mTracksDatabase),
-          mSelectRadioIdFromHttpAddress(mTracksDatabase),
-          mUpdateAlbumArtUriFromAlbumIdQuery(mTracksDatabase), mSelectTracksMappingPriorityByTrackId(mTracksDatabase),
-          mSelectAlbumIdsFromArtist(mTracksDatabase), mSelectAllTrackFilesQuery(mTracksDatabase),
-          mRemoveTracksMappingFromSource(mTracksDatabase), mRemoveTracksMapping(mTracksDatabase),
-          mSelectTracksWithoutMappingQuery(mTracksDatabase), mSelectAlbumIdFromTitleAndArtistQuery(mTracksDatabase),
-          mSelectAlbumIdFromTitleWithoutArtistQuery(mTracksDatabase),
-          mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery(mTracksDatabase), mSelectAlbumArtUriFromAlbumIdQuery(mTracksDatabase),
-          mInsertComposerQuery(mTracksDatabase), mSelectComposerByNameQuery(mTracksDatabase),
-          mSelectComposerQuery(mTracksDatabase), mInsertLyricistQuery(mTracksDatabase),
-          mSelectLyricistByNameQuery(mTracksDatabase), mSelectLyricistQuery(mTracksDatabase),
-          mInsertGenreQuery(mTracksDatabase), mSelectGenreByNameQuery(mTracksDatabase),
-          mSelectGenreQuery(mTracksDatabase), mSelectAllTracksShortQuery(mTracksDatabase),
-          mSelectAllAlbumsShortQuery(mTracksDatabase), mSelectAllComposersQuery(mTracksDatabase),
-          mSelectAllLyricistsQuery(mTracksDatabase), mSelectCountAlbumsForComposerQuery(mTracksDatabase),
-          mSelectCountAlbumsForLyricistQuery(mTracksDatabase), mSelectAllGenresQuery(mTracksDatabase),
-          mSelectGenreForArtistQuery(mTracksDatabase), mSelectGenreForAlbumQuery(mTracksDatabase),
-          mUpdateTrackQuery(mTracksDatabase), mUpdateAlbumArtistQuery(mTracksDatabase),
-          mUpdateRadioQuery(mTracksDatabase),
-          mUpdateAlbumArtistInTracksQuery(mTracksDatabase), mQueryMaximumTrackIdQuery(mTracksDatabase),
-          mQueryMaximumAlbumIdQuery(mTracksDatabase), mQueryMaximumArtistIdQuery(mTracksDatabase),
-          mQueryMaximumLyricistIdQuery(mTracksDatabase), mQueryMaximumComposerIdQuery(mTracksDatabase),
-          mQueryMaximumGenreIdQuery(mTracksDatabase), mSelectAllArtistsWithGenreFilterQuery(mTracksDatabase),
-          mSelectAllAlbumsShortWithGenreArtistFilterQuery(mTracksDatabase), mSelectAllAlbumsShortWithArtistFilterQuery(mTracksDatabase),
-          mSelectAllRecentlyPlayedTracksQuery(mTracksDatabase), mSelectAllFrequentlyPlayedTracksQuery(mTracksDatabase),
-          mClearTracksDataTable(mTracksDatabase), mClearTracksTable(mTracksDatabase),
-          mClearAlbumsTable(mTracksDatabase), mClearArtistsTable(mTracksDatabase),
-          mClearComposerTable(mTracksDatabase), mClearGenreTable(mTracksDatabase), mClearLyricistTable(mTracksDatabase),
-          mArtistMatchGenreQuery(mTracksDatabase), mSelectTrackIdQuery(mTracksDatabase),
-          mInsertRadioQuery(mTracksDatabase), mDeleteRadioQuery(mTracksDatabase),
-          mSelectTrackFromIdAndUrlQuery(mTracksDatabase),
-          mUpdateDatabaseVersionQuery(mTracksDatabase), mSelectDatabaseVersionQuery(mTracksDatabase)
+    struct Entry
     {
-    }
+        qint64 mCount = 0;
 
-    QSqlDatabase mTracksDatabase;
+        qint64 mTotalTime = 0;
 
-    QSqlQuery mSelectAlbumQuery;
+        qint64 mRows = 0;
+
+        std::vector<qint64> mSamples;
+
+        size_t mNextSample = 0;
+    };
+
+    bool isEnabled() const
+    {
+        return mEnabled.loadAcquire() == 1;
+    }
+
+    void setEnabled(bool enabled)
+    {
+        mEnabled.storeRelease(enabled ? 1 : 0);
+    }
 
-    QSqlQuery mSelectTrackQuery;
+    void addExecution(const QString &queryText, qint64 nanoseconds, qint64 rows)
+    {
+        QMutexLocker locker(&mMutex);
 
-    QSqlQuery mSelectAlbumIdFromTitleQuery;
+        auto &entry = mEntries[queryText];
 
-    QSqlQuery mInsertAlbumQuery;
+        ++entry.mCount;
+        entry.mTotalTime += nanoseconds;
+        entry.mRows += rows;
 
-    QSqlQuery mSelectTrackIdFromTitleAlbumIdArtistQuery;
+        if (entry.mSamples.size() < MaximumSamples) {
+            entry.mSamples.push_back(nanoseconds);
+        } else {
+            entry.mSamples[entry.mNextSample] = nanoseconds;
+            entry.mNextSample = (entry.mNextSample + 1) % MaximumSamples;
+        }
+    }
 
-    QSqlQuery mInsertTrackQuery;
+    void addRows(const QString &queryText, qint64 rows)
+    {
+        QMutexLocker locker(&mMutex);
 
-    QSqlQuery mSelectTracksFromArtist;
+        mEntries[queryText].mRows += rows;
+    }
 
-    QSqlQuery mSelectTracksFromGenre;
+    void transactionStarted()
+    {
+        QMutexLocker locker(&mMutex);
 
-    QSqlQuery mSelectTrackFromIdQuery;
+        mTransactionTimers[QThread::currentThread()].start();
+    }
 
-    QSqlQuery mSelectRadioFromIdQuery;
+    void transactionFinished()
+    {
+        auto nanoseconds = qint64{0};
 
-    QSqlQuery mSelectCountAlbumsForArtistQuery;
+        {
+            QMutexLocker locker(&mMutex);
 
-    QSqlQuery mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery;
+            auto itTimer = mTransactionTimers.find(QThread::currentThread());
+            if (itTimer == mTransactionTimers.end() || !itTimer->isValid()) {
+                return;
+            }
 
-    QSqlQuery mSelectAllAlbumsFromArtistQuery;
+            nanoseconds = itTimer->nsecsElapsed();
+            itTimer->invalidate();
+        }
 
-    QSqlQuery mSelectAllArtistsQuery;
+        addExecution(QStringLiteral("<transaction>"), nanoseconds, 0);
+    }
 
-    QSqlQuery mInsertArtistsQuery;
+    void reset()
+    {
+        QMutexLocker locker(&mMutex);
 
-    QSqlQuery mSelectArtistByNameQuery;
+        mEntries.clear();
+        mTransactionTimers.clear();
+    }
 
-    QSqlQuery mSelectArtistQuery;
+    QString report() const
+    {
+        auto sortedEntries = std::vector<std::pair<QString, Entry>>{};
 
-    QSqlQuery mUpdateTrackStatistics;
+        {
+            QMutexLocker locker(&mMutex);
 
-    QSqlQuery mRemoveTrackQuery;
+            sortedEntries.assign(mEntries.begin(), mEntries.end());
+        }
 
-    QSqlQuery mRemoveAlbumQuery;
+        std::sort(sortedEntries.begin(), sortedEntries.end(), [](const auto &left, const auto &right) {
+            return left.second.mTotalTime > right.second.mTotalTime;
+        });
 
-    QSqlQuery mRemoveArtistQuery;
+        auto result = QString{};
+        QTextStream reportStream(&result);
 
-    QSqlQuery mSelectAllTracksQuery;
+        reportStream << "count\ttotal ms\tp50 ms\tp95 ms\tp99 ms\trows\tstatement\n";
 
-    QSqlQuery mSelectAllRadiosQuery;
+        for (auto &oneEntry : sortedEntries) {
+            auto &samples = oneEntry.second.mSamples;
+            std::sort(samples.begin(), samples.end());
 
-    QSqlQuery mInsertTrackMapping;
+            const auto percentile = [&samples](int percent) {
+                return samples.empty() ? 0. : samples[(samples.size() - 1) * static_cast<size_t>(percent) / 100] / 1000000.;
+            };
 
-    QSqlQuery mUpdateTrackFirstPlayStatistics;
+            reportStream << oneEntry.second.mCount << '\t'
+                         << oneEntry.second.mTotalTime / 1000000. << '\t'
+                         << percentile(50) << '\t'
+                         << percentile(95) << '\t'
+                         << percentile(99) << '\t'
+                         << oneEntry.second.mRows << '\t'
+                         << oneEntry.first.simplified() << '\n';
+        }
 
-    QSqlQuery mInsertMusicSource;
+        return result;
+    }
 
-    QSqlQuery mSelectMusicSource;
+private:
 
-    QSqlQuery mUpdateTrackPriority;
+    static const size_t MaximumSamples = 1024;
 
-    QSqlQuery mUpdateTrackFileModifiedTime;
+    QAtomicInt mEnabled = 0;
 
-    QSqlQuery mSelectTracksMapping;
+    mutable QMutex mMutex;
 
-    QSqlQuery mSelectTracksMappingPriority;
+    std::map<QString, Entry> mEntries;
 
-    QSqlQuery mSelectRadioIdFromHttpAddress;
+    QHash<QThread*, QElapsedTimer> mTransactionTimers;
 
-    QSqlQuery mUpdateAlbumArtUriFromAlbumIdQuery;
+};
 
-    QSqlQuery mSelectTracksMappingPriorityByTrackId;
+class DatabaseStatementRegistry
+{
+public:
 
-    QSqlQuery mSelectAlbumIdsFromArtist;
+    explicit DatabaseStatementRegistry(const QSqlDatabase &database) : mDatabase(database)
+    {
+    }
 
-    QSqlQuery mSelectAllTrackFilesQuery;
+    bool prepare(QSqlQuery &query, const QString &queryText)
+    {
+        auto timer = QElapsedTimer{};
+        timer.start();
 
-    QSqlQuery mRemoveTracksMappingFromSource;
+        query.setForwardOnly(true);
+        auto result = query.prepare(queryText);
 
-    QSqlQuery mRemoveTracksMapping;
+        ++mPreparedCount;
+        mPrepareTime += timer.nsecsElapsed();
 
-    QSqlQuery mSelectTracksWithoutMappingQuery;
+        if (!result && mPrepareErrorHandler) {
+            mPrepareErrorHandler(query);
+        }
 
-    QSqlQuery mSelectAlbumIdFromTitleAndArtistQuery;
+        return result;
+    }
 
-    QSqlQuery mSelectAlbumIdFromTitleWithoutArtistQuery;
+    QSqlDatabase mDatabase;
 
-    QSqlQuery mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery;
+    std::function<void(const QSqlQuery&)> mPrepareErrorHandler;
 
-    QSqlQuery mSelectAlbumArtUriFromAlbumIdQuery;
+    DatabaseStatistics *mStatistics = nullptr;
 
-    QSqlQuery mInsertComposerQuery;
+    int mRegisteredCount = 0;
 
-    QSqlQuery mSelectComposerByNameQuery;
+    int mPreparedCount = 0;
 
-    QSqlQuery mSelectComposerQuery;
+    qint64 mPrepareTime = 0;
 
-    QSqlQuery mInsertLyricistQuery;
+};
 
-    QSqlQuery mSelectLyricistByNameQuery;
+/* the query text is recorded at init time but only prepared the first time the statement is used */
+class DatabaseStatement
+{
+public:
 
-    QSqlQuery mSelectLyricistQuery;
+    explicit DatabaseStatement(DatabaseStatementRegistry &registry) : mRegistry(registry), mQuery(registry.mDatabase)
+    {
+    }
 
-    QSqlQuery mInsertGenreQuery;
+    void setQueryText(const QString &queryText)
+    {
+        if (mQueryText.isEmpty()) {
+            ++mRegistry.mRegisteredCount;
+        }
 
-    QSqlQuery mSelectGenreByNameQuery;
+        mQueryText = queryText;
+        mIsPrepared = false;
+    }
 
-    QSqlQuery mSelectGenreQuery;
+    const QString &queryText() const
+    {
+        return mQueryText;
+    }
 
-    QSqlQuery mSelectAllTracksShortQuery;
+    QSqlQuery &query()
+    {
+        if (!mIsPrepared) {
+            mIsPrepared = true;
+            mRegistry.prepare(mQuery, mQueryText);
+        }
 
-    QSqlQuery mSelectAllAlbumsShortQuery;
+        return mQuery;
+    }
 
-    QSqlQuery mSelectAllComposersQuery;
+    operator QSqlQuery&()
+    {
+        return query();
+    }
 
-    QSqlQuery mSelectAllLyricistsQuery;
+    void bindValue(const QString &placeholder, const QVariant &value)
+    {
+        query().bindValue(placeholder, value);
+    }
 
-    QSqlQuery mSelectCountAlbumsForComposerQuery;
+    QMap<QString, QVariant> boundValues() const
+    {
+        return mQuery.boundValues();
+    }
 
-    QSqlQuery mSelectCountAlbumsForLyricistQuery;
+    void finish()
+    {
+        if (mRowsFetched != 0 && mRegistry.mStatistics && mRegistry.mStatistics->isEnabled()) {
+            mRegistry.mStatistics->addRows(mQueryText, mRowsFetched);
+        }
+        mRowsFetched = 0;
 
-    QSqlQuery mSelectAllGenresQuery;
+        mQuery.finish();
+    }
 
-    QSqlQuery mSelectGenreForArtistQuery;
+    bool isActive() const
+    {
+        return mQuery.isActive();
+    }
 
-    QSqlQuery mSelectGenreForAlbumQuery;
+    bool isSelect() const
+    {
+        return mQuery.isSelect();
+    }
 
-    QSqlQuery mUpdateTrackQuery;
+    QSqlError lastError() const
+    {
+        return mQuery.lastError();
+    }
 
-    QSqlQuery mUpdateAlbumArtistQuery;
+    QString lastQuery() const
+    {
+        return mQueryText;
+    }
 
-    QSqlQuery mUpdateRadioQuery;
+    bool next()
+    {
+        auto result = mQuery.next();
 
-    QSqlQuery mUpdateAlbumArtistInTracksQuery;
+        if (result) {
+            ++mRowsFetched;
+        }
 
-    QSqlQuery mQueryMaximumTrackIdQuery;
+        return result;
+    }
 
-    QSqlQuery mQueryMaximumAlbumIdQuery;
+    QSqlRecord record() const
+    {
+        return mQuery.record();
+    }
 
-    QSqlQuery mQueryMaximumArtistIdQuery;
+    QVariant value(int index) const
+    {
+        return mQuery.value(index);
+    }
 
-    QSqlQuery mQueryMaximumLyricistIdQuery;
+private:
 
-    QSqlQuery mQueryMaximumComposerIdQuery;
+    DatabaseStatementRegistry &mRegistry;
 
-    QSqlQuery mQueryMaximumGenreIdQuery;
+    QSqlQuery mQuery;
 
-    QSqlQuery mSelectAllArtistsWithGenreFilterQuery;
+    QString mQueryText;
 
-    QSqlQuery mSelectAllAlbumsShortWithGenreArtistFilterQuery;
+    qint64 mRowsFetched = 0;
 
-    QSqlQuery mSelectAllAlbumsShortWithArtistFilterQuery;
+    bool mIsPrepared = false;
 
-    QSqlQuery mSelectAllRecentlyPlayedTracksQuery;
+};
 
-    QSqlQuery mSelectAllFrequentlyPlayedTracksQuery;
+class DatabaseReadConnection
+{
+public:
 
-    QSqlQuery mClearTracksDataTable;
+    QString mConnectionName;
 
-    QSqlQuery mClearTracksTable;
+    QSqlDatabase mDatabase;
 
-    QSqlQuery mClearAlbumsTable;
+    std::unique_ptr<DatabaseStatementRegistry> mStatements;
 
-    QSqlQuery mClearArtistsTable;
+    std::unordered_map<const DatabaseStatement*, std::unique_ptr<DatabaseStatement>> mQueries;
 
-    QSqlQuery mClearComposerTable;
+    void close()
+    {
+        mQueries.clear();
+        mStatements.reset();
+        mDatabase.close();
+        mDatabase = QSqlDatabase{};
 
-    QSqlQuery mClearGenreTable;
+        QSqlDatabase::removeDatabase(mConnectionName);
+    }
 
-    QSqlQuery mClearLyricistTable;
+};
 
-    QSqlQuery mArtistMatchGenreQuery;
+/* shared with the reader threads: a connection is closed on its own thread when that thread finishes,
+ * even if the DatabaseInterface is already gone */
+class DatabaseReadConnections
+{
+public:
 
-    QSqlQuery mSelectTrackIdQuery;
+    void release(QThread *readerThread)
+    {
+        auto readConnection = std::shared_ptr<DatabaseReadConnection>{};
 
-    QSqlQuery mInsertRadioQuery;
+        {
+            QMutexLocker locker(&mMutex);
 
-    QSqlQuery mDeleteRadioQuery;
+            auto itConnection = mConnections.find(readerThread);
+            if (itConnection == mConnections.end()) {
+                return;
+            }
 
-    QSqlQuery mSelectTrackFromIdAndUrlQuery;
+            readConnection = itConnection.value();
+            mConnections.erase(itConnection);
+        }
 
-    QSqlQuery mUpdateDatabaseVersionQuery;
+        readConnection->close();
+    }
 
-    QSqlQuery mSelectDatabaseVersionQuery;
+    QMutex mMutex;
 
-    QSet<qulonglong> mModifiedTrackIds;
+    QHash<QThread*, std::shared_ptr<DatabaseReadConnection>> mConnections;
 
-    QSet<qulonglong> mModifiedAlbumIds;
+    int mOpenedCount = 0;
 
-    QSet<qulonglong> mModifiedArtistIds;
+};
 
-    QSet<qulonglong> mInsertedTracks;
+template <typename Key>
+class DatabaseIdCache
+{
+public:
 
-    QSet<qulonglong> mInsertedAlbums;
+    bool find(const Key &key, qulonglong &id)
+    {
+        auto itId = mIds.find(key);
 
-    QSet<qulonglong> mInsertedArtists;
+        if (itId == mIds.end()) {
+            ++mMisses;
+            return false;
+        }
 
-    qulonglong mAlbumId = 1;
+        ++mHits;
+        id = itId->second;
 
-    qulonglong mArtistId = 1;
+        return true;
+    }
 
-    qulonglong mComposerId = 1;
+    bool contains(const Key &key) const
+    {
+        return mIds.find(key) != mIds.end();
+    }
 
-    qulonglong mLyricistId = 1;
+    void insert(const Key &key, qulonglong id)
+    {
+        mIds[key] = id;
+    }
 
-    qulonglong mGenreId = 1;
+    void removeId(qulonglong id)
+    {
+        for (auto itId = mIds.begin(); itId != mIds.end(); ) {
+            if (itId->second == id) {
+                itId = mIds.erase(itId);
+            } else {
+                ++itId;
+            }
+        }
+    }
 
-    qulonglong mTrackId = 1;
+    void clear()
+    {
+        mIds.clear();
+    }
 
-    QAtomicInt mStopRequest = 0;
+    std::map<Key, qulonglong> mIds;
 
-    bool mInitFinished = false;
+    qulonglong mHits = 0;
 
-    bool mIsInBadState = false;
+    qulonglong mMisses = 0;
 
 };
 
-DatabaseInterface::DatabaseInterface(QObject *parent) : QObject(parent), d(nullptr)
+// built track records by id and URL (empty for lookups by id only), least recently used first to be evicted
+class TrackDataCache
 {
-}
+public:
 
-DatabaseInterface::~DatabaseInterface()
-{
-    if (d) {
-        d->mTracksDatabase.close();
-    }
-}
+    using Key = std::pair<qulonglong, QString>;
 
-void DatabaseInterface::init(const QString &dbName, const QString &databaseFileName)
-{
-    QSqlDatabase tracksDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), dbName);
+    quint64 epoch() const
+    {
+        QMutexLocker locker(&mMutex);
 
-    if (!databaseFileName.isEmpty()) {
-        tracksDatabase.setDatabaseName(QStringLiteral("file:") + databaseFileName);
-    } else {
-        tracksDatabase.setDatabaseName(QStringLiteral("file:memdb1?mode=memory"));
+        return mEpoch;
     }
-    tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;locking_mode = EXCLUSIVE;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
 
-    auto result = tracksDatabase.open();
-    if (result) {
-        qCDebug(orgKdeElisaDatabase) << "database open";
-    } else {
-        qCDebug(orgKdeElisaDatabase) << "database not open";
-    }
-    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::init" << (tracksDatabase.driver()->hasFeature(QSqlDriver::Transactions) ? "yes" : "no");
+    bool find(const Key &key, DataTypes::TrackDataType &track)
+    {
+        QMutexLocker locker(&mMutex);
 
-    tracksDatabase.exec(QStringLiteral("PRAGMA foreign_keys = ON;"));
+        auto itEntry = mEntries.find(key);
 
-    d = std::make_unique<DatabaseInterfacePrivate>(tracksDatabase);
+        if (itEntry == mEntries.end()) {
+            ++mMisses;
+            return false;
+        }
 
-    initDatabase();
-    initRequest();
+        ++mHits;
+        mRecentlyUsed.splice(mRecentlyUsed.begin(), mRecentlyUsed, itEntry->second.mPosition);
+        track = itEntry->second.mTrack;
 
-    if (!databaseFileName.isEmpty()) {
-        reloadExistingDatabase();
+        return true;
     }
-}
 
-qulonglong DatabaseInterface::albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath)
-{
-    auto result = qulonglong{0};
+    // records read before an invalidation (epoch has changed) may already be outdated and are not kept
+    void insert(const Key &key, const DataTypes::TrackDataType &track, quint64 epoch)
+    {
+        if (track.isEmpty()) {
+            return;
+        }
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+        const auto cost = trackCost(track);
 
-    result = internalAlbumIdFromTitleAndArtist(title, artist, albumPath);
+        QMutexLocker locker(&mMutex);
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+        if (epoch != mEpoch || cost > MaximumCost) {
+            return;
+        }
 
-    return result;
-}
+        auto itEntry = mEntries.find(key);
+        if (itEntry != mEntries.end()) {
+            removeEntry(itEntry);
+        }
 
-DataTypes::ListTrackDataType DatabaseInterface::allTracksData()
-{
-    auto result = DataTypes::ListTrackDataType{};
+        mRecentlyUsed.push_front(key);
+        mEntries.emplace(key, Entry{track, cost, mRecentlyUsed.begin()});
+        mCost += cost;
 
-    if (!d) {
-        return result;
+        while (mCost > MaximumCost) {
+            removeEntry(mEntries.find(mRecentlyUsed.back()));
+            ++mEvictions;
+        }
     }
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    void invalidateTracks(const QList<qulonglong> &trackIds)
+    {
+        QMutexLocker locker(&mMutex);
 
-    result = internalAllTracksPartialData();
+        ++mEpoch;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
+        for (auto oneTrackId : trackIds) {
+            auto itEntry = mEntries.lower_bound({oneTrackId, {}});
+
+            while (itEntry != mEntries.end() && itEntry->first.first == oneTrackId) {
+                itEntry = removeEntry(itEntry);
+                ++mInvalidations;
+            }
+        }
     }
 
-    return result;
-}
+    void invalidateAlbums(const QList<qulonglong> &albumIds)
+    {
+        QMutexLocker locker(&mMutex);
 
-DataTypes::ListRadioDataType DatabaseInterface::allRadiosData()
-{
-    auto result = DataTypes::ListRadioDataType{};
+        ++mEpoch;
 
-    if (!d) {
-        return result;
+        for (auto itEntry = mEntries.begin(); itEntry != mEntries.end(); ) {
+            if (albumIds.contains(itEntry->second.mTrack.albumId())) {
+                itEntry = removeEntry(itEntry);
+                ++mInvalidations;
+            } else {
+                ++itEntry;
+            }
+        }
     }
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    void clear()
+    {
+        QMutexLocker locker(&mMutex);
 
-    result = internalAllRadiosPartialData();
+        ++mEpoch;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
+        mEntries.clear();
+        mRecentlyUsed.clear();
+        mCost = 0;
     }
 
-    return result;
-}
+    QString report() const
+    {
+        QMutexLocker locker(&mMutex);
 
-DataTypes::ListTrackDataType DatabaseInterface::recentlyPlayedTracksData(int count)
-{
-    auto result = DataTypes::ListTrackDataType{};
+        const auto lookups = mHits + mMisses;
 
-    if (!d) {
-        return result;
+        return QStringLiteral("track cache: %1 hits %2 misses (%3%) %4 evictions %5 invalidations %6 entries %7 bytes")
+                .arg(mHits).arg(mMisses).arg(lookups ? 100 * mHits / lookups : 0)
+                .arg(mEvictions).arg(mInvalidations).arg(mEntries.size()).arg(mCost);
     }
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+private:
 
-    result = internalRecentlyPlayedTracksData(count);
+    struct Entry
+    {
+        DataTypes::TrackDataType mTrack;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+        size_t mCost = 0;
 
-    return result;
-}
+        std::list<Key>::iterator mPosition;
+    };
 
-DataTypes::ListTrackDataType DatabaseInterface::frequentlyPlayedTracksData(int count)
-{
-    auto result = DataTypes::ListTrackDataType{};
+    static size_t trackCost(const DataTypes::TrackDataType &track)
+    {
+        auto result = sizeof(Entry) + sizeof(Key) + DataTypes::TrackDataType::StoredRolesCount * sizeof(QVariant);
 
-    if (!d) {
-        return result;
-    }
+        for (auto itValue = track.constBegin(); itValue != track.constEnd(); ++itValue) {
+            switch (itValue.value().userType())
+            {
+            case QMetaType::QString:
+                result += static_cast<size_t>(itValue.value().toString().size()) * sizeof(QChar);
+                break;
+            case QMetaType::QUrl:
+                result += static_cast<size_t>(itValue.value().toUrl().toString().size()) * sizeof(QChar);
+                break;
+            default:
+                break;
+            }
+        }
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
         return result;
     }
 
-    result = internalFrequentlyPlayedTracksData(count);
+    std::map<Key, Entry>::iterator removeEntry(std::map<Key, Entry>::iterator itEntry)
+    {
+        mCost -= itEntry->second.mCost;
+        mRecentlyUsed.erase(itEntry->second.mPosition);
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
+        return mEntries.erase(itEntry);
     }
 
-    return result;
-}
+    static const size_t MaximumCost = 4 * 1024 * 1024;
 
-DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsData()
-{
-    auto result = DataTypes::ListAlbumDataType{};
+    std::map<Key, Entry> mEntries;
 
-    if (!d) {
-        return result;
-    }
+    std::list<Key> mRecentlyUsed;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    size_t mCost = 0;
 
-    result = internalAllAlbumsPartialData(d->mSelectAllAlbumsShortQuery);
+    quint64 mEpoch = 0;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    qulonglong mHits = 0;
 
-    return result;
-}
+    qulonglong mMisses = 0;
 
-DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsDataByGenreAndArtist(const QString &genre, const QString &artist)
-{
-    auto result = DataTypes::ListAlbumDataType{};
+    qulonglong mEvictions = 0;
 
-    if (!d) {
-        return result;
-    }
+    qulonglong mInvalidations = 0;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    mutable QMutex mMutex;
 
-    d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.bindValue(QStringLiteral(":artistFilter"), artist);
-    d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.bindValue(QStringLiteral(":genreFilter"), genre);
+};
 
-    result = internalAllAlbumsPartialData(d->mSelectAllAlbumsShortWithGenreArtistFilterQuery);
+struct PendingPlayStatistics
+{
+    QDateTime mFirstPlayTime;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    QDateTime mLastPlayTime;
 
-    return result;
-}
+    int mPlayCount = 0;
+};
 
-DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsDataByArtist(const QString &artist)
+class DatabaseInterfacePrivate
 {
-    auto result = DataTypes::ListAlbumDataType{};
+public:
 
-    if (!d) {
-        return result;
+    DatabaseInterfacePrivate(const QSqlDatabase &tracksDatabase)
+        : mTracksDatabase(tracksDatabase), mStatements(mTracksDatabase),
+          mSelectAlbumQuery(mStatements),
+          mSelectTrackQuery(mStatements), mSelectAlbumIdFromTitleQuery(mStatements),
+          mInsertAlbumQuery(mStatements), mSelectTrackIdFromTitleAlbumIdArtistQuery(mStatements),
+          mInsertTrackQuery(mStatements), mSelectTracksFromArtist(mStatements),
+          mSelectTracksFromGenre(mStatements),
+          mSelectTrackFromIdQuery(mStatements), mSelectRadioFromIdQuery(mStatements),
+          mSelectCountAlbumsForArtistQuery(mStatements),
+          mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery(mStatements),
+          mSelectAllAlbumsFromArtistQuery(mStatements), mSelectAllArtistsQuery(mStatements),
+          mInsertArtistsQuery(mStatements), mSelectArtistByNameQuery(mStatements),
+          mSelectArtistQuery(mStatements), mUpdateTrackStatistics(mStatements),
+          mRemoveTrackQuery(mStatements), mRemoveAlbumQuery(mStatements),
+          mRemoveArtistQuery(mStatements), mSelectAllTracksQuery(mStatements),
+          mSelectTracksPageQuery(mStatements), mSelectAlbumsShortPageQuery(mStatements),
+          mSelectAllRadiosQuery(mStatements),
+          mInsertDirectory(mStatements),
+          mInsertTrackMapping(mStatements), mUpdateTrackFirstPlayStatistics(mStatements),
+          mInsertMusicSource(mStatements), mSelectMusicSource(mStatements),
+          mUpdateTrackPriority(mStatements), mUpdateTrackFileModifiedTime(mStatements),
+          mSelectTracksMapping(mStatements), mSelectTracksMappingPriority(mStatements),
+          mSelectRadioIdFromHttpAddress(mStatements),
+          mUpdateAlbumArtUriFromAlbumIdQuery(mStatements), mSelectTracksMappingPriorityByTrackId(mStatements),
+          mSelectAlbumIdsFromArtist(mStatements), mSelectAllTrackFilesQuery(mStatements),
+          mRemoveTracksMappingFromSource(mStatements), mRemoveTracksMapping(mStatements),
+          mRemoveUnusedDirectory(mStatements), mUpdateTrackFileNameQuery(mStatements),
+          mSelectTracksWithoutMappingQuery(mStatements), mSelectAlbumIdFromTitleAndArtistQuery(mStatements),
+          mSelectAlbumIdFromTitleWithoutArtistQuery(mStatements),
+          mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery(mStatements), mSelectAlbumArtUriFromAlbumIdQuery(mStatements),
+          mInsertComposerQuery(mStatements), mSelectComposerByNameQuery(mStatements),
+          mSelectComposerQuery(mStatements), mInsertLyricistQuery(mStatements),
+          mSelectLyricistByNameQuery(mStatements), mSelectLyricistQuery(mStatements),
+          mInsertGenreQuery(mStatements), mSelectGenreByNameQuery(mStatements),
+          mSelectGenreQuery(mStatements), mSelectAllTracksShortQuery(mStatements),
+          mSelectAllAlbumsShortQuery(mStatements), mSelectAllComposersQuery(mStatements),
+          mSelectAllLyricistsQuery(mStatements), mSelectCountAlbumsForComposerQuery(mStatements),
+          mSelectCountAlbumsForLyricistQuery(mStatements), mSelectAllGenresQuery(mStatements),
+          mSelectGenreForArtistQuery(mStatements), mSelectGenreForAlbumQuery(mStatements),
+          mUpdateTrackQuery(mStatements), mUpdateAlbumArtistQuery(mStatements),
+          mUpdateRadioQuery(mStatements),
+          mUpdateAlbumArtistInTracksQuery(mStatements), mQueryMaximumTrackIdQuery(mStatements),
+          mQueryMaximumAlbumIdQuery(mStatements), mQueryMaximumArtistIdQuery(mStatements),
+          mQueryMaximumLyricistIdQuery(mStatements), mQueryMaximumComposerIdQuery(mStatements),
+          mQueryMaximumGenreIdQuery(mStatements), mSelectAllArtistsWithGenreFilterQuery(mStatements),
+          mSelectAllAlbumsShortWithGenreArtistFilterQuery(mStatements), mSelectAllAlbumsShortWithArtistFilterQuery(mStatements),
+          mSelectAllRecentlyPlayedTracksQuery(mStatements), mSelectAllFrequentlyPlayedTracksQuery(mStatements),
+          mClearTracksDataTable(mStatements), mClearDirectoriesTable(mStatements), mClearTracksTable(mStatements),
+          mClearAlbumsTable(mStatements), mClearArtistsTable(mStatements),
+          mClearComposerTable(mStatements), mClearGenreTable(mStatements), mClearLyricistTable(mStatements),
+          mArtistMatchGenreQuery(mStatements), mSelectTrackIdQuery(mStatements),
+          mInsertRadioQuery(mStatements), mDeleteRadioQuery(mStatements),
+          mSelectTrackFromIdAndUrlQuery(mStatements),
+          mUpdateDatabaseVersionQuery(mStatements), mSelectDatabaseVersionQuery(mStatements),
+          mInsertTrackSearchQuery(mStatements), mRemoveTrackSearchQuery(mStatements),
+          mInsertAlbumSearchQuery(mStatements), mRemoveAlbumSearchQuery(mStatements),
+          mSearchTracksQuery(mStatements), mSearchAlbumsQuery(mStatements),
+          mInsertAlbumSummaryQuery(mStatements), mRemoveAlbumSummaryQuery(mStatements),
+          mUpdateGenerationQuery(mStatements), mInsertTrackPlayScoreQuery(mStatements),
+          mUpdateTrackPlayScoreQuery(mStatements), mSelectGenerationQuery(mStatements),
+          mSelectDataVersionQuery(mStatements), mInsertChangesJournalQuery(mStatements),
+          mPruneChangesJournalQuery(mStatements), mSelectChangesJournalQuery(mStatements),
+          mSelectAllDirectoriesStateQuery(mStatements), mInsertDirectoryStateQuery(mStatements),
+          mRemoveDirectoryStateQuery(mStatements), mClearDirectoriesStateQuery(mStatements),
+          mUpdatePlayStatisticsSequenceQuery(mStatements)
+    {
+    }
+
+    static std::pair<QString, QString> splitFileName(const QString &fileName)
+    {
+        const auto baseNameIndex = fileName.lastIndexOf(QLatin1Char('/')) + 1;
+
+        return {fileName.left(baseNameIndex), fileName.mid(baseNameIndex)};
+    }
+
+    static void bindFileName(DatabaseStatement &statement, const QUrl &fileName)
+    {
+        const auto &[directory, baseName] = splitFileName(fileName.toString());
+
+        statement.bindValue(QStringLiteral(":directory"), directory);
+        statement.bindValue(QStringLiteral(":baseName"), baseName);
+    }
+
+    static bool syncFile(QFile &file)
+    {
+        if (!file.flush()) {
+            return false;
+        }
+
+#if defined Q_OS_UNIX
+        return ::fsync(file.handle()) == 0;
+#else
+        return true;
+#endif
     }
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    QSqlDatabase mTracksDatabase;
 
-    d->mSelectAllAlbumsShortWithArtistFilterQuery.bindValue(QStringLiteral(":artistFilter"), artist);
+    QString mConnectionName;
 
-    result = internalAllAlbumsPartialData(d->mSelectAllAlbumsShortWithArtistFilterQuery);
+    QString mDatabaseFileName;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    QThread *mWriterThread = nullptr;
 
-    return result;
-}
+    std::shared_ptr<DatabaseReadConnections> mReadConnections = std::make_shared<DatabaseReadConnections>();
 
-DataTypes::AlbumDataType DatabaseInterface::albumDataFromDatabaseId(qulonglong id)
-{
-    auto result = DataTypes::AlbumDataType{};
+    DatabaseStatistics mStatistics;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatementRegistry mStatements;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mSelectAlbumQuery;
 
-    result = internalOneAlbumPartialData(id);
+    DatabaseStatement mSelectTrackQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mSelectAlbumIdFromTitleQuery;
 
-    return result;
-}
+    DatabaseStatement mInsertAlbumQuery;
 
-DataTypes::ListTrackDataType DatabaseInterface::albumData(qulonglong databaseId)
-{
-    auto result = DataTypes::ListTrackDataType{};
+    DatabaseStatement mSelectTrackIdFromTitleAlbumIdArtistQuery;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mInsertTrackQuery;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mSelectTracksFromArtist;
 
-    d->mSelectTrackQuery.bindValue(QStringLiteral(":albumId"), databaseId);
+    DatabaseStatement mSelectTracksFromGenre;
 
-    auto queryResult = execQuery(d->mSelectTrackQuery);
+    DatabaseStatement mSelectTrackFromIdQuery;
 
-    if (!queryResult || !d->mSelectTrackQuery.isSelect() || !d->mSelectTrackQuery.isActive()) {
-        Q_EMIT databaseError();
+    DatabaseStatement mSelectRadioFromIdQuery;
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::albumData" << d->mSelectTrackQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::albumData" << d->mSelectTrackQuery.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::albumData" << d->mSelectTrackQuery.lastError();
-    }
+    DatabaseStatement mSelectCountAlbumsForArtistQuery;
 
-    while (d->mSelectTrackQuery.next()) {
-        const auto &currentRecord = d->mSelectTrackQuery.record();
+    DatabaseStatement mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery;
 
-        result.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
-    }
+    DatabaseStatement mSelectAllAlbumsFromArtistQuery;
 
-    d->mSelectTrackQuery.finish();
+    DatabaseStatement mSelectAllArtistsQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mInsertArtistsQuery;
 
-    return result;
-}
+    DatabaseStatement mSelectArtistByNameQuery;
 
-DataTypes::ListArtistDataType DatabaseInterface::allArtistsData()
-{
-    auto result = DataTypes::ListArtistDataType{};
+    DatabaseStatement mSelectArtistQuery;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mUpdateTrackStatistics;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mRemoveTrackQuery;
 
-    result = internalAllArtistsPartialData(d->mSelectAllArtistsQuery);
+    DatabaseStatement mRemoveAlbumQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mRemoveArtistQuery;
 
-    return result;
-}
+    DatabaseStatement mSelectAllTracksQuery;
 
-DataTypes::ListArtistDataType DatabaseInterface::allArtistsDataByGenre(const QString &genre)
-{
-    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::allArtistsDataByGenre" << genre;
+    DatabaseStatement mSelectTracksPageQuery;
 
-    auto result = DataTypes::ListArtistDataType{};
+    DatabaseStatement mSelectAlbumsShortPageQuery;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mSelectAllRadiosQuery;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mInsertDirectory;
 
-    d->mSelectAllArtistsWithGenreFilterQuery.bindValue(QStringLiteral(":genreFilter"), genre);
+    DatabaseStatement mInsertTrackMapping;
 
-    result = internalAllArtistsPartialData(d->mSelectAllArtistsWithGenreFilterQuery);
+    DatabaseStatement mUpdateTrackFirstPlayStatistics;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mInsertMusicSource;
 
-    return result;
-}
+    DatabaseStatement mSelectMusicSource;
 
-DataTypes::ListGenreDataType DatabaseInterface::allGenresData()
-{
-    auto result = DataTypes::ListGenreDataType{};
+    DatabaseStatement mUpdateTrackPriority;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mUpdateTrackFileModifiedTime;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mSelectTracksMapping;
 
-    result = internalAllGenresPartialData();
+    DatabaseStatement mSelectTracksMappingPriority;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mSelectRadioIdFromHttpAddress;
 
-    return result;
-}
+    DatabaseStatement mUpdateAlbumArtUriFromAlbumIdQuery;
 
-bool DatabaseInterface::internalArtistMatchGenre(qulonglong databaseId, const QString &genre)
-{
-    auto result = true;
+    DatabaseStatement mSelectTracksMappingPriorityByTrackId;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mSelectAlbumIdsFromArtist;
 
-    d->mArtistMatchGenreQuery.bindValue(QStringLiteral(":databaseId"), databaseId);
-    d->mArtistMatchGenreQuery.bindValue(QStringLiteral(":genreFilter"), genre);
+    DatabaseStatement mSelectAllTrackFilesQuery;
 
-    auto queryResult = execQuery(d->mArtistMatchGenreQuery);
+    DatabaseStatement mRemoveTracksMappingFromSource;
 
-    if (!queryResult || !d->mArtistMatchGenreQuery.isSelect() || !d->mArtistMatchGenreQuery.isActive()) {
-        Q_EMIT databaseError();
+    DatabaseStatement mRemoveTracksMapping;
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::artistMatchGenre" << d->mArtistMatchGenreQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::artistMatchGenre" << d->mArtistMatchGenreQuery.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::artistMatchGenre" << d->mArtistMatchGenreQuery.lastError();
+    DatabaseStatement mRemoveUnusedDirectory;
 
-        d->mArtistMatchGenreQuery.finish();
+    DatabaseStatement mUpdateTrackFileNameQuery;
 
-        auto transactionResult = finishTransaction();
-        if (!transactionResult) {
-            return result;
-        }
+    DatabaseStatement mSelectTracksWithoutMappingQuery;
 
-        return result;
-    }
+    DatabaseStatement mSelectAlbumIdFromTitleAndArtistQuery;
 
-    result = d->mArtistMatchGenreQuery.next();
+    DatabaseStatement mSelectAlbumIdFromTitleWithoutArtistQuery;
 
-    d->mArtistMatchGenreQuery.finish();
+    DatabaseStatement mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery;
 
-    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalArtistMatchGenre" << databaseId << (result ? "match" : "does not match");
+    DatabaseStatement mSelectAlbumArtUriFromAlbumIdQuery;
 
-    return result;
-}
+    DatabaseStatement mInsertComposerQuery;
 
-DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromAuthor(const QString &ArtistName)
-{
-    auto allTracks = DataTypes::ListTrackDataType{};
+    DatabaseStatement mSelectComposerByNameQuery;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return allTracks;
-    }
+    DatabaseStatement mSelectComposerQuery;
 
-    allTracks = internalTracksFromAuthor(ArtistName);
+    DatabaseStatement mInsertLyricistQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return allTracks;
-    }
+    DatabaseStatement mSelectLyricistByNameQuery;
 
-    return allTracks;
-}
+    DatabaseStatement mSelectLyricistQuery;
 
-DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromGenre(const QString &genre)
-{
-    auto allTracks = DataTypes::ListTrackDataType{};
+    DatabaseStatement mInsertGenreQuery;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return allTracks;
-    }
+    DatabaseStatement mSelectGenreByNameQuery;
 
-    allTracks = internalTracksFromGenre(genre);
+    DatabaseStatement mSelectGenreQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return allTracks;
-    }
+    DatabaseStatement mSelectAllTracksShortQuery;
 
-    return allTracks;
-}
-DataTypes::TrackDataType DatabaseInterface::trackDataFromDatabaseId(qulonglong id)
-{
-    auto result = DataTypes::TrackDataType();
+    DatabaseStatement mSelectAllAlbumsShortQuery;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mSelectAllComposersQuery;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mSelectAllLyricistsQuery;
 
-    result = internalOneTrackPartialData(id);
+    DatabaseStatement mSelectCountAlbumsForComposerQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mSelectCountAlbumsForLyricistQuery;
 
-    return result;
-}
+    DatabaseStatement mSelectAllGenresQuery;
 
-DataTypes::TrackDataType DatabaseInterface::trackDataFromDatabaseIdAndUrl(qulonglong id, const QUrl &trackUrl)
-{
-    auto result = DataTypes::TrackDataType();
+    DatabaseStatement mSelectGenreForArtistQuery;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mSelectGenreForAlbumQuery;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mUpdateTrackQuery;
 
-    result = internalOneTrackPartialDataByIdAndUrl(id, trackUrl);
+    DatabaseStatement mUpdateAlbumArtistQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mUpdateRadioQuery;
 
-    return result;
-}
+    DatabaseStatement mUpdateAlbumArtistInTracksQuery;
 
-DataTypes::TrackDataType DatabaseInterface::radioDataFromDatabaseId(qulonglong id)
-{
-    auto result = DataTypes::TrackDataType();
+    DatabaseStatement mQueryMaximumTrackIdQuery;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mQueryMaximumAlbumIdQuery;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mQueryMaximumArtistIdQuery;
 
-    result = internalOneRadioPartialData(id);
+    DatabaseStatement mQueryMaximumLyricistIdQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mQueryMaximumComposerIdQuery;
 
-    return result;
-}
+    DatabaseStatement mQueryMaximumGenreIdQuery;
 
-qulonglong DatabaseInterface::trackIdFromTitleAlbumTrackDiscNumber(const QString &title, const QString &artist, const std::optional<QString> &album,
-                                                                     std::optional<int> trackNumber, std::optional<int> discNumber)
-{
-    auto result = qulonglong(0);
+    DatabaseStatement mSelectAllArtistsWithGenreFilterQuery;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mSelectAllAlbumsShortWithGenreArtistFilterQuery;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mSelectAllAlbumsShortWithArtistFilterQuery;
 
-    result = internalTrackIdFromTitleAlbumTracDiscNumber(title, artist, album, trackNumber, discNumber);
+    DatabaseStatement mSelectAllRecentlyPlayedTracksQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mSelectAllFrequentlyPlayedTracksQuery;
 
-    return result;
-}
+    DatabaseStatement mClearTracksDataTable;
 
-qulonglong DatabaseInterface::trackIdFromFileName(const QUrl &fileName)
-{
-    auto result = qulonglong(0);
+    DatabaseStatement mClearDirectoriesTable;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mClearTracksTable;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mClearAlbumsTable;
 
-    result = internalTrackIdFromFileName(fileName);
+    DatabaseStatement mClearArtistsTable;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mClearComposerTable;
 
-    return result;
-}
+    DatabaseStatement mClearGenreTable;
 
-qulonglong DatabaseInterface::radioIdFromFileName(const QUrl &fileName)
-{
-    auto result = qulonglong(0);
+    DatabaseStatement mClearLyricistTable;
 
-    if (!d) {
-        return result;
-    }
+    DatabaseStatement mArtistMatchGenreQuery;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mSelectTrackIdQuery;
 
-    result = internalRadioIdFromHttpAddress(fileName.toString());
+    DatabaseStatement mInsertRadioQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
+    DatabaseStatement mDeleteRadioQuery;
 
-    return result;
-}
+    DatabaseStatement mSelectTrackFromIdAndUrlQuery;
 
-void DatabaseInterface::applicationAboutToQuit()
-{
-    d->mStopRequest = 1;
-}
+    DatabaseStatement mUpdateDatabaseVersionQuery;
 
-void DatabaseInterface::askRestoredTracks()
-{
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return;
-    }
+    DatabaseStatement mSelectDatabaseVersionQuery;
 
-    auto result = internalAllFileName();
+    DatabaseStatement mInsertTrackSearchQuery;
 
-    Q_EMIT restoredTracks(result);
+    DatabaseStatement mRemoveTrackSearchQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return;
-    }
-}
+    DatabaseStatement mInsertAlbumSearchQuery;
 
-void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time)
-{
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return;
-    }
+    DatabaseStatement mRemoveAlbumSearchQuery;
 
-    updateTrackStatistics(fileName, time);
-    auto trackId = internalTrackIdFromFileName(fileName);
-    if (trackId != 0) {
-        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
-    }
+    DatabaseStatement mSearchTracksQuery;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return;
-    }
-}
+    DatabaseStatement mSearchAlbumsQuery;
 
-void DatabaseInterface::clearData()
-{
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return;
-    }
+    bool mHasSearchIndex = false;
 
-    auto queryResult = execQuery(d->mClearTracksTable);
+    DatabaseStatement mInsertAlbumSummaryQuery;
 
-    if (!queryResult || !d->mClearTracksTable.isActive()) {
-        Q_EMIT databaseError();
+    DatabaseStatement mRemoveAlbumSummaryQuery;
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastError();
-    }
+    DatabaseStatement mUpdateGenerationQuery;
 
-    d->mClearTracksTable.finish();
+    DatabaseStatement mSelectGenerationQuery;
 
-    queryResult = execQuery(d->mClearTracksDataTable);
+    DatabaseStatement mSelectDataVersionQuery;
 
-    if (!queryResult || !d->mClearTracksDataTable.isActive()) {
-        Q_EMIT databaseError();
+    DatabaseStatement mInsertChangesJournalQuery;
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.lastError();
-    }
+    DatabaseStatement mPruneChangesJournalQuery;
 
-    d->mClearTracksDataTable.finish();
+    DatabaseStatement mSelectChangesJournalQuery;
 
-    queryResult = execQuery(d->mClearAlbumsTable);
+    DatabaseStatement mSelectAllDirectoriesStateQuery;
 
-    if (!queryResult || !d->mClearAlbumsTable.isActive()) {
-        Q_EMIT databaseError();
+    DatabaseStatement mInsertDirectoryStateQuery;
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastError();
-    }
+    DatabaseStatement mRemoveDirectoryStateQuery;
 
-    d->mClearAlbumsTable.finish();
+    DatabaseStatement mClearDirectoriesStateQuery;
 
-    queryResult = execQuery(d->mClearComposerTable);
+    DatabaseStatement mUpdatePlayStatisticsSequenceQuery;
 
-    if (!queryResult || !d->mClearComposerTable.isActive()) {
-        Q_EMIT databaseError();
+    DatabaseStatement mInsertTrackPlayScoreQuery;
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.lastError();
-    }
+    DatabaseStatement mUpdateTrackPlayScoreQuery;
 
-    d->mClearComposerTable.finish();
+    qint64 mPlayScoreReference = 0;
 
-    queryResult = execQuery(d->mClearLyricistTable);
+    QAtomicInteger<qulonglong> mGeneration = 0;
 
-    if (!queryResult || !d->mClearLyricistTable.isActive()) {
-        Q_EMIT databaseError();
+    QTimer mSnapshotTimer;
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearLyricistTable.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearLyricistTable.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearLyricistTable.lastError();
-    }
+    bool mModelSnapshotOutdated = false;
 
-    d->mClearLyricistTable.finish();
+    // the snapshot is read on a reader connection, the database thread keeps writing meanwhile
+    QFutureWatcher<bool> mModelSnapshotWatcher;
 
-    queryResult = execQuery(d->mClearGenreTable);
+    enum ChangesJournalKind {
+        AddedTrackChange,
+        ModifiedTrackChange,
+        RemovedTrackChange,
+        AddedAlbumChange,
+        ModifiedAlbumChange,
+        RemovedAlbumChange,
+        AddedArtistChange,
+        RemovedArtistChange,
+        ClearedDatabaseChange,
+    };
 
-    if (!queryResult || !d->mClearGenreTable.isActive()) {
-        Q_EMIT databaseError();
+    QTimer mExternalCommitsTimer;
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearGenreTable.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearGenreTable.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearGenreTable.lastError();
-    }
+    // writes that found the database locked by another process, applied in order once it is free
+    std::deque<std::function<void()>> mDelayedWrites;
 
-    d->mClearGenreTable.finish();
+    QTimer mDelayedWritesTimer;
 
-    queryResult = execQuery(d->mClearArtistsTable);
+    bool mWriteLockBusy = false;
 
-    if (!queryResult || !d->mClearArtistsTable.isActive()) {
-        Q_EMIT databaseError();
+    qlonglong mDataVersion = 0;
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearArtistsTable.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearArtistsTable.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearArtistsTable.lastError();
-    }
+    bool mHasExternalCommits = false;
 
-    d->mClearArtistsTable.finish();
+    QHash<QUrl, PendingPlayStatistics> mPendingPlays;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return;
-    }
+    QTimer mPlayStatisticsTimer;
 
-    Q_EMIT cleanedDatabase();
-}
+    enum MaintenanceStep {
+        AnalyzeStep,
+        IncrementalVacuumStep,
+        QuickCheckStep,
+    };
 
-void DatabaseInterface::initChangesTrackers()
-{
-    d->mModifiedTrackIds.clear();
-    d->mModifiedAlbumIds.clear();
-    d->mModifiedArtistIds.clear();
-    d->mInsertedTracks.clear();
-    d->mInsertedAlbums.clear();
-    d->mInsertedArtists.clear();
-}
+    QTimer mMaintenanceTimer;
 
-void DatabaseInterface::recordModifiedTrack(qulonglong trackId)
-{
-    d->mModifiedTrackIds.insert(trackId);
-}
+    QAtomicInt mMaintenanceAllowed = 0;
 
-void DatabaseInterface::recordModifiedAlbum(qulonglong albumId)
-{
-    d->mModifiedAlbumIds.insert(albumId);
-}
+    bool mMaintenanceRunning = false;
 
-void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers)
-{
-    qCDebug(orgKdeElisaDatabase()) << "DatabaseInterface::insertTracksList" << tracks.count();
-    if (d->mStopRequest == 1) {
-        Q_EMIT finishInsertingTracksList();
-        return;
-    }
+    MaintenanceStep mMaintenanceStep = AnalyzeStep;
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        Q_EMIT finishInsertingTracksList();
-        return;
-    }
+    qint64 mMaintenanceTime = 0;
 
-    initChangesTrackers();
+    qlonglong mMaintenanceFreedPages = 0;
 
-    for(const auto &oneTrack : tracks) {
-        d->mSelectTracksMapping.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
+    bool mMaintenanceRebuiltStatistics = false;
 
-        auto result = execQuery(d->mSelectTracksMapping);
+    QDateTime mLastMaintenance;
 
-        if (!result || !d->mSelectTracksMapping.isSelect() || !d->mSelectTracksMapping.isActive()) {
-            Q_EMIT databaseError();
+    DatabaseInterface::StorageSettings mStorageSettings;
 
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.boundValues();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastError();
+    QFile mPlayStatisticsJournal;
 
-            d->mSelectTracksMapping.finish();
+    std::unique_ptr<QLockFile> mPlayStatisticsJournalLock;
 
-            rollBackTransaction();
-            Q_EMIT finishInsertingTracksList();
-            return;
-        }
+    // sequence number of the last play written to the journal, the database stores the last one applied
+    qulonglong mPlayStatisticsSequence = 0;
 
-        bool isNewTrack = !d->mSelectTracksMapping.next();
+    QTimer mPlayStatisticsJournalSyncTimer;
 
-        if (isNewTrack) {
-            insertTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime(),
-                              QDateTime::currentDateTime());
-        } else if (!d->mSelectTracksMapping.record().value(0).isNull() && d->mSelectTracksMapping.record().value(0).toULongLong() != 0) {
-            updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
-        }
+    QSet<qulonglong> mModifiedTrackIds;
 
-        d->mSelectTracksMapping.finish();
+    QSet<qulonglong> mModifiedAlbumIds;
 
-        bool isInserted = false;
+    QSet<qulonglong> mModifiedArtistIds;
 
-        const auto insertedTrackId = internalInsertTrack(oneTrack, covers, isInserted);
+    QSet<qulonglong> mInsertedTracks;
 
-        if (isInserted && insertedTrackId != 0) {
-            d->mInsertedTracks.insert(insertedTrackId);
-        }
+    QSet<qulonglong> mInsertedAlbums;
 
-        if (d->mStopRequest == 1) {
-            transactionResult = finishTransaction();
-            if (!transactionResult) {
-                Q_EMIT finishInsertingTracksList();
-                return;
-            }
-            Q_EMIT finishInsertingTracksList();
-            return;
-        }
-    }
+    QSet<qulonglong> mInsertedArtists;
 
-    if (!d->mInsertedArtists.isEmpty()) {
-        DataTypes::ListArtistDataType newArtists;
+    QSet<qulonglong> mRemovedTracks;
 
-        for (auto artistId : qAsConst(d->mInsertedArtists)) {
-            newArtists.push_back({{DataTypes::DatabaseIdRole, artistId}});
-        }
-        qCInfo(orgKdeElisaDatabase) << "artistsAdded" << newArtists.size();
-        Q_EMIT artistsAdded(newArtists);
-    }
+    QSet<qulonglong> mRemovedAlbums;
 
-    if (!d->mInsertedAlbums.isEmpty()) {
-        DataTypes::ListAlbumDataType newAlbums;
+    QSet<qulonglong> mRemovedArtists;
 
-        for (auto albumId : qAsConst(d->mInsertedAlbums)) {
-            d->mModifiedAlbumIds.remove(albumId);
-            newAlbums.push_back(internalOneAlbumPartialData(albumId));
-        }
+    QList<DataTypes::DatabaseChanges> mChangesHistory;
 
-        qCInfo(orgKdeElisaDatabase) << "albumsAdded" << newAlbums.size();
-        Q_EMIT albumsAdded(newAlbums);
-    }
+    qulonglong mPublishedSequenceNumber = 0;
 
-    for (auto albumId : qAsConst(d->mModifiedAlbumIds)) {
-        Q_EMIT albumModified({{DataTypes::DatabaseIdRole, albumId}}, albumId);
-    }
+    mutable QMutex mChangesHistoryMutex;
 
-    if (!d->mInsertedTracks.isEmpty()) {
-        DataTypes::ListTrackDataType newTracks;
+    DatabaseIdCache<QString> mArtistIdCache;
 
-        for (auto trackId : qAsConst(d->mInsertedTracks)) {
-            newTracks.push_back(internalOneTrackPartialData(trackId));
-            d->mModifiedTrackIds.remove(trackId);
-        }
+    DatabaseIdCache<QString> mGenreIdCache;
 
-        qCInfo(orgKdeElisaDatabase) << "tracksAdded" << newTracks.size();
-        Q_EMIT tracksAdded(newTracks);
-    }
+    DatabaseIdCache<QString> mComposerIdCache;
 
-    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
-        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
-    }
+    DatabaseIdCache<QString> mLyricistIdCache;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        Q_EMIT finishInsertingTracksList();
-        return;
-    }
-    Q_EMIT finishInsertingTracksList();
-}
+    DatabaseIdCache<std::tuple<QString, QString, QString>> mAlbumIdCache;
 
-void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
-{
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        Q_EMIT finishRemovingTracksList();
-        return;
-    }
+    DatabaseIdCache<std::tuple<QString, QString, QString>> mAlbumLookupIdCache;
 
-    initChangesTrackers();
+    TrackDataCache mTrackDataCache;
 
-    internalRemoveTracksList(removedTracks);
+    qulonglong mAlbumId = 1;
 
-    if (!d->mInsertedArtists.isEmpty()) {
-        DataTypes::ListArtistDataType newArtists;
-        for (auto artistId : qAsConst(d->mInsertedArtists)) {
-            newArtists.push_back({{DataTypes::DatabaseIdRole, artistId}});
-        }
-        Q_EMIT artistsAdded(newArtists);
-    }
+    qulonglong mArtistId = 1;
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        Q_EMIT finishRemovingTracksList();
-        return;
-    }
+    qulonglong mComposerId = 1;
 
-    Q_EMIT finishRemovingTracksList();
-}
+    qulonglong mLyricistId = 1;
 
-bool DatabaseInterface::startTransaction() const
-{
-    auto result = false;
+    qulonglong mGenreId = 1;
 
-    auto transactionResult = d->mTracksDatabase.transaction();
-    if (!transactionResult) {
-        qCDebug(orgKdeElisaDatabase) << "transaction failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().driverText();
+    qulonglong mTrackId = 1;
 
-        return result;
-    }
+    QAtomicInt mStopRequest = 0;
 
-    result = true;
+    bool mInitFinished = false;
 
-    return result;
-}
+    bool mIsInBadState = false;
 
-bool DatabaseInterface::finishTransaction() const
-{
-    auto result = false;
+    // a batch of tracks was not fully committed since the directories state was last recorded
+    bool mIncompleteTracksInsertion = false;
 
-    auto transactionResult = d->mTracksDatabase.commit();
+    static const int BulkQueryChunkSize = 200;
 
-    if (!transactionResult) {
-        qCDebug(orgKdeElisaDatabase) << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
+    static const int SnapshotIdleDelay = 60000;
 
-        return result;
-    }
+    static const int SnapshotPageSize = 500;
 
-    result = true;
+    static const int PlayStatisticsDelay = 10000;
 
-    return result;
-}
+    static const int MaximumPendingPlays = 64;
 
-bool DatabaseInterface::rollBackTransaction() const
-{
-    auto result = false;
+    static const int PlayStatisticsJournalSyncDelay = 2000;
 
-    auto transactionResult = d->mTracksDatabase.rollback();
+    static const int MaximumChangesHistory = 256;
 
-    if (!transactionResult) {
-        qCDebug(orgKdeElisaDatabase) << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
+    static const int ExternalCommitsPollInterval = 2000;
 
-        return result;
-    }
+    static const int BusyTimeout = 30000;
 
-    result = true;
+    static const int WriteLockTimeout = 200;
 
-    return result;
-}
+    static const int DelayedWritesRetryDelay = 5000;
 
-void DatabaseInterface::initDatabase()
-{
-    auto listTables = d->mTracksDatabase.tables();
+    static const int MaintenanceDelay = 5 * 60 * 1000;
 
-    if (listTables.contains(QLatin1String("DatabaseVersionV2")) ||
-        listTables.contains(QLatin1String("DatabaseVersionV3")) ||
-        listTables.contains(QLatin1String("DatabaseVersionV4")) ||
-        listTables.contains(QLatin1String("DatabaseVersionV6")) ||
-        listTables.contains(QLatin1String("DatabaseVersionV7")) ||
-        listTables.contains(QLatin1String("DatabaseVersionV8")) ||
-        listTables.contains(QLatin1String("DatabaseVersionV10"))) {
+    static const int MaintenanceInterval = 24 * 3600;
 
-        qCDebug(orgKdeElisaDatabase()) << "Old database schema unsupported: delete and start from scratch";
-        qCDebug(orgKdeElisaDatabase()) << "list of old tables" << d->mTracksDatabase.tables();
+    static const int IncrementalVacuumPages = 128;
 
-        auto oldTables = QStringList{
-                QStringLiteral("DatabaseVersionV2"),
-                QStringLiteral("DatabaseVersionV3"),
-                QStringLiteral("DatabaseVersionV4"),
-                QStringLiteral("DatabaseVersionV5"),
-                QStringLiteral("DatabaseVersionV6"),
-                QStringLiteral("DatabaseVersionV7"),
-                QStringLiteral("DatabaseVersionV8"),
-                QStringLiteral("DatabaseVersionV10"),
-                QStringLiteral("AlbumsArtists"),
-                QStringLiteral("TracksArtists"),
-                QStringLiteral("TracksMapping"),
-                QStringLiteral("Tracks"),
-                QStringLiteral("Composer"),
-                QStringLiteral("Genre"),
-                QStringLiteral("Lyricist"),
-                QStringLiteral("Albums"),
-                QStringLiteral("DiscoverSource"),
-                QStringLiteral("Artists"),};
-        for (const auto &oneTable : oldTables) {
-            if (listTables.indexOf(oneTable) == -1) {
-                continue;
-            }
+    static constexpr qlonglong MinimumCacheSize = 2 * 1024;
 
-            QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    static constexpr qlonglong MaximumCacheSize = 64 * 1024;
 
-            auto result = createSchemaQuery.exec(QLatin1String("DROP TABLE ") + oneTable);
+    static constexpr qlonglong MinimumMemoryMapSize = 16 * 1024 * 1024;
 
-            if (!result) {
-                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
-                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+    static constexpr qlonglong MaximumMemoryMapSize = 256 * 1024 * 1024;
 
-                Q_EMIT databaseError();
-            }
-        }
-    }
+    static constexpr qint64 PlayScoreHalfLife = 30LL * 24 * 3600 * 1000;
 
-    manageNewDatabaseVersion();
-}
+    static constexpr qint64 MaximumPlayScoreAge = 16 * PlayScoreHalfLife;
 
-void DatabaseInterface::createDatabaseV9()
+};
+
+DatabaseInterface::DatabaseInterface(QObject *parent) : QObject(parent), d(nullptr)
 {
-    qCInfo(orgKdeElisaDatabase) << "begin creation of v9 database schema";
+}
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+DatabaseInterface::~DatabaseInterface()
+{
+    if (d) {
+        d->mModelSnapshotWatcher.waitForFinished();
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV9` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+        d->mReadConnections->release(QThread::currentThread());
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+        {
+            QMutexLocker locker(&d->mReadConnections->mMutex);
 
-            Q_EMIT databaseError();
+            /* the connections of the reader threads still running are closed when they finish */
+            for (const auto &oneConnection : qAsConst(d->mReadConnections->mConnections)) {
+                if (oneConnection->mStatements) {
+                    oneConnection->mStatements->mPrepareErrorHandler = {};
+                    oneConnection->mStatements->mStatistics = nullptr;
+                }
+            }
         }
-    }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
-
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DiscoverSource` (`ID` INTEGER PRIMARY KEY NOT NULL, "
-                                                                   "`Name` VARCHAR(55) NOT NULL, "
-                                                                   "UNIQUE (`Name`))"));
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
+        d->mTracksDatabase.close();
     }
+}
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
-
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Artists` (`ID` INTEGER PRIMARY KEY NOT NULL, "
-                                                                   "`Name` VARCHAR(55) NOT NULL, "
-                                                                   "UNIQUE (`Name`))"));
+void DatabaseInterface::init(const QString &dbName, const QString &databaseFileName, const StorageSettings &storageSettings)
+{
+    auto startupTimer = QElapsedTimer{};
+    startupTimer.start();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+    QSqlDatabase tracksDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), dbName);
 
-            Q_EMIT databaseError();
-        }
+    if (!databaseFileName.isEmpty()) {
+        tracksDatabase.setDatabaseName(QStringLiteral("file:") + databaseFileName);
+    } else {
+        tracksDatabase.setDatabaseName(QStringLiteral("file:memdb1?mode=memory"));
     }
+    tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=%1").arg(DatabaseInterfacePrivate::BusyTimeout));
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    auto result = tracksDatabase.open();
+    if (result) {
+        qCDebug(orgKdeElisaDatabase) << "database open";
+    } else {
+        qCDebug(orgKdeElisaDatabase) << "database not open";
+    }
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::init" << (tracksDatabase.driver()->hasFeature(QSqlDriver::Transactions) ? "yes" : "no");
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Composer` (`ID` INTEGER PRIMARY KEY NOT NULL, "
-                                                                   "`Name` VARCHAR(55) NOT NULL, "
-                                                                   "UNIQUE (`Name`))"));
+    tracksDatabase.exec(QStringLiteral("PRAGMA foreign_keys = ON;"));
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+    if (!databaseFileName.isEmpty()) {
+        // only effective when the database file is created, lets the idle maintenance give back free pages in small steps;
+        // older files are converted by the v25 update
+        tracksDatabase.exec(QStringLiteral("PRAGMA auto_vacuum = INCREMENTAL;"));
 
-            Q_EMIT databaseError();
+        // write-ahead logging lets the read-only connections used by other threads, and other processes like
+        // elisaImport, read while this one writes; writers of both processes take turns through the busy timeout
+        auto journalModeQuery = tracksDatabase.exec(QStringLiteral("PRAGMA journal_mode = WAL;"));
+        if (journalModeQuery.next()) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::init" << "journal mode" << journalModeQuery.value(0).toString();
         }
+        tracksDatabase.exec(QStringLiteral("PRAGMA synchronous = NORMAL;"));
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    auto openTime = startupTimer.restart();
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Genre` (`ID` INTEGER PRIMARY KEY NOT NULL, "
-                                                                   "`Name` VARCHAR(85) NOT NULL, "
-                                                                   "UNIQUE (`Name`))"));
+    d = std::make_unique<DatabaseInterfacePrivate>(tracksDatabase);
+    d->mConnectionName = dbName;
+    d->mDatabaseFileName = databaseFileName;
+    d->mWriterThread = QThread::currentThread();
+    d->mStatements.mPrepareErrorHandler = [this](const QSqlQuery &query) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::init" << query.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::init" << query.lastError();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+        Q_EMIT databaseError();
+    };
+    d->mStatements.mStatistics = &d->mStatistics;
+    d->mStatistics.setEnabled(orgKdeElisaDatabaseStatistics().isDebugEnabled());
 
-            Q_EMIT databaseError();
-        }
-    }
+    initStorageSettings(storageSettings);
+    applyStorageSettings(d->mTracksDatabase);
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    initDatabase();
+    auto initDatabaseTime = startupTimer.restart();
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Lyricist` (`ID` INTEGER PRIMARY KEY NOT NULL, "
-                                                                   "`Name` VARCHAR(55) NOT NULL, "
-                                                                   "UNIQUE (`Name`))"));
+    initSearchIndex();
+    initGeneration();
+    initPlayScore();
+    auto initDerivedTablesTime = startupTimer.restart();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+    initRequest();
+    auto initRequestTime = startupTimer.restart();
 
-            Q_EMIT databaseError();
-        }
-    }
+    d->mDelayedWritesTimer.setSingleShot(true);
+    d->mDelayedWritesTimer.setInterval(DatabaseInterfacePrivate::DelayedWritesRetryDelay);
+    connect(&d->mDelayedWritesTimer, &QTimer::timeout,
+            this, &DatabaseInterface::retryDelayedWrites);
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    if (!databaseFileName.isEmpty()) {
+        reloadExistingDatabase();
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Albums` ("
-                                                                   "`ID` INTEGER PRIMARY KEY NOT NULL, "
-                                                                   "`Title` VARCHAR(55) NOT NULL, "
-                                                                   "`ArtistName` VARCHAR(55), "
-                                                                   "`AlbumPath` VARCHAR(255) NOT NULL, "
-                                                                   "`CoverFileName` VARCHAR(255) NOT NULL, "
-                                                                   "UNIQUE (`Title`, `ArtistName`, `AlbumPath`), "
-                                                                   "CONSTRAINT fk_artists FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`) "
-                                                                   "ON DELETE CASCADE)"));
+        d->mSnapshotTimer.setSingleShot(true);
+        d->mSnapshotTimer.setInterval(DatabaseInterfacePrivate::SnapshotIdleDelay);
+        connect(&d->mSnapshotTimer, &QTimer::timeout,
+                this, &DatabaseInterface::writeModelSnapshot);
+        connect(&d->mModelSnapshotWatcher, &QFutureWatcher<bool>::finished, this, [this]() {
+            // changes committed while the snapshot was read are written by the next one
+            if (d->mModelSnapshotOutdated) {
+                d->mSnapshotTimer.start();
+            }
+        });
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+        if (!QFileInfo::exists(ModelSnapshot::fileNameForDatabase(databaseFileName))) {
+            scheduleModelSnapshot();
         }
-    }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+        d->mPlayStatisticsTimer.setSingleShot(true);
+        d->mPlayStatisticsTimer.setInterval(DatabaseInterfacePrivate::PlayStatisticsDelay);
+        connect(&d->mPlayStatisticsTimer, &QTimer::timeout,
+                this, &DatabaseInterface::flushPlayStatistics);
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Tracks` ("
-                                                                   "`ID` INTEGER PRIMARY KEY NOT NULL, "
-                                                                   "`Title` VARCHAR(85) NOT NULL, "
-                                                                   "`ArtistName` VARCHAR(55), "
-                                                                   "`AlbumTitle` VARCHAR(55), "
-                                                                   "`AlbumArtistName` VARCHAR(55), "
-                                                                   "`AlbumPath` VARCHAR(255), "
-                                                                   "`TrackNumber` INTEGER DEFAULT -1, "
-                                                                   "`DiscNumber` INTEGER DEFAULT -1, "
-                                                                   "`Duration` INTEGER NOT NULL, "
-                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
-                                                                   "`Genre` VARCHAR(55), "
-                                                                   "`Composer` VARCHAR(55), "
-                                                                   "`Lyricist` VARCHAR(55), "
-                                                                   "`Comment` VARCHAR(255) DEFAULT '', "
-                                                                   "`Year` INTEGER DEFAULT 0, "
-                                                                   "`Channels` INTEGER DEFAULT -1, "
-                                                                   "`BitRate` INTEGER DEFAULT -1, "
-                                                                   "`SampleRate` INTEGER DEFAULT -1, "
-                                                                   "`HasEmbeddedCover` BOOLEAN NOT NULL, "
-                                                                   "`ImportDate` INTEGER NOT NULL, "
-                                                                   "`FirstPlayDate` INTEGER, "
-                                                                   "`LastPlayDate` INTEGER, "
-                                                                   "`PlayCounter` INTEGER NOT NULL, "
-                                                                   "UNIQUE ("
-                                                                   "`Title`, `AlbumTitle`, `AlbumArtistName`, "
-                                                                   "`AlbumPath`, `TrackNumber`, `DiscNumber`"
-                                                                   "), "
-                                                                   "CONSTRAINT fk_artist FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_album FOREIGN KEY ("
-                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
-                                                                   "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
+        d->mPlayStatisticsJournalSyncTimer.setSingleShot(true);
+        d->mPlayStatisticsJournalSyncTimer.setInterval(DatabaseInterfacePrivate::PlayStatisticsJournalSyncDelay);
+        connect(&d->mPlayStatisticsJournalSyncTimer, &QTimer::timeout,
+                this, &DatabaseInterface::syncPlayStatisticsJournal);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+        initPlayStatisticsJournal();
 
-            Q_EMIT databaseError();
-        }
+        d->mMaintenanceTimer.setSingleShot(true);
+        d->mMaintenanceTimer.setInterval(DatabaseInterfacePrivate::MaintenanceDelay);
+        connect(&d->mMaintenanceTimer, &QTimer::timeout,
+                this, &DatabaseInterface::startMaintenance);
+
+        d->mExternalCommitsTimer.setInterval(DatabaseInterfacePrivate::ExternalCommitsPollInterval);
+        connect(&d->mExternalCommitsTimer, &QTimer::timeout,
+                this, &DatabaseInterface::checkExternalCommits);
+        d->mExternalCommitsTimer.start();
     }
+    auto reloadTime = startupTimer.elapsed();
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::init" << "open" << openTime << "ms"
+                                << "schema" << initDatabaseTime << "ms"
+                                << "search index and play scores" << initDerivedTablesTime << "ms"
+                                << "requests" << initRequestTime << "ms"
+                                << "reload" << reloadTime << "ms";
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::init" << d->mStatements.mRegisteredCount << "statements registered"
+                                << d->mStatements.mPreparedCount << "prepared in" << d->mStatements.mPrepareTime / 1000000. << "ms";
+}
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `TracksMapping` ("
-                                                                   "`TrackID` INTEGER NULL, "
-                                                                   "`DiscoverID` INTEGER NOT NULL, "
-                                                                   "`FileName` VARCHAR(255) NOT NULL, "
-                                                                   "`Priority` INTEGER NOT NULL, "
-                                                                   "`FileModifiedTime` DATETIME NOT NULL, "
-                                                                   "PRIMARY KEY (`FileName`), "
-                                                                   "CONSTRAINT TracksUnique UNIQUE (`TrackID`, `Priority`), "
-                                                                   "CONSTRAINT fk_tracksmapping_trackID FOREIGN KEY (`TrackID`) REFERENCES `Tracks`(`ID`) ON DELETE CASCADE, "
-                                                                   "CONSTRAINT fk_tracksmapping_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`))"));
+qulonglong DatabaseInterface::albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath)
+{
+    auto result = qulonglong{0};
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
-        }
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    result = internalAlbumIdFromTitleAndArtist(title, artist, albumPath);
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TitleAlbumsIndex` ON `Albums` "
-                                                                  "(`Title`)"));
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+    return result;
+}
 
-            Q_EMIT databaseError();
-        }
-    }
+DataTypes::ListTrackDataType DatabaseInterface::allTracksData()
+{
+    auto result = DataTypes::ListTrackDataType{};
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    if (!d) {
+        return result;
+    }
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`ArtistNameAlbumsIndex` ON `Albums` "
-                                                                  "(`ArtistName`)"));
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+    result = internalAllTracksPartialData();
 
-            Q_EMIT databaseError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    return result;
+}
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksAlbumIndex` ON `Tracks` "
-                                                                  "(`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+DataTypes::ListTrackDataType DatabaseInterface::allTracksDataAfter(const QString &lastFileName, int count)
+{
+    auto result = DataTypes::ListTrackDataType{};
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+    if (!d) {
+        return result;
+    }
 
-            Q_EMIT databaseError();
-        }
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    result = internalTracksPagePartialData(lastFileName, count);
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`ArtistNameIndex` ON `Tracks` "
-                                                                  "(`ArtistName`)"));
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+    return result;
+}
 
-            Q_EMIT databaseError();
-        }
+qulonglong DatabaseInterface::allTracksDataByPages(int count, const std::function<void(const DataTypes::ListTrackDataType&)> &pageReady)
+{
+    if (!d) {
+        return 0;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    /* all pages are read from the same snapshot of the database: a concurrent insertion cannot skip or repeat rows */
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return 0;
+    }
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`AlbumArtistNameIndex` ON `Tracks` "
-                                                                  "(`AlbumArtistName`)"));
+    const auto generation = internalCommittedGeneration();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+    auto lastFileName = QString{};
 
-            Q_EMIT databaseError();
+    while (true) {
+        const auto tracksPage = internalTracksPagePartialData(lastFileName, count);
+
+        if (tracksPage.isEmpty() && !lastFileName.isEmpty()) {
+            break;
         }
-    }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+        auto isLastPage = tracksPage.size() < count;
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksFileNameIndex` ON `TracksMapping` "
-                                                                  "(`FileName`)"));
+        if (!isLastPage) {
+            lastFileName = tracksPage.last()[DataTypes::ResourceRole].toString();
+        }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+        pageReady(tracksPage);
 
-            Q_EMIT databaseError();
+        if (isLastPage) {
+            break;
         }
     }
 
-    qCInfo(orgKdeElisaDatabase) << "end creation of v9 database schema";
+    finishTransaction();
+
+    return generation;
 }
 
-void DatabaseInterface::upgradeDatabaseV9()
+DataTypes::ListRadioDataType DatabaseInterface::allRadiosData()
 {
-    qCInfo(orgKdeElisaDatabase) << "begin update to v9 of database schema";
+    auto result = DataTypes::ListRadioDataType{};
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    if (!d) {
+        return result;
+    }
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV9` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+    result = internalAllRadiosPartialData();
 
-            Q_EMIT databaseError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery disableForeignKeys(d->mTracksDatabase);
-
-        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+    return result;
+}
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << disableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << disableForeignKeys.lastError();
+DataTypes::ListTrackDataType DatabaseInterface::recentlyPlayedTracksData(int count)
+{
+    auto result = DataTypes::ListTrackDataType{};
 
-            Q_EMIT databaseError();
-        }
+    if (!d) {
+        return result;
     }
 
-    d->mTracksDatabase.transaction();
-
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewAlbums` ("
-                                                                   "`ID` INTEGER PRIMARY KEY NOT NULL, "
-                                                                   "`Title` VARCHAR(55) NOT NULL, "
-                                                                   "`ArtistName` VARCHAR(55), "
-                                                                   "`AlbumPath` VARCHAR(255) NOT NULL, "
-                                                                   "`CoverFileName` VARCHAR(255) NOT NULL, "
-                                                                   "UNIQUE (`Title`, `ArtistName`, `AlbumPath`), "
-                                                                   "CONSTRAINT fk_artists FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`) "
-                                                                   "ON DELETE CASCADE)"));
+    result = internalRecentlyPlayedTracksData(count);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery copyDataQuery(d->mTracksDatabase);
+    return result;
+}
 
-        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `NewAlbums` "
-                                                        "SELECT "
-                                                        "album.`ID`, "
-                                                        "album.`Title`, "
-                                                        "artist.`Name`, "
-                                                        "album.`AlbumPath`, "
-                                                        "album.`CoverFileName` "
-                                                        "FROM "
-                                                        "`Albums` album, "
-                                                        "`AlbumsArtists` albumArtistMapping, "
-                                                        "`Artists` artist "
-                                                        "WHERE "
-                                                        "album.`ID` = albumArtistMapping.`AlbumID` AND "
-                                                        "albumArtistMapping.`ArtistID` = artist.`ID`"));
+DataTypes::ListTrackDataType DatabaseInterface::frequentlyPlayedTracksData(int count)
+{
+    auto result = DataTypes::ListTrackDataType{};
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << copyDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << copyDataQuery.lastError();
+    if (!d) {
+        return result;
+    }
 
-            Q_EMIT databaseError();
-        }
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    result = internalFrequentlyPlayedTracksData(count);
 
-        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Albums`"));
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+    return result;
+}
 
-            Q_EMIT databaseError();
-        }
-    }
+DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsData()
+{
+    auto result = DataTypes::ListAlbumDataType{};
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    if (!d) {
+        return result;
+    }
 
-        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `AlbumsArtists`"));
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+    result = internalAllAlbumsPartialData(queryForCurrentThread(d->mSelectAllAlbumsShortQuery));
 
-            Q_EMIT databaseError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    return result;
+}
 
-        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewAlbums` RENAME TO `Albums`"));
+DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsDataAfter(const QString &lastTitle, qulonglong lastDatabaseId, int count)
+{
+    auto result = DataTypes::ListAlbumDataType{};
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+    if (!d) {
+        return result;
+    }
 
-            Q_EMIT databaseError();
-        }
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    result = internalAlbumsPagePartialData(lastTitle, lastDatabaseId, count);
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewTracks` ("
-                                                                   "`ID` INTEGER PRIMARY KEY NOT NULL, "
-                                                                   "`Title` VARCHAR(85) NOT NULL, "
-                                                                   "`ArtistName` VARCHAR(55), "
-                                                                   "`AlbumTitle` VARCHAR(55), "
-                                                                   "`AlbumArtistName` VARCHAR(55), "
-                                                                   "`AlbumPath` VARCHAR(255), "
-                                                                   "`TrackNumber` INTEGER DEFAULT -1, "
-                                                                   "`DiscNumber` INTEGER DEFAULT -1, "
-                                                                   "`Duration` INTEGER NOT NULL, "
-                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
-                                                                   "`Genre` VARCHAR(55), "
-                                                                   "`Composer` VARCHAR(55), "
-                                                                   "`Lyricist` VARCHAR(55), "
-                                                                   "`Comment` VARCHAR(255) DEFAULT '', "
-                                                                   "`Year` INTEGER DEFAULT 0, "
-                                                                   "`Channels` INTEGER DEFAULT -1, "
-                                                                   "`BitRate` INTEGER DEFAULT -1, "
-                                                                   "`SampleRate` INTEGER DEFAULT -1, "
-                                                                   "`HasEmbeddedCover` BOOLEAN NOT NULL, "
-                                                                   "`ImportDate` INTEGER NOT NULL, "
-                                                                   "`FirstPlayDate` INTEGER, "
-                                                                   "`LastPlayDate` INTEGER, "
-                                                                   "`PlayCounter` INTEGER NOT NULL, "
-                                                                   "UNIQUE ("
-                                                                   "`Title`, `AlbumTitle`, `AlbumArtistName`, "
-                                                                   "`AlbumPath`, `TrackNumber`, `DiscNumber`"
-                                                                   "), "
-                                                                   "CONSTRAINT fk_artist FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_album FOREIGN KEY ("
-                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
-                                                                   "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+    return result;
+}
 
-            Q_EMIT databaseError();
-        }
+qulonglong DatabaseInterface::allAlbumsDataByPages(int count, const std::function<void(const DataTypes::ListAlbumDataType&)> &pageReady)
+{
+    if (!d) {
+        return 0;
     }
 
-    {
-        QSqlQuery copyDataQuery(d->mTracksDatabase);
+    /* all pages are read from the same snapshot of the database: a concurrent insertion cannot skip or repeat rows */
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return 0;
+    }
 
-        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `NewTracks` "
-                                                        "(`ID`, `Title`, `ArtistName`, "
-                                                        "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`, "
-                                                        "`TrackNumber`, `DiscNumber`, `Duration`, "
-                                                        "`Rating`, `Genre`, `Composer`, "
-                                                        "`Lyricist`, `Comment`, `Year`, "
-                                                        "`Channels`, `BitRate`, `SampleRate`, "
-                                                        "`HasEmbeddedCover`, `ImportDate`, `PlayCounter`) "
-                                                        "SELECT "
-                                                        "track.`ID`, "
-                                                        "track.`Title`, "
-                                                        "artist.`Name`, "
-                                                        "album.`Title`, "
-                                                        "album.`ArtistName`, "
-                                                        "album.`AlbumPath`, "
-                                                        "track.`TrackNumber`, "
-                                                        "track.`DiscNumber`, "
-                                                        "track.`Duration`, "
-                                                        "track.`Rating`, "
-                                                        "genre.`Name`, "
-                                                        "composer.`Name`, "
-                                                        "lyricist.`Name`, "
-                                                        "track.`Comment`, "
-                                                        "track.`Year`, "
-                                                        "track.`Channels`, "
-                                                        "track.`BitRate`, "
-                                                        "track.`SampleRate`, "
-                                                        "FALSE, "
-                                                        "strftime('%s', 'now'), "
-                                                        "0 "
-                                                        "FROM "
-                                                        "`Tracks` track, "
-                                                        "`TracksArtists` trackArtistMapping, "
-                                                        "`Artists` artist, "
-                                                        "`Albums` album "
-                                                        "left join "
-                                                        "`Genre` genre "
-                                                        "on track.`GenreID` = genre.`ID` "
-                                                        "left join "
-                                                        "`Composer` composer "
-                                                        "on track.`ComposerID` = composer.`ID` "
-                                                        "left join "
-                                                        "`Lyricist` lyricist "
-                                                        "on track.`LyricistID` = lyricist.`ID` "
-                                                        "WHERE "
-                                                        "track.`ID` = trackArtistMapping.`TrackID` AND "
-                                                        "trackArtistMapping.`ArtistID` = artist.`ID` AND "
-                                                        "track.`AlbumID` = album.`ID`"));
+    const auto generation = internalCommittedGeneration();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << copyDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << copyDataQuery.lastError();
+    auto lastTitle = QString{};
+    auto lastDatabaseId = qulonglong{0};
 
-            Q_EMIT databaseError();
+    while (true) {
+        const auto albumsPage = internalAlbumsPagePartialData(lastTitle, lastDatabaseId, count);
+
+        if (albumsPage.isEmpty() && lastDatabaseId != 0) {
+            break;
         }
-    }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+        auto isLastPage = albumsPage.size() < count;
 
-        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Tracks`"));
+        if (!isLastPage) {
+            lastTitle = albumsPage.last().title();
+            lastDatabaseId = albumsPage.last().databaseId();
+        }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+        pageReady(albumsPage);
 
-            Q_EMIT databaseError();
+        if (isLastPage) {
+            break;
         }
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    finishTransaction();
 
-        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `TracksArtists`"));
+    return generation;
+}
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsDataByGenreAndArtist(const QString &genre, const QString &artist)
+{
+    auto result = DataTypes::ListAlbumDataType{};
 
-            Q_EMIT databaseError();
-        }
+    if (!d) {
+        return result;
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewTracks` RENAME TO `Tracks`"));
+    auto &currentQuery = queryForCurrentThread(d->mSelectAllAlbumsShortWithGenreArtistFilterQuery);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+    currentQuery.bindValue(QStringLiteral(":artistFilter"), artist);
+    currentQuery.bindValue(QStringLiteral(":genreFilter"), genre);
 
-            Q_EMIT databaseError();
-        }
+    result = internalAllAlbumsPartialData(currentQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    d->mTracksDatabase.commit();
+    return result;
+}
 
-    {
-        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsDataByArtist(const QString &artist)
+{
+    auto result = DataTypes::ListAlbumDataType{};
 
-        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+    if (!d) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << enableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << enableForeignKeys.lastError();
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-            Q_EMIT databaseError();
-        }
+    auto &currentQuery = queryForCurrentThread(d->mSelectAllAlbumsShortWithArtistFilterQuery);
+
+    currentQuery.bindValue(QStringLiteral(":artistFilter"), artist);
+
+    result = internalAllAlbumsPartialData(currentQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    qCInfo(orgKdeElisaDatabase) << "finished update to v9 of database schema";
+    return result;
 }
 
-void DatabaseInterface::upgradeDatabaseV11()
+DataTypes::AlbumDataType DatabaseInterface::albumDataFromDatabaseId(qulonglong id)
 {
-    qCInfo(orgKdeElisaDatabase) << "begin update to v11 of database schema";
+    auto result = DataTypes::AlbumDataType{};
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    if (!d) {
+        return result;
+    }
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV11` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+    result = internalOneAlbumPartialData(id);
 
-            Q_EMIT databaseError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+    return result;
+}
 
-        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+DataTypes::ListTrackDataType DatabaseInterface::albumData(qulonglong databaseId)
+{
+    auto result = DataTypes::ListTrackDataType{};
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << disableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << disableForeignKeys.lastError();
+    if (!d) {
+        return result;
+    }
 
-            Q_EMIT databaseError();
-        }
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    d->mTracksDatabase.transaction();
+    auto &currentQuery = queryForCurrentThread(d->mSelectTrackQuery);
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    currentQuery.bindValue(QStringLiteral(":albumId"), databaseId);
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `TracksData` ("
-                                                                   "`DiscoverID` INTEGER NOT NULL, "
-                                                                   "`FileName` VARCHAR(255) NOT NULL, "
-                                                                   "`FileModifiedTime` DATETIME NOT NULL, "
-                                                                   "`ImportDate` INTEGER NOT NULL, "
-                                                                   "`FirstPlayDate` INTEGER, "
-                                                                   "`LastPlayDate` INTEGER, "
-                                                                   "`PlayCounter` INTEGER NOT NULL, "
-                                                                   "PRIMARY KEY (`FileName`, `DiscoverID`), "
-                                                                   "CONSTRAINT fk_tracksmapping_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`))"));
+    auto queryResult = execQuery(currentQuery);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
-        }
+    if (!queryResult || !currentQuery.isSelect() || !currentQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::albumData" << currentQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::albumData" << currentQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::albumData" << currentQuery.lastError();
     }
 
-    {
-        QSqlQuery copyDataQuery(d->mTracksDatabase);
+    while (currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
-        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `TracksData` "
-                                                        "SELECT "
-                                                        "m.`DiscoverID`, "
-                                                        "m.`FileName`, "
-                                                        "m.`FileModifiedTime`, "
-                                                        "t.`ImportDate`, "
-                                                        "t.`FirstPlayDate`, "
-                                                        "t.`LastPlayDate`, "
-                                                        "t.`PlayCounter` "
-                                                        "FROM "
-                                                        "`Tracks` t, "
-                                                        "`TracksMapping` m "
-                                                        "WHERE "
-                                                        "t.`ID` = m.`TrackID`"));
+        result.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << copyDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << copyDataQuery.lastError();
+    currentQuery.finish();
 
-            Q_EMIT databaseError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
-
-        auto result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewTracks` ("
-                                                            "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
-                                                            "`DiscoverID` INTEGER NOT NULL, "
-                                                            "`FileName` VARCHAR(255) NOT NULL, "
-                                                            "`Priority` INTEGER NOT NULL, "
-                                                            "`Title` VARCHAR(85) NOT NULL, "
-                                                            "`ArtistName` VARCHAR(55), "
-                                                            "`AlbumTitle` VARCHAR(55), "
-                                                            "`AlbumArtistName` VARCHAR(55), "
-                                                            "`AlbumPath` VARCHAR(255), "
-                                                            "`TrackNumber` INTEGER, "
-                                                            "`DiscNumber` INTEGER, "
-                                                            "`Duration` INTEGER NOT NULL, "
-                                                            "`Rating` INTEGER NOT NULL DEFAULT 0, "
-                                                            "`Genre` VARCHAR(55), "
-                                                            "`Composer` VARCHAR(55), "
-                                                            "`Lyricist` VARCHAR(55), "
-                                                            "`Comment` VARCHAR(255), "
-                                                            "`Year` INTEGER, "
-                                                            "`Channels` INTEGER, "
-                                                            "`BitRate` INTEGER, "
-                                                            "`SampleRate` INTEGER, "
-                                                            "`HasEmbeddedCover` BOOLEAN NOT NULL, "
-                                                            "UNIQUE ("
-                                                            "`FileName`"
-                                                            "), "
-                                                            "UNIQUE ("
-                                                            "`Priority`, `Title`, `ArtistName`, "
-                                                            "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`"
-                                                            "), "
-                                                            "CONSTRAINT fk_fileName FOREIGN KEY (`FileName`, `DiscoverID`) "
-                                                            "REFERENCES `TracksData`(`FileName`, `DiscoverID`) ON DELETE CASCADE, "
-                                                            "CONSTRAINT fk_artist FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`), "
-                                                            "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
-                                                            "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
-                                                            "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
-                                                            "CONSTRAINT fk_tracks_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`)"
-                                                            "CONSTRAINT fk_tracks_album FOREIGN KEY ("
-                                                            "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
-                                                            "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+    return result;
+}
 
-            Q_EMIT databaseError();
-        }
-    }
+DataTypes::ListArtistDataType DatabaseInterface::allArtistsData()
+{
+    auto generation = qulonglong{0};
 
-    {
-        QSqlQuery copyDataQuery(d->mTracksDatabase);
+    return allArtistsData(generation);
+}
 
-        auto result = copyDataQuery.exec(QStringLiteral("INSERT OR IGNORE INTO `NewTracks` "
-                                                        "("
-                                                        "`DiscoverID`, "
-                                                        "`FileName`, "
-                                                        "`Priority`, "
-                                                        "`Title`, "
-                                                        "`ArtistName`, "
-                                                        "`AlbumTitle`, "
-                                                        "`AlbumArtistName`, "
-                                                        "`AlbumPath`, "
-                                                        "`TrackNumber`, "
-                                                        "`DiscNumber`, "
-                                                        "`Duration`, "
-                                                        "`Rating`, "
-                                                        "`Genre`, "
-                                                        "`Composer`, "
-                                                        "`Lyricist`, "
-                                                        "`Comment`, "
-                                                        "`Year`, "
-                                                        "`Channels`, "
-                                                        "`BitRate`, "
-                                                        "`SampleRate`, "
-                                                        "`HasEmbeddedCover`"
-                                                        ") "
-                                                        "SELECT "
-                                                        "m.`DiscoverID`, "
-                                                        "m.`FileName`, "
-                                                        "m.`Priority`, "
-                                                        "t.`Title`, "
-                                                        "t.`ArtistName`, "
-                                                        "t.`AlbumTitle`, "
-                                                        "t.`AlbumArtistName`, "
-                                                        "t.`AlbumPath`, "
-                                                        "t.`TrackNumber`, "
-                                                        "t.`DiscNumber`, "
-                                                        "t.`Duration`, "
-                                                        "t.`Rating`, "
-                                                        "t.`Genre`, "
-                                                        "t.`Composer`, "
-                                                        "t.`Lyricist`, "
-                                                        "t.`Comment`, "
-                                                        "t.`Year`, "
-                                                        "t.`Channels`, "
-                                                        "t.`BitRate`, "
-                                                        "t.`SampleRate`, "
-                                                        "t.`HasEmbeddedCover` "
-                                                        "FROM "
-                                                        "`Tracks` t, "
-                                                        "`TracksMapping` m "
-                                                        "WHERE "
-                                                        "t.`ID` = m.`TrackID`"));
+DataTypes::ListArtistDataType DatabaseInterface::allArtistsData(qulonglong &generation)
+{
+    auto result = DataTypes::ListArtistDataType{};
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << copyDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << copyDataQuery.lastError();
+    generation = 0;
 
-            Q_EMIT databaseError();
-        }
+    if (!d) {
+        return result;
     }
 
-    {
-        QSqlQuery updateDataQuery(d->mTracksDatabase);
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        auto result = updateDataQuery.exec(QStringLiteral("UPDATE `NewTracks` "
-                                                          "SET "
-                                                          "`TrackNumber` = NULL "
-                                                          "WHERE "
-                                                          "`TrackNumber` = -1"));
+    generation = internalCommittedGeneration();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastError();
+    result = internalAllArtistsPartialData(queryForCurrentThread(d->mSelectAllArtistsQuery));
 
-            Q_EMIT databaseError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery updateDataQuery(d->mTracksDatabase);
+    return result;
+}
 
-        auto result = updateDataQuery.exec(QStringLiteral("UPDATE `NewTracks` "
-                                                          "SET "
-                                                          "`Channels` = NULL "
-                                                          "WHERE "
-                                                          "`Channels` = -1"));
+DataTypes::ListArtistDataType DatabaseInterface::allArtistsDataByGenre(const QString &genre)
+{
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::allArtistsDataByGenre" << genre;
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastError();
+    auto result = DataTypes::ListArtistDataType{};
 
-            Q_EMIT databaseError();
-        }
+    if (!d) {
+        return result;
     }
 
-    {
-        QSqlQuery updateDataQuery(d->mTracksDatabase);
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        auto result = updateDataQuery.exec(QStringLiteral("UPDATE `NewTracks` "
-                                                          "SET "
-                                                          "`BitRate` = NULL "
-                                                          "WHERE "
-                                                          "`BitRate` = -1"));
+    auto &currentQuery = queryForCurrentThread(d->mSelectAllArtistsWithGenreFilterQuery);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastError();
+    currentQuery.bindValue(QStringLiteral(":genreFilter"), genre);
 
-            Q_EMIT databaseError();
-        }
+    result = internalAllArtistsPartialData(currentQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery updateDataQuery(d->mTracksDatabase);
+    return result;
+}
 
-        auto result = updateDataQuery.exec(QStringLiteral("UPDATE `NewTracks` "
-                                                          "SET "
-                                                          "`SampleRate` = NULL "
-                                                          "WHERE "
-                                                          "`SampleRate` = -1"));
+DataTypes::ListGenreDataType DatabaseInterface::allGenresData()
+{
+    auto result = DataTypes::ListGenreDataType{};
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastError();
+    if (!d) {
+        return result;
+    }
 
-            Q_EMIT databaseError();
-        }
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    result = internalAllGenresPartialData();
 
-        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Tracks`"));
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+    return result;
+}
 
-            Q_EMIT databaseError();
-        }
-    }
+bool DatabaseInterface::internalArtistMatchGenre(qulonglong databaseId, const QString &genre)
+{
+    auto result = true;
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    if (!d) {
+        return result;
+    }
 
-        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `TracksMapping`"));
+    auto &currentQuery = queryForCurrentThread(d->mArtistMatchGenreQuery);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+    currentQuery.bindValue(QStringLiteral(":databaseId"), databaseId);
+    currentQuery.bindValue(QStringLiteral(":genreFilter"), genre);
 
-            Q_EMIT databaseError();
-        }
-    }
+    auto queryResult = execQuery(currentQuery);
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    if (!queryResult || !currentQuery.isSelect() || !currentQuery.isActive()) {
+        Q_EMIT databaseError();
 
-        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewTracks` RENAME TO `Tracks`"));
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::artistMatchGenre" << currentQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::artistMatchGenre" << currentQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::artistMatchGenre" << currentQuery.lastError();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+        currentQuery.finish();
 
-            Q_EMIT databaseError();
+        auto transactionResult = finishTransaction();
+        if (!transactionResult) {
+            return result;
         }
-    }
 
-    d->mTracksDatabase.commit();
+        return result;
+    }
 
-    {
-        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+    result = currentQuery.next();
 
-        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+    currentQuery.finish();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << enableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << enableForeignKeys.lastError();
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalArtistMatchGenre" << databaseId << (result ? "match" : "does not match");
 
-            Q_EMIT databaseError();
-        }
-    }
+    return result;
+}
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromAuthor(const QString &ArtistName)
+{
+    auto allTracks = DataTypes::ListTrackDataType{};
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksAlbumIndex` ON `Tracks` "
-                                                                  "(`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return allTracks;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+    allTracks = internalTracksFromAuthor(ArtistName);
 
-            Q_EMIT databaseError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return allTracks;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    return allTracks;
+}
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`ArtistNameIndex` ON `Tracks` "
-                                                                  "(`ArtistName`)"));
+DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromGenre(const QString &genre)
+{
+    auto allTracks = DataTypes::ListTrackDataType{};
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return allTracks;
+    }
 
-            Q_EMIT databaseError();
-        }
+    allTracks = internalTracksFromGenre(genre);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return allTracks;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    return allTracks;
+}
+DataTypes::TrackDataType DatabaseInterface::trackDataFromDatabaseId(qulonglong id)
+{
+    auto result = DataTypes::TrackDataType();
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`AlbumArtistNameIndex` ON `Tracks` "
-                                                                  "(`AlbumArtistName`)"));
+    if (!d) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+    const auto cacheKey = TrackDataCache::Key{id, {}};
 
-            Q_EMIT databaseError();
-        }
+    if (d->mTrackDataCache.find(cacheKey, result)) {
+        return result;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    const auto cacheEpoch = d->mTrackDataCache.epoch();
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksUniqueData` ON `Tracks` "
-                                                                  "(`Title`, `ArtistName`, "
-                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+    result = internalOneTrackPartialData(id);
 
-            Q_EMIT databaseError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    d->mTrackDataCache.insert(cacheKey, result, cacheEpoch);
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksUniqueDataPriority` ON `Tracks` "
-                                                                  "(`Priority`, `Title`, `ArtistName`, "
-                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+    return result;
+}
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+DataTypes::TrackDataType DatabaseInterface::trackDataFromDatabaseIdAndUrl(qulonglong id, const QUrl &trackUrl)
+{
+    auto result = DataTypes::TrackDataType();
 
-            Q_EMIT databaseError();
-        }
+    if (!d) {
+        return result;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    const auto cacheKey = TrackDataCache::Key{id, trackUrl.toString()};
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksFileNameIndex` ON `Tracks` "
-                                                                  "(`FileName`)"));
+    if (d->mTrackDataCache.find(cacheKey, result)) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+    const auto cacheEpoch = d->mTrackDataCache.epoch();
 
-            Q_EMIT databaseError();
-        }
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    qCInfo(orgKdeElisaDatabase) << "finished update to v11 of database schema";
+    result = internalOneTrackPartialDataByIdAndUrl(id, trackUrl);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    d->mTrackDataCache.insert(cacheKey, result, cacheEpoch);
+
+    return result;
 }
 
-void DatabaseInterface::upgradeDatabaseV12()
+DataTypes::TrackDataType DatabaseInterface::radioDataFromDatabaseId(qulonglong id)
 {
-    qCInfo(orgKdeElisaDatabase) << "begin update to v12 of database schema";
+    auto result = DataTypes::TrackDataType();
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    if (!d) {
+        return result;
+    }
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV12` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+    result = internalOneRadioPartialData(id);
 
-            Q_EMIT databaseError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery disableForeignKeys(d->mTracksDatabase);
-
-        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+    return result;
+}
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << disableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << disableForeignKeys.lastError();
+qulonglong DatabaseInterface::trackIdFromTitleAlbumTrackDiscNumber(const QString &title, const QString &artist, const std::optional<QString> &album,
+                                                                     std::optional<int> trackNumber, std::optional<int> discNumber)
+{
+    auto result = qulonglong(0);
 
-            Q_EMIT databaseError();
-        }
+    if (!d) {
+        return result;
     }
 
-    d->mTracksDatabase.transaction();
-
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewTracks` ("
-                                                                   "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
-                                                                   "`FileName` VARCHAR(255) NOT NULL, "
-                                                                   "`Priority` INTEGER NOT NULL, "
-                                                                   "`Title` VARCHAR(85) NOT NULL, "
-                                                                   "`ArtistName` VARCHAR(55), "
-                                                                   "`AlbumTitle` VARCHAR(55), "
-                                                                   "`AlbumArtistName` VARCHAR(55), "
-                                                                   "`AlbumPath` VARCHAR(255), "
-                                                                   "`TrackNumber` INTEGER, "
-                                                                   "`DiscNumber` INTEGER, "
-                                                                   "`Duration` INTEGER NOT NULL, "
-                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
-                                                                   "`Genre` VARCHAR(55), "
-                                                                   "`Composer` VARCHAR(55), "
-                                                                   "`Lyricist` VARCHAR(55), "
-                                                                   "`Comment` VARCHAR(255), "
-                                                                   "`Year` INTEGER, "
-                                                                   "`Channels` INTEGER, "
-                                                                   "`BitRate` INTEGER, "
-                                                                   "`SampleRate` INTEGER, "
-                                                                   "`HasEmbeddedCover` BOOLEAN NOT NULL, "
-                                                                   "UNIQUE ("
-                                                                   "`FileName`"
-                                                                   "), "
-                                                                   "UNIQUE ("
-                                                                   "`Priority`, `Title`, `ArtistName`, "
-                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`"
-                                                                   "), "
-                                                                   "CONSTRAINT fk_fileName FOREIGN KEY (`FileName`) "
-                                                                   "REFERENCES `TracksData`(`FileName`) ON DELETE CASCADE, "
-                                                                   "CONSTRAINT fk_artist FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_album FOREIGN KEY ("
-                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
-                                                                   "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
+    result = internalTrackIdFromTitleAlbumTracDiscNumber(title, artist, album, trackNumber, discNumber);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    return result;
+}
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewTracksData` ("
-                                                                   "`FileName` VARCHAR(255) NOT NULL, "
-                                                                   "`FileModifiedTime` DATETIME NOT NULL, "
-                                                                   "`ImportDate` INTEGER NOT NULL, "
-                                                                   "`FirstPlayDate` INTEGER, "
-                                                                   "`LastPlayDate` INTEGER, "
-                                                                   "`PlayCounter` INTEGER NOT NULL, "
-                                                                   "PRIMARY KEY (`FileName`))"));
+qulonglong DatabaseInterface::trackIdFromFileName(const QUrl &fileName)
+{
+    auto result = qulonglong(0);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
-        }
+    if (!d) {
+        return result;
     }
 
-    {
-        QSqlQuery copyDataQuery(d->mTracksDatabase);
-
-        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `NewTracksData` "
-                                                        "SELECT "
-                                                        "td.`FileName`, "
-                                                        "td.`FileModifiedTime`, "
-                                                        "td.`ImportDate`, "
-                                                        "td.`FirstPlayDate`, "
-                                                        "td.`LastPlayDate`, "
-                                                        "td.`PlayCounter` "
-                                                        "FROM "
-                                                        "`TracksData` td"));
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << copyDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << copyDataQuery.lastError();
+    result = internalTrackIdFromFileName(fileName);
 
-            Q_EMIT databaseError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery copyDataQuery(d->mTracksDatabase);
+    return result;
+}
 
-        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `NewTracks` "
-                                                        "SELECT "
-                                                        "t.`ID`, "
-                                                        "t.`FileName`, "
-                                                        "t.`Priority`, "
-                                                        "t.`Title`, "
-                                                        "t.`ArtistName`, "
-                                                        "t.`AlbumTitle`, "
-                                                        "t.`AlbumArtistName`, "
-                                                        "t.`AlbumPath`, "
-                                                        "t.`TrackNumber`, "
-                                                        "t.`DiscNumber`, "
-                                                        "t.`Duration`, "
-                                                        "t.`Rating`, "
-                                                        "t.`Genre`, "
-                                                        "t.`Composer`, "
-                                                        "t.`Lyricist`, "
-                                                        "t.`Comment`, "
-                                                        "t.`Year`, "
-                                                        "t.`Channels`, "
-                                                        "t.`BitRate`, "
-                                                        "t.`SampleRate`, "
-                                                        "t.`HasEmbeddedCover` "
-                                                        "FROM "
-                                                        "`Tracks` t"));
+qulonglong DatabaseInterface::radioIdFromFileName(const QUrl &fileName)
+{
+    auto result = qulonglong(0);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << copyDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << copyDataQuery.lastError();
+    if (!d) {
+        return result;
+    }
 
-            Q_EMIT databaseError();
-        }
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    result = internalRadioIdFromHttpAddress(fileName.toString());
 
-        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `TracksData`"));
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+    return result;
+}
 
-            Q_EMIT databaseError();
-        }
+DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromDatabaseIds(const QList<qulonglong> &ids)
+{
+    auto result = DataTypes::ListTrackDataType();
+
+    if (!d) {
+        return result;
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    const auto cacheEpoch = d->mTrackDataCache.epoch();
 
-        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Tracks`"));
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+    result.reserve(ids.size());
 
-            Q_EMIT databaseError();
+    for (auto oneId : ids) {
+        auto oneTrack = internalOneTrackPartialData(oneId);
+
+        if (!oneTrack.isEmpty()) {
+            result.push_back(oneTrack);
         }
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
-
-        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewTracksData` RENAME TO `TracksData`"));
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-            Q_EMIT databaseError();
-        }
+    for (const auto &oneTrack : qAsConst(result)) {
+        d->mTrackDataCache.insert({oneTrack.databaseId(), {}}, oneTrack, cacheEpoch);
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    return result;
+}
 
-        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewTracks` RENAME TO `Tracks`"));
+qulonglong DatabaseInterface::databaseGeneration() const
+{
+    return d ? d->mGeneration.loadAcquire() : 0;
+}
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+bool DatabaseInterface::changesSince(qulonglong sequenceNumber, DataTypes::DatabaseChanges &changes) const
+{
+    changes = {};
 
-            Q_EMIT databaseError();
-        }
+    if (!d) {
+        return false;
     }
 
-    d->mTracksDatabase.commit();
+    QMutexLocker lock(&d->mChangesHistoryMutex);
 
-    {
-        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+    changes.mSequenceNumber = std::max(sequenceNumber, d->mPublishedSequenceNumber);
 
-        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+    if (sequenceNumber >= d->mPublishedSequenceNumber) {
+        return sequenceNumber == d->mPublishedSequenceNumber;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << enableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << enableForeignKeys.lastError();
+    if (d->mChangesHistory.isEmpty() || d->mChangesHistory.constFirst().mSequenceNumber > sequenceNumber + 1) {
+        return false;
+    }
 
-            Q_EMIT databaseError();
+    for (const auto &oneChange : qAsConst(d->mChangesHistory)) {
+        if (oneChange.mSequenceNumber > sequenceNumber) {
+            changes.merge(oneChange);
         }
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    return true;
+}
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksAlbumIndex` ON `Tracks` "
-                                                                  "(`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+bool DatabaseInterface::journaledChangesSince(qulonglong generation, DataTypes::DatabaseChanges &changes)
+{
+    changes = {};
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+    if (!d || d->mDatabaseFileName.isEmpty()) {
+        return false;
+    }
 
-            Q_EMIT databaseError();
-        }
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return false;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    /* the generation is read in the same transaction as the journal: a commit in progress is either fully seen or not at all */
+    const auto lastGeneration = internalCommittedGeneration();
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`ArtistNameIndex` ON `Tracks` "
-                                                                  "(`ArtistName`)"));
+    changes.mSequenceNumber = lastGeneration;
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+    // the journal keeps the latest generations only
+    if (lastGeneration < generation || lastGeneration - generation > DatabaseInterfacePrivate::MaximumChangesHistory) {
+        finishTransaction();
 
-            Q_EMIT databaseError();
-        }
+        return false;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    auto journaledChanges = QList<DataTypes::DatabaseChanges>{};
+    auto isDatabaseCleared = false;
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`AlbumArtistNameIndex` ON `Tracks` "
-                                                                  "(`AlbumArtistName`)"));
+    auto queryResult = internalChangesJournal(generation, lastGeneration, journaledChanges, isDatabaseCleared);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+    finishTransaction();
 
-            Q_EMIT databaseError();
-        }
+    if (!queryResult || isDatabaseCleared) {
+        return false;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    for (const auto &oneChange : qAsConst(journaledChanges)) {
+        changes.merge(oneChange);
+    }
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksUniqueData` ON `Tracks` "
-                                                                  "(`Title`, `ArtistName`, "
-                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+    changes.mSequenceNumber = lastGeneration;
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+    return true;
+}
 
-            Q_EMIT databaseError();
-        }
+bool DatabaseInterface::isStatisticsEnabled() const
+{
+    return d && d->mStatistics.isEnabled();
+}
+
+void DatabaseInterface::setStatisticsEnabled(bool enabled)
+{
+    if (!d) {
+        return;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    d->mStatistics.setEnabled(enabled);
+}
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksUniqueDataPriority` ON `Tracks` "
-                                                                  "(`Priority`, `Title`, `ArtistName`, "
-                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+void DatabaseInterface::resetStatistics()
+{
+    if (!d) {
+        return;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+    d->mStatistics.reset();
+}
 
-            Q_EMIT databaseError();
-        }
+QString DatabaseInterface::statisticsReport() const
+{
+    if (!d) {
+        return {};
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
-
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksFileNameIndex` ON `Tracks` "
-                                                                  "(`FileName`)"));
+    return d->mStatistics.report();
+}
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+void DatabaseInterface::dumpStatistics() const
+{
+    if (!d || !d->mStatistics.isEnabled()) {
+        return;
+    }
 
-            Q_EMIT databaseError();
-        }
+    const auto reportLines = statisticsReport().split(QLatin1Char('\n'), QString::SkipEmptyParts);
+    for (const auto &oneLine : reportLines) {
+        qCInfo(orgKdeElisaDatabaseStatistics) << qPrintable(oneLine);
     }
 
-    qCInfo(orgKdeElisaDatabase) << "finished update to v12 of database schema";
+    qCInfo(orgKdeElisaDatabaseStatistics) << qPrintable(d->mTrackDataCache.report());
 }
 
-void DatabaseInterface::upgradeDatabaseV13()
+bool DatabaseInterface::hasSearchIndex() const
 {
-    qCInfo(orgKdeElisaDatabase) << "begin update to v13 of database schema";
-
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    return d && d->mHasSearchIndex;
+}
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV13` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+QList<qulonglong> DatabaseInterface::searchTracks(const QString &searchText, int maximumCount)
+{
+    auto result = QList<qulonglong>{};
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastError();
+    if (!d || !d->mHasSearchIndex) {
+        return result;
+    }
 
-            Q_EMIT databaseError();
-        }
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+    result = internalSearch(queryForCurrentThread(d->mSearchTracksQuery), searchText, maximumCount);
 
-        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << disableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << disableForeignKeys.lastError();
+    return result;
+}
 
-            Q_EMIT databaseError();
-        }
-    }
+QList<qulonglong> DatabaseInterface::searchAlbums(const QString &searchText, int maximumCount)
+{
+    auto result = QList<qulonglong>{};
 
-    d->mTracksDatabase.transaction();
+    if (!d || !d->mHasSearchIndex) {
+        return result;
+    }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewTracks` ("
-                                                                   "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
-                                                                   "`FileName` VARCHAR(255) NOT NULL, "
-                                                                   "`Priority` INTEGER NOT NULL, "
-                                                                   "`Title` VARCHAR(85) NOT NULL, "
-                                                                   "`ArtistName` VARCHAR(55), "
-                                                                   "`AlbumTitle` VARCHAR(55), "
-                                                                   "`AlbumArtistName` VARCHAR(55), "
-                                                                   "`AlbumPath` VARCHAR(255), "
-                                                                   "`TrackNumber` INTEGER, "
-                                                                   "`DiscNumber` INTEGER, "
-                                                                   "`Duration` INTEGER NOT NULL, "
-                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
-                                                                   "`Genre` VARCHAR(55), "
-                                                                   "`Composer` VARCHAR(55), "
-                                                                   "`Lyricist` VARCHAR(55), "
-                                                                   "`Comment` VARCHAR(255), "
-                                                                   "`Year` INTEGER, "
-                                                                   "`Channels` INTEGER, "
-                                                                   "`BitRate` INTEGER, "
-                                                                   "`SampleRate` INTEGER, "
-                                                                   "`HasEmbeddedCover` BOOLEAN NOT NULL, "
-                                                                   "UNIQUE ("
-                                                                   "`FileName`"
-                                                                   "), "
-                                                                   "UNIQUE ("
-                                                                   "`Priority`, `Title`, `ArtistName`, "
-                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`, "
-                                                                   "`TrackNumber`, `DiscNumber`"
-                                                                   "), "
-                                                                   "CONSTRAINT fk_fileName FOREIGN KEY (`FileName`) "
-                                                                   "REFERENCES `TracksData`(`FileName`) ON DELETE CASCADE, "
-                                                                   "CONSTRAINT fk_artist FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
-                                                                   "CONSTRAINT fk_tracks_album FOREIGN KEY ("
-                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
-                                                                   "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
+    result = internalSearch(queryForCurrentThread(d->mSearchAlbumsQuery), searchText, maximumCount);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastError();
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    {
-        QSqlQuery copyDataQuery(d->mTracksDatabase);
+    return result;
+}
 
-        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `NewTracks` "
-                                                        "SELECT "
-                                                        "t.`ID`, "
-                                                        "t.`FileName`, "
-                                                        "t.`Priority`, "
-                                                        "t.`Title`, "
-                                                        "t.`ArtistName`, "
-                                                        "t.`AlbumTitle`, "
-                                                        "t.`AlbumArtistName`, "
-                                                        "t.`AlbumPath`, "
-                                                        "t.`TrackNumber`, "
-                                                        "t.`DiscNumber`, "
-                                                        "t.`Duration`, "
-                                                        "t.`Rating`, "
-                                                        "t.`Genre`, "
-                                                        "t.`Composer`, "
-                                                        "t.`Lyricist`, "
-                                                        "t.`Comment`, "
-                                                        "t.`Year`, "
-                                                        "t.`Channels`, "
-                                                        "t.`BitRate`, "
-                                                        "t.`SampleRate`, "
-                                                        "t.`HasEmbeddedCover` "
-                                                        "FROM "
-                                                        "`Tracks` t"));
+void DatabaseInterface::applicationAboutToQuit()
+{
+    d->mStopRequest = 1;
+    d->mMaintenanceAllowed.storeRelease(0);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << copyDataQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << copyDataQuery.lastError();
+    dumpStatistics();
 
-            Q_EMIT databaseError();
-        }
+    /* the database thread is stopped right after this call: wait until the pending writes are done */
+    if (QThread::currentThread() == thread() || !thread()->isRunning()) {
+        flushPlayStatistics();
+        syncPlayStatisticsJournal();
+        writeModelSnapshot();
+    } else {
+        QMetaObject::invokeMethod(this, [this]() {
+            flushPlayStatistics();
+            syncPlayStatisticsJournal();
+            writeModelSnapshot();
+        }, Qt::BlockingQueuedConnection);
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    // the snapshot is read on a reader connection, the database thread is free to stop meanwhile
+    d->mModelSnapshotWatcher.waitForFinished();
+}
 
-        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Tracks`"));
+void DatabaseInterface::askRestoredTracks()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastError();
+    Q_EMIT restoredDirectoriesState(internalAllDirectoriesState());
 
-            Q_EMIT databaseError();
-        }
-    }
+    auto result = internalAllFileName();
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    Q_EMIT restoredTracks(result);
 
-        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewTracks` RENAME TO `Tracks`"));
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastError();
+void DatabaseInterface::updateDirectoriesState(const DataTypes::DirectoriesStateType &modifiedDirectories, const QStringList &removedDirectories)
+{
+    /* a directory recorded as unchanged is not scanned again: never record it before its tracks are stored */
+    auto recordedDirectories = DataTypes::DirectoriesStateType{};
 
-            Q_EMIT databaseError();
-        }
+    if (!d->mIncompleteTracksInsertion) {
+        recordedDirectories = modifiedDirectories;
+    } else {
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::updateDirectoriesState" << modifiedDirectories.size()
+                                    << "directories will be scanned again, their tracks were not all stored";
     }
 
-    d->mTracksDatabase.commit();
+    d->mIncompleteTracksInsertion = false;
 
-    {
-        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+    if (recordedDirectories.isEmpty() && removedDirectories.isEmpty()) {
+        return;
+    }
 
-        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+    auto isDelayed = false;
+    auto transactionResult = startOrDelayWriteTransaction([this, recordedDirectories, removedDirectories]() {
+        updateDirectoriesState(recordedDirectories, removedDirectories);
+    }, isDelayed);
+    if (!transactionResult) {
+        return;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << enableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << enableForeignKeys.lastError();
+    for (auto itDirectory = recordedDirectories.constBegin(); itDirectory != recordedDirectories.constEnd(); ++itDirectory) {
+        d->mInsertDirectoryStateQuery.bindValue(QStringLiteral(":path"), itDirectory.key());
+        d->mInsertDirectoryStateQuery.bindValue(QStringLiteral(":modifiedTime"), itDirectory->mModifiedTime.toMSecsSinceEpoch());
+        d->mInsertDirectoryStateQuery.bindValue(QStringLiteral(":entriesCount"), itDirectory->mEntriesCount);
 
+        auto queryResult = execQuery(d->mInsertDirectoryStateQuery);
+
+        if (!queryResult || !d->mInsertDirectoryStateQuery.isActive()) {
             Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateDirectoriesState" << d->mInsertDirectoryStateQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateDirectoriesState" << d->mInsertDirectoryStateQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateDirectoriesState" << d->mInsertDirectoryStateQuery.lastError();
         }
-    }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+        d->mInsertDirectoryStateQuery.finish();
+    }
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksAlbumIndex` ON `Tracks` "
-                                                                  "(`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+    for (const auto &oneDirectory : removedDirectories) {
+        d->mRemoveDirectoryStateQuery.bindValue(QStringLiteral(":path"), oneDirectory);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+        auto queryResult = execQuery(d->mRemoveDirectoryStateQuery);
 
+        if (!queryResult || !d->mRemoveDirectoryStateQuery.isActive()) {
             Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateDirectoriesState" << d->mRemoveDirectoryStateQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateDirectoriesState" << d->mRemoveDirectoryStateQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateDirectoriesState" << d->mRemoveDirectoryStateQuery.lastError();
         }
+
+        d->mRemoveDirectoryStateQuery.finish();
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`ArtistNameIndex` ON `Tracks` "
-                                                                  "(`ArtistName`)"));
+void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time)
+{
+    if (!d) {
+        return;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+    if (d->mPlayStatisticsJournal.isOpen()) {
+        ++d->mPlayStatisticsSequence;
 
-            Q_EMIT databaseError();
+        d->mPlayStatisticsJournal.write(QByteArray::number(d->mPlayStatisticsSequence) + '\t' +
+                                        QByteArray::number(time.toMSecsSinceEpoch()) + '\t' + fileName.toEncoded() + '\n');
+
+        // a crash of the application keeps the written plays, the disk is synchronized once for a batch of plays:
+        // the last commits of the database are not safe from a power loss either with synchronous=NORMAL
+        if (!d->mPlayStatisticsJournal.flush()) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::trackHasStartedPlaying" << d->mPlayStatisticsJournal.fileName();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::trackHasStartedPlaying" << d->mPlayStatisticsJournal.errorString();
         }
-    }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+        if (!d->mPlayStatisticsJournalSyncTimer.isActive()) {
+            d->mPlayStatisticsJournalSyncTimer.start();
+        }
+    }
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`AlbumArtistNameIndex` ON `Tracks` "
-                                                                  "(`AlbumArtistName`)"));
+    auto &pendingPlay = d->mPendingPlays[fileName];
+    if (pendingPlay.mPlayCount == 0) {
+        pendingPlay.mFirstPlayTime = time;
+    }
+    pendingPlay.mLastPlayTime = time;
+    ++pendingPlay.mPlayCount;
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+    if (d->mDatabaseFileName.isEmpty() || d->mPendingPlays.size() >= DatabaseInterfacePrivate::MaximumPendingPlays) {
+        flushPlayStatistics();
+    } else if (!d->mPlayStatisticsTimer.isActive()) {
+        d->mPlayStatisticsTimer.start();
+    }
+}
 
-            Q_EMIT databaseError();
-        }
+void DatabaseInterface::clearData()
+{
+    auto isDelayed = false;
+    auto transactionResult = startOrDelayWriteTransaction([this]() {clearData();}, isDelayed);
+    if (!transactionResult) {
+        return;
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    clearIdCaches();
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksUniqueData` ON `Tracks` "
-                                                                  "(`Title`, `ArtistName`, "
-                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`, "
-                                                                  "`TrackNumber`, `DiscNumber`)"));
+    auto queryResult = execQuery(d->mClearTracksTable);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+    if (!queryResult || !d->mClearTracksTable.isActive()) {
+        Q_EMIT databaseError();
 
-            Q_EMIT databaseError();
-        }
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastError();
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    d->mClearTracksTable.finish();
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksUniqueDataPriority` ON `Tracks` "
-                                                                  "(`Priority`, `Title`, `ArtistName`, "
-                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`, "
-                                                                  "`TrackNumber`, `DiscNumber`)"));
+    queryResult = execQuery(d->mClearTracksDataTable);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+    if (!queryResult || !d->mClearTracksDataTable.isActive()) {
+        Q_EMIT databaseError();
 
-            Q_EMIT databaseError();
-        }
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.lastError();
     }
 
-    {
-        QSqlQuery createTrackIndex(d->mTracksDatabase);
+    d->mClearTracksDataTable.finish();
 
-        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
-                                                                  "IF NOT EXISTS "
-                                                                  "`TracksFileNameIndex` ON `Tracks` "
-                                                                  "(`FileName`)"));
+    queryResult = execQuery(d->mClearDirectoriesTable);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+    if (!queryResult || !d->mClearDirectoriesTable.isActive()) {
+        Q_EMIT databaseError();
 
-            Q_EMIT databaseError();
-        }
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearDirectoriesTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearDirectoriesTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearDirectoriesTable.lastError();
     }
 
-    qCInfo(orgKdeElisaDatabase) << "finished update to v13 of database schema";
-}
+    d->mClearDirectoriesTable.finish();
 
-void DatabaseInterface::upgradeDatabaseV14()
-{
-    qCInfo(orgKdeElisaDatabase) << "begin update to v14 of database schema";
+    queryResult = execQuery(d->mClearAlbumsTable);
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    if (!queryResult || !d->mClearAlbumsTable.isActive()) {
+        Q_EMIT databaseError();
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV14` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastError();
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << createSchemaQuery.lastError();
+    d->mClearAlbumsTable.finish();
 
-            Q_EMIT databaseError();
-        }
+    queryResult = execQuery(d->mClearComposerTable);
+
+    if (!queryResult || !d->mClearComposerTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.lastError();
     }
 
-    {
-        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+    d->mClearComposerTable.finish();
 
-        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+    queryResult = execQuery(d->mClearLyricistTable);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << disableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << disableForeignKeys.lastError();
+    if (!queryResult || !d->mClearLyricistTable.isActive()) {
+        Q_EMIT databaseError();
 
-            Q_EMIT databaseError();
-        }
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearLyricistTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearLyricistTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearLyricistTable.lastError();
     }
 
-    d->mTracksDatabase.transaction();
-
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    d->mClearLyricistTable.finish();
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Radios` ("
-                                                                   "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
-                                                                   "`HttpAddress` VARCHAR(255) NOT NULL, "
-                                                                   "`Priority` INTEGER NOT NULL, "
-                                                                   "`Title` VARCHAR(85) NOT NULL, "
-                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
-                                                                   "`Genre` VARCHAR(55), "
-                                                                   "`Comment` VARCHAR(255), "
-                                                                   "UNIQUE ("
-                                                                   "`HttpAddress`"
-                                                                   "), "
-                                                                   "UNIQUE ("
-                                                                   "`Priority`, `Title`, `HttpAddress`"
-                                                                   ") "
-                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`))"
-                                                                   ));
+    queryResult = execQuery(d->mClearGenreTable);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << createSchemaQuery.lastError();
+    if (!queryResult || !d->mClearGenreTable.isActive()) {
+        Q_EMIT databaseError();
 
-            Q_EMIT databaseError();
-        }
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearGenreTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearGenreTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearGenreTable.lastError();
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    d->mClearGenreTable.finish();
 
-        //Find webradios (french): https://doc.ubuntu-fr.org/liste_radio_france
-        //English: https://www.radio.fr/language/english (to get the link play a radio and look for streamUrl in the html elements page).
-        const auto &result = createSchemaQuery.exec(QStringLiteral("INSERT INTO `Radios` (`HttpAddress`, `Priority`, `Title`) "
-                                        "SELECT 'http://classicrock.stream.ouifm.fr/ouifm3.mp3', 1, 'OuiFM_Classic_Rock' UNION ALL "
-                                        "SELECT 'http://rock70s.stream.ouifm.fr/ouifmseventies.mp3', 1, 'OuiFM_70s' UNION ALL "
-                                        "SELECT 'http://jazzradio.ice.infomaniak.ch/jazzradio-high.mp3', 2 , 'Jazz_Radio' UNION ALL "
-                                        "SELECT 'http://cdn.nrjaudio.fm/audio1/fr/30601/mp3_128.mp3?origine=playerweb', 1, 'Nostalgie' UNION ALL "
-                                        "SELECT 'https://scdn.nrjaudio.fm/audio1/fr/30713/aac_64.mp3?origine=playerweb', 1, 'Nostalgie Johnny' UNION ALL "
-                                        "SELECT 'http://sc-classrock.1.fm:8200', 1, 'Classic rock replay' UNION ALL "
-                                        "SELECT 'http://agnes.torontocast.com:8151/stream', 1, 'Instrumentals Forever' UNION ALL "
-                                        "SELECT 'https://stream.laut.fm/jahfari', 1, 'Jahfari'"
-                                                                   ));
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << createSchemaQuery.lastError();
+    queryResult = execQuery(d->mClearArtistsTable);
 
-            Q_EMIT databaseError();
-        }
-    }
+    if (!queryResult || !d->mClearArtistsTable.isActive()) {
+        Q_EMIT databaseError();
 
-    d->mTracksDatabase.commit();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearArtistsTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearArtistsTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearArtistsTable.lastError();
+    }
 
-    {
-        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+    d->mClearArtistsTable.finish();
 
-        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+    queryResult = execQuery(d->mClearDirectoriesStateQuery);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << enableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << enableForeignKeys.lastError();
+    if (!queryResult || !d->mClearDirectoriesStateQuery.isActive()) {
+        Q_EMIT databaseError();
 
-            Q_EMIT databaseError();
-        }
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearDirectoriesStateQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearDirectoriesStateQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearDirectoriesStateQuery.lastError();
     }
 
-    qCInfo(orgKdeElisaDatabase) << "finished update to v14 of database schema";
-}
-
-void DatabaseInterface::upgradeDatabaseV15()
-{
-    qCInfo(orgKdeElisaDatabase) << "begin update to v15 of database schema";
+    d->mClearDirectoriesStateQuery.finish();
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    increaseGeneration();
+    scheduleModelSnapshot();
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV15` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+    // the changes journaled before cannot bring an older model snapshot up to date
+    if (!d->mDatabaseFileName.isEmpty()) {
+        d->mInsertChangesJournalQuery.bindValue(QStringLiteral(":generation"), d->mGeneration.loadAcquire());
+        d->mInsertChangesJournalQuery.bindValue(QStringLiteral(":kind"), DatabaseInterfacePrivate::ClearedDatabaseChange);
+        d->mInsertChangesJournalQuery.bindValue(QStringLiteral(":id"), 0);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastError();
+        queryResult = execQuery(d->mInsertChangesJournalQuery);
 
+        if (!queryResult || !d->mInsertChangesJournalQuery.isActive()) {
             Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mInsertChangesJournalQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mInsertChangesJournalQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mInsertChangesJournalQuery.lastError();
         }
+
+        d->mInsertChangesJournalQuery.finish();
     }
 
-    {
-        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+    if (d->mHasSearchIndex) {
+        QSqlQuery clearSearchIndexQuery(d->mTracksDatabase);
 
-        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+        for (const auto &oneSearchTable : {QStringLiteral("TracksSearch"), QStringLiteral("AlbumsSearch")}) {
+            queryResult = clearSearchIndexQuery.exec(QStringLiteral("DELETE FROM `%1`").arg(oneSearchTable));
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << disableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << disableForeignKeys.lastError();
+            if (!queryResult) {
+                Q_EMIT databaseError();
 
-            Q_EMIT databaseError();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << clearSearchIndexQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << clearSearchIndexQuery.lastError();
+            }
         }
     }
 
-    d->mTracksDatabase.transaction();
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
 
     {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+        QMutexLocker lock(&d->mChangesHistoryMutex);
+        d->mChangesHistory.clear();
+        d->mPublishedSequenceNumber = d->mGeneration.loadAcquire();
+    }
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `RadiosNew` ("
-                                                                   "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
-                                                                   "`HttpAddress` VARCHAR(255) NOT NULL, "
-                                                                   "`ImageAddress` VARCHAR(255) NOT NULL, "
-                                                                   "`Title` VARCHAR(85) NOT NULL, "
-                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
-                                                                   "`Genre` VARCHAR(55), "
-                                                                   "`Comment` VARCHAR(255), "
-                                                                   "UNIQUE ("
-                                                                   "`HttpAddress`"
-                                                                   "), "
-                                                                   "UNIQUE ("
-                                                                   "`Title`, `HttpAddress`"
-                                                                   ") "
-                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`))"
-                                                                   ));
+    d->mTrackDataCache.clear();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastError();
+    Q_EMIT cleanedDatabase();
+}
 
-            Q_EMIT databaseError();
-        }
-    }
+void DatabaseInterface::initChangesTrackers()
+{
+    d->mModifiedTrackIds.clear();
+    d->mModifiedAlbumIds.clear();
+    d->mModifiedArtistIds.clear();
+    d->mInsertedTracks.clear();
+    d->mInsertedAlbums.clear();
+    d->mInsertedArtists.clear();
+    d->mRemovedTracks.clear();
+    d->mRemovedAlbums.clear();
+    d->mRemovedArtists.clear();
+}
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+void DatabaseInterface::recordModifiedTrack(qulonglong trackId)
+{
+    d->mModifiedTrackIds.insert(trackId);
+}
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("INSERT INTO RadiosNew SELECT ID, HttpAddress, '', Title, Rating, Genre, Comment FROM Radios"));
+void DatabaseInterface::recordModifiedAlbum(qulonglong albumId)
+{
+    d->mModifiedAlbumIds.insert(albumId);
+}
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastError();
+DataTypes::DatabaseChanges DatabaseInterface::collectChanges() const
+{
+    auto changes = DataTypes::DatabaseChanges{};
 
-            Q_EMIT databaseError();
+    changes.mAddedTracks = d->mInsertedTracks.values();
+    changes.mRemovedTracks = d->mRemovedTracks.values();
+    changes.mAddedAlbums = d->mInsertedAlbums.values();
+    changes.mRemovedAlbums = d->mRemovedAlbums.values();
+    changes.mAddedArtists = d->mInsertedArtists.values();
+    changes.mRemovedArtists = d->mRemovedArtists.values();
+
+    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
+        if (!d->mInsertedTracks.contains(trackId) && !d->mRemovedTracks.contains(trackId)) {
+            changes.mModifiedTracks.push_back(trackId);
         }
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
-
-        const auto &result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Radios`"));
+    for (auto albumId : qAsConst(d->mModifiedAlbumIds)) {
+        if (!d->mInsertedAlbums.contains(albumId) && !d->mRemovedAlbums.contains(albumId)) {
+            changes.mModifiedAlbums.push_back(albumId);
+        }
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastError();
+    return changes;
+}
 
-            Q_EMIT databaseError();
-        }
+void DatabaseInterface::publishChanges(DataTypes::DatabaseChanges changes)
+{
+    if (changes.isEmpty()) {
+        return;
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    d->mTrackDataCache.invalidateTracks(changes.mModifiedTracks + changes.mRemovedTracks);
+    if (!changes.mModifiedAlbums.isEmpty() || !changes.mRemovedAlbums.isEmpty()) {
+        d->mTrackDataCache.invalidateAlbums(changes.mModifiedAlbums + changes.mRemovedAlbums);
+    }
 
-        const auto &result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `RadiosNew` RENAME TO `Radios`"));
+    changes.mSequenceNumber = d->mGeneration.loadAcquire();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastError();
+    // the generations committed by other processes before this one are published first
+    if (d->mHasExternalCommits) {
+        d->mHasExternalCommits = false;
 
-            Q_EMIT databaseError();
-        }
+        publishExternalChanges(changes.mSequenceNumber - 1);
     }
 
-    {
-        QSqlQuery createSchemaQuery(d->mTracksDatabase);
-        const auto &result = createSchemaQuery.exec(QStringLiteral("INSERT INTO `Radios` (`HttpAddress`, `ImageAddress`, `Title`) "
-                                        "SELECT 'https://chai5she.cdn.dvmr.fr/francemusique-lofi.mp3', 'https://static.radio.fr/images/broadcasts/07/f7/3366/c44.png', 'France Musique'"
-                                                                   ));
-        if (!result) {
-            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << createSchemaQuery.lastQuery();
-            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << createSchemaQuery.lastError();
+    // the added data is only read once committed: a view loading concurrently sees it in its load or in these signals
+    if (!changes.mAddedArtists.isEmpty() || !changes.mAddedAlbums.isEmpty() || !changes.mAddedTracks.isEmpty()) {
+        auto transactionResult = startTransaction();
+        if (transactionResult) {
+            publishAddedData(changes);
 
-            Q_EMIT databaseError();
+            finishTransaction();
         }
     }
 
-    d->mTracksDatabase.commit();
+    publishEntityChanges(changes);
 
-    {
-        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+    appendPublishedChanges(changes);
+}
 
-        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+void DatabaseInterface::publishEntityChanges(const DataTypes::DatabaseChanges &changes)
+{
+    const auto hasEntityListeners = isSignalConnected(QMetaMethod::fromSignal(&DatabaseInterface::artistRemoved)) ||
+            isSignalConnected(QMetaMethod::fromSignal(&DatabaseInterface::albumRemoved)) ||
+            isSignalConnected(QMetaMethod::fromSignal(&DatabaseInterface::trackRemoved)) ||
+            isSignalConnected(QMetaMethod::fromSignal(&DatabaseInterface::albumModified)) ||
+            isSignalConnected(QMetaMethod::fromSignal(&DatabaseInterface::trackModified));
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << enableForeignKeys.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << enableForeignKeys.lastError();
+    if (!hasEntityListeners) {
+        return;
+    }
 
-            Q_EMIT databaseError();
-        }
+    for (auto trackId : changes.mRemovedTracks) {
+        Q_EMIT trackRemoved(trackId);
     }
 
-    qCInfo(orgKdeElisaDatabase) << "finished update to v15 of database schema";
-}
+    for (auto albumId : changes.mRemovedAlbums) {
+        Q_EMIT albumRemoved(albumId);
+    }
 
-void DatabaseInterface::upgradeDatabaseV16()
-{
+    for (auto artistId : changes.mRemovedArtists) {
+        Q_EMIT artistRemoved(artistId);
+    }
 
-}
+    for (auto albumId : changes.mModifiedAlbums) {
+        Q_EMIT albumModified({{DataTypes::DatabaseIdRole, albumId}}, albumId);
+    }
 
-void DatabaseInterface::checkDatabaseSchema()
-{
-    checkAlbumsTableSchema();
-    if (d->mIsInBadState)
-    {
-        resetDatabase();
+    if (changes.mModifiedTracks.isEmpty()) {
         return;
     }
 
-    checkArtistsTableSchema();
-    if (d->mIsInBadState)
-    {
-        resetDatabase();
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
         return;
     }
 
-    checkComposerTableSchema();
-    if (d->mIsInBadState)
-    {
-        resetDatabase();
-        return;
+    for (auto trackId : changes.mModifiedTracks) {
+        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
     }
 
-    checkGenreTableSchema();
-    if (d->mIsInBadState)
-    {
-        resetDatabase();
-        return;
-    }
+    finishTransaction();
+}
 
-    checkLyricistTableSchema();
-    if (d->mIsInBadState)
-    {
-        resetDatabase();
-        return;
-    }
+void DatabaseInterface::publishAddedData(const DataTypes::DatabaseChanges &changes)
+{
+    if (!changes.mAddedArtists.isEmpty()) {
+        DataTypes::ListArtistDataType newArtists;
 
-    checkTracksTableSchema();
-    if (d->mIsInBadState)
-    {
-        resetDatabase();
-        return;
-    }
+        for (auto artistId : changes.mAddedArtists) {
+            newArtists.push_back({{DataTypes::DatabaseIdRole, artistId}});
+        }
 
-    checkTracksDataTableSchema();
-    if (d->mIsInBadState)
-    {
-        resetDatabase();
-        return;
+        qCInfo(orgKdeElisaDatabase) << "artistsAdded" << newArtists.size();
+        Q_EMIT artistsAdded(newArtists, changes.mSequenceNumber);
     }
-}
 
-void DatabaseInterface::checkAlbumsTableSchema()
-{
-    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Title"),
-                                  QStringLiteral("ArtistName"), QStringLiteral("AlbumPath"),
-                                  QStringLiteral("CoverFileName")};
+    if (!changes.mAddedAlbums.isEmpty()) {
+        DataTypes::ListAlbumDataType newAlbums;
 
-    genericCheckTable(QStringLiteral("Albums"), fieldsList);
-}
+        for (auto albumId : changes.mAddedAlbums) {
+            auto oneAlbum = internalOneAlbumPartialData(albumId);
 
-void DatabaseInterface::checkArtistsTableSchema()
-{
-    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name")};
+            if (!oneAlbum.isEmpty()) {
+                newAlbums.push_back(oneAlbum);
+            }
+        }
 
-    genericCheckTable(QStringLiteral("Artists"), fieldsList);
-}
+        qCInfo(orgKdeElisaDatabase) << "albumsAdded" << newAlbums.size();
+        Q_EMIT albumsAdded(newAlbums, changes.mSequenceNumber);
+    }
 
-void DatabaseInterface::checkComposerTableSchema()
-{
-    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name")};
+    if (!changes.mAddedTracks.isEmpty()) {
+        DataTypes::ListTrackDataType newTracks;
 
-    genericCheckTable(QStringLiteral("Composer"), fieldsList);
-}
+        for (auto trackId : changes.mAddedTracks) {
+            auto oneTrack = internalOneTrackPartialData(trackId);
 
-void DatabaseInterface::checkGenreTableSchema()
-{
-    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name")};
+            if (!oneTrack.isEmpty()) {
+                newTracks.push_back(oneTrack);
+            }
+        }
 
-    genericCheckTable(QStringLiteral("Genre"), fieldsList);
+        qCInfo(orgKdeElisaDatabase) << "tracksAdded" << newTracks.size();
+        Q_EMIT tracksAdded(newTracks, changes.mSequenceNumber);
+    }
 }
 
-void DatabaseInterface::checkLyricistTableSchema()
+void DatabaseInterface::appendPublishedChanges(const DataTypes::DatabaseChanges &changes)
 {
-    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name")};
+    {
+        QMutexLocker lock(&d->mChangesHistoryMutex);
 
-    genericCheckTable(QStringLiteral("Lyricist"), fieldsList);
+        d->mChangesHistory.push_back(changes);
+        d->mPublishedSequenceNumber = changes.mSequenceNumber;
+        while (d->mChangesHistory.size() > DatabaseInterfacePrivate::MaximumChangesHistory) {
+            d->mChangesHistory.pop_front();
+        }
+    }
+
+    Q_EMIT databaseChanged(changes);
 }
 
-void DatabaseInterface::checkTracksTableSchema()
+void DatabaseInterface::journalChanges(const DataTypes::DatabaseChanges &changes)
 {
-    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("FileName"),
-                                  QStringLiteral("Priority"), QStringLiteral("Title"),
-                                  QStringLiteral("ArtistName"), QStringLiteral("AlbumTitle"),
-                                  QStringLiteral("AlbumArtistName"), QStringLiteral("AlbumPath"),
-                                  QStringLiteral("TrackNumber"), QStringLiteral("DiscNumber"),
-                                  QStringLiteral("Duration"), QStringLiteral("Rating"),
-                                  QStringLiteral("Genre"), QStringLiteral("Composer"),
-                                  QStringLiteral("Lyricist"), QStringLiteral("Comment"),
-                                  QStringLiteral("Year"), QStringLiteral("Channels"),
-                                  QStringLiteral("BitRate"), QStringLiteral("SampleRate"),
-                                  QStringLiteral("HasEmbeddedCover")};
+    if (d->mDatabaseFileName.isEmpty() || changes.isEmpty()) {
+        return;
+    }
 
-    genericCheckTable(QStringLiteral("Tracks"), fieldsList);
-}
+    const auto generation = d->mGeneration.loadAcquire();
 
-void DatabaseInterface::checkTracksDataTableSchema()
-{
-    auto fieldsList = QStringList{QStringLiteral("FileName"), QStringLiteral("FileModifiedTime"),
-                                  QStringLiteral("ImportDate"), QStringLiteral("FirstPlayDate"),
-                                  QStringLiteral("LastPlayDate"), QStringLiteral("PlayCounter")};
+    const auto journaledIds = std::initializer_list<std::pair<DatabaseInterfacePrivate::ChangesJournalKind, const QList<qulonglong>*>>{
+        {DatabaseInterfacePrivate::AddedTrackChange, &changes.mAddedTracks},
+        {DatabaseInterfacePrivate::ModifiedTrackChange, &changes.mModifiedTracks},
+        {DatabaseInterfacePrivate::RemovedTrackChange, &changes.mRemovedTracks},
+        {DatabaseInterfacePrivate::AddedAlbumChange, &changes.mAddedAlbums},
+        {DatabaseInterfacePrivate::ModifiedAlbumChange, &changes.mModifiedAlbums},
+        {DatabaseInterfacePrivate::RemovedAlbumChange, &changes.mRemovedAlbums},
+        {DatabaseInterfacePrivate::AddedArtistChange, &changes.mAddedArtists},
+        {DatabaseInterfacePrivate::RemovedArtistChange, &changes.mRemovedArtists},
+    };
 
-    genericCheckTable(QStringLiteral("TracksData"), fieldsList);
-}
+    for (const auto &[kind, ids] : journaledIds) {
+        for (auto oneId : *ids) {
+            d->mInsertChangesJournalQuery.bindValue(QStringLiteral(":generation"), generation);
+            d->mInsertChangesJournalQuery.bindValue(QStringLiteral(":kind"), kind);
+            d->mInsertChangesJournalQuery.bindValue(QStringLiteral(":id"), oneId);
 
-void DatabaseInterface::genericCheckTable(const QString &tableName, const QStringList &expectedColumns)
-{
-    auto columnsList = d->mTracksDatabase.record(tableName);
+            auto queryResult = execQuery(d->mInsertChangesJournalQuery);
 
-    if (columnsList.count() != expectedColumns.count()) {
-        qCInfo(orgKdeElisaDatabase()) << tableName << "table has wrong number of columns" << columnsList.count() << "expected" << expectedColumns.count();
-        d->mIsInBadState = true;
-        return;
-    }
+            if (!queryResult || !d->mInsertChangesJournalQuery.isActive()) {
+                Q_EMIT databaseError();
 
-    for (const auto &oneField : expectedColumns) {
-        if (!columnsList.contains(oneField)) {
-            qCInfo(orgKdeElisaDatabase()) << tableName << "table has missing column" << oneField;
-            d->mIsInBadState = true;
-            return;
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::journalChanges" << d->mInsertChangesJournalQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::journalChanges" << d->mInsertChangesJournalQuery.boundValues();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::journalChanges" << d->mInsertChangesJournalQuery.lastError();
+
+                d->mInsertChangesJournalQuery.finish();
+
+                return;
+            }
+
+            d->mInsertChangesJournalQuery.finish();
         }
     }
-}
-
-void DatabaseInterface::resetDatabase()
-{
-    qCInfo(orgKdeElisaDatabase()) << "Full reset of database due to corrupted database";
 
-    auto listTables = d->mTracksDatabase.tables();
+    if (generation <= DatabaseInterfacePrivate::MaximumChangesHistory) {
+        return;
+    }
 
-    while(!listTables.isEmpty()) {
-        for (const auto &oneTable : listTables) {
-            QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    d->mPruneChangesJournalQuery.bindValue(QStringLiteral(":generation"), generation - DatabaseInterfacePrivate::MaximumChangesHistory);
 
-            qCDebug(orgKdeElisaDatabase()) << "dropping table" << oneTable;
-            createSchemaQuery.exec(QStringLiteral("DROP TABLE ") + oneTable);
-        }
+    auto queryResult = execQuery(d->mPruneChangesJournalQuery);
 
-        listTables = d->mTracksDatabase.tables();
+    if (!queryResult || !d->mPruneChangesJournalQuery.isActive()) {
+        Q_EMIT databaseError();
 
-        if (listTables == QStringList{QStringLiteral("sqlite_sequence")}) {
-            break;
-        }
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::journalChanges" << d->mPruneChangesJournalQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::journalChanges" << d->mPruneChangesJournalQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::journalChanges" << d->mPruneChangesJournalQuery.lastError();
     }
 
-    d->mIsInBadState = false;
+    d->mPruneChangesJournalQuery.finish();
 }
 
-void DatabaseInterface::manageNewDatabaseVersion()
+void DatabaseInterface::publishExternalChanges(qulonglong lastGeneration)
 {
-    int versionBegin = 0;
+    const auto firstGeneration = d->mPublishedSequenceNumber;
 
-    auto listTables = d->mTracksDatabase.tables();
+    if (lastGeneration <= firstGeneration) {
+        return;
+    }
 
-    if (listTables.contains(QLatin1String("DatabaseVersion"))) {
-        manageNewDatabaseVersionInitRequests();
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
 
-        auto queryResult = execQuery(d->mSelectDatabaseVersionQuery);
-        if (!queryResult) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersion" << d->mUpdateDatabaseVersionQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersion" << d->mUpdateDatabaseVersionQuery.lastError();
+    auto externalChanges = QList<DataTypes::DatabaseChanges>{};
+    auto isDatabaseCleared = false;
 
-            Q_EMIT databaseError();
-        }
+    auto queryResult = internalChangesJournal(firstGeneration, lastGeneration, externalChanges, isDatabaseCleared);
+    if (!queryResult) {
+        finishTransaction();
 
-        if(d->mSelectDatabaseVersionQuery.next()) {
-            const auto &currentRecord = d->mSelectDatabaseVersionQuery.record();
+        return;
+    }
 
-            versionBegin = currentRecord.value(0).toInt();
-        }
-    } else if (listTables.contains(QLatin1String("DatabaseVersionV5")) &&
-               !listTables.contains(QLatin1String("DatabaseVersionV9"))) {
-        versionBegin = DatabaseInterface::V9;
-    } else {
-        createDatabaseVersionTable();
-        manageNewDatabaseVersionInitRequests();
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::publishExternalChanges" << "generations" << firstGeneration + 1 << "to" << lastGeneration
+                                << "committed by another process" << externalChanges.size() << "journaled";
 
-        if(listTables.contains(QLatin1String("DatabaseVersionV9"))) {
-            if (!listTables.contains(QLatin1String("DatabaseVersionV11"))) {
-                versionBegin = DatabaseInterface::V11;
-            } else if (!listTables.contains(QLatin1String("DatabaseVersionV12"))) {
-                versionBegin = DatabaseInterface::V12;
-            } else if (!listTables.contains(QLatin1String("DatabaseVersionV13"))) {
-                versionBegin = DatabaseInterface::V13;
-            } else if (!listTables.contains(QLatin1String("DatabaseVersionV14"))) {
-                versionBegin = DatabaseInterface::V14;
-            } else {
-                versionBegin = DatabaseInterface::V15;
-            }
-        } else {
-            createDatabaseV9();
-            versionBegin = DatabaseInterface::V11;
-        }
+    // the oldest generations are no longer in the journal: the listeners asking for the missed changes have to reload
+    if (lastGeneration - firstGeneration > DatabaseInterfacePrivate::MaximumChangesHistory || isDatabaseCleared) {
+        QMutexLocker lock(&d->mChangesHistoryMutex);
+        d->mChangesHistory.clear();
     }
 
-    int version = versionBegin;
-    for (; version-1 != DatabaseInterface::V16; version++) {
-        callUpgradeFunctionForVersion(static_cast<DatabaseVersion>(version));
-    }
+    for (const auto &oneChange : qAsConst(externalChanges)) {
+        publishAddedData(oneChange);
 
-    if (version-1 != versionBegin) {
-        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV9"));
-        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV11"));
-        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV12"));
-        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV13"));
-        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV14"));
+        appendPublishedChanges(oneChange);
     }
 
-    setDatabaseVersionInTable(DatabaseInterface::V16);
-
-    checkDatabaseSchema();
+    finishTransaction();
 }
 
-void DatabaseInterface::dropTable(QString query)
+bool DatabaseInterface::internalChangesJournal(qulonglong firstGeneration, qulonglong lastGeneration,
+                                               QList<DataTypes::DatabaseChanges> &journaledChanges, bool &isDatabaseCleared)
 {
-    QSqlQuery dropQueryQuery(d->mTracksDatabase);
+    isDatabaseCleared = false;
 
-    const auto &result = dropQueryQuery.exec(query);
+    auto &currentQuery = queryForCurrentThread(d->mSelectChangesJournalQuery);
 
-    if (!result) {
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::dropTable" << dropQueryQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::dropTable" << dropQueryQuery.lastError();
+    currentQuery.bindValue(QStringLiteral(":firstGeneration"), firstGeneration);
+    currentQuery.bindValue(QStringLiteral(":lastGeneration"), lastGeneration);
 
-        Q_EMIT databaseError();
-    }
-}
+    auto queryResult = execQuery(currentQuery);
 
-void DatabaseInterface::setDatabaseVersionInTable(int version)
-{
-    d->mUpdateDatabaseVersionQuery.bindValue(QStringLiteral(":version"), version);
+    if (!queryResult || !currentQuery.isSelect() || !currentQuery.isActive()) {
+        Q_EMIT databaseError();
 
-    auto queryResult = execQuery(d->mUpdateDatabaseVersionQuery);
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalChangesJournal" << currentQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalChangesJournal" << currentQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalChangesJournal" << currentQuery.lastError();
 
-    if (!queryResult) {
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::setDatabaseVersionInTable" << d->mUpdateDatabaseVersionQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::setDatabaseVersionInTable" << d->mUpdateDatabaseVersionQuery.lastError();
+        currentQuery.finish();
 
-        Q_EMIT databaseError();
+        return false;
     }
-}
 
-void DatabaseInterface::createDatabaseVersionTable()
-{
-    qCInfo(orgKdeElisaDatabase) << "begin creation of DatabaseVersion table";
-    QSqlQuery createSchemaQuery(d->mTracksDatabase);
+    while (currentQuery.next()) {
+        const auto generation = currentQuery.value(0).toULongLong();
+        const auto kind = currentQuery.value(1).toInt();
+        const auto id = currentQuery.value(2).toULongLong();
 
-    const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersion` (`Version` INTEGER PRIMARY KEY NOT NULL default 0)"));
+        if (journaledChanges.isEmpty() || journaledChanges.constLast().mSequenceNumber != generation) {
+            journaledChanges.push_back({});
+            journaledChanges.last().mSequenceNumber = generation;
+        }
 
-    if (!result) {
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseVersionTable" << createSchemaQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseVersionTable" << createSchemaQuery.lastError();
+        auto &changes = journaledChanges.last();
 
-        Q_EMIT databaseError();
+        switch (kind)
+        {
+        case DatabaseInterfacePrivate::AddedTrackChange:
+            changes.mAddedTracks.push_back(id);
+            break;
+        case DatabaseInterfacePrivate::ModifiedTrackChange:
+            changes.mModifiedTracks.push_back(id);
+            break;
+        case DatabaseInterfacePrivate::RemovedTrackChange:
+            changes.mRemovedTracks.push_back(id);
+            break;
+        case DatabaseInterfacePrivate::AddedAlbumChange:
+            changes.mAddedAlbums.push_back(id);
+            break;
+        case DatabaseInterfacePrivate::ModifiedAlbumChange:
+            changes.mModifiedAlbums.push_back(id);
+            break;
+        case DatabaseInterfacePrivate::RemovedAlbumChange:
+            changes.mRemovedAlbums.push_back(id);
+            break;
+        case DatabaseInterfacePrivate::AddedArtistChange:
+            changes.mAddedArtists.push_back(id);
+            break;
+        case DatabaseInterfacePrivate::RemovedArtistChange:
+            changes.mRemovedArtists.push_back(id);
+            break;
+        case DatabaseInterfacePrivate::ClearedDatabaseChange:
+            isDatabaseCleared = true;
+            break;
+        }
     }
 
-    const auto resultInsert = createSchemaQuery.exec(QStringLiteral("INSERT INTO `DatabaseVersion` VALUES (0)"));
-    if (!resultInsert) {
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseVersionTable" << createSchemaQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseVersionTable" << createSchemaQuery.lastError();
+    currentQuery.finish();
 
-        Q_EMIT databaseError();
-    }
+    return true;
 }
 
-void DatabaseInterface::manageNewDatabaseVersionInitRequests()
+void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers)
 {
-    {
-        auto  initDatabaseVersionQuery = QStringLiteral("UPDATE `DatabaseVersion` set `Version` = :version ");
-
-        auto result = prepareQuery(d->mUpdateDatabaseVersionQuery, initDatabaseVersionQuery);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersionInitRequests" << d->mUpdateDatabaseVersionQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersionInitRequests" << d->mUpdateDatabaseVersionQuery.lastError();
+    qCDebug(orgKdeElisaDatabase()) << "DatabaseInterface::insertTracksList" << tracks.count();
+    if (d->mStopRequest == 1) {
+        d->mIncompleteTracksInsertion = true;
+        Q_EMIT finishInsertingTracksList();
+        return;
+    }
 
-            Q_EMIT databaseError();
-        }
+    auto isDelayed = false;
+    auto transactionResult = startOrDelayWriteTransaction([this, tracks, covers]() {insertTracksList(tracks, covers);}, isDelayed);
+    if (isDelayed) {
+        return;
     }
 
-    {
-        auto  selectDatabaseVersionQuery = QStringLiteral("SELECT versionTable.`Version` FROM `DatabaseVersion` versionTable");
+    if (!transactionResult) {
+        d->mIncompleteTracksInsertion = true;
+        Q_EMIT finishInsertingTracksList();
+        return;
+    }
 
-        auto result = prepareQuery(d->mSelectDatabaseVersionQuery, selectDatabaseVersionQuery);
+    initChangesTrackers();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersionInitRequests" << d->mSelectDatabaseVersionQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersionInitRequests" << d->mSelectDatabaseVersionQuery.lastError();
+    auto existingTracks = QHash<QString, qulonglong>{};
+    auto newTrackFiles = QStringList{};
 
-            Q_EMIT databaseError();
+    if (!prepareTracksListInsertion(tracks, existingTracks, newTrackFiles)) {
+        rollBackTransaction();
+        d->mIncompleteTracksInsertion = true;
+        Q_EMIT finishInsertingTracksList();
+        return;
+    }
+
+    auto processedFiles = QSet<QString>{};
+
+    for(const auto &oneTrack : tracks) {
+        const auto &trackFileName = oneTrack.resourceURI().toString();
+
+        auto itExistingTrack = existingTracks.constFind(trackFileName);
+        if (processedFiles.contains(trackFileName) || (itExistingTrack != existingTracks.constEnd() && itExistingTrack.value() != 0)) {
+            updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
+        }
+
+        processedFiles.insert(trackFileName);
+
+        bool isInserted = false;
+
+        const auto insertedTrackId = internalInsertTrack(oneTrack, covers, isInserted);
+
+        if (isInserted && insertedTrackId != 0) {
+            d->mInsertedTracks.insert(insertedTrackId);
+        }
+
+        if (d->mStopRequest == 1) {
+            d->mIncompleteTracksInsertion = true;
+
+            // origins of the files not yet processed were inserted in bulk: forget them to rescan them next time
+            for (const auto &oneNewFile : qAsConst(newTrackFiles)) {
+                if (!processedFiles.contains(oneNewFile)) {
+                    removeTrackOrigin(QUrl(oneNewFile));
+                }
+            }
+
+            updateAlbumSummariesForChanges();
+            updateSearchIndexForChanges();
+
+            logIdCachesStatistics();
+
+            if (!d->mInsertedTracks.isEmpty() || !d->mModifiedTrackIds.isEmpty() || !d->mModifiedAlbumIds.isEmpty()) {
+                increaseGeneration();
+                scheduleModelSnapshot();
+            }
+
+            const auto changes = collectChanges();
+
+            journalChanges(changes);
+
+            transactionResult = finishTransaction();
+            if (!transactionResult) {
+                Q_EMIT finishInsertingTracksList();
+                return;
+            }
+
+            publishChanges(changes);
+
+            Q_EMIT finishInsertingTracksList();
+            return;
         }
     }
-}
 
-void DatabaseInterface::callUpgradeFunctionForVersion(DatabaseVersion databaseVersion)
-{
-    switch(databaseVersion)
-    {
-    case DatabaseInterface::V9:
-        upgradeDatabaseV9();
-        break;
-    case DatabaseInterface::V11:
-        upgradeDatabaseV11();
-        break;
-    case DatabaseInterface::V12:
-        upgradeDatabaseV12();
-        break;
-    case DatabaseInterface::V13:
-        upgradeDatabaseV13();
-        break;
-    case DatabaseInterface::V14:
-        upgradeDatabaseV14();
-        break;
-    case DatabaseInterface::V15:
-        upgradeDatabaseV15();
-        break;
-    case DatabaseInterface::V16:
-        upgradeDatabaseV16();
-        break;
+    updateAlbumSummariesForChanges();
+    updateSearchIndexForChanges();
+
+    logIdCachesStatistics();
+
+    if (!d->mInsertedTracks.isEmpty() || !d->mModifiedTrackIds.isEmpty() || !d->mModifiedAlbumIds.isEmpty()) {
+        increaseGeneration();
+        scheduleModelSnapshot();
+    }
+
+    const auto changes = collectChanges();
+
+    journalChanges(changes);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        d->mIncompleteTracksInsertion = true;
+        Q_EMIT finishInsertingTracksList();
+        return;
     }
+
+    publishChanges(changes);
+
+    Q_EMIT finishInsertingTracksList();
 }
 
-void DatabaseInterface::initRequest()
+void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
 {
-    auto transactionResult = startTransaction();
+    auto isDelayed = false;
+    auto transactionResult = startOrDelayWriteTransaction([this, removedTracks]() {removeTracksList(removedTracks);}, isDelayed);
+    if (isDelayed) {
+        return;
+    }
+
     if (!transactionResult) {
+        Q_EMIT finishRemovingTracksList();
         return;
     }
 
-    {
-        auto selectAlbumQueryText = QStringLiteral("SELECT "
-                                                   "album.`ID`, "
-                                                   "album.`Title`, "
-                                                   "album.`ArtistName`, "
-                                                   "album.`AlbumPath`, "
-                                                   "album.`CoverFileName`, "
-                                                   "("
-                                                   "SELECT "
-                                                   "COUNT(*) "
-                                                   "FROM "
-                                                   "`Tracks` tracks3 "
-                                                   "WHERE "
-                                                   "tracks3.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks3.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracks3.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks3.`AlbumPath` = album.`AlbumPath` "
-                                                   ") as `TracksCount`, "
-                                                   "("
-                                                   "SELECT "
-                                                   "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                   "FROM "
-                                                   "`Tracks` tracks2 "
-                                                   "WHERE "
-                                                   "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                   ") as `IsSingleDiscAlbum`, "
-                                                   "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
-                                                   "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
-                                                   "MAX(tracks.`Rating`) as HighestRating, "
-                                                   "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
-                                                   "( "
-                                                   "SELECT tracksCover.`FileName` "
-                                                   "FROM "
-                                                   "`Tracks` tracksCover "
-                                                   "WHERE "
-                                                   "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                   "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL "
-                                                   ") "
-                                                   ") AND "
-                                                   "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                   ") as EmbeddedCover "
-                                                   "FROM "
-                                                   "`Albums` album LEFT JOIN "
-                                                   "`Tracks` tracks ON "
-                                                   "tracks.`AlbumTitle` = album.`Title` AND "
-                                                   "("
-                                                   "tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "("
-                                                   "tracks.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks.`AlbumPath` = album.`AlbumPath`"
-                                                   "LEFT JOIN "
-                                                   "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                   "WHERE "
-                                                   "album.`ID` = :albumId "
-                                                   "GROUP BY album.`ID`");
+    initChangesTrackers();
 
-        auto result = prepareQuery(d->mSelectAlbumQuery, selectAlbumQueryText);
+    internalRemoveTracksList(removedTracks);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumQuery.lastError();
+    const auto changes = collectChanges();
 
-            Q_EMIT databaseError();
-        }
+    if (!changes.isEmpty()) {
+        increaseGeneration();
+        scheduleModelSnapshot();
     }
 
-    {
-        auto selectAllGenresText = QStringLiteral("SELECT "
-                                                  "genre.`ID`, "
-                                                  "genre.`Name` "
-                                                  "FROM `Genre` genre "
-                                                  "ORDER BY genre.`Name` COLLATE NOCASE");
+    journalChanges(changes);
 
-        auto result = prepareQuery(d->mSelectAllGenresQuery, selectAllGenresText);
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        Q_EMIT finishRemovingTracksList();
+        return;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllGenresQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllGenresQuery.lastError();
+    publishChanges(changes);
 
-            Q_EMIT databaseError();
-        }
+    Q_EMIT finishRemovingTracksList();
+}
+
+void DatabaseInterface::moveTrackFile(const QUrl &oldFileName, const QUrl &newFileName)
+{
+    auto isDelayed = false;
+    auto transactionResult = startOrDelayWriteTransaction([this, oldFileName, newFileName]() {moveTrackFile(oldFileName, newFileName);}, isDelayed);
+    if (isDelayed || !transactionResult) {
+        return;
     }
 
-    {
-        auto selectAllAlbumsText = QStringLiteral("SELECT "
-                                                  "album.`ID`, "
-                                                  "album.`Title`, "
-                                                  "album.`ArtistName` as SecondaryText, "
-                                                  "album.`CoverFileName`, "
-                                                  "album.`ArtistName`, "
-                                                  "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
-                                                  "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
-                                                  "MAX(tracks.`Rating`) as HighestRating, "
-                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
-                                                  "FROM "
-                                                  "`Albums` album, "
-                                                  "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                  "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ") "
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
-                                                  "ORDER BY album.`Title` COLLATE NOCASE");
+    initChangesTrackers();
+
+    // the track keeps its id and its play statistics, only its file name changes
+    const auto trackId = internalTrackIdFromFileName(oldFileName);
+    if (trackId == 0) {
+        finishTransaction();
+        return;
+    }
 
-        auto result = prepareQuery(d->mSelectAllAlbumsShortQuery, selectAllAlbumsText);
+    DatabaseInterfacePrivate::bindFileName(d->mInsertDirectory, newFileName);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortQuery.lastError();
+    auto queryResult = execQuery(d->mInsertDirectory);
 
-            Q_EMIT databaseError();
-        }
+    if (!queryResult || !d->mInsertDirectory.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::moveTrackFile" << d->mInsertDirectory.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::moveTrackFile" << d->mInsertDirectory.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::moveTrackFile" << d->mInsertDirectory.lastError();
+
+        d->mInsertDirectory.finish();
+        rollBackTransaction();
+        return;
     }
 
-    {
-        auto selectAllAlbumsText = QStringLiteral("SELECT "
-                                                  "album.`ID`, "
-                                                  "album.`Title`, "
-                                                  "album.`ArtistName` as SecondaryText, "
-                                                  "album.`CoverFileName`, "
-                                                  "album.`ArtistName`, "
-                                                  "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
-                                                  "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
-                                                  "MAX(tracks.`Rating`) as HighestRating, "
-                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
-                                                  "FROM "
-                                                  "`Albums` album, "
-                                                  "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                  "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` AND "
-                                                  "EXISTS ("
-                                                  "  SELECT tracks2.`Genre` "
-                                                  "  FROM "
-                                                  "  `Tracks` tracks2, "
-                                                  "  `Genre` genre2 "
-                                                  "  WHERE "
-                                                  "  tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "  (tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "   (tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "    album.`ArtistName` IS NULL"
-                                                  "   )"
-                                                  "  ) AND "
-                                                  "  tracks2.`Genre` = genre2.`Name` AND "
-                                                  "  genre2.`Name` = :genreFilter AND "
-                                                  "  (tracks2.`ArtistName` = :artistFilter OR tracks2.`AlbumArtistName` = :artistFilter) "
-                                                  ") "
-                                                  "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
-                                                  "ORDER BY album.`Title` COLLATE NOCASE");
+    d->mInsertDirectory.finish();
 
-        auto result = prepareQuery(d->mSelectAllAlbumsShortWithGenreArtistFilterQuery, selectAllAlbumsText);
+    const auto &[newDirectory, newBaseName] = DatabaseInterfacePrivate::splitFileName(newFileName.toString());
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastError();
+    DatabaseInterfacePrivate::bindFileName(d->mUpdateTrackFileNameQuery, oldFileName);
+    d->mUpdateTrackFileNameQuery.bindValue(QStringLiteral(":newDirectory"), newDirectory);
+    d->mUpdateTrackFileNameQuery.bindValue(QStringLiteral(":newBaseName"), newBaseName);
 
-            Q_EMIT databaseError();
-        }
+    queryResult = execQuery(d->mUpdateTrackFileNameQuery);
+
+    if (!queryResult || !d->mUpdateTrackFileNameQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::moveTrackFile" << d->mUpdateTrackFileNameQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::moveTrackFile" << d->mUpdateTrackFileNameQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::moveTrackFile" << d->mUpdateTrackFileNameQuery.lastError();
+
+        d->mUpdateTrackFileNameQuery.finish();
+        rollBackTransaction();
+        return;
     }
 
-    {
-        auto selectAllAlbumsText = QStringLiteral("SELECT "
-                                                  "album.`ID`, "
-                                                  "album.`Title`, "
-                                                  "album.`ArtistName` as SecondaryText, "
-                                                  "album.`CoverFileName`, "
-                                                  "album.`ArtistName`, "
-                                                  "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
-                                                  "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
-                                                  "MAX(tracks.`Rating`) as HighestRating, "
-                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
-                                                  "FROM "
-                                                  "`Albums` album, "
-                                                  "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                  "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` AND "
-                                                  "EXISTS ("
-                                                  "  SELECT tracks2.`Genre` "
-                                                  "  FROM "
-                                                  "  `Tracks` tracks2 "
-                                                  "  WHERE "
-                                                  "  tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "  ( "
-                                                  "    tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "    ( "
-                                                  "      tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "      album.`ArtistName` IS NULL "
-                                                  "    )"
-                                                  "  ) AND "
-                                                  "  (tracks2.`ArtistName` = :artistFilter OR tracks2.`AlbumArtistName` = :artistFilter) "
-                                                  ") "
-                                                  "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
-                                                  "ORDER BY album.`Title` COLLATE NOCASE");
+    d->mUpdateTrackFileNameQuery.finish();
 
-        auto result = prepareQuery(d->mSelectAllAlbumsShortWithArtistFilterQuery, selectAllAlbumsText);
+    d->mRemoveUnusedDirectory.bindValue(QStringLiteral(":directory"), DatabaseInterfacePrivate::splitFileName(oldFileName.toString()).first);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithArtistFilterQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithArtistFilterQuery.lastError();
+    queryResult = execQuery(d->mRemoveUnusedDirectory);
 
-            Q_EMIT databaseError();
-        }
+    if (!queryResult || !d->mRemoveUnusedDirectory.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::moveTrackFile" << d->mRemoveUnusedDirectory.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::moveTrackFile" << d->mRemoveUnusedDirectory.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::moveTrackFile" << d->mRemoveUnusedDirectory.lastError();
     }
 
-    {
-        auto selectAllArtistsWithFilterText = QStringLiteral("SELECT artists.`ID`, "
-                                                             "artists.`Name`, "
-                                                             "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
-                                                             "FROM `Artists` artists  LEFT JOIN "
-                                                             "`Tracks` tracks ON artists.`Name` = tracks.`ArtistName` LEFT JOIN "
-                                                             "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                             "GROUP BY artists.`ID` "
-                                                             "ORDER BY artists.`Name` COLLATE NOCASE");
+    d->mRemoveUnusedDirectory.finish();
 
-        auto result = prepareQuery(d->mSelectAllArtistsQuery, selectAllArtistsWithFilterText);
+    recordModifiedTrack(trackId);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsQuery.lastError();
+    const auto changes = collectChanges();
 
-            Q_EMIT databaseError();
-        }
+    increaseGeneration();
+    scheduleModelSnapshot();
+
+    journalChanges(changes);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
     }
 
-    {
-        auto selectAllArtistsWithGenreFilterText = QStringLiteral("SELECT artists.`ID`, "
-                                                                  "artists.`Name`, "
-                                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
-                                                                  "FROM `Artists` artists  LEFT JOIN "
-                                                                  "`Tracks` tracks ON (tracks.`ArtistName` = artists.`Name` OR tracks.`AlbumArtistName` = artists.`Name`) LEFT JOIN "
-                                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                                  "WHERE "
-                                                                  "EXISTS ("
-                                                                  "  SELECT tracks2.`Genre` "
-                                                                  "  FROM "
-                                                                  "  `Tracks` tracks2, "
-                                                                  "  `Genre` genre2 "
-                                                                  "  WHERE "
-                                                                  "  (tracks2.`ArtistName` = artists.`Name` OR tracks2.`AlbumArtistName` = artists.`Name`) AND "
-                                                                  "  tracks2.`Genre` = genre2.`Name` AND "
-                                                                  "  genre2.`Name` = :genreFilter "
-                                                                  ") "
-                                                                  "GROUP BY artists.`ID` "
-                                                                  "ORDER BY artists.`Name` COLLATE NOCASE");
+    // plays not yet written follow the file
+    const auto itPendingPlay = d->mPendingPlays.find(oldFileName);
+    if (itPendingPlay != d->mPendingPlays.end()) {
+        const auto pendingPlay = *itPendingPlay;
+        d->mPendingPlays.erase(itPendingPlay);
+        d->mPendingPlays[newFileName] = pendingPlay;
+    }
 
-        auto result = prepareQuery(d->mSelectAllArtistsWithGenreFilterQuery, selectAllArtistsWithGenreFilterText);
+    publishChanges(changes);
+}
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsWithGenreFilterQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsWithGenreFilterQuery.lastError();
+bool DatabaseInterface::startTransaction() const
+{
+    auto result = false;
 
-            Q_EMIT databaseError();
+    auto currentDatabase = databaseForCurrentThread();
+
+    auto transactionResult = currentDatabase.transaction();
+    if (!transactionResult) {
+        qCDebug(orgKdeElisaDatabase) << "transaction failed" << currentDatabase.lastError() << currentDatabase.lastError().driverText();
+
+        return result;
+    }
+
+    if (d->mStatistics.isEnabled()) {
+        d->mStatistics.transactionStarted();
+    }
+
+    result = true;
+
+    return result;
+}
+
+bool DatabaseInterface::startWriteTransaction()
+{
+    auto result = false;
+
+    // the write lock is taken at once: a deferred transaction started before a commit of another process could not write
+    QSqlQuery beginQuery(d->mTracksDatabase);
+
+    // a write waiting for another process is delayed and tried again later instead of blocking the database thread
+    beginQuery.exec(QStringLiteral("PRAGMA busy_timeout = %1").arg(DatabaseInterfacePrivate::WriteLockTimeout));
+
+    auto transactionResult = beginQuery.exec(QStringLiteral("BEGIN IMMEDIATE"));
+
+    // SQLITE_BUSY: another process kept the write lock longer than the busy timeout
+    d->mWriteLockBusy = !transactionResult && beginQuery.lastError().nativeErrorCode() == QLatin1String("5");
+
+    if (!transactionResult) {
+        qCDebug(orgKdeElisaDatabase) << "transaction failed" << beginQuery.lastError() << beginQuery.lastError().driverText();
+    }
+
+    beginQuery.exec(QStringLiteral("PRAGMA busy_timeout = %1").arg(DatabaseInterfacePrivate::BusyTimeout));
+
+    if (!transactionResult) {
+        return result;
+    }
+
+    if (d->mStatistics.isEnabled()) {
+        d->mStatistics.transactionStarted();
+    }
+
+    synchronizeWithExternalCommits();
+
+    result = true;
+
+    return result;
+}
+
+bool DatabaseInterface::startOrDelayWriteTransaction(const std::function<void()> &write, bool &isDelayed)
+{
+    isDelayed = false;
+
+    // the writes are applied in order: wait behind the ones already delayed
+    if (!d->mDelayedWrites.empty()) {
+        d->mDelayedWrites.push_back(write);
+        isDelayed = true;
+
+        return false;
+    }
+
+    if (startWriteTransaction()) {
+        return true;
+    }
+
+    if (!d->mWriteLockBusy) {
+        return false;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::startOrDelayWriteTransaction" << "database locked by another process, write delayed";
+
+    d->mDelayedWrites.push_back(write);
+    d->mDelayedWritesTimer.start();
+    isDelayed = true;
+
+    return false;
+}
+
+void DatabaseInterface::retryDelayedWrites()
+{
+    auto delayedWrites = std::move(d->mDelayedWrites);
+    d->mDelayedWrites.clear();
+
+    while (!delayedWrites.empty()) {
+        const auto oneWrite = std::move(delayedWrites.front());
+        delayedWrites.pop_front();
+
+        oneWrite();
+
+        // still locked: the write was delayed again, the others stay behind it
+        if (!d->mDelayedWrites.empty()) {
+            std::move(delayedWrites.begin(), delayedWrites.end(), std::back_inserter(d->mDelayedWrites));
+
+            return;
         }
     }
+}
 
-    {
-        auto artistMatchGenreText = QStringLiteral("SELECT artists.`ID` "
-                                                   "FROM `Artists` artists  LEFT JOIN "
-                                                   "`Tracks` tracks ON (tracks.`ArtistName` = artists.`Name` OR tracks.`AlbumArtistName` = artists.`Name`) LEFT JOIN "
-                                                   "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                   "WHERE "
-                                                   "EXISTS ("
-                                                   "  SELECT tracks2.`Genre` "
-                                                   "  FROM "
-                                                   "  `Tracks` tracks2, "
-                                                   "  `Genre` genre2 "
-                                                   "  WHERE "
-                                                   "  (tracks2.`ArtistName` = artists.`Name` OR tracks2.`AlbumArtistName` = artists.`Name`) AND "
-                                                   "  tracks2.`Genre` = genre2.`Name` AND "
-                                                   "  genre2.`Name` = :genreFilter "
-                                                   ") AND "
-                                                   "artists.`ID` = :databaseId");
+bool DatabaseInterface::finishTransaction() const
+{
+    auto result = false;
 
-        auto result = prepareQuery(d->mArtistMatchGenreQuery, artistMatchGenreText);
+    auto currentDatabase = databaseForCurrentThread();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mArtistMatchGenreQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mArtistMatchGenreQuery.lastError();
+    auto transactionResult = currentDatabase.commit();
 
-            Q_EMIT databaseError();
+    if (d->mStatistics.isEnabled()) {
+        d->mStatistics.transactionFinished();
+    }
+
+    if (!transactionResult) {
+        qCDebug(orgKdeElisaDatabase) << "commit failed" << currentDatabase.lastError() << currentDatabase.lastError().nativeErrorCode();
+
+        clearIdCaches();
+
+        return result;
+    }
+
+    result = true;
+
+    return result;
+}
+
+bool DatabaseInterface::rollBackTransaction() const
+{
+    auto result = false;
+
+    clearIdCaches();
+
+    auto currentDatabase = databaseForCurrentThread();
+
+    auto transactionResult = currentDatabase.rollback();
+
+    if (!transactionResult) {
+        qCDebug(orgKdeElisaDatabase) << "commit failed" << currentDatabase.lastError() << currentDatabase.lastError().nativeErrorCode();
+
+        return result;
+    }
+
+    result = true;
+
+    return result;
+}
+
+DatabaseReadConnection *DatabaseInterface::readConnectionForCurrentThread() const
+{
+    if (d->mDatabaseFileName.isEmpty() || QThread::currentThread() == d->mWriterThread) {
+        return nullptr;
+    }
+
+    auto readerThread = QThread::currentThread();
+
+    QMutexLocker locker(&d->mReadConnections->mMutex);
+
+    auto &readConnection = d->mReadConnections->mConnections[readerThread];
+
+    if (!readConnection) {
+        ++d->mReadConnections->mOpenedCount;
+
+        readConnection = std::make_shared<DatabaseReadConnection>();
+        readConnection->mConnectionName = d->mConnectionName + QStringLiteral("-reader-") + QString::number(d->mReadConnections->mOpenedCount);
+        readConnection->mDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), readConnection->mConnectionName);
+        readConnection->mDatabase.setDatabaseName(QStringLiteral("file:") + d->mDatabaseFileName);
+        readConnection->mDatabase.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=%1").arg(DatabaseInterfacePrivate::BusyTimeout));
+
+        readConnection->mStatements = std::make_unique<DatabaseStatementRegistry>(readConnection->mDatabase);
+        readConnection->mStatements->mPrepareErrorHandler = d->mStatements.mPrepareErrorHandler;
+        readConnection->mStatements->mStatistics = &d->mStatistics;
+
+        auto result = readConnection->mDatabase.open();
+        if (result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::readConnectionForCurrentThread" << readConnection->mConnectionName << "read-only database open";
+
+            applyStorageSettings(readConnection->mDatabase);
+        } else {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::readConnectionForCurrentThread" << readConnection->mConnectionName << readConnection->mDatabase.lastError();
         }
+
+        // finished is emitted by the reader thread itself, the connection is closed on the thread that used it
+        QObject::connect(readerThread, &QThread::finished, readerThread,
+                         [readConnections = d->mReadConnections, readerThread]() {readConnections->release(readerThread);},
+                         Qt::DirectConnection);
     }
 
-    {
-        auto selectAllComposersWithFilterText = QStringLiteral("SELECT `ID`, "
-                                                               "`Name` "
-                                                               "FROM `Artists` "
-                                                               "ORDER BY `Name` COLLATE NOCASE");
+    return readConnection.get();
+}
 
-        auto result = prepareQuery(d->mSelectAllComposersQuery, selectAllComposersWithFilterText);
+QSqlDatabase DatabaseInterface::databaseForCurrentThread() const
+{
+    auto readConnection = readConnectionForCurrentThread();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastError();
+    if (!readConnection) {
+        return d->mTracksDatabase;
+    }
 
-            Q_EMIT databaseError();
+    return readConnection->mDatabase;
+}
+
+DatabaseStatement &DatabaseInterface::queryForCurrentThread(DatabaseStatement &statement)
+{
+    auto readConnection = readConnectionForCurrentThread();
+
+    if (!readConnection) {
+        return statement;
+    }
+
+    auto itQuery = readConnection->mQueries.find(&statement);
+    if (itQuery == readConnection->mQueries.end()) {
+        itQuery = readConnection->mQueries.emplace(&statement, std::make_unique<DatabaseStatement>(*readConnection->mStatements)).first;
+
+        itQuery->second->setQueryText(statement.queryText());
+    }
+
+    return *itQuery->second;
+}
+
+void DatabaseInterface::initStorageSettings(const StorageSettings &storageSettings)
+{
+    d->mStorageSettings = storageSettings;
+
+    const auto databaseSize = d->mDatabaseFileName.isEmpty() ? qlonglong{0} : QFileInfo(d->mDatabaseFileName).size();
+
+    auto physicalMemory = qlonglong{0};
+#if defined Q_OS_UNIX
+    const auto pagesCount = sysconf(_SC_PHYS_PAGES);
+    const auto pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pagesCount > 0 && pageSize > 0) {
+        physicalMemory = static_cast<qlonglong>(pagesCount) * pageSize;
+    }
+#endif
+
+    // without knowing the memory, stay with the minimum sizes
+    const auto memoryBudget = [physicalMemory](qlonglong wanted, qlonglong minimum, qlonglong maximum, int memoryDivisor) {
+        auto result = std::min(wanted, maximum);
+        if (physicalMemory > 0) {
+            result = std::min(result, physicalMemory / memoryDivisor);
+        } else {
+            result = minimum;
         }
+        return std::max(result, minimum);
+    };
+
+    // at most 1/64 of the memory (in KiB) for the page cache and 1/16 for the memory mapping
+    if (d->mStorageSettings.mCacheSize < 0) {
+        d->mStorageSettings.mCacheSize = memoryBudget(databaseSize / 1024, DatabaseInterfacePrivate::MinimumCacheSize,
+                                                      DatabaseInterfacePrivate::MaximumCacheSize, 64 * 1024);
     }
 
-    {
-        auto selectAllLyricistsWithFilterText = QStringLiteral("SELECT `ID`, "
-                                                               "`Name` "
-                                                               "FROM `Lyricist` "
-                                                               "ORDER BY `Name` COLLATE NOCASE");
+    if (d->mStorageSettings.mMemoryMapSize < 0) {
+        // leave room for the database to grow before the mapping has to be extended by the next start
+        d->mStorageSettings.mMemoryMapSize = d->mDatabaseFileName.isEmpty() ? 0 :
+                memoryBudget(2 * databaseSize, DatabaseInterfacePrivate::MinimumMemoryMapSize,
+                             DatabaseInterfacePrivate::MaximumMemoryMapSize, 16);
+    }
 
-        auto result = prepareQuery(d->mSelectAllLyricistsQuery, selectAllLyricistsWithFilterText);
+    if (d->mStorageSettings.mTempStore < 0) {
+        d->mStorageSettings.mTempStore = (physicalMemory == 0 || physicalMemory >= 1024LL * 1024 * 1024) ? 2 : 0;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastError();
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initStorageSettings" << "database" << databaseSize / 1024 << "KiB"
+                                << "memory" << physicalMemory / (1024 * 1024) << "MiB"
+                                << "cache_size" << d->mStorageSettings.mCacheSize << "KiB"
+                                << "mmap_size" << d->mStorageSettings.mMemoryMapSize / (1024 * 1024) << "MiB"
+                                << "temp_store" << d->mStorageSettings.mTempStore;
+}
 
-            Q_EMIT databaseError();
+void DatabaseInterface::applyStorageSettings(QSqlDatabase &database) const
+{
+    QSqlQuery pragmaQuery(database);
+
+    // a negative cache_size is in KiB instead of pages
+    const auto pragmaTexts = QStringList{
+            QStringLiteral("PRAGMA cache_size = -%1").arg(d->mStorageSettings.mCacheSize),
+            QStringLiteral("PRAGMA mmap_size = %1").arg(d->mStorageSettings.mMemoryMapSize),
+            QStringLiteral("PRAGMA temp_store = %1").arg(d->mStorageSettings.mTempStore),
+    };
+
+    for (const auto &onePragma : pragmaTexts) {
+        if (!pragmaQuery.exec(onePragma)) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::applyStorageSettings" << pragmaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::applyStorageSettings" << pragmaQuery.lastError();
         }
+        pragmaQuery.finish();
     }
+}
 
-    {
-        auto selectAllTracksText = QStringLiteral("SELECT "
-                                                  "tracks.`ID`, "
-                                                  "tracks.`Title`, "
-                                                  "album.`ID`, "
-                                                  "tracks.`ArtistName`, "
-                                                  "( "
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                  "FROM "
-                                                  "`Tracks` tracksFromAlbum1 "
-                                                  "WHERE "
-                                                  "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                  ") AS ArtistsCount, "
+void DatabaseInterface::initDatabase()
+{
+    auto listTables = d->mTracksDatabase.tables();
+
+    if (listTables.contains(QLatin1String("DatabaseVersionV2")) ||
+        listTables.contains(QLatin1String("DatabaseVersionV3")) ||
+        listTables.contains(QLatin1String("DatabaseVersionV4")) ||
+        listTables.contains(QLatin1String("DatabaseVersionV6")) ||
+        listTables.contains(QLatin1String("DatabaseVersionV7")) ||
+        listTables.contains(QLatin1String("DatabaseVersionV8")) ||
+        listTables.contains(QLatin1String("DatabaseVersionV10"))) {
+
+        qCDebug(orgKdeElisaDatabase()) << "Old database schema unsupported: delete and start from scratch";
+        qCDebug(orgKdeElisaDatabase()) << "list of old tables" << d->mTracksDatabase.tables();
+
+        auto oldTables = QStringList{
+                QStringLiteral("DatabaseVersionV2"),
+                QStringLiteral("DatabaseVersionV3"),
+                QStringLiteral("DatabaseVersionV4"),
+                QStringLiteral("DatabaseVersionV5"),
+                QStringLiteral("DatabaseVersionV6"),
+                QStringLiteral("DatabaseVersionV7"),
+                QStringLiteral("DatabaseVersionV8"),
+                QStringLiteral("DatabaseVersionV10"),
+                QStringLiteral("AlbumsArtists"),
+                QStringLiteral("TracksArtists"),
+                QStringLiteral("TracksMapping"),
+                QStringLiteral("Tracks"),
+                QStringLiteral("Composer"),
+                QStringLiteral("Genre"),
+                QStringLiteral("Lyricist"),
+                QStringLiteral("Albums"),
+                QStringLiteral("DiscoverSource"),
+                QStringLiteral("Artists"),};
+        for (const auto &oneTable : oldTables) {
+            if (listTables.indexOf(oneTable) == -1) {
+                continue;
+            }
+
+            QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+            auto result = createSchemaQuery.exec(QLatin1String("DROP TABLE ") + oneTable);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initDatabase" << createSchemaQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+    }
+
+    manageNewDatabaseVersion();
+}
+
+void DatabaseInterface::initGeneration()
+{
+    QSqlQuery generationQuery(d->mTracksDatabase);
+
+    auto result = generationQuery.exec(QStringLiteral("SELECT `Generation` FROM `DatabaseGeneration`"));
+
+    if (result && generationQuery.next()) {
+        d->mGeneration.storeRelease(generationQuery.value(0).toULongLong());
+        d->mPublishedSequenceNumber = d->mGeneration.loadAcquire();
+        return;
+    }
+
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initGeneration" << generationQuery.lastQuery();
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initGeneration" << generationQuery.lastError();
+
+    Q_EMIT databaseError();
+}
+
+void DatabaseInterface::initPlayScore()
+{
+    QSqlQuery playScoreQuery(d->mTracksDatabase);
+
+    auto result = playScoreQuery.exec(QStringLiteral("SELECT `ReferenceTime` FROM `PlayScoreReference`"));
+
+    if (!result || !playScoreQuery.next()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initPlayScore" << playScoreQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initPlayScore" << playScoreQuery.lastError();
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    d->mPlayScoreReference = playScoreQuery.value(0).toLongLong();
+
+    const auto now = QDateTime::currentMSecsSinceEpoch();
+
+    if (now - d->mPlayScoreReference > DatabaseInterfacePrivate::PlayScoreHalfLife) {
+        d->mTracksDatabase.transaction();
+        decayPlayScores(now);
+        d->mTracksDatabase.commit();
+    }
+}
+
+void DatabaseInterface::decayPlayScores(qint64 referenceTime)
+{
+    QSqlQuery decayQuery(d->mTracksDatabase);
+
+    decayQuery.prepare(QStringLiteral("UPDATE `TracksPlayScore` SET `Score` = `Score` * :factor"));
+    decayQuery.bindValue(QStringLiteral(":factor"), std::exp2(double(d->mPlayScoreReference - referenceTime) / DatabaseInterfacePrivate::PlayScoreHalfLife));
+
+    auto result = decayQuery.exec();
+
+    if (result) {
+        decayQuery.prepare(QStringLiteral("UPDATE `PlayScoreReference` SET `ReferenceTime` = :referenceTime"));
+        decayQuery.bindValue(QStringLiteral(":referenceTime"), referenceTime);
+
+        result = decayQuery.exec();
+    }
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::decayPlayScores" << decayQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::decayPlayScores" << decayQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::decayPlayScores" << decayQuery.lastError();
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::decayPlayScores" << "reference time moved from" << d->mPlayScoreReference << "to" << referenceTime;
+
+    d->mPlayScoreReference = referenceTime;
+}
+
+void DatabaseInterface::increaseGeneration()
+{
+    auto newGeneration = d->mGeneration.loadAcquire() + 1;
+
+    d->mUpdateGenerationQuery.bindValue(QStringLiteral(":generation"), newGeneration);
+
+    auto queryResult = execQuery(d->mUpdateGenerationQuery);
+
+    if (!queryResult || !d->mUpdateGenerationQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::increaseGeneration" << d->mUpdateGenerationQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::increaseGeneration" << d->mUpdateGenerationQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::increaseGeneration" << d->mUpdateGenerationQuery.lastError();
+
+        d->mUpdateGenerationQuery.finish();
+
+        return;
+    }
+
+    d->mUpdateGenerationQuery.finish();
+
+    d->mGeneration.storeRelease(newGeneration);
+}
+
+qulonglong DatabaseInterface::internalCommittedGeneration()
+{
+    auto result = qulonglong{0};
+
+    auto &currentQuery = queryForCurrentThread(d->mSelectGenerationQuery);
+
+    auto queryResult = execQuery(currentQuery);
+
+    if (!queryResult || !currentQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalCommittedGeneration" << currentQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalCommittedGeneration" << currentQuery.lastError();
+
+        currentQuery.finish();
+
+        return result;
+    }
+
+    if (currentQuery.next()) {
+        result = currentQuery.value(0).toULongLong();
+    }
+
+    currentQuery.finish();
+
+    return result;
+}
+
+qlonglong DatabaseInterface::currentDataVersion()
+{
+    auto result = qlonglong{0};
+
+    auto queryResult = execQuery(d->mSelectDataVersionQuery);
+
+    if (!queryResult || !d->mSelectDataVersionQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::currentDataVersion" << d->mSelectDataVersionQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::currentDataVersion" << d->mSelectDataVersionQuery.lastError();
+
+        d->mSelectDataVersionQuery.finish();
+
+        return result;
+    }
+
+    if (d->mSelectDataVersionQuery.next()) {
+        result = d->mSelectDataVersionQuery.value(0).toLongLong();
+    }
+
+    d->mSelectDataVersionQuery.finish();
+
+    return result;
+}
+
+bool DatabaseInterface::synchronizeWithExternalCommits()
+{
+    // data_version only changes when another connection, usually another process, commits to the database file
+    if (d->mDataVersion == 0) {
+        return false;
+    }
+
+    const auto dataVersion = currentDataVersion();
+    if (dataVersion == 0 || dataVersion == d->mDataVersion) {
+        return false;
+    }
+
+    d->mDataVersion = dataVersion;
+    d->mHasExternalCommits = true;
+
+    reloadIdCounters();
+    clearIdCaches();
+    d->mTrackDataCache.clear();
+
+    auto queryResult = execQuery(d->mSelectGenerationQuery);
+
+    if (!queryResult || !d->mSelectGenerationQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::synchronizeWithExternalCommits" << d->mSelectGenerationQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::synchronizeWithExternalCommits" << d->mSelectGenerationQuery.lastError();
+
+        d->mSelectGenerationQuery.finish();
+
+        return true;
+    }
+
+    if (d->mSelectGenerationQuery.next()) {
+        const auto generation = d->mSelectGenerationQuery.value(0).toULongLong();
+
+        if (generation > d->mGeneration.loadAcquire()) {
+            d->mGeneration.storeRelease(generation);
+        }
+    }
+
+    d->mSelectGenerationQuery.finish();
+
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::synchronizeWithExternalCommits" << "generation" << d->mGeneration.loadAcquire();
+
+    return true;
+}
+
+void DatabaseInterface::checkExternalCommits()
+{
+    if (!d) {
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    synchronizeWithExternalCommits();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult || !d->mHasExternalCommits) {
+        return;
+    }
+
+    d->mHasExternalCommits = false;
+
+    publishExternalChanges(d->mGeneration.loadAcquire());
+}
+
+void DatabaseInterface::initPlayStatisticsJournal()
+{
+    d->mPlayStatisticsJournal.setFileName(d->mDatabaseFileName + QStringLiteral(".plays"));
+
+    // only one of the processes using the database file replays and truncates the journal
+    d->mPlayStatisticsJournalLock = std::make_unique<QLockFile>(d->mPlayStatisticsJournal.fileName() + QStringLiteral(".lock"));
+
+    if (!d->mPlayStatisticsJournalLock->tryLock(0)) {
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initPlayStatisticsJournal" << "journal used by another process";
+
+        return;
+    }
+
+    if (!d->mPlayStatisticsJournal.open(QIODevice::ReadWrite | QIODevice::Append)) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initPlayStatisticsJournal" << d->mPlayStatisticsJournal.fileName();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initPlayStatisticsJournal" << d->mPlayStatisticsJournal.errorString();
+
+        return;
+    }
+
+    QSqlQuery sequenceQuery(d->mTracksDatabase);
+
+    if (!sequenceQuery.exec(QStringLiteral("SELECT `LastAppliedSequence` FROM `PlayStatisticsJournalState`")) || !sequenceQuery.next()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initPlayStatisticsJournal" << sequenceQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initPlayStatisticsJournal" << sequenceQuery.lastError();
+
+        d->mPlayStatisticsJournal.close();
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    // the plays committed before a crash that left them in the journal are not counted twice
+    const auto lastAppliedSequence = sequenceQuery.value(0).toULongLong();
+    sequenceQuery.finish();
+
+    d->mPlayStatisticsSequence = lastAppliedSequence;
+
+    d->mPlayStatisticsJournal.seek(0);
+
+    while (!d->mPlayStatisticsJournal.atEnd()) {
+        const auto journalFields = d->mPlayStatisticsJournal.readLine().trimmed().split('\t');
+
+        if (journalFields.size() != 3) {
+            continue;
+        }
+
+        const auto playSequence = journalFields[0].toULongLong();
+        d->mPlayStatisticsSequence = std::max(d->mPlayStatisticsSequence, playSequence);
+
+        if (playSequence <= lastAppliedSequence) {
+            continue;
+        }
+
+        const auto playTime = QDateTime::fromMSecsSinceEpoch(journalFields[1].toLongLong());
+        const auto fileName = QUrl::fromEncoded(journalFields[2]);
+
+        auto &pendingPlay = d->mPendingPlays[fileName];
+        if (pendingPlay.mPlayCount == 0) {
+            pendingPlay.mFirstPlayTime = playTime;
+        }
+        pendingPlay.mLastPlayTime = playTime;
+        ++pendingPlay.mPlayCount;
+    }
+
+    if (!d->mPendingPlays.isEmpty()) {
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initPlayStatisticsJournal" << "replaying plays for" << d->mPendingPlays.size() << "tracks";
+
+        flushPlayStatistics();
+    } else if (d->mPlayStatisticsJournal.size() > 0 && !d->mPlayStatisticsJournal.resize(0)) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initPlayStatisticsJournal" << d->mPlayStatisticsJournal.fileName();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initPlayStatisticsJournal" << d->mPlayStatisticsJournal.errorString();
+    }
+}
+
+void DatabaseInterface::syncPlayStatisticsJournal()
+{
+    d->mPlayStatisticsJournalSyncTimer.stop();
+
+    if (!d->mPlayStatisticsJournal.isOpen() || d->mPendingPlays.isEmpty()) {
+        return;
+    }
+
+    if (!DatabaseInterfacePrivate::syncFile(d->mPlayStatisticsJournal)) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::syncPlayStatisticsJournal" << d->mPlayStatisticsJournal.fileName();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::syncPlayStatisticsJournal" << d->mPlayStatisticsJournal.errorString();
+    }
+}
+
+void DatabaseInterface::flushPlayStatistics()
+{
+    if (!d || d->mPendingPlays.isEmpty()) {
+        return;
+    }
+
+    d->mPlayStatisticsTimer.stop();
+
+    // the plays stay pending until they are committed, a locked database delays them behind the other writes
+    auto isDelayed = false;
+    auto transactionResult = startOrDelayWriteTransaction([this]() {flushPlayStatistics();}, isDelayed);
+    if (isDelayed) {
+        return;
+    }
+
+    if (!transactionResult) {
+        d->mPlayStatisticsTimer.start();
+        return;
+    }
+
+    auto changes = DataTypes::DatabaseChanges{};
+
+    for (auto itPlay = d->mPendingPlays.cbegin(); itPlay != d->mPendingPlays.cend(); ++itPlay) {
+        updateTrackStatistics(itPlay.key(), itPlay->mFirstPlayTime, itPlay->mLastPlayTime, itPlay->mPlayCount);
+
+        auto trackId = internalTrackIdFromFileName(itPlay.key());
+        if (trackId != 0) {
+            changes.mModifiedTracks.push_back(trackId);
+        }
+    }
+
+    // committed with the plays: the journal may still hold them after a crash
+    if (d->mPlayStatisticsJournal.isOpen()) {
+        d->mUpdatePlayStatisticsSequenceQuery.bindValue(QStringLiteral(":sequence"), d->mPlayStatisticsSequence);
+
+        auto queryResult = execQuery(d->mUpdatePlayStatisticsSequenceQuery);
+
+        if (!queryResult || !d->mUpdatePlayStatisticsSequenceQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::flushPlayStatistics" << d->mUpdatePlayStatisticsSequenceQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::flushPlayStatistics" << d->mUpdatePlayStatisticsSequenceQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::flushPlayStatistics" << d->mUpdatePlayStatisticsSequenceQuery.lastError();
+
+            d->mUpdatePlayStatisticsSequenceQuery.finish();
+            rollBackTransaction();
+            d->mPlayStatisticsTimer.start();
+            return;
+        }
+
+        d->mUpdatePlayStatisticsSequenceQuery.finish();
+    }
+
+    if (!changes.isEmpty()) {
+        increaseGeneration();
+        scheduleModelSnapshot();
+    }
+
+    journalChanges(changes);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        d->mPlayStatisticsTimer.start();
+        return;
+    }
+
+    d->mPendingPlays.clear();
+    d->mPlayStatisticsJournalSyncTimer.stop();
+
+    // the plays left after a crash before this point are skipped by their sequence number
+    if (d->mPlayStatisticsJournal.isOpen() && !d->mPlayStatisticsJournal.resize(0)) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::flushPlayStatistics" << d->mPlayStatisticsJournal.fileName();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::flushPlayStatistics" << d->mPlayStatisticsJournal.errorString();
+    }
+
+    publishChanges(changes);
+}
+
+void DatabaseInterface::setMaintenanceAllowed(bool allowed)
+{
+    if (!d) {
+        return;
+    }
+
+    // running steps check the flag, the idle timer itself belongs to the database thread
+    d->mMaintenanceAllowed.storeRelease(allowed ? 1 : 0);
+
+    QMetaObject::invokeMethod(this, [this, allowed]() {
+        if (allowed && !d->mDatabaseFileName.isEmpty()) {
+            d->mMaintenanceTimer.start();
+        } else {
+            d->mMaintenanceTimer.stop();
+        }
+    }, Qt::QueuedConnection);
+}
+
+void DatabaseInterface::startMaintenance()
+{
+    if (!d || d->mDatabaseFileName.isEmpty() || d->mMaintenanceRunning || !d->mMaintenanceAllowed.loadAcquire()) {
+        return;
+    }
+
+    if (d->mLastMaintenance.isValid() &&
+            d->mLastMaintenance.secsTo(QDateTime::currentDateTime()) < DatabaseInterfacePrivate::MaintenanceInterval) {
+        return;
+    }
+
+    d->mMaintenanceRunning = true;
+
+    QTimer::singleShot(0, this, &DatabaseInterface::runMaintenanceStep);
+}
+
+void DatabaseInterface::runMaintenanceStep()
+{
+    // each step is short and goes back to the event loop, requests queued in between run before the next one
+    if (!d->mMaintenanceAllowed.loadAcquire()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::runMaintenanceStep" << "interrupted before step" << d->mMaintenanceStep;
+
+        d->mMaintenanceRunning = false;
+
+        return;
+    }
+
+    auto stepTimer = QElapsedTimer{};
+    stepTimer.start();
+
+    QSqlQuery maintenanceQuery(d->mTracksDatabase);
+
+    const auto readPragma = [&maintenanceQuery](const QString &pragmaText) {
+        if (!maintenanceQuery.exec(pragmaText) || !maintenanceQuery.next()) {
+            return QVariant{};
+        }
+
+        return maintenanceQuery.value(0);
+    };
+
+    auto result = true;
+    auto isFinished = false;
+
+    switch (d->mMaintenanceStep)
+    {
+    case DatabaseInterfacePrivate::AnalyzeStep:
+    {
+        // statistics are gathered on a bounded sample, later runs only refresh the tables that need it
+        maintenanceQuery.exec(QStringLiteral("PRAGMA analysis_limit = 1000"));
+
+        // the driver only lists sqlite_master as a system table
+        result = maintenanceQuery.exec(QStringLiteral("SELECT 1 FROM `sqlite_master` WHERE `name` = 'sqlite_stat1'"));
+        const auto hasStatistics = result && maintenanceQuery.next();
+        maintenanceQuery.finish();
+
+        if (result) {
+            result = maintenanceQuery.exec(hasStatistics ? QStringLiteral("PRAGMA optimize") : QStringLiteral("ANALYZE"));
+            d->mMaintenanceRebuiltStatistics = !hasStatistics;
+        }
+
+        d->mMaintenanceStep = DatabaseInterfacePrivate::IncrementalVacuumStep;
+        break;
+    }
+    case DatabaseInterfacePrivate::IncrementalVacuumStep:
+    {
+        const auto autoVacuumMode = readPragma(QStringLiteral("PRAGMA auto_vacuum")).toInt();
+        const auto freePages = readPragma(QStringLiteral("PRAGMA freelist_count")).toLongLong();
+
+        // 2 is incremental, databases created before it was enabled are converted by the v25 update
+        if (autoVacuumMode != 2 || freePages == 0) {
+            d->mMaintenanceStep = DatabaseInterfacePrivate::QuickCheckStep;
+            break;
+        }
+
+        result = maintenanceQuery.exec(QStringLiteral("PRAGMA incremental_vacuum(%1)").arg(DatabaseInterfacePrivate::IncrementalVacuumPages));
+        while (result && maintenanceQuery.next()) {
+        }
+
+        const auto remainingFreePages = result ? readPragma(QStringLiteral("PRAGMA freelist_count")).toLongLong() : freePages;
+
+        // a locked database or a freelist that does not shrink would repeat this step forever
+        if (remainingFreePages >= freePages) {
+            d->mMaintenanceStep = DatabaseInterfacePrivate::QuickCheckStep;
+            break;
+        }
+
+        d->mMaintenanceFreedPages += freePages - remainingFreePages;
+        break;
+    }
+    case DatabaseInterfacePrivate::QuickCheckStep:
+    {
+        result = maintenanceQuery.exec(QStringLiteral("PRAGMA quick_check"));
+
+        if (result && maintenanceQuery.next() && maintenanceQuery.value(0).toString() != QLatin1String("ok")) {
+            Q_EMIT databaseError();
+
+            do {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::runMaintenanceStep" << maintenanceQuery.value(0).toString();
+            } while (maintenanceQuery.next());
+        }
+
+        isFinished = true;
+        break;
+    }
+    }
+
+    if (!result) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::runMaintenanceStep" << maintenanceQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::runMaintenanceStep" << maintenanceQuery.lastError();
+    }
+
+    maintenanceQuery.finish();
+
+    d->mMaintenanceTime += stepTimer.elapsed();
+
+    if (!isFinished) {
+        QTimer::singleShot(0, this, &DatabaseInterface::runMaintenanceStep);
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::runMaintenanceStep" << "maintenance done in" << d->mMaintenanceTime << "ms"
+                                << d->mMaintenanceFreedPages << "pages freed"
+                                << (d->mMaintenanceRebuiltStatistics ? "statistics rebuilt" : "statistics refreshed");
+
+    Q_EMIT maintenanceFinished(d->mMaintenanceFreedPages, d->mMaintenanceTime, d->mMaintenanceRebuiltStatistics);
+
+    d->mMaintenanceRunning = false;
+    d->mMaintenanceStep = DatabaseInterfacePrivate::AnalyzeStep;
+    d->mMaintenanceTime = 0;
+    d->mMaintenanceFreedPages = 0;
+    d->mMaintenanceRebuiltStatistics = false;
+    d->mLastMaintenance = QDateTime::currentDateTime();
+}
+
+void DatabaseInterface::scheduleModelSnapshot()
+{
+    if (d->mDatabaseFileName.isEmpty()) {
+        return;
+    }
+
+    /* the snapshot is a dump of all the views: it is written when changes stop arriving or when the application quits */
+    d->mModelSnapshotOutdated = true;
+    d->mSnapshotTimer.start();
+}
+
+void DatabaseInterface::writeModelSnapshot()
+{
+    d->mSnapshotTimer.stop();
+
+    // a snapshot being read is followed by another one when it finishes
+    if (!d->mModelSnapshotOutdated || d->mModelSnapshotWatcher.isRunning()) {
+        return;
+    }
+
+    d->mModelSnapshotOutdated = false;
+
+    d->mModelSnapshotWatcher.setFuture(QtConcurrent::run(QThreadPool::globalInstance(), [this]() {
+        return buildModelSnapshot();
+    }));
+}
+
+bool DatabaseInterface::buildModelSnapshot()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return false;
+    }
+
+    const auto generation = internalCommittedGeneration();
+
+    finishTransaction();
+
+    auto snapshot = ModelSnapshot{};
+    auto albums = DataTypes::ListAlbumDataType{};
+    auto tracks = DataTypes::ListTrackDataType{};
+
+    allAlbumsDataByPages(DatabaseInterfacePrivate::SnapshotPageSize, [&albums](const DataTypes::ListAlbumDataType &albumsPage) {
+        albums.append(albumsPage);
+    });
+    snapshot.setAlbums(albums);
+    snapshot.setArtists(allArtistsData());
+    snapshot.setGenres(allGenresData());
+    allTracksDataByPages(DatabaseInterfacePrivate::SnapshotPageSize, [&tracks](const DataTypes::ListTrackDataType &tracksPage) {
+        tracks.append(tracksPage);
+    });
+    snapshot.setTracks(tracks);
+
+    transactionResult = startTransaction();
+    if (!transactionResult) {
+        return false;
+    }
+
+    const auto lastGeneration = internalCommittedGeneration();
+
+    finishTransaction();
+
+    /* every page is read in its own transaction: a commit in between would mix two generations in the snapshot */
+    if (lastGeneration != generation) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::buildModelSnapshot" << "generation moved from" << generation << "to" << lastGeneration;
+
+        return false;
+    }
+
+    snapshot.setGeneration(generation);
+
+    return snapshot.write(ModelSnapshot::fileNameForDatabase(d->mDatabaseFileName));
+}
+
+void DatabaseInterface::rebuildAlbumSummary()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    QSqlQuery rebuildAlbumSummaryQuery(d->mTracksDatabase);
+
+    const auto rebuildAlbumSummaryTexts = QStringList{
+            QStringLiteral("DELETE FROM `AlbumSummary`"),
+            QStringLiteral("INSERT INTO `AlbumSummary` "
+                           "(`AlbumID`, `TracksCount`, `ArtistsCount`, `AllArtists`, `HighestRating`, `AllGenres`, `IsSingleDiscAlbum`, `EmbeddedCover`) "
+                           "SELECT "
+                           "album.`ID`, "
+                           "COUNT(tracks.`ID`), "
+                           "COUNT(DISTINCT tracks.`ArtistName`), "
+                           "GROUP_CONCAT(tracks.`ArtistName`, ', '), "
+                           "MAX(tracks.`Rating`), "
+                           "GROUP_CONCAT(genres.`Name`, ', '), "
+                           "COUNT(DISTINCT tracks.`DiscNumber`) <= 1, "
+                           "MIN(CASE WHEN tracks.`HasEmbeddedCover` = 1 THEN trackDirectory.`Path` || trackData.`BaseName` END) "
+                           "FROM "
+                           "`Albums` album, "
+                           "`Tracks` tracks LEFT JOIN "
+                           "`Genre` genres ON genres.`ID` = tracks.`GenreID` "
+                           "JOIN `TracksData` trackData ON trackData.`ID` = tracks.`FileID` "
+                           "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = trackData.`DirectoryID` "
+                           "WHERE "
+                           "tracks.`AlbumID` = album.`ID` "
+                           "GROUP BY album.`ID`"),
+    };
+
+    for (const auto &oneQueryText : rebuildAlbumSummaryTexts) {
+        auto result = rebuildAlbumSummaryQuery.exec(oneQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::rebuildAlbumSummary" << rebuildAlbumSummaryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::rebuildAlbumSummary" << rebuildAlbumSummaryQuery.lastError();
+
+            Q_EMIT databaseError();
+
+            rollBackTransaction();
+            return;
+        }
+    }
+
+    finishTransaction();
+}
+
+void DatabaseInterface::updateAlbumSummary(qulonglong albumId)
+{
+    d->mRemoveAlbumSummaryQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+    auto result = execQuery(d->mRemoveAlbumSummaryQuery);
+
+    if (!result || !d->mRemoveAlbumSummaryQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumSummary" << d->mRemoveAlbumSummaryQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumSummary" << d->mRemoveAlbumSummaryQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumSummary" << d->mRemoveAlbumSummaryQuery.lastError();
+    }
+
+    d->mRemoveAlbumSummaryQuery.finish();
+
+    d->mInsertAlbumSummaryQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+    result = execQuery(d->mInsertAlbumSummaryQuery);
+
+    if (!result || !d->mInsertAlbumSummaryQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumSummary" << d->mInsertAlbumSummaryQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumSummary" << d->mInsertAlbumSummaryQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumSummary" << d->mInsertAlbumSummaryQuery.lastError();
+    }
+
+    d->mInsertAlbumSummaryQuery.finish();
+}
+
+void DatabaseInterface::updateAlbumSummariesForChanges()
+{
+    for (auto albumId : qAsConst(d->mInsertedAlbums)) {
+        updateAlbumSummary(albumId);
+    }
+
+    for (auto albumId : qAsConst(d->mModifiedAlbumIds)) {
+        if (!d->mInsertedAlbums.contains(albumId)) {
+            updateAlbumSummary(albumId);
+        }
+    }
+}
+
+void DatabaseInterface::initSearchIndex()
+{
+    auto listTables = d->mTracksDatabase.tables();
+
+    /* the index is created by the v18 upgrade when SQLite has the fts5 module */
+    d->mHasSearchIndex = listTables.contains(QLatin1String("TracksSearch")) &&
+            listTables.contains(QLatin1String("AlbumsSearch"));
+}
+
+void DatabaseInterface::rebuildSearchIndex()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    QSqlQuery rebuildSearchIndexQuery(d->mTracksDatabase);
+
+    const auto rebuildSearchIndexTexts = QStringList{
+            QStringLiteral("DELETE FROM `TracksSearch`"),
+            QStringLiteral("DELETE FROM `AlbumsSearch`"),
+            QStringLiteral("INSERT INTO `TracksSearch` "
+                           "(`rowid`, `Title`, `ArtistName`, `AlbumArtistName`, `AlbumTitle`, `Genre`, `Composer`, `Lyricist`) "
+                           "SELECT "
+                           "tracks.`ID`, "
+                           "tracks.`Title`, "
+                           "tracks.`ArtistName`, "
+                           "tracks.`AlbumArtistName`, "
+                           "tracks.`AlbumTitle`, "
+                           "trackGenre.`Name`, "
+                           "trackComposer.`Name`, "
+                           "trackLyricist.`Name` "
+                           "FROM "
+                           "`Tracks` tracks "
+                           "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                           "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                           "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID`"),
+            QStringLiteral("INSERT INTO `AlbumsSearch` "
+                           "(`rowid`, `Title`, `ArtistName`, `AllArtists`, `AllGenres`) "
+                           "SELECT "
+                           "album.`ID`, "
+                           "album.`Title`, "
+                           "album.`ArtistName`, "
+                           "GROUP_CONCAT(DISTINCT tracks.`ArtistName`), "
+                           "GROUP_CONCAT(DISTINCT albumGenre.`Name`) "
+                           "FROM "
+                           "`Albums` album "
+                           "LEFT JOIN "
+                           "`Tracks` tracks "
+                           "ON "
+                           "tracks.`AlbumID` = album.`ID` "
+                           "LEFT JOIN `Genre` albumGenre ON albumGenre.`ID` = tracks.`GenreID` "
+                           "GROUP BY album.`ID`"),
+    };
+
+    for (const auto &oneQueryText : rebuildSearchIndexTexts) {
+        auto result = rebuildSearchIndexQuery.exec(oneQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::rebuildSearchIndex" << rebuildSearchIndexQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::rebuildSearchIndex" << rebuildSearchIndexQuery.lastError();
+
+            Q_EMIT databaseError();
+
+            rollBackTransaction();
+            return;
+        }
+    }
+
+    finishTransaction();
+}
+
+void DatabaseInterface::updateTrackSearchIndex(qulonglong trackId)
+{
+    if (!d->mHasSearchIndex) {
+        return;
+    }
+
+    removeTrackSearchIndex(trackId);
+
+    d->mInsertTrackSearchQuery.bindValue(QStringLiteral(":trackId"), trackId);
+
+    auto result = execQuery(d->mInsertTrackSearchQuery);
+
+    if (!result || !d->mInsertTrackSearchQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackSearchIndex" << d->mInsertTrackSearchQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackSearchIndex" << d->mInsertTrackSearchQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackSearchIndex" << d->mInsertTrackSearchQuery.lastError();
+    }
+
+    d->mInsertTrackSearchQuery.finish();
+}
+
+void DatabaseInterface::removeTrackSearchIndex(qulonglong trackId)
+{
+    if (!d->mHasSearchIndex) {
+        return;
+    }
+
+    d->mRemoveTrackSearchQuery.bindValue(QStringLiteral(":trackId"), trackId);
+
+    auto result = execQuery(d->mRemoveTrackSearchQuery);
+
+    if (!result || !d->mRemoveTrackSearchQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackSearchIndex" << d->mRemoveTrackSearchQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackSearchIndex" << d->mRemoveTrackSearchQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackSearchIndex" << d->mRemoveTrackSearchQuery.lastError();
+    }
+
+    d->mRemoveTrackSearchQuery.finish();
+}
+
+void DatabaseInterface::updateAlbumSearchIndex(qulonglong albumId)
+{
+    if (!d->mHasSearchIndex) {
+        return;
+    }
+
+    removeAlbumSearchIndex(albumId);
+
+    d->mInsertAlbumSearchQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+    auto result = execQuery(d->mInsertAlbumSearchQuery);
+
+    if (!result || !d->mInsertAlbumSearchQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumSearchIndex" << d->mInsertAlbumSearchQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumSearchIndex" << d->mInsertAlbumSearchQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumSearchIndex" << d->mInsertAlbumSearchQuery.lastError();
+    }
+
+    d->mInsertAlbumSearchQuery.finish();
+}
+
+void DatabaseInterface::removeAlbumSearchIndex(qulonglong albumId)
+{
+    if (!d->mHasSearchIndex) {
+        return;
+    }
+
+    d->mRemoveAlbumSearchQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+    auto result = execQuery(d->mRemoveAlbumSearchQuery);
+
+    if (!result || !d->mRemoveAlbumSearchQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumSearchIndex" << d->mRemoveAlbumSearchQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumSearchIndex" << d->mRemoveAlbumSearchQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumSearchIndex" << d->mRemoveAlbumSearchQuery.lastError();
+    }
+
+    d->mRemoveAlbumSearchQuery.finish();
+}
+
+void DatabaseInterface::updateSearchIndexForChanges()
+{
+    if (!d->mHasSearchIndex) {
+        return;
+    }
+
+    for (auto trackId : qAsConst(d->mInsertedTracks)) {
+        updateTrackSearchIndex(trackId);
+    }
+
+    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
+        if (!d->mInsertedTracks.contains(trackId)) {
+            updateTrackSearchIndex(trackId);
+        }
+    }
+
+    for (auto albumId : qAsConst(d->mInsertedAlbums)) {
+        updateAlbumSearchIndex(albumId);
+    }
+
+    for (auto albumId : qAsConst(d->mModifiedAlbumIds)) {
+        if (!d->mInsertedAlbums.contains(albumId)) {
+            updateAlbumSearchIndex(albumId);
+        }
+    }
+}
+
+QString DatabaseInterface::searchExpression(const QString &searchText) const
+{
+    auto prefixTerms = QStringList{};
+
+    const auto &searchWords = searchText.split(QRegularExpression(QStringLiteral("\\s+")), QString::SkipEmptyParts);
+    for (auto oneWord : searchWords) {
+        // each word is quoted so that fts5 operators typed by the user are matched as plain text
+        oneWord.replace(QLatin1Char('"'), QStringLiteral("\"\""));
+        prefixTerms.push_back(QLatin1Char('"') + oneWord + QStringLiteral("\"*"));
+    }
+
+    return prefixTerms.join(QLatin1Char(' '));
+}
+
+QList<qulonglong> DatabaseInterface::internalSearch(DatabaseStatement &searchQuery, const QString &searchText, int maximumCount)
+{
+    auto result = QList<qulonglong>{};
+
+    const auto &matchExpression = searchExpression(searchText);
+
+    if (matchExpression.isEmpty()) {
+        return result;
+    }
+
+    searchQuery.bindValue(QStringLiteral(":searchText"), matchExpression);
+    searchQuery.bindValue(QStringLiteral(":maximumCount"), maximumCount);
+
+    auto queryResult = execQuery(searchQuery);
+
+    if (!queryResult || !searchQuery.isSelect() || !searchQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalSearch" << searchQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalSearch" << searchQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalSearch" << searchQuery.lastError();
+
+        searchQuery.finish();
+
+        return result;
+    }
+
+    while (searchQuery.next()) {
+        result.push_back(searchQuery.value(0).toULongLong());
+    }
+
+    searchQuery.finish();
+
+    return result;
+}
+
+void DatabaseInterface::createDatabaseV9()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin creation of v9 database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV9` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DiscoverSource` (`ID` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`Name` VARCHAR(55) NOT NULL, "
+                                                                   "UNIQUE (`Name`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Artists` (`ID` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`Name` VARCHAR(55) NOT NULL, "
+                                                                   "UNIQUE (`Name`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Composer` (`ID` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`Name` VARCHAR(55) NOT NULL, "
+                                                                   "UNIQUE (`Name`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Genre` (`ID` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`Name` VARCHAR(85) NOT NULL, "
+                                                                   "UNIQUE (`Name`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Lyricist` (`ID` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`Name` VARCHAR(55) NOT NULL, "
+                                                                   "UNIQUE (`Name`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Albums` ("
+                                                                   "`ID` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`Title` VARCHAR(55) NOT NULL, "
+                                                                   "`ArtistName` VARCHAR(55), "
+                                                                   "`AlbumPath` VARCHAR(255) NOT NULL, "
+                                                                   "`CoverFileName` VARCHAR(255) NOT NULL, "
+                                                                   "UNIQUE (`Title`, `ArtistName`, `AlbumPath`), "
+                                                                   "CONSTRAINT fk_artists FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`) "
+                                                                   "ON DELETE CASCADE)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Tracks` ("
+                                                                   "`ID` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`Title` VARCHAR(85) NOT NULL, "
+                                                                   "`ArtistName` VARCHAR(55), "
+                                                                   "`AlbumTitle` VARCHAR(55), "
+                                                                   "`AlbumArtistName` VARCHAR(55), "
+                                                                   "`AlbumPath` VARCHAR(255), "
+                                                                   "`TrackNumber` INTEGER DEFAULT -1, "
+                                                                   "`DiscNumber` INTEGER DEFAULT -1, "
+                                                                   "`Duration` INTEGER NOT NULL, "
+                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
+                                                                   "`Genre` VARCHAR(55), "
+                                                                   "`Composer` VARCHAR(55), "
+                                                                   "`Lyricist` VARCHAR(55), "
+                                                                   "`Comment` VARCHAR(255) DEFAULT '', "
+                                                                   "`Year` INTEGER DEFAULT 0, "
+                                                                   "`Channels` INTEGER DEFAULT -1, "
+                                                                   "`BitRate` INTEGER DEFAULT -1, "
+                                                                   "`SampleRate` INTEGER DEFAULT -1, "
+                                                                   "`HasEmbeddedCover` BOOLEAN NOT NULL, "
+                                                                   "`ImportDate` INTEGER NOT NULL, "
+                                                                   "`FirstPlayDate` INTEGER, "
+                                                                   "`LastPlayDate` INTEGER, "
+                                                                   "`PlayCounter` INTEGER NOT NULL, "
+                                                                   "UNIQUE ("
+                                                                   "`Title`, `AlbumTitle`, `AlbumArtistName`, "
+                                                                   "`AlbumPath`, `TrackNumber`, `DiscNumber`"
+                                                                   "), "
+                                                                   "CONSTRAINT fk_artist FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_album FOREIGN KEY ("
+                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
+                                                                   "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `TracksMapping` ("
+                                                                   "`TrackID` INTEGER NULL, "
+                                                                   "`DiscoverID` INTEGER NOT NULL, "
+                                                                   "`FileName` VARCHAR(255) NOT NULL, "
+                                                                   "`Priority` INTEGER NOT NULL, "
+                                                                   "`FileModifiedTime` DATETIME NOT NULL, "
+                                                                   "PRIMARY KEY (`FileName`), "
+                                                                   "CONSTRAINT TracksUnique UNIQUE (`TrackID`, `Priority`), "
+                                                                   "CONSTRAINT fk_tracksmapping_trackID FOREIGN KEY (`TrackID`) REFERENCES `Tracks`(`ID`) ON DELETE CASCADE, "
+                                                                   "CONSTRAINT fk_tracksmapping_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createSchemaQuery.lastError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TitleAlbumsIndex` ON `Albums` "
+                                                                  "(`Title`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`ArtistNameAlbumsIndex` ON `Albums` "
+                                                                  "(`ArtistName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksAlbumIndex` ON `Tracks` "
+                                                                  "(`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`ArtistNameIndex` ON `Tracks` "
+                                                                  "(`ArtistName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`AlbumArtistNameIndex` ON `Tracks` "
+                                                                  "(`AlbumArtistName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksFileNameIndex` ON `TracksMapping` "
+                                                                  "(`FileName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseV9" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "end creation of v9 database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV9()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v9 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV9` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+
+        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << disableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << disableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.transaction();
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewAlbums` ("
+                                                                   "`ID` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`Title` VARCHAR(55) NOT NULL, "
+                                                                   "`ArtistName` VARCHAR(55), "
+                                                                   "`AlbumPath` VARCHAR(255) NOT NULL, "
+                                                                   "`CoverFileName` VARCHAR(255) NOT NULL, "
+                                                                   "UNIQUE (`Title`, `ArtistName`, `AlbumPath`), "
+                                                                   "CONSTRAINT fk_artists FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`) "
+                                                                   "ON DELETE CASCADE)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+        }
+    }
+
+    {
+        QSqlQuery copyDataQuery(d->mTracksDatabase);
+
+        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `NewAlbums` "
+                                                        "SELECT "
+                                                        "album.`ID`, "
+                                                        "album.`Title`, "
+                                                        "artist.`Name`, "
+                                                        "album.`AlbumPath`, "
+                                                        "album.`CoverFileName` "
+                                                        "FROM "
+                                                        "`Albums` album, "
+                                                        "`AlbumsArtists` albumArtistMapping, "
+                                                        "`Artists` artist "
+                                                        "WHERE "
+                                                        "album.`ID` = albumArtistMapping.`AlbumID` AND "
+                                                        "albumArtistMapping.`ArtistID` = artist.`ID`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << copyDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << copyDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Albums`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `AlbumsArtists`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewAlbums` RENAME TO `Albums`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewTracks` ("
+                                                                   "`ID` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`Title` VARCHAR(85) NOT NULL, "
+                                                                   "`ArtistName` VARCHAR(55), "
+                                                                   "`AlbumTitle` VARCHAR(55), "
+                                                                   "`AlbumArtistName` VARCHAR(55), "
+                                                                   "`AlbumPath` VARCHAR(255), "
+                                                                   "`TrackNumber` INTEGER DEFAULT -1, "
+                                                                   "`DiscNumber` INTEGER DEFAULT -1, "
+                                                                   "`Duration` INTEGER NOT NULL, "
+                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
+                                                                   "`Genre` VARCHAR(55), "
+                                                                   "`Composer` VARCHAR(55), "
+                                                                   "`Lyricist` VARCHAR(55), "
+                                                                   "`Comment` VARCHAR(255) DEFAULT '', "
+                                                                   "`Year` INTEGER DEFAULT 0, "
+                                                                   "`Channels` INTEGER DEFAULT -1, "
+                                                                   "`BitRate` INTEGER DEFAULT -1, "
+                                                                   "`SampleRate` INTEGER DEFAULT -1, "
+                                                                   "`HasEmbeddedCover` BOOLEAN NOT NULL, "
+                                                                   "`ImportDate` INTEGER NOT NULL, "
+                                                                   "`FirstPlayDate` INTEGER, "
+                                                                   "`LastPlayDate` INTEGER, "
+                                                                   "`PlayCounter` INTEGER NOT NULL, "
+                                                                   "UNIQUE ("
+                                                                   "`Title`, `AlbumTitle`, `AlbumArtistName`, "
+                                                                   "`AlbumPath`, `TrackNumber`, `DiscNumber`"
+                                                                   "), "
+                                                                   "CONSTRAINT fk_artist FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_album FOREIGN KEY ("
+                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
+                                                                   "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery copyDataQuery(d->mTracksDatabase);
+
+        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `NewTracks` "
+                                                        "(`ID`, `Title`, `ArtistName`, "
+                                                        "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`, "
+                                                        "`TrackNumber`, `DiscNumber`, `Duration`, "
+                                                        "`Rating`, `Genre`, `Composer`, "
+                                                        "`Lyricist`, `Comment`, `Year`, "
+                                                        "`Channels`, `BitRate`, `SampleRate`, "
+                                                        "`HasEmbeddedCover`, `ImportDate`, `PlayCounter`) "
+                                                        "SELECT "
+                                                        "track.`ID`, "
+                                                        "track.`Title`, "
+                                                        "artist.`Name`, "
+                                                        "album.`Title`, "
+                                                        "album.`ArtistName`, "
+                                                        "album.`AlbumPath`, "
+                                                        "track.`TrackNumber`, "
+                                                        "track.`DiscNumber`, "
+                                                        "track.`Duration`, "
+                                                        "track.`Rating`, "
+                                                        "genre.`Name`, "
+                                                        "composer.`Name`, "
+                                                        "lyricist.`Name`, "
+                                                        "track.`Comment`, "
+                                                        "track.`Year`, "
+                                                        "track.`Channels`, "
+                                                        "track.`BitRate`, "
+                                                        "track.`SampleRate`, "
+                                                        "FALSE, "
+                                                        "strftime('%s', 'now'), "
+                                                        "0 "
+                                                        "FROM "
+                                                        "`Tracks` track, "
+                                                        "`TracksArtists` trackArtistMapping, "
+                                                        "`Artists` artist, "
+                                                        "`Albums` album "
+                                                        "left join "
+                                                        "`Genre` genre "
+                                                        "on track.`GenreID` = genre.`ID` "
+                                                        "left join "
+                                                        "`Composer` composer "
+                                                        "on track.`ComposerID` = composer.`ID` "
+                                                        "left join "
+                                                        "`Lyricist` lyricist "
+                                                        "on track.`LyricistID` = lyricist.`ID` "
+                                                        "WHERE "
+                                                        "track.`ID` = trackArtistMapping.`TrackID` AND "
+                                                        "trackArtistMapping.`ArtistID` = artist.`ID` AND "
+                                                        "track.`AlbumID` = album.`ID`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << copyDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << copyDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Tracks`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `TracksArtists`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewTracks` RENAME TO `Tracks`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.commit();
+
+    {
+        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+
+        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << enableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV9" << enableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v9 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV11()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v11 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV11` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+
+        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << disableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << disableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.transaction();
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `TracksData` ("
+                                                                   "`DiscoverID` INTEGER NOT NULL, "
+                                                                   "`FileName` VARCHAR(255) NOT NULL, "
+                                                                   "`FileModifiedTime` DATETIME NOT NULL, "
+                                                                   "`ImportDate` INTEGER NOT NULL, "
+                                                                   "`FirstPlayDate` INTEGER, "
+                                                                   "`LastPlayDate` INTEGER, "
+                                                                   "`PlayCounter` INTEGER NOT NULL, "
+                                                                   "PRIMARY KEY (`FileName`, `DiscoverID`), "
+                                                                   "CONSTRAINT fk_tracksmapping_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+        }
+    }
+
+    {
+        QSqlQuery copyDataQuery(d->mTracksDatabase);
+
+        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `TracksData` "
+                                                        "SELECT "
+                                                        "m.`DiscoverID`, "
+                                                        "m.`FileName`, "
+                                                        "m.`FileModifiedTime`, "
+                                                        "t.`ImportDate`, "
+                                                        "t.`FirstPlayDate`, "
+                                                        "t.`LastPlayDate`, "
+                                                        "t.`PlayCounter` "
+                                                        "FROM "
+                                                        "`Tracks` t, "
+                                                        "`TracksMapping` m "
+                                                        "WHERE "
+                                                        "t.`ID` = m.`TrackID`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << copyDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << copyDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewTracks` ("
+                                                            "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
+                                                            "`DiscoverID` INTEGER NOT NULL, "
+                                                            "`FileName` VARCHAR(255) NOT NULL, "
+                                                            "`Priority` INTEGER NOT NULL, "
+                                                            "`Title` VARCHAR(85) NOT NULL, "
+                                                            "`ArtistName` VARCHAR(55), "
+                                                            "`AlbumTitle` VARCHAR(55), "
+                                                            "`AlbumArtistName` VARCHAR(55), "
+                                                            "`AlbumPath` VARCHAR(255), "
+                                                            "`TrackNumber` INTEGER, "
+                                                            "`DiscNumber` INTEGER, "
+                                                            "`Duration` INTEGER NOT NULL, "
+                                                            "`Rating` INTEGER NOT NULL DEFAULT 0, "
+                                                            "`Genre` VARCHAR(55), "
+                                                            "`Composer` VARCHAR(55), "
+                                                            "`Lyricist` VARCHAR(55), "
+                                                            "`Comment` VARCHAR(255), "
+                                                            "`Year` INTEGER, "
+                                                            "`Channels` INTEGER, "
+                                                            "`BitRate` INTEGER, "
+                                                            "`SampleRate` INTEGER, "
+                                                            "`HasEmbeddedCover` BOOLEAN NOT NULL, "
+                                                            "UNIQUE ("
+                                                            "`FileName`"
+                                                            "), "
+                                                            "UNIQUE ("
+                                                            "`Priority`, `Title`, `ArtistName`, "
+                                                            "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`"
+                                                            "), "
+                                                            "CONSTRAINT fk_fileName FOREIGN KEY (`FileName`, `DiscoverID`) "
+                                                            "REFERENCES `TracksData`(`FileName`, `DiscoverID`) ON DELETE CASCADE, "
+                                                            "CONSTRAINT fk_artist FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`), "
+                                                            "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
+                                                            "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
+                                                            "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
+                                                            "CONSTRAINT fk_tracks_discoverID FOREIGN KEY (`DiscoverID`) REFERENCES `DiscoverSource`(`ID`)"
+                                                            "CONSTRAINT fk_tracks_album FOREIGN KEY ("
+                                                            "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
+                                                            "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery copyDataQuery(d->mTracksDatabase);
+
+        auto result = copyDataQuery.exec(QStringLiteral("INSERT OR IGNORE INTO `NewTracks` "
+                                                        "("
+                                                        "`DiscoverID`, "
+                                                        "`FileName`, "
+                                                        "`Priority`, "
+                                                        "`Title`, "
+                                                        "`ArtistName`, "
+                                                        "`AlbumTitle`, "
+                                                        "`AlbumArtistName`, "
+                                                        "`AlbumPath`, "
+                                                        "`TrackNumber`, "
+                                                        "`DiscNumber`, "
+                                                        "`Duration`, "
+                                                        "`Rating`, "
+                                                        "`Genre`, "
+                                                        "`Composer`, "
+                                                        "`Lyricist`, "
+                                                        "`Comment`, "
+                                                        "`Year`, "
+                                                        "`Channels`, "
+                                                        "`BitRate`, "
+                                                        "`SampleRate`, "
+                                                        "`HasEmbeddedCover`"
+                                                        ") "
+                                                        "SELECT "
+                                                        "m.`DiscoverID`, "
+                                                        "m.`FileName`, "
+                                                        "m.`Priority`, "
+                                                        "t.`Title`, "
+                                                        "t.`ArtistName`, "
+                                                        "t.`AlbumTitle`, "
+                                                        "t.`AlbumArtistName`, "
+                                                        "t.`AlbumPath`, "
+                                                        "t.`TrackNumber`, "
+                                                        "t.`DiscNumber`, "
+                                                        "t.`Duration`, "
+                                                        "t.`Rating`, "
+                                                        "t.`Genre`, "
+                                                        "t.`Composer`, "
+                                                        "t.`Lyricist`, "
+                                                        "t.`Comment`, "
+                                                        "t.`Year`, "
+                                                        "t.`Channels`, "
+                                                        "t.`BitRate`, "
+                                                        "t.`SampleRate`, "
+                                                        "t.`HasEmbeddedCover` "
+                                                        "FROM "
+                                                        "`Tracks` t, "
+                                                        "`TracksMapping` m "
+                                                        "WHERE "
+                                                        "t.`ID` = m.`TrackID`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << copyDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << copyDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery updateDataQuery(d->mTracksDatabase);
+
+        auto result = updateDataQuery.exec(QStringLiteral("UPDATE `NewTracks` "
+                                                          "SET "
+                                                          "`TrackNumber` = NULL "
+                                                          "WHERE "
+                                                          "`TrackNumber` = -1"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery updateDataQuery(d->mTracksDatabase);
+
+        auto result = updateDataQuery.exec(QStringLiteral("UPDATE `NewTracks` "
+                                                          "SET "
+                                                          "`Channels` = NULL "
+                                                          "WHERE "
+                                                          "`Channels` = -1"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery updateDataQuery(d->mTracksDatabase);
+
+        auto result = updateDataQuery.exec(QStringLiteral("UPDATE `NewTracks` "
+                                                          "SET "
+                                                          "`BitRate` = NULL "
+                                                          "WHERE "
+                                                          "`BitRate` = -1"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery updateDataQuery(d->mTracksDatabase);
+
+        auto result = updateDataQuery.exec(QStringLiteral("UPDATE `NewTracks` "
+                                                          "SET "
+                                                          "`SampleRate` = NULL "
+                                                          "WHERE "
+                                                          "`SampleRate` = -1"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << updateDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Tracks`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `TracksMapping`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewTracks` RENAME TO `Tracks`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.commit();
+
+    {
+        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+
+        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << enableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << enableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksAlbumIndex` ON `Tracks` "
+                                                                  "(`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`ArtistNameIndex` ON `Tracks` "
+                                                                  "(`ArtistName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`AlbumArtistNameIndex` ON `Tracks` "
+                                                                  "(`AlbumArtistName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksUniqueData` ON `Tracks` "
+                                                                  "(`Title`, `ArtistName`, "
+                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksUniqueDataPriority` ON `Tracks` "
+                                                                  "(`Priority`, `Title`, `ArtistName`, "
+                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksFileNameIndex` ON `Tracks` "
+                                                                  "(`FileName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV11" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v11 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV12()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v12 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV12` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+
+        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << disableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << disableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.transaction();
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewTracks` ("
+                                                                   "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
+                                                                   "`FileName` VARCHAR(255) NOT NULL, "
+                                                                   "`Priority` INTEGER NOT NULL, "
+                                                                   "`Title` VARCHAR(85) NOT NULL, "
+                                                                   "`ArtistName` VARCHAR(55), "
+                                                                   "`AlbumTitle` VARCHAR(55), "
+                                                                   "`AlbumArtistName` VARCHAR(55), "
+                                                                   "`AlbumPath` VARCHAR(255), "
+                                                                   "`TrackNumber` INTEGER, "
+                                                                   "`DiscNumber` INTEGER, "
+                                                                   "`Duration` INTEGER NOT NULL, "
+                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
+                                                                   "`Genre` VARCHAR(55), "
+                                                                   "`Composer` VARCHAR(55), "
+                                                                   "`Lyricist` VARCHAR(55), "
+                                                                   "`Comment` VARCHAR(255), "
+                                                                   "`Year` INTEGER, "
+                                                                   "`Channels` INTEGER, "
+                                                                   "`BitRate` INTEGER, "
+                                                                   "`SampleRate` INTEGER, "
+                                                                   "`HasEmbeddedCover` BOOLEAN NOT NULL, "
+                                                                   "UNIQUE ("
+                                                                   "`FileName`"
+                                                                   "), "
+                                                                   "UNIQUE ("
+                                                                   "`Priority`, `Title`, `ArtistName`, "
+                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`"
+                                                                   "), "
+                                                                   "CONSTRAINT fk_fileName FOREIGN KEY (`FileName`) "
+                                                                   "REFERENCES `TracksData`(`FileName`) ON DELETE CASCADE, "
+                                                                   "CONSTRAINT fk_artist FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_album FOREIGN KEY ("
+                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
+                                                                   "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewTracksData` ("
+                                                                   "`FileName` VARCHAR(255) NOT NULL, "
+                                                                   "`FileModifiedTime` DATETIME NOT NULL, "
+                                                                   "`ImportDate` INTEGER NOT NULL, "
+                                                                   "`FirstPlayDate` INTEGER, "
+                                                                   "`LastPlayDate` INTEGER, "
+                                                                   "`PlayCounter` INTEGER NOT NULL, "
+                                                                   "PRIMARY KEY (`FileName`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+        }
+    }
+
+    {
+        QSqlQuery copyDataQuery(d->mTracksDatabase);
+
+        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `NewTracksData` "
+                                                        "SELECT "
+                                                        "td.`FileName`, "
+                                                        "td.`FileModifiedTime`, "
+                                                        "td.`ImportDate`, "
+                                                        "td.`FirstPlayDate`, "
+                                                        "td.`LastPlayDate`, "
+                                                        "td.`PlayCounter` "
+                                                        "FROM "
+                                                        "`TracksData` td"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << copyDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << copyDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery copyDataQuery(d->mTracksDatabase);
+
+        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `NewTracks` "
+                                                        "SELECT "
+                                                        "t.`ID`, "
+                                                        "t.`FileName`, "
+                                                        "t.`Priority`, "
+                                                        "t.`Title`, "
+                                                        "t.`ArtistName`, "
+                                                        "t.`AlbumTitle`, "
+                                                        "t.`AlbumArtistName`, "
+                                                        "t.`AlbumPath`, "
+                                                        "t.`TrackNumber`, "
+                                                        "t.`DiscNumber`, "
+                                                        "t.`Duration`, "
+                                                        "t.`Rating`, "
+                                                        "t.`Genre`, "
+                                                        "t.`Composer`, "
+                                                        "t.`Lyricist`, "
+                                                        "t.`Comment`, "
+                                                        "t.`Year`, "
+                                                        "t.`Channels`, "
+                                                        "t.`BitRate`, "
+                                                        "t.`SampleRate`, "
+                                                        "t.`HasEmbeddedCover` "
+                                                        "FROM "
+                                                        "`Tracks` t"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << copyDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << copyDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `TracksData`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Tracks`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewTracksData` RENAME TO `TracksData`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewTracks` RENAME TO `Tracks`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.commit();
+
+    {
+        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+
+        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << enableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << enableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksAlbumIndex` ON `Tracks` "
+                                                                  "(`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`ArtistNameIndex` ON `Tracks` "
+                                                                  "(`ArtistName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`AlbumArtistNameIndex` ON `Tracks` "
+                                                                  "(`AlbumArtistName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksUniqueData` ON `Tracks` "
+                                                                  "(`Title`, `ArtistName`, "
+                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksUniqueDataPriority` ON `Tracks` "
+                                                                  "(`Priority`, `Title`, `ArtistName`, "
+                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksFileNameIndex` ON `Tracks` "
+                                                                  "(`FileName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV12" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v12 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV13()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v13 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV13` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+
+        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << disableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << disableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.transaction();
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `NewTracks` ("
+                                                                   "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
+                                                                   "`FileName` VARCHAR(255) NOT NULL, "
+                                                                   "`Priority` INTEGER NOT NULL, "
+                                                                   "`Title` VARCHAR(85) NOT NULL, "
+                                                                   "`ArtistName` VARCHAR(55), "
+                                                                   "`AlbumTitle` VARCHAR(55), "
+                                                                   "`AlbumArtistName` VARCHAR(55), "
+                                                                   "`AlbumPath` VARCHAR(255), "
+                                                                   "`TrackNumber` INTEGER, "
+                                                                   "`DiscNumber` INTEGER, "
+                                                                   "`Duration` INTEGER NOT NULL, "
+                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
+                                                                   "`Genre` VARCHAR(55), "
+                                                                   "`Composer` VARCHAR(55), "
+                                                                   "`Lyricist` VARCHAR(55), "
+                                                                   "`Comment` VARCHAR(255), "
+                                                                   "`Year` INTEGER, "
+                                                                   "`Channels` INTEGER, "
+                                                                   "`BitRate` INTEGER, "
+                                                                   "`SampleRate` INTEGER, "
+                                                                   "`HasEmbeddedCover` BOOLEAN NOT NULL, "
+                                                                   "UNIQUE ("
+                                                                   "`FileName`"
+                                                                   "), "
+                                                                   "UNIQUE ("
+                                                                   "`Priority`, `Title`, `ArtistName`, "
+                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`, "
+                                                                   "`TrackNumber`, `DiscNumber`"
+                                                                   "), "
+                                                                   "CONSTRAINT fk_fileName FOREIGN KEY (`FileName`) "
+                                                                   "REFERENCES `TracksData`(`FileName`) ON DELETE CASCADE, "
+                                                                   "CONSTRAINT fk_artist FOREIGN KEY (`ArtistName`) REFERENCES `Artists`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_composer FOREIGN KEY (`Composer`) REFERENCES `Composer`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`Lyricist`) REFERENCES `Lyricist`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`), "
+                                                                   "CONSTRAINT fk_tracks_album FOREIGN KEY ("
+                                                                   "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"
+                                                                   "REFERENCES `Albums`(`Title`, `ArtistName`, `AlbumPath`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastError();
+        }
+    }
+
+    {
+        QSqlQuery copyDataQuery(d->mTracksDatabase);
+
+        auto result = copyDataQuery.exec(QStringLiteral("INSERT INTO `NewTracks` "
+                                                        "SELECT "
+                                                        "t.`ID`, "
+                                                        "t.`FileName`, "
+                                                        "t.`Priority`, "
+                                                        "t.`Title`, "
+                                                        "t.`ArtistName`, "
+                                                        "t.`AlbumTitle`, "
+                                                        "t.`AlbumArtistName`, "
+                                                        "t.`AlbumPath`, "
+                                                        "t.`TrackNumber`, "
+                                                        "t.`DiscNumber`, "
+                                                        "t.`Duration`, "
+                                                        "t.`Rating`, "
+                                                        "t.`Genre`, "
+                                                        "t.`Composer`, "
+                                                        "t.`Lyricist`, "
+                                                        "t.`Comment`, "
+                                                        "t.`Year`, "
+                                                        "t.`Channels`, "
+                                                        "t.`BitRate`, "
+                                                        "t.`SampleRate`, "
+                                                        "t.`HasEmbeddedCover` "
+                                                        "FROM "
+                                                        "`Tracks` t"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << copyDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << copyDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Tracks`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        auto result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `NewTracks` RENAME TO `Tracks`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.commit();
+
+    {
+        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+
+        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << enableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << enableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksAlbumIndex` ON `Tracks` "
+                                                                  "(`AlbumTitle`, `AlbumArtistName`, `AlbumPath`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`ArtistNameIndex` ON `Tracks` "
+                                                                  "(`ArtistName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`AlbumArtistNameIndex` ON `Tracks` "
+                                                                  "(`AlbumArtistName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksUniqueData` ON `Tracks` "
+                                                                  "(`Title`, `ArtistName`, "
+                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`, "
+                                                                  "`TrackNumber`, `DiscNumber`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksUniqueDataPriority` ON `Tracks` "
+                                                                  "(`Priority`, `Title`, `ArtistName`, "
+                                                                  "`AlbumTitle`, `AlbumArtistName`, `AlbumPath`, "
+                                                                  "`TrackNumber`, `DiscNumber`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksFileNameIndex` ON `Tracks` "
+                                                                  "(`FileName`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV13" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v13 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV14()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v14 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV14` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+
+        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << disableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << disableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.transaction();
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `Radios` ("
+                                                                   "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
+                                                                   "`HttpAddress` VARCHAR(255) NOT NULL, "
+                                                                   "`Priority` INTEGER NOT NULL, "
+                                                                   "`Title` VARCHAR(85) NOT NULL, "
+                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
+                                                                   "`Genre` VARCHAR(55), "
+                                                                   "`Comment` VARCHAR(255), "
+                                                                   "UNIQUE ("
+                                                                   "`HttpAddress`"
+                                                                   "), "
+                                                                   "UNIQUE ("
+                                                                   "`Priority`, `Title`, `HttpAddress`"
+                                                                   ") "
+                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`))"
+                                                                   ));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        //Find webradios (french): https://doc.ubuntu-fr.org/liste_radio_france
+        //English: https://www.radio.fr/language/english (to get the link play a radio and look for streamUrl in the html elements page).
+        const auto &result = createSchemaQuery.exec(QStringLiteral("INSERT INTO `Radios` (`HttpAddress`, `Priority`, `Title`) "
+                                        "SELECT 'http://classicrock.stream.ouifm.fr/ouifm3.mp3', 1, 'OuiFM_Classic_Rock' UNION ALL "
+                                        "SELECT 'http://rock70s.stream.ouifm.fr/ouifmseventies.mp3', 1, 'OuiFM_70s' UNION ALL "
+                                        "SELECT 'http://jazzradio.ice.infomaniak.ch/jazzradio-high.mp3', 2 , 'Jazz_Radio' UNION ALL "
+                                        "SELECT 'http://cdn.nrjaudio.fm/audio1/fr/30601/mp3_128.mp3?origine=playerweb', 1, 'Nostalgie' UNION ALL "
+                                        "SELECT 'https://scdn.nrjaudio.fm/audio1/fr/30713/aac_64.mp3?origine=playerweb', 1, 'Nostalgie Johnny' UNION ALL "
+                                        "SELECT 'http://sc-classrock.1.fm:8200', 1, 'Classic rock replay' UNION ALL "
+                                        "SELECT 'http://agnes.torontocast.com:8151/stream', 1, 'Instrumentals Forever' UNION ALL "
+                                        "SELECT 'https://stream.laut.fm/jahfari', 1, 'Jahfari'"
+                                                                   ));
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.commit();
+
+    {
+        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+
+        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << enableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV14" << enableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v14 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV15()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v15 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersionV15` (`Version` INTEGER PRIMARY KEY NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+
+        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << disableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << disableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.transaction();
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `RadiosNew` ("
+                                                                   "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
+                                                                   "`HttpAddress` VARCHAR(255) NOT NULL, "
+                                                                   "`ImageAddress` VARCHAR(255) NOT NULL, "
+                                                                   "`Title` VARCHAR(85) NOT NULL, "
+                                                                   "`Rating` INTEGER NOT NULL DEFAULT 0, "
+                                                                   "`Genre` VARCHAR(55), "
+                                                                   "`Comment` VARCHAR(255), "
+                                                                   "UNIQUE ("
+                                                                   "`HttpAddress`"
+                                                                   "), "
+                                                                   "UNIQUE ("
+                                                                   "`Title`, `HttpAddress`"
+                                                                   ") "
+                                                                   "CONSTRAINT fk_tracks_genre FOREIGN KEY (`Genre`) REFERENCES `Genre`(`Name`))"
+                                                                   ));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("INSERT INTO RadiosNew SELECT ID, HttpAddress, '', Title, Rating, Genre, Comment FROM Radios"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("DROP TABLE `Radios`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `RadiosNew` RENAME TO `Radios`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+        const auto &result = createSchemaQuery.exec(QStringLiteral("INSERT INTO `Radios` (`HttpAddress`, `ImageAddress`, `Title`) "
+                                        "SELECT 'https://chai5she.cdn.dvmr.fr/francemusique-lofi.mp3', 'https://static.radio.fr/images/broadcasts/07/f7/3366/c44.png', 'France Musique'"
+                                                                   ));
+        if (!result) {
+            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << createSchemaQuery.lastQuery();
+            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    d->mTracksDatabase.commit();
+
+    {
+        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+
+        auto result = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << enableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV15" << enableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v15 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV16()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v16 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    {
+        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+
+        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << disableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << disableForeignKeys.lastError();
+
+            d->mIsInBadState = true;
+
+            Q_EMIT databaseError();
+
+            return;
+        }
+    }
+
+    // the new table is only renamed once all the tracks are copied: on any failure the old tables are kept untouched
+    const auto upgradeTexts = QStringList{
+            // the names are kept for display and for the duplicated tracks detection, the references use the integer ids
+            QStringLiteral("CREATE TABLE `NewTracks` ("
+                           "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
+                           "`FileName` VARCHAR(255) NOT NULL, "
+                           "`Priority` INTEGER NOT NULL, "
+                           "`Title` VARCHAR(85) NOT NULL, "
+                           "`ArtistName` VARCHAR(55), "
+                           "`AlbumTitle` VARCHAR(55), "
+                           "`AlbumArtistName` VARCHAR(55), "
+                           "`AlbumPath` VARCHAR(255), "
+                           "`TrackNumber` INTEGER, "
+                           "`DiscNumber` INTEGER, "
+                           "`Duration` INTEGER NOT NULL, "
+                           "`Rating` INTEGER NOT NULL DEFAULT 0, "
+                           "`Comment` VARCHAR(255), "
+                           "`Year` INTEGER, "
+                           "`Channels` INTEGER, "
+                           "`BitRate` INTEGER, "
+                           "`SampleRate` INTEGER, "
+                           "`HasEmbeddedCover` BOOLEAN NOT NULL, "
+                           "`ArtistID` INTEGER, "
+                           "`AlbumID` INTEGER, "
+                           "`GenreID` INTEGER, "
+                           "`ComposerID` INTEGER, "
+                           "`LyricistID` INTEGER, "
+                           "UNIQUE ("
+                           "`FileName`"
+                           "), "
+                           "UNIQUE ("
+                           "`Priority`, `Title`, `ArtistID`, `AlbumID`, "
+                           "`TrackNumber`, `DiscNumber`"
+                           "), "
+                           "CONSTRAINT fk_fileName FOREIGN KEY (`FileName`) "
+                           "REFERENCES `TracksData`(`FileName`) ON DELETE CASCADE, "
+                           "CONSTRAINT fk_artist FOREIGN KEY (`ArtistID`) REFERENCES `Artists`(`ID`), "
+                           "CONSTRAINT fk_tracks_composer FOREIGN KEY (`ComposerID`) REFERENCES `Composer`(`ID`), "
+                           "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`LyricistID`) REFERENCES `Lyricist`(`ID`), "
+                           "CONSTRAINT fk_tracks_genre FOREIGN KEY (`GenreID`) REFERENCES `Genre`(`ID`), "
+                           "CONSTRAINT fk_tracks_album FOREIGN KEY (`AlbumID`) REFERENCES `Albums`(`ID`))"),
+            QStringLiteral("INSERT INTO `NewTracks` "
+                           "SELECT "
+                           "t.`ID`, "
+                           "t.`FileName`, "
+                           "t.`Priority`, "
+                           "t.`Title`, "
+                           "t.`ArtistName`, "
+                           "t.`AlbumTitle`, "
+                           "t.`AlbumArtistName`, "
+                           "t.`AlbumPath`, "
+                           "t.`TrackNumber`, "
+                           "t.`DiscNumber`, "
+                           "t.`Duration`, "
+                           "t.`Rating`, "
+                           "t.`Comment`, "
+                           "t.`Year`, "
+                           "t.`Channels`, "
+                           "t.`BitRate`, "
+                           "t.`SampleRate`, "
+                           "t.`HasEmbeddedCover`, "
+                           "(SELECT artist.`ID` FROM `Artists` artist WHERE artist.`Name` = t.`ArtistName`), "
+                           "("
+                           "SELECT album.`ID` FROM `Albums` album "
+                           "WHERE "
+                           "album.`Title` = t.`AlbumTitle` AND "
+                           "(album.`ArtistName` = t.`AlbumArtistName` OR "
+                           "(album.`ArtistName` IS NULL AND t.`AlbumArtistName` IS NULL)) AND "
+                           "album.`AlbumPath` = t.`AlbumPath` "
+                           "ORDER BY album.`ID` "
+                           "LIMIT 1"
+                           "), "
+                           "(SELECT genre.`ID` FROM `Genre` genre WHERE genre.`Name` = t.`Genre`), "
+                           "(SELECT composer.`ID` FROM `Composer` composer WHERE composer.`Name` = t.`Composer`), "
+                           "(SELECT lyricist.`ID` FROM `Lyricist` lyricist WHERE lyricist.`Name` = t.`Lyricist`) "
+                           "FROM "
+                           "`Tracks` t"),
+            QStringLiteral("DROP TABLE `Tracks`"),
+            QStringLiteral("ALTER TABLE `NewTracks` RENAME TO `Tracks`"),
+    };
+
+    auto result = d->mTracksDatabase.transaction();
+
+    QSqlQuery upgradeQuery(d->mTracksDatabase);
+
+    for (const auto &oneText : upgradeTexts) {
+        if (!result) {
+            break;
+        }
+
+        result = upgradeQuery.exec(oneText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << upgradeQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << upgradeQuery.lastError();
+        }
+    }
+
+    if (result) {
+        result = d->mTracksDatabase.commit();
+    }
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << d->mTracksDatabase.lastError();
+
+        d->mTracksDatabase.rollback();
+    }
+
+    {
+        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+
+        auto enableResult = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+
+        if (!enableResult) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << enableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << enableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    if (!result) {
+        d->mIsInBadState = true;
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    const auto createTrackIndexTexts = QStringList{
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksUniqueData` ON `Tracks` "
+                           "(`Title`, `ArtistID`, `AlbumID`, `Priority`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksFileNameIndex` ON `Tracks` (`FileName`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksAlbumIDIndex` ON `Tracks` (`AlbumID`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksArtistIDIndex` ON `Tracks` (`ArtistID`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksGenreIDIndex` ON `Tracks` (`GenreID`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksComposerIDIndex` ON `Tracks` (`ComposerID`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksLyricistIDIndex` ON `Tracks` (`LyricistID`)"),
+    };
+
+    QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+    for (const auto &oneText : createTrackIndexTexts) {
+        if (!createTrackIndex.exec(oneText)) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v16 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::upgradeDatabaseV17()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v17 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    {
+        QSqlQuery disableForeignKeys(d->mTracksDatabase);
+
+        auto result = disableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=OFF"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << disableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << disableForeignKeys.lastError();
+
+            d->mIsInBadState = true;
+
+            Q_EMIT databaseError();
+
+            return;
+        }
+    }
+
+    // file names are stored once per directory: the directory keeps its trailing slash and the
+    // new TracksData rows keep the rowid of the old ones so that Tracks follows
+    const auto upgradeTexts = QStringList{
+            QStringLiteral("CREATE TABLE `Directories` ("
+                           "`ID` INTEGER PRIMARY KEY NOT NULL, "
+                           "`Path` VARCHAR(255) NOT NULL, "
+                           "UNIQUE (`Path`))"),
+            QStringLiteral("INSERT INTO `Directories` (`Path`) "
+                           "SELECT DISTINCT "
+                           "substr(td.`FileName`, 1, length(rtrim(td.`FileName`, replace(td.`FileName`, '/', '')))) "
+                           "FROM "
+                           "`TracksData` td"),
+            QStringLiteral("CREATE TABLE `NewTracksData` ("
+                           "`ID` INTEGER PRIMARY KEY NOT NULL, "
+                           "`DirectoryID` INTEGER NOT NULL, "
+                           "`BaseName` VARCHAR(255) NOT NULL, "
+                           "`FileModifiedTime` DATETIME NOT NULL, "
+                           "`ImportDate` INTEGER NOT NULL, "
+                           "`FirstPlayDate` INTEGER, "
+                           "`LastPlayDate` INTEGER, "
+                           "`PlayCounter` INTEGER NOT NULL, "
+                           "UNIQUE (`DirectoryID`, `BaseName`), "
+                           "CONSTRAINT fk_directory FOREIGN KEY (`DirectoryID`) REFERENCES `Directories`(`ID`))"),
+            QStringLiteral("INSERT INTO `NewTracksData` "
+                           "SELECT "
+                           "td.`rowid`, "
+                           "directory.`ID`, "
+                           "substr(td.`FileName`, length(directory.`Path`) + 1), "
+                           "td.`FileModifiedTime`, "
+                           "td.`ImportDate`, "
+                           "td.`FirstPlayDate`, "
+                           "td.`LastPlayDate`, "
+                           "td.`PlayCounter` "
+                           "FROM "
+                           "`TracksData` td, "
+                           "`Directories` directory "
+                           "WHERE "
+                           "directory.`Path` = substr(td.`FileName`, 1, length(rtrim(td.`FileName`, replace(td.`FileName`, '/', ''))))"),
+            QStringLiteral("CREATE TABLE `NewTracks` ("
+                           "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
+                           "`FileID` INTEGER NOT NULL, "
+                           "`Priority` INTEGER NOT NULL, "
+                           "`Title` VARCHAR(85) NOT NULL, "
+                           "`ArtistName` VARCHAR(55), "
+                           "`AlbumTitle` VARCHAR(55), "
+                           "`AlbumArtistName` VARCHAR(55), "
+                           "`AlbumPath` VARCHAR(255), "
+                           "`TrackNumber` INTEGER, "
+                           "`DiscNumber` INTEGER, "
+                           "`Duration` INTEGER NOT NULL, "
+                           "`Rating` INTEGER NOT NULL DEFAULT 0, "
+                           "`Comment` VARCHAR(255), "
+                           "`Year` INTEGER, "
+                           "`Channels` INTEGER, "
+                           "`BitRate` INTEGER, "
+                           "`SampleRate` INTEGER, "
+                           "`HasEmbeddedCover` BOOLEAN NOT NULL, "
+                           "`ArtistID` INTEGER, "
+                           "`AlbumID` INTEGER, "
+                           "`GenreID` INTEGER, "
+                           "`ComposerID` INTEGER, "
+                           "`LyricistID` INTEGER, "
+                           "UNIQUE ("
+                           "`FileID`"
+                           "), "
+                           "UNIQUE ("
+                           "`Priority`, `Title`, `ArtistID`, `AlbumID`, "
+                           "`TrackNumber`, `DiscNumber`"
+                           "), "
+                           "CONSTRAINT fk_fileName FOREIGN KEY (`FileID`) "
+                           "REFERENCES `TracksData`(`ID`) ON DELETE CASCADE, "
+                           "CONSTRAINT fk_artist FOREIGN KEY (`ArtistID`) REFERENCES `Artists`(`ID`), "
+                           "CONSTRAINT fk_tracks_composer FOREIGN KEY (`ComposerID`) REFERENCES `Composer`(`ID`), "
+                           "CONSTRAINT fk_tracks_lyricist FOREIGN KEY (`LyricistID`) REFERENCES `Lyricist`(`ID`), "
+                           "CONSTRAINT fk_tracks_genre FOREIGN KEY (`GenreID`) REFERENCES `Genre`(`ID`), "
+                           "CONSTRAINT fk_tracks_album FOREIGN KEY (`AlbumID`) REFERENCES `Albums`(`ID`))"),
+            QStringLiteral("INSERT INTO `NewTracks` "
+                           "SELECT "
+                           "t.`ID`, "
+                           "td.`rowid`, "
+                           "t.`Priority`, "
+                           "t.`Title`, "
+                           "t.`ArtistName`, "
+                           "t.`AlbumTitle`, "
+                           "t.`AlbumArtistName`, "
+                           "t.`AlbumPath`, "
+                           "t.`TrackNumber`, "
+                           "t.`DiscNumber`, "
+                           "t.`Duration`, "
+                           "t.`Rating`, "
+                           "t.`Comment`, "
+                           "t.`Year`, "
+                           "t.`Channels`, "
+                           "t.`BitRate`, "
+                           "t.`SampleRate`, "
+                           "t.`HasEmbeddedCover`, "
+                           "t.`ArtistID`, "
+                           "t.`AlbumID`, "
+                           "t.`GenreID`, "
+                           "t.`ComposerID`, "
+                           "t.`LyricistID` "
+                           "FROM "
+                           "`Tracks` t, "
+                           "`TracksData` td "
+                           "WHERE "
+                           "td.`FileName` = t.`FileName`"),
+            QStringLiteral("DROP TABLE `Tracks`"),
+            QStringLiteral("DROP TABLE `TracksData`"),
+            QStringLiteral("ALTER TABLE `NewTracksData` RENAME TO `TracksData`"),
+            QStringLiteral("ALTER TABLE `NewTracks` RENAME TO `Tracks`"),
+    };
+
+    // the old tables are only dropped once everything is copied: on any failure they are kept untouched
+    auto result = d->mTracksDatabase.transaction();
+
+    QSqlQuery upgradeQuery(d->mTracksDatabase);
+
+    for (const auto &oneText : upgradeTexts) {
+        if (!result) {
+            break;
+        }
+
+        result = upgradeQuery.exec(oneText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << upgradeQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << upgradeQuery.lastError();
+        }
+    }
+
+    if (result) {
+        result = d->mTracksDatabase.commit();
+    }
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << d->mTracksDatabase.lastError();
+
+        d->mTracksDatabase.rollback();
+    }
+
+    {
+        QSqlQuery enableForeignKeys(d->mTracksDatabase);
+
+        auto enableResult = enableForeignKeys.exec(QStringLiteral(" PRAGMA foreign_keys=ON"));
+
+        if (!enableResult) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << enableForeignKeys.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << enableForeignKeys.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    if (!result) {
+        d->mIsInBadState = true;
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    const auto createTrackIndexTexts = QStringList{
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksUniqueData` ON `Tracks` "
+                           "(`Title`, `ArtistID`, `AlbumID`, `Priority`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksAlbumIDIndex` ON `Tracks` (`AlbumID`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksArtistIDIndex` ON `Tracks` (`ArtistID`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksGenreIDIndex` ON `Tracks` (`GenreID`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksComposerIDIndex` ON `Tracks` (`ComposerID`)"),
+            QStringLiteral("CREATE INDEX IF NOT EXISTS `TracksLyricistIDIndex` ON `Tracks` (`LyricistID`)"),
+    };
+
+    QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+    for (const auto &oneText : createTrackIndexTexts) {
+        if (!createTrackIndex.exec(oneText)) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v17 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::upgradeDatabaseV18()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v18 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    QSqlQuery createSearchIndexQuery(d->mTracksDatabase);
+
+    // the search index is optional: without the fts5 module, the views keep filtering their rows themselves
+    auto result = createSearchIndexQuery.exec(QStringLiteral("CREATE VIRTUAL TABLE IF NOT EXISTS `TracksSearch` USING fts5("
+                                                             "`Title`, "
+                                                             "`ArtistName`, "
+                                                             "`AlbumArtistName`, "
+                                                             "`AlbumTitle`, "
+                                                             "`Genre`, "
+                                                             "`Composer`, "
+                                                             "`Lyricist`, "
+                                                             "tokenize = 'unicode61', "
+                                                             "prefix = '2 3')"));
+
+    if (result) {
+        result = createSearchIndexQuery.exec(QStringLiteral("CREATE VIRTUAL TABLE IF NOT EXISTS `AlbumsSearch` USING fts5("
+                                                            "`Title`, "
+                                                            "`ArtistName`, "
+                                                            "`AllArtists`, "
+                                                            "`AllGenres`, "
+                                                            "tokenize = 'unicode61', "
+                                                            "prefix = '2 3')"));
+    }
+
+    if (result) {
+        rebuildSearchIndex();
+    } else {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV18" << createSearchIndexQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV18" << createSearchIndexQuery.lastError();
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v18 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::upgradeDatabaseV19()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v19 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    QSqlQuery createAlbumIndex(d->mTracksDatabase);
+
+    const auto &result = createAlbumIndex.exec(QStringLiteral("CREATE INDEX "
+                                                              "IF NOT EXISTS "
+                                                              "`AlbumsTitleIndex` ON `Albums` "
+                                                              "(`Title` COLLATE NOCASE, `ID`)"));
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << createAlbumIndex.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << createAlbumIndex.lastError();
+
+        Q_EMIT databaseError();
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v19 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::upgradeDatabaseV20()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v20 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    QSqlQuery upgradeQuery(d->mTracksDatabase);
+
+    // aggregates of the tracks of each album, kept up to date when tracks are inserted, modified or removed
+    auto result = upgradeQuery.exec(QStringLiteral("CREATE TABLE `AlbumSummary` ("
+                                                   "`AlbumID` INTEGER PRIMARY KEY NOT NULL, "
+                                                   "`TracksCount` INTEGER NOT NULL, "
+                                                   "`ArtistsCount` INTEGER NOT NULL, "
+                                                   "`AllArtists` TEXT, "
+                                                   "`HighestRating` INTEGER, "
+                                                   "`AllGenres` TEXT, "
+                                                   "`IsSingleDiscAlbum` BOOLEAN NOT NULL, "
+                                                   "`EmbeddedCover` VARCHAR(255), "
+                                                   "CONSTRAINT fk_album FOREIGN KEY (`AlbumID`) REFERENCES `Albums`(`ID`) "
+                                                   "ON DELETE CASCADE)"));
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV20" << upgradeQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV20" << upgradeQuery.lastError();
+
+        d->mIsInBadState = true;
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    rebuildAlbumSummary();
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v20 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::upgradeDatabaseV21()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v21 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    const auto upgradeTexts = QStringList{
+            // increased with each change of the data shown in the views, the model snapshot is only reused when it matches
+            QStringLiteral("CREATE TABLE `DatabaseGeneration` ("
+                           "`Generation` INTEGER NOT NULL)"),
+            QStringLiteral("INSERT INTO `DatabaseGeneration` (`Generation`) VALUES (0)"),
+    };
+
+    auto result = d->mTracksDatabase.transaction();
+
+    QSqlQuery upgradeQuery(d->mTracksDatabase);
+
+    for (const auto &oneText : upgradeTexts) {
+        if (!result) {
+            break;
+        }
+
+        result = upgradeQuery.exec(oneText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV21" << upgradeQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV21" << upgradeQuery.lastError();
+        }
+    }
+
+    if (result) {
+        result = d->mTracksDatabase.commit();
+    }
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV21" << d->mTracksDatabase.lastError();
+
+        d->mTracksDatabase.rollback();
+
+        d->mIsInBadState = true;
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v21 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::upgradeDatabaseV22()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v22 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    const auto upgradeTexts = QStringList{
+            // each play adds 2^((playDate - ReferenceTime) / half-life) to the score of the track: comparing the scores gives
+            // the same order as comparing decayed play counts, and the scores are only rescaled when ReferenceTime moves
+            QStringLiteral("CREATE TABLE `TracksPlayScore` ("
+                           "`FileID` INTEGER PRIMARY KEY NOT NULL, "
+                           "`Score` REAL NOT NULL, "
+                           "CONSTRAINT fk_tracksdata FOREIGN KEY (`FileID`) REFERENCES `TracksData`(`ID`) "
+                           "ON DELETE CASCADE)"),
+            QStringLiteral("CREATE INDEX `TracksPlayScoreIndex` ON `TracksPlayScore` (`Score`)"),
+            QStringLiteral("CREATE INDEX `TracksDataLastPlayDateIndex` ON `TracksData` (`LastPlayDate`)"),
+            QStringLiteral("CREATE TABLE `PlayScoreReference` ("
+                           "`ReferenceTime` INTEGER NOT NULL)"),
+    };
+
+    auto result = d->mTracksDatabase.transaction();
+
+    QSqlQuery upgradeQuery(d->mTracksDatabase);
+
+    for (const auto &oneText : upgradeTexts) {
+        if (!result) {
+            break;
+        }
+
+        result = upgradeQuery.exec(oneText);
+    }
+
+    const auto referenceTime = QDateTime::currentMSecsSinceEpoch();
+
+    if (result) {
+        upgradeQuery.prepare(QStringLiteral("INSERT INTO `PlayScoreReference` (`ReferenceTime`) VALUES (:referenceTime)"));
+        upgradeQuery.bindValue(QStringLiteral(":referenceTime"), referenceTime);
+        result = upgradeQuery.exec();
+    }
+
+    if (result) {
+        result = upgradeQuery.exec(QStringLiteral("SELECT `ID`, `FirstPlayDate`, `LastPlayDate`, `PlayCounter` "
+                                                  "FROM `TracksData` "
+                                                  "WHERE `PlayCounter` > 0"));
+    }
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV22" << upgradeQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV22" << upgradeQuery.lastError();
+    }
+
+    QSqlQuery insertPlayScoreQuery(d->mTracksDatabase);
+    insertPlayScoreQuery.prepare(QStringLiteral("INSERT INTO `TracksPlayScore` (`FileID`, `Score`) "
+                                                "VALUES (:fileId, :score)"));
+
+    while (result && upgradeQuery.next()) {
+        const auto firstPlayDate = upgradeQuery.value(1).toLongLong();
+        const auto lastPlayDate = upgradeQuery.value(2).toLongLong();
+        const auto playCounter = upgradeQuery.value(3).toInt();
+
+        insertPlayScoreQuery.bindValue(QStringLiteral(":fileId"), upgradeQuery.value(0));
+        insertPlayScoreQuery.bindValue(QStringLiteral(":score"),
+                                       std::exp2(double(firstPlayDate - referenceTime) / DatabaseInterfacePrivate::PlayScoreHalfLife) +
+                                       (playCounter - 1) * std::exp2(double(lastPlayDate - referenceTime) / DatabaseInterfacePrivate::PlayScoreHalfLife));
+
+        result = insertPlayScoreQuery.exec();
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV22" << insertPlayScoreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV22" << insertPlayScoreQuery.lastError();
+        }
+    }
+
+    upgradeQuery.finish();
+
+    if (result) {
+        result = d->mTracksDatabase.commit();
+    }
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV22" << d->mTracksDatabase.lastError();
+
+        d->mTracksDatabase.rollback();
+
+        d->mIsInBadState = true;
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v22 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::upgradeDatabaseV23()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v23 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    const auto upgradeTexts = QStringList{
+            // ids changed by the last generations, read by the other processes using the same database file
+            QStringLiteral("CREATE TABLE `DatabaseChangesJournal` ("
+                           "`Generation` INTEGER NOT NULL, "
+                           "`Kind` INTEGER NOT NULL, "
+                           "`ID` INTEGER NOT NULL)"),
+            QStringLiteral("CREATE INDEX `DatabaseChangesJournalGenerationIndex` "
+                           "ON `DatabaseChangesJournal` (`Generation`)"),
+    };
+
+    auto result = d->mTracksDatabase.transaction();
+
+    QSqlQuery upgradeQuery(d->mTracksDatabase);
+
+    for (const auto &oneText : upgradeTexts) {
+        if (!result) {
+            break;
+        }
+
+        result = upgradeQuery.exec(oneText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV23" << upgradeQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV23" << upgradeQuery.lastError();
+        }
+    }
+
+    if (result) {
+        result = d->mTracksDatabase.commit();
+    }
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV23" << d->mTracksDatabase.lastError();
+
+        d->mTracksDatabase.rollback();
+
+        d->mIsInBadState = true;
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v23 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::upgradeDatabaseV24()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v24 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    QSqlQuery upgradeQuery(d->mTracksDatabase);
+
+    // directories whose modification time and entries count did not change are not listed again by the next startup scan
+    auto result = upgradeQuery.exec(QStringLiteral("CREATE TABLE `DirectoriesState` ("
+                                                   "`Path` VARCHAR(255) PRIMARY KEY NOT NULL, "
+                                                   "`ModifiedTime` INTEGER NOT NULL, "
+                                                   "`EntriesCount` INTEGER NOT NULL)"));
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV24" << upgradeQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV24" << upgradeQuery.lastError();
+
+        d->mIsInBadState = true;
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v24 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::upgradeDatabaseV25()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v25 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    QSqlQuery upgradeQuery(d->mTracksDatabase);
+
+    auto result = upgradeQuery.exec(QStringLiteral("PRAGMA auto_vacuum"));
+    const auto autoVacuumMode = (result && upgradeQuery.next()) ? upgradeQuery.value(0).toInt() : 0;
+    upgradeQuery.finish();
+
+    // the auto vacuum mode of an existing file only changes with a full VACUUM, it cannot run inside a transaction
+    if (result && autoVacuumMode != 2 && !d->mDatabaseFileName.isEmpty()) {
+        result = upgradeQuery.exec(QStringLiteral("PRAGMA auto_vacuum = INCREMENTAL"));
+
+        if (result) {
+            result = upgradeQuery.exec(QStringLiteral("VACUUM"));
+        }
+    }
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV25" << upgradeQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV25" << upgradeQuery.lastError();
+
+        d->mIsInBadState = true;
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v25 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::upgradeDatabaseV26()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v26 of database schema";
+
+    auto upgradeTimer = QElapsedTimer{};
+    upgradeTimer.start();
+
+    const auto upgradeTexts = QStringList{
+            // sequence number of the last play of the play statistics journal committed to the database
+            QStringLiteral("CREATE TABLE `PlayStatisticsJournalState` ("
+                           "`LastAppliedSequence` INTEGER NOT NULL)"),
+            QStringLiteral("INSERT INTO `PlayStatisticsJournalState` (`LastAppliedSequence`) VALUES (0)"),
+    };
+
+    auto result = d->mTracksDatabase.transaction();
+
+    QSqlQuery upgradeQuery(d->mTracksDatabase);
+
+    for (const auto &oneText : upgradeTexts) {
+        if (!result) {
+            break;
+        }
+
+        result = upgradeQuery.exec(oneText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV26" << upgradeQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV26" << upgradeQuery.lastError();
+        }
+    }
+
+    if (result) {
+        result = d->mTracksDatabase.commit();
+    }
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV26" << d->mTracksDatabase.lastError();
+
+        d->mTracksDatabase.rollback();
+
+        d->mIsInBadState = true;
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v26 of database schema in" << upgradeTimer.elapsed() << "ms";
+}
+
+void DatabaseInterface::checkDatabaseSchema()
+{
+    checkAlbumsTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkArtistsTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkComposerTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkGenreTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkLyricistTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkTracksTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkTracksDataTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+}
+
+void DatabaseInterface::checkAlbumsTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Title"),
+                                  QStringLiteral("ArtistName"), QStringLiteral("AlbumPath"),
+                                  QStringLiteral("CoverFileName")};
+
+    genericCheckTable(QStringLiteral("Albums"), fieldsList);
+}
+
+void DatabaseInterface::checkArtistsTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name")};
+
+    genericCheckTable(QStringLiteral("Artists"), fieldsList);
+}
+
+void DatabaseInterface::checkComposerTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name")};
+
+    genericCheckTable(QStringLiteral("Composer"), fieldsList);
+}
+
+void DatabaseInterface::checkGenreTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name")};
+
+    genericCheckTable(QStringLiteral("Genre"), fieldsList);
+}
+
+void DatabaseInterface::checkLyricistTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name")};
+
+    genericCheckTable(QStringLiteral("Lyricist"), fieldsList);
+}
+
+void DatabaseInterface::checkTracksTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("FileID"),
+                                  QStringLiteral("Priority"), QStringLiteral("Title"),
+                                  QStringLiteral("ArtistName"), QStringLiteral("AlbumTitle"),
+                                  QStringLiteral("AlbumArtistName"), QStringLiteral("AlbumPath"),
+                                  QStringLiteral("TrackNumber"), QStringLiteral("DiscNumber"),
+                                  QStringLiteral("Duration"), QStringLiteral("Rating"),
+                                  QStringLiteral("Comment"), QStringLiteral("Year"),
+                                  QStringLiteral("Channels"), QStringLiteral("BitRate"),
+                                  QStringLiteral("SampleRate"), QStringLiteral("HasEmbeddedCover"),
+                                  QStringLiteral("ArtistID"), QStringLiteral("AlbumID"),
+                                  QStringLiteral("GenreID"), QStringLiteral("ComposerID"),
+                                  QStringLiteral("LyricistID")};
+
+    genericCheckTable(QStringLiteral("Tracks"), fieldsList);
+}
+
+void DatabaseInterface::checkTracksDataTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("DirectoryID"),
+                                  QStringLiteral("BaseName"), QStringLiteral("FileModifiedTime"),
+                                  QStringLiteral("ImportDate"), QStringLiteral("FirstPlayDate"),
+                                  QStringLiteral("LastPlayDate"), QStringLiteral("PlayCounter")};
+
+    genericCheckTable(QStringLiteral("TracksData"), fieldsList);
+}
+
+void DatabaseInterface::genericCheckTable(const QString &tableName, const QStringList &expectedColumns)
+{
+    auto columnsList = d->mTracksDatabase.record(tableName);
+
+    if (columnsList.count() != expectedColumns.count()) {
+        qCInfo(orgKdeElisaDatabase()) << tableName << "table has wrong number of columns" << columnsList.count() << "expected" << expectedColumns.count();
+        d->mIsInBadState = true;
+        return;
+    }
+
+    for (const auto &oneField : expectedColumns) {
+        if (!columnsList.contains(oneField)) {
+            qCInfo(orgKdeElisaDatabase()) << tableName << "table has missing column" << oneField;
+            d->mIsInBadState = true;
+            return;
+        }
+    }
+}
+
+void DatabaseInterface::resetDatabase()
+{
+    qCInfo(orgKdeElisaDatabase()) << "Full reset of database due to corrupted database";
+
+    auto listTables = d->mTracksDatabase.tables();
+
+    while(!listTables.isEmpty()) {
+        for (const auto &oneTable : listTables) {
+            QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+            qCDebug(orgKdeElisaDatabase()) << "dropping table" << oneTable;
+            createSchemaQuery.exec(QStringLiteral("DROP TABLE ") + oneTable);
+        }
+
+        listTables = d->mTracksDatabase.tables();
+
+        if (listTables == QStringList{QStringLiteral("sqlite_sequence")}) {
+            break;
+        }
+    }
+
+    d->mIsInBadState = false;
+}
+
+void DatabaseInterface::manageNewDatabaseVersion()
+{
+    int versionBegin = 0;
+
+    auto listTables = d->mTracksDatabase.tables();
+
+    if (listTables.contains(QLatin1String("DatabaseVersion"))) {
+        manageNewDatabaseVersionInitRequests();
+
+        auto queryResult = execQuery(d->mSelectDatabaseVersionQuery);
+        if (!queryResult) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersion" << d->mUpdateDatabaseVersionQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersion" << d->mUpdateDatabaseVersionQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+
+        if(d->mSelectDatabaseVersionQuery.next()) {
+            const auto &currentRecord = d->mSelectDatabaseVersionQuery.record();
+
+            versionBegin = currentRecord.value(0).toInt() + 1;
+        }
+
+        // a statement still reading would make the VACUUM of the v25 update fail
+        d->mSelectDatabaseVersionQuery.finish();
+
+        // V16 used to be stored before its upgrade existed
+        if (versionBegin > DatabaseInterface::V16 &&
+                !d->mTracksDatabase.record(QStringLiteral("Tracks")).contains(QStringLiteral("AlbumID"))) {
+            versionBegin = DatabaseInterface::V16;
+        }
+    } else if (listTables.contains(QLatin1String("DatabaseVersionV5")) &&
+               !listTables.contains(QLatin1String("DatabaseVersionV9"))) {
+        versionBegin = DatabaseInterface::V9;
+    } else {
+        createDatabaseVersionTable();
+        manageNewDatabaseVersionInitRequests();
+
+        if(listTables.contains(QLatin1String("DatabaseVersionV9"))) {
+            if (!listTables.contains(QLatin1String("DatabaseVersionV11"))) {
+                versionBegin = DatabaseInterface::V11;
+            } else if (!listTables.contains(QLatin1String("DatabaseVersionV12"))) {
+                versionBegin = DatabaseInterface::V12;
+            } else if (!listTables.contains(QLatin1String("DatabaseVersionV13"))) {
+                versionBegin = DatabaseInterface::V13;
+            } else if (!listTables.contains(QLatin1String("DatabaseVersionV14"))) {
+                versionBegin = DatabaseInterface::V14;
+            } else {
+                versionBegin = DatabaseInterface::V15;
+            }
+        } else {
+            createDatabaseV9();
+            versionBegin = DatabaseInterface::V11;
+        }
+    }
+
+    auto version = versionBegin;
+    for (; version <= DatabaseInterface::V26; ++version) {
+        callUpgradeFunctionForVersion(static_cast<DatabaseVersion>(version));
+
+        if (d->mIsInBadState) {
+            break;
+        }
+    }
+
+    if (versionBegin < DatabaseInterface::V16) {
+        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV9"));
+        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV11"));
+        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV12"));
+        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV13"));
+        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV14"));
+    }
+
+    // the steps before the failed one are committed, it is tried again at the next start: the schema check would reset the database
+    if (d->mIsInBadState) {
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersion" << "update to version" << version << "failed";
+
+        setDatabaseVersionInTable(version - 1);
+
+        return;
+    }
+
+    setDatabaseVersionInTable(DatabaseInterface::V26);
+
+    checkDatabaseSchema();
+}
+
+void DatabaseInterface::dropTable(QString query)
+{
+    QSqlQuery dropQueryQuery(d->mTracksDatabase);
+
+    const auto &result = dropQueryQuery.exec(query);
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::dropTable" << dropQueryQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::dropTable" << dropQueryQuery.lastError();
+
+        Q_EMIT databaseError();
+    }
+}
+
+void DatabaseInterface::setDatabaseVersionInTable(int version)
+{
+    d->mUpdateDatabaseVersionQuery.bindValue(QStringLiteral(":version"), version);
+
+    auto queryResult = execQuery(d->mUpdateDatabaseVersionQuery);
+
+    if (!queryResult) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::setDatabaseVersionInTable" << d->mUpdateDatabaseVersionQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::setDatabaseVersionInTable" << d->mUpdateDatabaseVersionQuery.lastError();
+
+        Q_EMIT databaseError();
+    }
+}
+
+void DatabaseInterface::createDatabaseVersionTable()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin creation of DatabaseVersion table";
+    QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+    const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `DatabaseVersion` (`Version` INTEGER PRIMARY KEY NOT NULL default 0)"));
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseVersionTable" << createSchemaQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseVersionTable" << createSchemaQuery.lastError();
+
+        Q_EMIT databaseError();
+    }
+
+    const auto resultInsert = createSchemaQuery.exec(QStringLiteral("INSERT INTO `DatabaseVersion` VALUES (0)"));
+    if (!resultInsert) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseVersionTable" << createSchemaQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::createDatabaseVersionTable" << createSchemaQuery.lastError();
+
+        Q_EMIT databaseError();
+    }
+}
+
+void DatabaseInterface::manageNewDatabaseVersionInitRequests()
+{
+    {
+        auto  initDatabaseVersionQuery = QStringLiteral("UPDATE `DatabaseVersion` set `Version` = :version ");
+
+        auto result = prepareQuery(d->mUpdateDatabaseVersionQuery, initDatabaseVersionQuery);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersionInitRequests" << d->mUpdateDatabaseVersionQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersionInitRequests" << d->mUpdateDatabaseVersionQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto  selectDatabaseVersionQuery = QStringLiteral("SELECT versionTable.`Version` FROM `DatabaseVersion` versionTable");
+
+        auto result = prepareQuery(d->mSelectDatabaseVersionQuery, selectDatabaseVersionQuery);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersionInitRequests" << d->mSelectDatabaseVersionQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::manageNewDatabaseVersionInitRequests" << d->mSelectDatabaseVersionQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+}
+
+void DatabaseInterface::callUpgradeFunctionForVersion(DatabaseVersion databaseVersion)
+{
+    switch(databaseVersion)
+    {
+    case DatabaseInterface::V9:
+        upgradeDatabaseV9();
+        break;
+    case DatabaseInterface::V11:
+        upgradeDatabaseV11();
+        break;
+    case DatabaseInterface::V12:
+        upgradeDatabaseV12();
+        break;
+    case DatabaseInterface::V13:
+        upgradeDatabaseV13();
+        break;
+    case DatabaseInterface::V14:
+        upgradeDatabaseV14();
+        break;
+    case DatabaseInterface::V15:
+        upgradeDatabaseV15();
+        break;
+    case DatabaseInterface::V16:
+        upgradeDatabaseV16();
+        break;
+    case DatabaseInterface::V17:
+        upgradeDatabaseV17();
+        break;
+    case DatabaseInterface::V18:
+        upgradeDatabaseV18();
+        break;
+    case DatabaseInterface::V19:
+        upgradeDatabaseV19();
+        break;
+    case DatabaseInterface::V20:
+        upgradeDatabaseV20();
+        break;
+    case DatabaseInterface::V21:
+        upgradeDatabaseV21();
+        break;
+    case DatabaseInterface::V22:
+        upgradeDatabaseV22();
+        break;
+    case DatabaseInterface::V23:
+        upgradeDatabaseV23();
+        break;
+    case DatabaseInterface::V24:
+        upgradeDatabaseV24();
+        break;
+    case DatabaseInterface::V25:
+        upgradeDatabaseV25();
+        break;
+    case DatabaseInterface::V26:
+        upgradeDatabaseV26();
+        break;
+    }
+}
+
+void DatabaseInterface::initRequest()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    {
+        auto selectAlbumQueryText = QStringLiteral("SELECT "
+                                                   "album.`ID`, "
+                                                   "album.`Title`, "
+                                                   "album.`ArtistName`, "
+                                                   "album.`AlbumPath`, "
+                                                   "album.`CoverFileName`, "
+                                                   "IFNULL(summary.`TracksCount`, 0) as `TracksCount`, "
+                                                   "IFNULL(summary.`IsSingleDiscAlbum`, 1) as `IsSingleDiscAlbum`, "
+                                                   "IFNULL(summary.`ArtistsCount`, 0) as ArtistsCount, "
+                                                   "summary.`AllArtists` as AllArtists, "
+                                                   "summary.`HighestRating` as HighestRating, "
+                                                   "summary.`AllGenres` as AllGenres, "
+                                                   "summary.`EmbeddedCover` as EmbeddedCover "
+                                                   "FROM "
+                                                   "`Albums` album LEFT JOIN "
+                                                   "`AlbumSummary` summary ON summary.`AlbumID` = album.`ID` "
+                                                   "WHERE "
+                                                   "album.`ID` = :albumId");
+
+        auto result = prepareQuery(d->mSelectAlbumQuery, selectAlbumQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllGenresText = QStringLiteral("SELECT "
+                                                  "genre.`ID`, "
+                                                  "genre.`Name` "
+                                                  "FROM `Genre` genre "
+                                                  "ORDER BY genre.`Name` COLLATE NOCASE");
+
+        auto result = prepareQuery(d->mSelectAllGenresQuery, selectAllGenresText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllGenresQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllGenresQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllAlbumsText = QStringLiteral("SELECT "
+                                                  "album.`ID`, "
+                                                  "album.`Title`, "
+                                                  "album.`ArtistName` as SecondaryText, "
+                                                  "album.`CoverFileName`, "
+                                                  "album.`ArtistName`, "
+                                                  "summary.`ArtistsCount` as ArtistsCount, "
+                                                  "summary.`AllArtists` as AllArtists, "
+                                                  "summary.`HighestRating` as HighestRating, "
+                                                  "summary.`AllGenres` as AllGenres, "
+                                                  "summary.`IsSingleDiscAlbum` as `IsSingleDiscAlbum`, "
+                                                  "summary.`EmbeddedCover` as EmbeddedCover "
+                                                  "FROM "
+                                                  "`Albums` album, "
+                                                  "`AlbumSummary` summary "
+                                                  "WHERE "
+                                                  "summary.`AlbumID` = album.`ID` ");
+
+        auto result = prepareQuery(d->mSelectAllAlbumsShortQuery, selectAllAlbumsText + QStringLiteral("ORDER BY album.`Title` COLLATE NOCASE"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+
+        // the range starts in AlbumsTitleIndex, only the albums of the page are read
+        auto selectAlbumsPageText = selectAllAlbumsText + QStringLiteral("AND "
+                                                                         "(album.`Title` COLLATE NOCASE, album.`ID`) > (IFNULL(:lastTitle, ''), IFNULL(:lastAlbumId, 0)) "
+                                                                         "ORDER BY album.`Title` COLLATE NOCASE, album.`ID` "
+                                                                         "LIMIT :count");
+
+        result = prepareQuery(d->mSelectAlbumsShortPageQuery, selectAlbumsPageText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumsShortPageQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumsShortPageQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllAlbumsText = QStringLiteral("SELECT "
+                                                  "album.`ID`, "
+                                                  "album.`Title`, "
+                                                  "album.`ArtistName` as SecondaryText, "
+                                                  "album.`CoverFileName`, "
+                                                  "album.`ArtistName`, "
+                                                  "summary.`ArtistsCount` as ArtistsCount, "
+                                                  "summary.`AllArtists` as AllArtists, "
+                                                  "summary.`HighestRating` as HighestRating, "
+                                                  "summary.`AllGenres` as AllGenres, "
+                                                  "summary.`IsSingleDiscAlbum` as `IsSingleDiscAlbum`, "
+                                                  "summary.`EmbeddedCover` as EmbeddedCover "
+                                                  "FROM "
+                                                  "`Albums` album, "
+                                                  "`AlbumSummary` summary "
+                                                  "WHERE "
+                                                  "summary.`AlbumID` = album.`ID` AND "
+                                                  "EXISTS ("
+                                                  "  SELECT tracks2.`ID` "
+                                                  "  FROM "
+                                                  "  `Tracks` tracks2, "
+                                                  "  `Genre` genre2 "
+                                                  "  WHERE "
+                                                  "  tracks2.`AlbumID` = album.`ID` AND "
+                                                  "  tracks2.`GenreID` = genre2.`ID` AND "
+                                                  "  genre2.`Name` = :genreFilter AND "
+                                                  "  (album.`ArtistName` = :artistFilter OR "
+                                                  "   tracks2.`ArtistID` = (SELECT artist2.`ID` FROM `Artists` artist2 WHERE artist2.`Name` = :artistFilter)) "
+                                                  ") "
+                                                  "ORDER BY album.`Title` COLLATE NOCASE");
+
+        auto result = prepareQuery(d->mSelectAllAlbumsShortWithGenreArtistFilterQuery, selectAllAlbumsText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllAlbumsText = QStringLiteral("SELECT "
+                                                  "album.`ID`, "
+                                                  "album.`Title`, "
+                                                  "album.`ArtistName` as SecondaryText, "
+                                                  "album.`CoverFileName`, "
+                                                  "album.`ArtistName`, "
+                                                  "summary.`ArtistsCount` as ArtistsCount, "
+                                                  "summary.`AllArtists` as AllArtists, "
+                                                  "summary.`HighestRating` as HighestRating, "
+                                                  "summary.`AllGenres` as AllGenres, "
+                                                  "summary.`IsSingleDiscAlbum` as `IsSingleDiscAlbum`, "
+                                                  "summary.`EmbeddedCover` as EmbeddedCover "
+                                                  "FROM "
+                                                  "`Albums` album, "
+                                                  "`AlbumSummary` summary "
+                                                  "WHERE "
+                                                  "summary.`AlbumID` = album.`ID` AND "
+                                                  "EXISTS ("
+                                                  "  SELECT tracks2.`ID` "
+                                                  "  FROM "
+                                                  "  `Tracks` tracks2 "
+                                                  "  WHERE "
+                                                  "  tracks2.`AlbumID` = album.`ID` AND "
+                                                  "  (album.`ArtistName` = :artistFilter OR "
+                                                  "   tracks2.`ArtistID` = (SELECT artist2.`ID` FROM `Artists` artist2 WHERE artist2.`Name` = :artistFilter)) "
+                                                  ") "
+                                                  "ORDER BY album.`Title` COLLATE NOCASE");
+
+        auto result = prepareQuery(d->mSelectAllAlbumsShortWithArtistFilterQuery, selectAllAlbumsText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithArtistFilterQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllAlbumsShortWithArtistFilterQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllArtistsWithFilterText = QStringLiteral("SELECT artists.`ID`, "
+                                                             "artists.`Name`, "
+                                                             "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
+                                                             "FROM `Artists` artists  LEFT JOIN "
+                                                             "`Tracks` tracks ON tracks.`ArtistID` = artists.`ID` LEFT JOIN "
+                                                             "`Genre` genres ON genres.`ID` = tracks.`GenreID` "
+                                                             "GROUP BY artists.`ID` "
+                                                             "ORDER BY artists.`Name` COLLATE NOCASE");
+
+        auto result = prepareQuery(d->mSelectAllArtistsQuery, selectAllArtistsWithFilterText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllArtistsWithGenreFilterText = QStringLiteral("SELECT artists.`ID`, "
+                                                                  "artists.`Name`, "
+                                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
+                                                                  "FROM `Artists` artists  LEFT JOIN "
+                                                                  "`Tracks` tracks ON (tracks.`ArtistID` = artists.`ID` OR "
+                                                                  "tracks.`AlbumID` IN (SELECT album.`ID` FROM `Albums` album WHERE album.`ArtistName` = artists.`Name`)) LEFT JOIN "
+                                                                  "`Genre` genres ON genres.`ID` = tracks.`GenreID` "
+                                                                  "WHERE "
+                                                                  "EXISTS ("
+                                                                  "  SELECT tracks2.`ID` "
+                                                                  "  FROM "
+                                                                  "  `Tracks` tracks2, "
+                                                                  "  `Genre` genre2 "
+                                                                  "  WHERE "
+                                                                  "  (tracks2.`ArtistID` = artists.`ID` OR "
+                                                                  "   tracks2.`AlbumID` IN (SELECT album2.`ID` FROM `Albums` album2 WHERE album2.`ArtistName` = artists.`Name`)) AND "
+                                                                  "  tracks2.`GenreID` = genre2.`ID` AND "
+                                                                  "  genre2.`Name` = :genreFilter "
+                                                                  ") "
+                                                                  "GROUP BY artists.`ID` "
+                                                                  "ORDER BY artists.`Name` COLLATE NOCASE");
+
+        auto result = prepareQuery(d->mSelectAllArtistsWithGenreFilterQuery, selectAllArtistsWithGenreFilterText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsWithGenreFilterQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllArtistsWithGenreFilterQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto artistMatchGenreText = QStringLiteral("SELECT artists.`ID` "
+                                                   "FROM `Artists` artists  LEFT JOIN "
+                                                   "`Tracks` tracks ON (tracks.`ArtistID` = artists.`ID` OR "
+                                                   "tracks.`AlbumID` IN (SELECT album.`ID` FROM `Albums` album WHERE album.`ArtistName` = artists.`Name`)) LEFT JOIN "
+                                                   "`Genre` genres ON genres.`ID` = tracks.`GenreID` "
+                                                   "WHERE "
+                                                   "EXISTS ("
+                                                   "  SELECT tracks2.`ID` "
+                                                   "  FROM "
+                                                   "  `Tracks` tracks2, "
+                                                   "  `Genre` genre2 "
+                                                   "  WHERE "
+                                                   "  (tracks2.`ArtistID` = artists.`ID` OR "
+                                                   "   tracks2.`AlbumID` IN (SELECT album2.`ID` FROM `Albums` album2 WHERE album2.`ArtistName` = artists.`Name`)) AND "
+                                                   "  tracks2.`GenreID` = genre2.`ID` AND "
+                                                   "  genre2.`Name` = :genreFilter "
+                                                   ") AND "
+                                                   "artists.`ID` = :databaseId");
+
+        auto result = prepareQuery(d->mArtistMatchGenreQuery, artistMatchGenreText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mArtistMatchGenreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mArtistMatchGenreQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllComposersWithFilterText = QStringLiteral("SELECT `ID`, "
+                                                               "`Name` "
+                                                               "FROM `Artists` "
+                                                               "ORDER BY `Name` COLLATE NOCASE");
+
+        auto result = prepareQuery(d->mSelectAllComposersQuery, selectAllComposersWithFilterText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllLyricistsWithFilterText = QStringLiteral("SELECT `ID`, "
+                                                               "`Name` "
+                                                               "FROM `Lyricist` "
+                                                               "ORDER BY `Name` COLLATE NOCASE");
+
+        auto result = prepareQuery(d->mSelectAllLyricistsQuery, selectAllLyricistsWithFilterText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllTracksText = QStringLiteral("SELECT "
+                                                  "tracks.`ID`, "
+                                                  "tracks.`Title`, "
+                                                  "album.`ID`, "
+                                                  "tracks.`ArtistName`, "
+                                                  "( "
+                                                  "SELECT "
+                                                  "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                  "FROM "
+                                                  "`Tracks` tracksFromAlbum1 "
+                                                  "WHERE "
+                                                  "tracksFromAlbum1.`AlbumID` = album.`ID` "
+                                                  ") AS ArtistsCount, "
                                                   "( "
                                                   "SELECT "
                                                   "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
                                                   "FROM "
                                                   "`Tracks` tracksFromAlbum2 "
                                                   "WHERE "
-                                                  "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
+                                                  "tracksFromAlbum2.`AlbumID` = album.`ID` "
                                                   ") AS AllArtists, "
                                                   "tracks.`AlbumArtistName`, "
-                                                  "tracksMapping.`FileName`, "
+                                                  "(trackDirectory.`Path` || tracksMapping.`BaseName`) AS FileName, "
                                                   "tracksMapping.`FileModifiedTime`, "
                                                   "tracks.`TrackNumber`, "
                                                   "tracks.`DiscNumber`, "
@@ -3912,13 +7793,7 @@ void DatabaseInterface::initRequest()
                                                   "FROM "
                                                   "`Tracks` tracks2 "
                                                   "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                  "tracks2.`AlbumID` = album.`ID` "
                                                   ") as `IsSingleDiscAlbum`, "
                                                   "trackGenre.`Name`, "
                                                   "trackComposer.`Name`, "
@@ -3935,34 +7810,35 @@ void DatabaseInterface::initRequest()
                                                   "tracksMapping.`PlayCounter`, "
                                                   "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
                                                   "( "
-                                                  "SELECT tracksCover.`FileName` "
+                                                  "SELECT ("
+                                                  "SELECT coverDirectory.`Path` || coverData.`BaseName` "
+                                                  "FROM "
+                                                  "`TracksData` coverData, "
+                                                  "`Directories` coverDirectory "
+                                                  "WHERE "
+                                                  "coverData.`ID` = tracksCover.`FileID` AND "
+                                                  "coverDirectory.`ID` = coverData.`DirectoryID`"
+                                                  ") "
                                                   "FROM "
                                                   "`Tracks` tracksCover "
                                                   "WHERE "
                                                   "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
+                                                  "tracksCover.`AlbumID` = album.`ID` "
                                                   ") as EmbeddedCover "
                                                   "FROM "
                                                   "`TracksData` tracksMapping "
+                                                  "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = tracksMapping.`DirectoryID` "
                                                   "LEFT JOIN "
                                                   "`Tracks` tracks "
                                                   "ON "
-                                                  "tracksMapping.`FileName` = tracks.`FileName` "
+                                                  "tracksMapping.`ID` = tracks.`FileID` "
                                                   "LEFT JOIN "
                                                   "`Albums` album "
                                                   "ON "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                  "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
-                                                  "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
+                                                  "tracks.`AlbumID` = album.`ID` "
+                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                  "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                                                  "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID` "
                                                   "WHERE "
                                                   "tracks.`Title` IS NULL OR "
                                                   "tracks.`Priority` = ("
@@ -3972,25 +7848,888 @@ void DatabaseInterface::initRequest()
                                                   "     `Tracks` tracks2 "
                                                   "     WHERE "
                                                   "     tracks.`Title` = tracks2.`Title` AND "
-                                                  "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
-                                                  "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
-                                                  "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
-                                                  "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
+                                                  "     (tracks.`ArtistID` IS NULL OR tracks.`ArtistID` = tracks2.`ArtistID`) AND "
+                                                  "     (tracks.`AlbumID` IS NULL OR tracks.`AlbumID` = tracks2.`AlbumID`)"
                                                   ")"
                                                   "");
 
-        auto result = prepareQuery(d->mSelectAllTracksQuery, selectAllTracksText);
+        auto result = prepareQuery(d->mSelectAllTracksQuery, selectAllTracksText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+
+        auto selectTracksPageText = QStringLiteral("SELECT * FROM (%1) "
+                                                   "WHERE "
+                                                   "`FileName` > IFNULL(:lastFileName, '') "
+                                                   "ORDER BY `FileName` "
+                                                   "LIMIT :count").arg(selectAllTracksText);
+
+        result = prepareQuery(d->mSelectTracksPageQuery, selectTracksPageText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksPageQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksPageQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllRadiosText = QStringLiteral("SELECT "
+                                                  "radios.`ID`, "
+                                                  "radios.`Title`, "
+                                                  "radios.`HttpAddress`, "
+                                                  "radios.`ImageAddress`, "
+                                                  "radios.`Rating`, "
+                                                  "trackGenre.`Name`, "
+                                                  "radios.`Comment` "
+                                                  "FROM "
+                                                  "`Radios` radios "
+                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = radios.`Genre` "
+                                                  "");
+
+        auto result = prepareQuery(d->mSelectAllRadiosQuery, selectAllRadiosText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllRadiosQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllRadiosQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllTracksText = QStringLiteral("SELECT "
+                                                  "tracks.`ID`, "
+                                                  "tracks.`Title`, "
+                                                  "album.`ID`, "
+                                                  "tracks.`ArtistName`, "
+                                                  "( "
+                                                  "SELECT "
+                                                  "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                  "FROM "
+                                                  "`Tracks` tracksFromAlbum1 "
+                                                  "WHERE "
+                                                  "tracksFromAlbum1.`AlbumID` = album.`ID` "
+                                                  ") AS ArtistsCount, "
+                                                  "( "
+                                                  "SELECT "
+                                                  "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                  "FROM "
+                                                  "`Tracks` tracksFromAlbum2 "
+                                                  "WHERE "
+                                                  "tracksFromAlbum2.`AlbumID` = album.`ID` "
+                                                  ") AS AllArtists, "
+                                                  "tracks.`AlbumArtistName`, "
+                                                  "(trackDirectory.`Path` || tracksMapping.`BaseName`) AS FileName, "
+                                                  "tracksMapping.`FileModifiedTime`, "
+                                                  "tracks.`TrackNumber`, "
+                                                  "tracks.`DiscNumber`, "
+                                                  "tracks.`Duration`, "
+                                                  "tracks.`AlbumTitle`, "
+                                                  "tracks.`Rating`, "
+                                                  "album.`CoverFileName`, "
+                                                  "("
+                                                  "SELECT "
+                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                  "FROM "
+                                                  "`Tracks` tracks2 "
+                                                  "WHERE "
+                                                  "tracks2.`AlbumID` = album.`ID` "
+                                                  ") as `IsSingleDiscAlbum`, "
+                                                  "trackGenre.`Name`, "
+                                                  "trackComposer.`Name`, "
+                                                  "trackLyricist.`Name`, "
+                                                  "tracks.`Comment`, "
+                                                  "tracks.`Year`, "
+                                                  "tracks.`Channels`, "
+                                                  "tracks.`BitRate`, "
+                                                  "tracks.`SampleRate`, "
+                                                  "tracks.`HasEmbeddedCover`, "
+                                                  "tracksMapping.`ImportDate`, "
+                                                  "tracksMapping.`FirstPlayDate`, "
+                                                  "tracksMapping.`LastPlayDate`, "
+                                                  "tracksMapping.`PlayCounter`, "
+                                                  "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                  "( "
+                                                  "SELECT ("
+                                                  "SELECT coverDirectory.`Path` || coverData.`BaseName` "
+                                                  "FROM "
+                                                  "`TracksData` coverData, "
+                                                  "`Directories` coverDirectory "
+                                                  "WHERE "
+                                                  "coverData.`ID` = tracksCover.`FileID` AND "
+                                                  "coverDirectory.`ID` = coverData.`DirectoryID`"
+                                                  ") "
+                                                  "FROM "
+                                                  "`Tracks` tracksCover "
+                                                  "WHERE "
+                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                  "tracksCover.`AlbumID` = album.`ID` "
+                                                  ") as EmbeddedCover "
+                                                  "FROM "
+                                                  "`Tracks` tracks, "
+                                                  "`TracksData` tracksMapping "
+                                                  "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = tracksMapping.`DirectoryID` "
+                                                  "LEFT JOIN "
+                                                  "`Albums` album "
+                                                  "ON "
+                                                  "tracks.`AlbumID` = album.`ID` "
+                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                  "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                                                  "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID` "
+                                                  "WHERE "
+                                                  "tracksMapping.`ID` = tracks.`FileID` AND "
+                                                  "tracksMapping.`PlayCounter` > 0 AND "
+                                                  "tracks.`Priority` = ("
+                                                  "     SELECT "
+                                                  "     MIN(`Priority`) "
+                                                  "     FROM "
+                                                  "     `Tracks` tracks2 "
+                                                  "     WHERE "
+                                                  "     tracks.`Title` = tracks2.`Title` AND "
+                                                  "     (tracks.`ArtistID` IS NULL OR tracks.`ArtistID` = tracks2.`ArtistID`) AND "
+                                                  "     (tracks.`AlbumID` IS NULL OR tracks.`AlbumID` = tracks2.`AlbumID`)"
+                                                  ")"
+                                                  "ORDER BY tracksMapping.`LastPlayDate` DESC "
+                                                  "LIMIT :maximumResults");
+
+        auto result = prepareQuery(d->mSelectAllRecentlyPlayedTracksQuery, selectAllTracksText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllRecentlyPlayedTracksQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllRecentlyPlayedTracksQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllTracksText = QStringLiteral("SELECT "
+                                                  "tracks.`ID`, "
+                                                  "tracks.`Title`, "
+                                                  "album.`ID`, "
+                                                  "tracks.`ArtistName`, "
+                                                  "( "
+                                                  "SELECT "
+                                                  "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                  "FROM "
+                                                  "`Tracks` tracksFromAlbum1 "
+                                                  "WHERE "
+                                                  "tracksFromAlbum1.`AlbumID` = album.`ID` "
+                                                  ") AS ArtistsCount, "
+                                                  "( "
+                                                  "SELECT "
+                                                  "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                  "FROM "
+                                                  "`Tracks` tracksFromAlbum2 "
+                                                  "WHERE "
+                                                  "tracksFromAlbum2.`AlbumID` = album.`ID` "
+                                                  ") AS AllArtists, "
+                                                  "tracks.`AlbumArtistName`, "
+                                                  "(trackDirectory.`Path` || tracksMapping.`BaseName`) AS FileName, "
+                                                  "tracksMapping.`FileModifiedTime`, "
+                                                  "tracks.`TrackNumber`, "
+                                                  "tracks.`DiscNumber`, "
+                                                  "tracks.`Duration`, "
+                                                  "tracks.`AlbumTitle`, "
+                                                  "tracks.`Rating`, "
+                                                  "album.`CoverFileName`, "
+                                                  "("
+                                                  "SELECT "
+                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                  "FROM "
+                                                  "`Tracks` tracks2 "
+                                                  "WHERE "
+                                                  "tracks2.`AlbumID` = album.`ID` "
+                                                  ") as `IsSingleDiscAlbum`, "
+                                                  "trackGenre.`Name`, "
+                                                  "trackComposer.`Name`, "
+                                                  "trackLyricist.`Name`, "
+                                                  "tracks.`Comment`, "
+                                                  "tracks.`Year`, "
+                                                  "tracks.`Channels`, "
+                                                  "tracks.`BitRate`, "
+                                                  "tracks.`SampleRate`, "
+                                                  "tracks.`HasEmbeddedCover`, "
+                                                  "tracksMapping.`ImportDate`, "
+                                                  "tracksMapping.`FirstPlayDate`, "
+                                                  "tracksMapping.`LastPlayDate`, "
+                                                  "tracksMapping.`PlayCounter`, "
+                                                  "CAST(tracksMapping.`PlayCounter` AS REAL) / ((CAST(strftime('%s','now') as INTEGER) - CAST(tracksMapping.`FirstPlayDate` / 1000 as INTEGER)) / CAST(1000 AS REAL)) as PlayFrequency, "
+                                                  "( "
+                                                  "SELECT ("
+                                                  "SELECT coverDirectory.`Path` || coverData.`BaseName` "
+                                                  "FROM "
+                                                  "`TracksData` coverData, "
+                                                  "`Directories` coverDirectory "
+                                                  "WHERE "
+                                                  "coverData.`ID` = tracksCover.`FileID` AND "
+                                                  "coverDirectory.`ID` = coverData.`DirectoryID`"
+                                                  ") "
+                                                  "FROM "
+                                                  "`Tracks` tracksCover "
+                                                  "WHERE "
+                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                  "tracksCover.`AlbumID` = album.`ID` "
+                                                  ") as EmbeddedCover "
+                                                  "FROM "
+                                                  "`TracksPlayScore` playScore, "
+                                                  "`Tracks` tracks, "
+                                                  "`TracksData` tracksMapping "
+                                                  "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = tracksMapping.`DirectoryID` "
+                                                  "LEFT JOIN "
+                                                  "`Albums` album "
+                                                  "ON "
+                                                  "tracks.`AlbumID` = album.`ID` "
+                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                  "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                                                  "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID` "
+                                                  "WHERE "
+                                                  "tracksMapping.`ID` = playScore.`FileID` AND "
+                                                  "tracksMapping.`ID` = tracks.`FileID` AND "
+                                                  "tracksMapping.`PlayCounter` > 0 AND "
+                                                  "tracks.`Priority` = ("
+                                                  "     SELECT "
+                                                  "     MIN(`Priority`) "
+                                                  "     FROM "
+                                                  "     `Tracks` tracks2 "
+                                                  "     WHERE "
+                                                  "     tracks.`Title` = tracks2.`Title` AND "
+                                                  "     (tracks.`ArtistID` IS NULL OR tracks.`ArtistID` = tracks2.`ArtistID`) AND "
+                                                  "     (tracks.`AlbumID` IS NULL OR tracks.`AlbumID` = tracks2.`AlbumID`)"
+                                                  ")"
+                                                  "ORDER BY playScore.`Score` DESC "
+                                                  "LIMIT :maximumResults");
+
+        auto result = prepareQuery(d->mSelectAllFrequentlyPlayedTracksQuery, selectAllTracksText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllFrequentlyPlayedTracksQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllFrequentlyPlayedTracksQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearAlbumsTableText = QStringLiteral("DELETE FROM `Albums`");
+
+        auto result = prepareQuery(d->mClearAlbumsTable, clearAlbumsTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearAlbumsTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearAlbumsTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearArtistsTableText = QStringLiteral("DELETE FROM `Artists`");
+
+        auto result = prepareQuery(d->mClearArtistsTable, clearArtistsTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearArtistsTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearArtistsTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearComposerTableText = QStringLiteral("DELETE FROM `Composer`");
+
+        auto result = prepareQuery(d->mClearComposerTable, clearComposerTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearComposerTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearComposerTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearGenreTableText = QStringLiteral("DELETE FROM `Genre`");
+
+        auto result = prepareQuery(d->mClearGenreTable, clearGenreTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearGenreTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearGenreTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearLyricistTableText = QStringLiteral("DELETE FROM `Lyricist`");
+
+        auto result = prepareQuery(d->mClearLyricistTable, clearLyricistTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearLyricistTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearLyricistTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearTracksDataTableText = QStringLiteral("DELETE FROM `TracksData`");
+
+        auto result = prepareQuery(d->mClearTracksDataTable, clearTracksDataTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearTracksDataTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearTracksDataTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearDirectoriesTableText = QStringLiteral("DELETE FROM `Directories`");
+
+        auto result = prepareQuery(d->mClearDirectoriesTable, clearDirectoriesTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearDirectoriesTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearDirectoriesTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearTracksTableText = QStringLiteral("DELETE FROM `Tracks`");
+
+        auto result = prepareQuery(d->mClearTracksTable, clearTracksTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearTracksTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearTracksTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllTracksShortText = QStringLiteral("SELECT "
+                                                       "tracks.`ID`, "
+                                                       "tracks.`Title`, "
+                                                       "tracks.`ArtistName`, "
+                                                       "tracks.`AlbumTitle`, "
+                                                       "( "
+                                                       "SELECT "
+                                                       "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                       "FROM "
+                                                       "`Tracks` tracksFromAlbum1 "
+                                                       "WHERE "
+                                                       "tracksFromAlbum1.`AlbumID` = album.`ID` "
+                                                       ") AS ArtistsCount, "
+                                                       "( "
+                                                       "SELECT "
+                                                       "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                       "FROM "
+                                                       "`Tracks` tracksFromAlbum2 "
+                                                       "WHERE "
+                                                       "tracksFromAlbum2.`AlbumID` = album.`ID` "
+                                                       ") AS AllArtists, "
+                                                       "tracks.`AlbumArtistName`, "
+                                                       "tracks.`Duration`, "
+                                                       "album.`CoverFileName`, "
+                                                       "tracks.`TrackNumber`, "
+                                                       "tracks.`DiscNumber`, "
+                                                       "tracks.`Rating` "
+                                                       "FROM "
+                                                       "`Tracks` tracks "
+                                                       "LEFT JOIN "
+                                                       "`Albums` album "
+                                                       "ON "
+                                                       "tracks.`AlbumID` = album.`ID` "
+                                                       "");
+
+        auto result = prepareQuery(d->mSelectAllTracksShortQuery, selectAllTracksShortText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksShortQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksShortQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectArtistByNameText = QStringLiteral("SELECT `ID`, "
+                                                     "`Name` "
+                                                     "FROM `Artists` "
+                                                     "WHERE "
+                                                     "`Name` = :name");
+
+        auto result = prepareQuery(d->mSelectArtistByNameQuery, selectArtistByNameText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistByNameQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistByNameQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectComposerByNameText = QStringLiteral("SELECT `ID`, "
+                                                       "`Name` "
+                                                       "FROM `Composer` "
+                                                       "WHERE "
+                                                       "`Name` = :name");
+
+        auto result = prepareQuery(d->mSelectComposerByNameQuery, selectComposerByNameText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerByNameQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerByNameQuery.lastError();
+        }
+    }
+
+    {
+        auto selectLyricistByNameText = QStringLiteral("SELECT `ID`, "
+                                                       "`Name` "
+                                                       "FROM `Lyricist` "
+                                                       "WHERE "
+                                                       "`Name` = :name");
+
+        auto result = prepareQuery(d->mSelectLyricistByNameQuery, selectLyricistByNameText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistByNameQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistByNameQuery.lastError();
+        }
+    }
+
+    {
+        auto selectGenreByNameText = QStringLiteral("SELECT `ID`, "
+                                                    "`Name` "
+                                                    "FROM `Genre` "
+                                                    "WHERE "
+                                                    "`Name` = :name");
+
+        auto result = prepareQuery(d->mSelectGenreByNameQuery, selectGenreByNameText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreByNameQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreByNameQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto insertArtistsText = QStringLiteral("INSERT INTO `Artists` (`ID`, `Name`) "
+                                                "VALUES (:artistId, :name)");
+
+        auto result = prepareQuery(d->mInsertArtistsQuery, insertArtistsText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertArtistsQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertArtistsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto insertGenreText = QStringLiteral("INSERT INTO `Genre` (`ID`, `Name`) "
+                                              "VALUES (:genreId, :name)");
+
+        auto result = prepareQuery(d->mInsertGenreQuery, insertGenreText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertGenreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertGenreQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto insertComposerText = QStringLiteral("INSERT INTO `Composer` (`ID`, `Name`) "
+                                                 "VALUES (:composerId, :name)");
+
+        auto result = prepareQuery(d->mInsertComposerQuery, insertComposerText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertComposerQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertComposerQuery.lastError();
+        }
+    }
+
+    {
+        auto insertLyricistText = QStringLiteral("INSERT INTO `Lyricist` (`ID`, `Name`) "
+                                                 "VALUES (:lyricistId, :name)");
+
+        auto result = prepareQuery(d->mInsertLyricistQuery, insertLyricistText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertLyricistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertLyricistQuery.lastError();
+        }
+    }
+
+    {
+        auto selectTrackQueryText = QStringLiteral("SELECT "
+                                                   "tracks.`ID`, "
+                                                   "tracks.`Title`, "
+                                                   "album.`ID`, "
+                                                   "tracks.`ArtistName`, "
+                                                   "( "
+                                                   "SELECT "
+                                                   "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                   "FROM "
+                                                   "`Tracks` tracksFromAlbum1 "
+                                                   "WHERE "
+                                                   "tracksFromAlbum1.`AlbumID` = album.`ID` "
+                                                   ") AS ArtistsCount, "
+                                                   "( "
+                                                   "SELECT "
+                                                   "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                   "FROM "
+                                                   "`Tracks` tracksFromAlbum2 "
+                                                   "WHERE "
+                                                   "tracksFromAlbum2.`AlbumID` = album.`ID` "
+                                                   ") AS AllArtists, "
+                                                   "tracks.`AlbumArtistName`, "
+                                                   "(trackDirectory.`Path` || tracksMapping.`BaseName`) AS FileName, "
+                                                   "tracksMapping.`FileModifiedTime`, "
+                                                   "tracks.`TrackNumber`, "
+                                                   "tracks.`DiscNumber`, "
+                                                   "tracks.`Duration`, "
+                                                   "tracks.`AlbumTitle`, "
+                                                   "tracks.`Rating`, "
+                                                   "album.`CoverFileName`, "
+                                                   "("
+                                                   "SELECT "
+                                                   "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                   "FROM "
+                                                   "`Tracks` tracks2 "
+                                                   "WHERE "
+                                                   "tracks2.`AlbumID` = album.`ID` "
+                                                   ") as `IsSingleDiscAlbum`, "
+                                                   "trackGenre.`Name`, "
+                                                   "trackComposer.`Name`, "
+                                                   "trackLyricist.`Name`, "
+                                                   "tracks.`Comment`, "
+                                                   "tracks.`Year`, "
+                                                   "tracks.`Channels`, "
+                                                   "tracks.`BitRate`, "
+                                                   "tracks.`SampleRate`, "
+                                                   "tracks.`HasEmbeddedCover`, "
+                                                   "tracksMapping.`ImportDate`, "
+                                                   "tracksMapping.`FirstPlayDate`, "
+                                                   "tracksMapping.`LastPlayDate`, "
+                                                   "tracksMapping.`PlayCounter`, "
+                                                   "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                   "( "
+                                                   "SELECT ("
+                                                   "SELECT coverDirectory.`Path` || coverData.`BaseName` "
+                                                   "FROM "
+                                                   "`TracksData` coverData, "
+                                                   "`Directories` coverDirectory "
+                                                   "WHERE "
+                                                   "coverData.`ID` = tracksCover.`FileID` AND "
+                                                   "coverDirectory.`ID` = coverData.`DirectoryID`"
+                                                   ") "
+                                                   "FROM "
+                                                   "`Tracks` tracksCover "
+                                                   "WHERE "
+                                                   "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                   "tracksCover.`AlbumID` = album.`ID` "
+                                                   ") as EmbeddedCover "
+                                                   "FROM "
+                                                   "`Tracks` tracks, "
+                                                   "`TracksData` tracksMapping "
+                                                   "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = tracksMapping.`DirectoryID` "
+                                                   "LEFT JOIN "
+                                                   "`Albums` album "
+                                                   "ON "
+                                                   "album.`ID` = :albumId AND "
+                                                   "tracks.`AlbumID` = album.`ID` "
+                                                   "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                                                   "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID` "
+                                                   "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                   "WHERE "
+                                                   "tracksMapping.`ID` = tracks.`FileID` AND "
+                                                   "album.`ID` = :albumId AND "
+                                                   "tracks.`Priority` = ("
+                                                   "     SELECT "
+                                                   "     MIN(`Priority`) "
+                                                   "     FROM "
+                                                   "     `Tracks` tracks2 "
+                                                   "     WHERE "
+                                                   "     tracks.`Title` = tracks2.`Title` AND "
+                                                   "     (tracks.`ArtistID` IS NULL OR tracks.`ArtistID` = tracks2.`ArtistID`) AND "
+                                                   "     (tracks.`AlbumID` IS NULL OR tracks.`AlbumID` = tracks2.`AlbumID`)"
+                                                   ")"
+                                                   "ORDER BY tracks.`DiscNumber` ASC, "
+                                                   "tracks.`TrackNumber` ASC");
+
+        auto result = prepareQuery(d->mSelectTrackQuery, selectTrackQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectTrackQueryText = QStringLiteral("SELECT "
+                                                   "tracks.`ID` "
+                                                   "FROM "
+                                                   "`Tracks` tracks, "
+                                                   "`TracksData` tracksMapping "
+                                                   "LEFT JOIN "
+                                                   "`Albums` album "
+                                                   "ON "
+                                                   "album.`ID` = :albumId AND "
+                                                   "tracks.`AlbumID` = album.`ID` "
+                                                   "WHERE "
+                                                   "tracksMapping.`ID` = tracks.`FileID` AND "
+                                                   "album.`ID` = :albumId AND "
+                                                   "tracks.`Priority` = ("
+                                                   "     SELECT "
+                                                   "     MIN(`Priority`) "
+                                                   "     FROM "
+                                                   "     `Tracks` tracks2 "
+                                                   "     WHERE "
+                                                   "     tracks.`Title` = tracks2.`Title` AND "
+                                                   "     (tracks.`ArtistID` IS NULL OR tracks.`ArtistID` = tracks2.`ArtistID`) AND "
+                                                   "     (tracks.`AlbumID` IS NULL OR tracks.`AlbumID` = tracks2.`AlbumID`)"
+                                                   ")"
+                                                   "ORDER BY tracks.`DiscNumber` ASC, "
+                                                   "tracks.`TrackNumber` ASC");
+
+        auto result = prepareQuery(d->mSelectTrackIdQuery, selectTrackQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectTrackFromIdQueryText = QStringLiteral("SELECT "
+                                                         "tracks.`Id`, "
+                                                         "tracks.`Title`, "
+                                                         "album.`ID`, "
+                                                         "tracks.`ArtistName`, "
+                                                         "( "
+                                                         "SELECT "
+                                                         "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                         "FROM "
+                                                         "`Tracks` tracksFromAlbum1 "
+                                                         "WHERE "
+                                                         "tracksFromAlbum1.`AlbumID` = album.`ID` "
+                                                         ") AS ArtistsCount, "
+                                                         "( "
+                                                         "SELECT "
+                                                         "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                         "FROM "
+                                                         "`Tracks` tracksFromAlbum2 "
+                                                         "WHERE "
+                                                         "tracksFromAlbum2.`AlbumID` = album.`ID` "
+                                                         ") AS AllArtists, "
+                                                         "tracks.`AlbumArtistName`, "
+                                                         "(trackDirectory.`Path` || tracksMapping.`BaseName`) AS FileName, "
+                                                         "tracksMapping.`FileModifiedTime`, "
+                                                         "tracks.`TrackNumber`, "
+                                                         "tracks.`DiscNumber`, "
+                                                         "tracks.`Duration`, "
+                                                         "tracks.`AlbumTitle`, "
+                                                         "tracks.`Rating`, "
+                                                         "album.`CoverFileName`, "
+                                                         "("
+                                                         "SELECT "
+                                                         "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                         "FROM "
+                                                         "`Tracks` tracks2 "
+                                                         "WHERE "
+                                                         "tracks2.`AlbumID` = album.`ID` "
+                                                         ") as `IsSingleDiscAlbum`, "
+                                                         "trackGenre.`Name`, "
+                                                         "trackComposer.`Name`, "
+                                                         "trackLyricist.`Name`, "
+                                                         "tracks.`Comment`, "
+                                                         "tracks.`Year`, "
+                                                         "tracks.`Channels`, "
+                                                         "tracks.`BitRate`, "
+                                                         "tracks.`SampleRate`, "
+                                                         "tracks.`HasEmbeddedCover`, "
+                                                         "tracksMapping.`ImportDate`, "
+                                                         "tracksMapping.`FirstPlayDate`, "
+                                                         "tracksMapping.`LastPlayDate`, "
+                                                         "tracksMapping.`PlayCounter`, "
+                                                         "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                         "( "
+                                                         "SELECT ("
+                                                         "SELECT coverDirectory.`Path` || coverData.`BaseName` "
+                                                         "FROM "
+                                                         "`TracksData` coverData, "
+                                                         "`Directories` coverDirectory "
+                                                         "WHERE "
+                                                         "coverData.`ID` = tracksCover.`FileID` AND "
+                                                         "coverDirectory.`ID` = coverData.`DirectoryID`"
+                                                         ") "
+                                                         "FROM "
+                                                         "`Tracks` tracksCover "
+                                                         "WHERE "
+                                                         "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                         "tracksCover.`AlbumID` = album.`ID` "
+                                                         ") as EmbeddedCover "
+                                                         "FROM "
+                                                         "`Tracks` tracks, "
+                                                         "`TracksData` tracksMapping "
+                                                         "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = tracksMapping.`DirectoryID` "
+                                                         "LEFT JOIN "
+                                                         "`Albums` album "
+                                                         "ON "
+                                                         "tracks.`AlbumID` = album.`ID` "
+                                                         "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                                                         "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID` "
+                                                         "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                         "WHERE "
+                                                         "tracks.`ID` = :trackId AND "
+                                                         "tracksMapping.`ID` = tracks.`FileID` AND "
+                                                         "tracks.`Priority` = ("
+                                                         "     SELECT "
+                                                         "     MIN(`Priority`) "
+                                                         "     FROM "
+                                                         "     `Tracks` tracks2 "
+                                                         "     WHERE "
+                                                         "     tracks.`Title` = tracks2.`Title` AND "
+                                                         "     (tracks.`ArtistID` IS NULL OR tracks.`ArtistID` = tracks2.`ArtistID`) AND "
+                                                         "     (tracks.`AlbumID` IS NULL OR tracks.`AlbumID` = tracks2.`AlbumID`)"
+                                                         ")"
+                                                         "");
+
+        auto result = prepareQuery(d->mSelectTrackFromIdQuery, selectTrackFromIdQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectTrackFromIdAndUrlQueryText = QStringLiteral("SELECT "
+                                                         "tracks.`Id`, "
+                                                         "tracks.`Title`, "
+                                                         "album.`ID`, "
+                                                         "tracks.`ArtistName`, "
+                                                         "( "
+                                                         "SELECT "
+                                                         "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                         "FROM "
+                                                         "`Tracks` tracksFromAlbum1 "
+                                                         "WHERE "
+                                                         "tracksFromAlbum1.`AlbumID` = album.`ID` "
+                                                         ") AS ArtistsCount, "
+                                                         "( "
+                                                         "SELECT "
+                                                         "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                         "FROM "
+                                                         "`Tracks` tracksFromAlbum2 "
+                                                         "WHERE "
+                                                         "tracksFromAlbum2.`AlbumID` = album.`ID` "
+                                                         ") AS AllArtists, "
+                                                         "tracks.`AlbumArtistName`, "
+                                                         "(trackDirectory.`Path` || tracksMapping.`BaseName`) AS FileName, "
+                                                         "tracksMapping.`FileModifiedTime`, "
+                                                         "tracks.`TrackNumber`, "
+                                                         "tracks.`DiscNumber`, "
+                                                         "tracks.`Duration`, "
+                                                         "tracks.`AlbumTitle`, "
+                                                         "tracks.`Rating`, "
+                                                         "album.`CoverFileName`, "
+                                                         "("
+                                                         "SELECT "
+                                                         "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                         "FROM "
+                                                         "`Tracks` tracks2 "
+                                                         "WHERE "
+                                                         "tracks2.`AlbumID` = album.`ID` "
+                                                         ") as `IsSingleDiscAlbum`, "
+                                                         "trackGenre.`Name`, "
+                                                         "trackComposer.`Name`, "
+                                                         "trackLyricist.`Name`, "
+                                                         "tracks.`Comment`, "
+                                                         "tracks.`Year`, "
+                                                         "tracks.`Channels`, "
+                                                         "tracks.`BitRate`, "
+                                                         "tracks.`SampleRate`, "
+                                                         "tracks.`HasEmbeddedCover`, "
+                                                         "tracksMapping.`ImportDate`, "
+                                                         "tracksMapping.`FirstPlayDate`, "
+                                                         "tracksMapping.`LastPlayDate`, "
+                                                         "tracksMapping.`PlayCounter`, "
+                                                         "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                         "( "
+                                                         "SELECT ("
+                                                         "SELECT coverDirectory.`Path` || coverData.`BaseName` "
+                                                         "FROM "
+                                                         "`TracksData` coverData, "
+                                                         "`Directories` coverDirectory "
+                                                         "WHERE "
+                                                         "coverData.`ID` = tracksCover.`FileID` AND "
+                                                         "coverDirectory.`ID` = coverData.`DirectoryID`"
+                                                         ") "
+                                                         "FROM "
+                                                         "`Tracks` tracksCover "
+                                                         "WHERE "
+                                                         "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                         "tracksCover.`AlbumID` = album.`ID` "
+                                                         ") as EmbeddedCover "
+                                                         "FROM "
+                                                         "`Tracks` tracks, "
+                                                         "`TracksData` tracksMapping "
+                                                         "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = tracksMapping.`DirectoryID` "
+                                                         "LEFT JOIN "
+                                                         "`Albums` album "
+                                                         "ON "
+                                                         "tracks.`AlbumID` = album.`ID` "
+                                                         "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                                                         "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID` "
+                                                         "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                         "WHERE "
+                                                         "tracks.`ID` = :trackId AND "
+                                                         "tracksMapping.`ID` = tracks.`FileID` AND "
+                                                         "trackDirectory.`Path` = :trackDirectory AND "
+                                                         "tracksMapping.`BaseName` = :trackBaseName "
+                                                         "");
+
+        auto result = prepareQuery(d->mSelectTrackFromIdAndUrlQuery, selectTrackFromIdAndUrlQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdAndUrlQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdAndUrlQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectAllRadiosText = QStringLiteral("SELECT "
+        auto selectRadioFromIdQueryText = QStringLiteral("SELECT "
                                                   "radios.`ID`, "
                                                   "radios.`Title`, "
                                                   "radios.`HttpAddress`, "
@@ -4001,2299 +8740,2132 @@ void DatabaseInterface::initRequest()
                                                   "FROM "
                                                   "`Radios` radios "
                                                   "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = radios.`Genre` "
+                                                  "WHERE "
+                                                  "radios.`ID` = :radioId "
                                                   "");
 
-        auto result = prepareQuery(d->mSelectAllRadiosQuery, selectAllRadiosText);
+        auto result = prepareQuery(d->mSelectRadioFromIdQuery, selectRadioFromIdQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllRadiosQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllRadiosQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectRadioFromIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectRadioFromIdQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+    {
+        auto selectCountAlbumsQueryText = QStringLiteral("SELECT count(*) "
+                                                         "FROM `Albums` album "
+                                                         "WHERE album.`ArtistName` = :artistName ");
+
+        const auto result = prepareQuery(d->mSelectCountAlbumsForArtistQuery, selectCountAlbumsQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForArtistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectAllTracksText = QStringLiteral("SELECT "
-                                                  "tracks.`ID`, "
-                                                  "tracks.`Title`, "
-                                                  "album.`ID`, "
-                                                  "tracks.`ArtistName`, "
-                                                  "( "
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                  "FROM "
-                                                  "`Tracks` tracksFromAlbum1 "
-                                                  "WHERE "
-                                                  "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                  ") AS ArtistsCount, "
-                                                  "( "
-                                                  "SELECT "
-                                                  "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
-                                                  "FROM "
-                                                  "`Tracks` tracksFromAlbum2 "
-                                                  "WHERE "
-                                                  "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") AS AllArtists, "
-                                                  "tracks.`AlbumArtistName`, "
-                                                  "tracksMapping.`FileName`, "
-                                                  "tracksMapping.`FileModifiedTime`, "
-                                                  "tracks.`TrackNumber`, "
-                                                  "tracks.`DiscNumber`, "
-                                                  "tracks.`Duration`, "
-                                                  "tracks.`AlbumTitle`, "
-                                                  "tracks.`Rating`, "
-                                                  "album.`CoverFileName`, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "trackGenre.`Name`, "
-                                                  "trackComposer.`Name`, "
-                                                  "trackLyricist.`Name`, "
-                                                  "tracks.`Comment`, "
-                                                  "tracks.`Year`, "
-                                                  "tracks.`Channels`, "
-                                                  "tracks.`BitRate`, "
-                                                  "tracks.`SampleRate`, "
-                                                  "tracks.`HasEmbeddedCover`, "
-                                                  "tracksMapping.`ImportDate`, "
-                                                  "tracksMapping.`FirstPlayDate`, "
-                                                  "tracksMapping.`LastPlayDate`, "
-                                                  "tracksMapping.`PlayCounter`, "
-                                                  "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
-                                                  "FROM "
-                                                  "`Tracks` tracks, "
-                                                  "`TracksData` tracksMapping "
-                                                  "LEFT JOIN "
-                                                  "`Albums` album "
-                                                  "ON "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                  "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
-                                                  "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                  "WHERE "
-                                                  "tracksMapping.`FileName` = tracks.`FileName` AND "
-                                                  "tracksMapping.`PlayCounter` > 0 AND "
-                                                  "tracks.`Priority` = ("
-                                                  "     SELECT "
-                                                  "     MIN(`Priority`) "
-                                                  "     FROM "
-                                                  "     `Tracks` tracks2 "
-                                                  "     WHERE "
-                                                  "     tracks.`Title` = tracks2.`Title` AND "
-                                                  "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
-                                                  "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
-                                                  "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
-                                                  "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
-                                                  ")"
-                                                  "ORDER BY tracksMapping.`LastPlayDate` DESC "
-                                                  "LIMIT :maximumResults");
+        auto selectGenreForArtistQueryText = QStringLiteral("SELECT DISTINCT trackGenre.`Name` "
+                                                            "FROM "
+                                                            "`Tracks` tracks "
+                                                            "LEFT JOIN "
+                                                            "`Albums` album "
+                                                            "ON "
+                                                            "tracks.`AlbumID` = album.`ID` "
+                                                            "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                            "WHERE "
+                                                            "album.`ArtistName` = :artistName");
 
-        auto result = prepareQuery(d->mSelectAllRecentlyPlayedTracksQuery, selectAllTracksText);
+        const auto result = prepareQuery(d->mSelectGenreForArtistQuery, selectGenreForArtistQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllRecentlyPlayedTracksQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllRecentlyPlayedTracksQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForArtistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectAllTracksText = QStringLiteral("SELECT "
-                                                  "tracks.`ID`, "
-                                                  "tracks.`Title`, "
-                                                  "album.`ID`, "
-                                                  "tracks.`ArtistName`, "
-                                                  "( "
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                  "FROM "
-                                                  "`Tracks` tracksFromAlbum1 "
-                                                  "WHERE "
-                                                  "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                  ") AS ArtistsCount, "
-                                                  "( "
-                                                  "SELECT "
-                                                  "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
-                                                  "FROM "
-                                                  "`Tracks` tracksFromAlbum2 "
-                                                  "WHERE "
-                                                  "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") AS AllArtists, "
-                                                  "tracks.`AlbumArtistName`, "
-                                                  "tracksMapping.`FileName`, "
-                                                  "tracksMapping.`FileModifiedTime`, "
-                                                  "tracks.`TrackNumber`, "
-                                                  "tracks.`DiscNumber`, "
-                                                  "tracks.`Duration`, "
-                                                  "tracks.`AlbumTitle`, "
-                                                  "tracks.`Rating`, "
-                                                  "album.`CoverFileName`, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "trackGenre.`Name`, "
-                                                  "trackComposer.`Name`, "
-                                                  "trackLyricist.`Name`, "
-                                                  "tracks.`Comment`, "
-                                                  "tracks.`Year`, "
-                                                  "tracks.`Channels`, "
-                                                  "tracks.`BitRate`, "
-                                                  "tracks.`SampleRate`, "
-                                                  "tracks.`HasEmbeddedCover`, "
-                                                  "tracksMapping.`ImportDate`, "
-                                                  "tracksMapping.`FirstPlayDate`, "
-                                                  "tracksMapping.`LastPlayDate`, "
-                                                  "tracksMapping.`PlayCounter`, "
-                                                  "CAST(tracksMapping.`PlayCounter` AS REAL) / ((CAST(strftime('%s','now') as INTEGER) - CAST(tracksMapping.`FirstPlayDate` / 1000 as INTEGER)) / CAST(1000 AS REAL)) as PlayFrequency, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
-                                                  "FROM "
-                                                  "`Tracks` tracks, "
-                                                  "`TracksData` tracksMapping "
-                                                  "LEFT JOIN "
-                                                  "`Albums` album "
-                                                  "ON "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                  "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
-                                                  "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                  "WHERE "
-                                                  "tracksMapping.`FileName` = tracks.`FileName` AND "
-                                                  "tracksMapping.`PlayCounter` > 0 AND "
-                                                  "tracks.`Priority` = ("
-                                                  "     SELECT "
-                                                  "     MIN(`Priority`) "
-                                                  "     FROM "
-                                                  "     `Tracks` tracks2 "
-                                                  "     WHERE "
-                                                  "     tracks.`Title` = tracks2.`Title` AND "
-                                                  "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
-                                                  "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
-                                                  "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
-                                                  "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
-                                                  ")"
-                                                  "ORDER BY CAST(tracksMapping.`PlayCounter` AS REAL) / ((CAST(strftime('%s','now') as INTEGER) - CAST(tracksMapping.`FirstPlayDate` / 1000 as INTEGER)) / CAST(1000 AS REAL)) DESC "
-                                                  "LIMIT :maximumResults");
+        auto selectGenreForAlbumQueryText = QStringLiteral("SELECT DISTINCT trackGenre.`Name` "
+                                                           "FROM "
+                                                           "`Tracks` tracks "
+                                                           "LEFT JOIN "
+                                                           "`Albums` album "
+                                                           "ON "
+                                                           "tracks.`AlbumID` = album.`ID` "
+                                                           "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                           "WHERE "
+                                                           "album.`ID` = :albumId");
+
+        const auto result = prepareQuery(d->mSelectGenreForAlbumQuery, selectGenreForAlbumQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForAlbumQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForAlbumQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectCountAlbumsQueryText = QStringLiteral("SELECT distinct count(album.`ID`) "
+                                                         "FROM "
+                                                         "`Tracks` tracks, "
+                                                         "`Albums` album "
+                                                         "LEFT JOIN `Composer` albumComposer ON albumComposer.`ID` = tracks.`ComposerID` "
+                                                         "WHERE "
+                                                         "tracks.`AlbumID` = album.`ID` AND "
+                                                         "albumComposer.`Name` = :artistName");
+
+        const auto result = prepareQuery(d->mSelectCountAlbumsForComposerQuery, selectCountAlbumsQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForComposerQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForComposerQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
 
-        auto result = prepareQuery(d->mSelectAllFrequentlyPlayedTracksQuery, selectAllTracksText);
+    {
+        auto selectCountAlbumsQueryText = QStringLiteral("SELECT distinct count(album.`ID`) "
+                                                         "FROM "
+                                                         "`Tracks` tracks, "
+                                                         "`Albums` album "
+                                                         "LEFT JOIN `Lyricist` albumLyricist ON albumLyricist.`ID` = tracks.`LyricistID` "
+                                                         "WHERE "
+                                                         "tracks.`AlbumID` = album.`ID` AND "
+                                                         "albumLyricist.`Name` = :artistName");
+
+        const auto result = prepareQuery(d->mSelectCountAlbumsForLyricistQuery, selectCountAlbumsQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllFrequentlyPlayedTracksQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllFrequentlyPlayedTracksQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForLyricistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForLyricistQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto clearAlbumsTableText = QStringLiteral("DELETE FROM `Albums`");
+        auto selectAlbumIdFromTitleQueryText = QStringLiteral("SELECT "
+                                                              "album.`ID` "
+                                                              "FROM "
+                                                              "`Albums` album "
+                                                              "WHERE "
+                                                              "album.`ArtistName` = :artistName AND "
+                                                              "album.`Title` = :title");
 
-        auto result = prepareQuery(d->mClearAlbumsTable, clearAlbumsTableText);
+        auto result = prepareQuery(d->mSelectAlbumIdFromTitleQuery, selectAlbumIdFromTitleQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearAlbumsTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearAlbumsTable.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto clearArtistsTableText = QStringLiteral("DELETE FROM `Artists`");
+        auto selectAlbumIdFromTitleAndArtistQueryText = QStringLiteral("SELECT "
+                                                                       "album.`ID` "
+                                                                       "FROM "
+                                                                       "`Albums` album "
+                                                                       "WHERE "
+                                                                       "(album.`ArtistName` = :artistName OR :artistName IS NULL OR album.`ArtistName` IS NULL) AND "
+                                                                       "album.`Title` = :title AND "
+                                                                       "album.`AlbumPath` = :albumPath");
 
-        auto result = prepareQuery(d->mClearArtistsTable, clearArtistsTableText);
+        auto result = prepareQuery(d->mSelectAlbumIdFromTitleAndArtistQuery, selectAlbumIdFromTitleAndArtistQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearArtistsTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearArtistsTable.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto clearComposerTableText = QStringLiteral("DELETE FROM `Composer`");
+        auto selectAlbumIdFromTitleWithoutArtistQueryText = QStringLiteral("SELECT "
+                                                                           "album.`ID` "
+                                                                           "FROM "
+                                                                           "`Albums` album "
+                                                                           "WHERE "
+                                                                           "album.`AlbumPath` = :albumPath AND "
+                                                                           "album.`Title` = :title AND "
+                                                                           "album.`ArtistName` IS NULL");
 
-        auto result = prepareQuery(d->mClearComposerTable, clearComposerTableText);
+        auto result = prepareQuery(d->mSelectAlbumIdFromTitleWithoutArtistQuery, selectAlbumIdFromTitleWithoutArtistQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearComposerTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearComposerTable.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto clearGenreTableText = QStringLiteral("DELETE FROM `Genre`");
+        auto insertAlbumQueryText = QStringLiteral("INSERT INTO `Albums` "
+                                                   "(`ID`, "
+                                                   "`Title`, "
+                                                   "`ArtistName`, "
+                                                   "`AlbumPath`, "
+                                                   "`CoverFileName`) "
+                                                   "VALUES "
+                                                   "(:albumId, "
+                                                   ":title, "
+                                                   ":albumArtist, "
+                                                   ":albumPath, "
+                                                   ":coverFileName)");
 
-        auto result = prepareQuery(d->mClearGenreTable, clearGenreTableText);
+        auto result = prepareQuery(d->mInsertAlbumQuery, insertAlbumQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearGenreTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearGenreTable.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertAlbumQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertAlbumQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto clearLyricistTableText = QStringLiteral("DELETE FROM `Lyricist`");
+        auto insertDirectoryQueryText = QStringLiteral("INSERT OR IGNORE INTO `Directories` (`Path`) "
+                                                       "VALUES (:directory)");
 
-        auto result = prepareQuery(d->mClearLyricistTable, clearLyricistTableText);
+        auto result = prepareQuery(d->mInsertDirectory, insertDirectoryQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearLyricistTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearLyricistTable.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertDirectory.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertDirectory.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto clearTracksDataTableText = QStringLiteral("DELETE FROM `TracksData`");
+        auto insertTrackMappingQueryText = QStringLiteral("INSERT INTO "
+                                                          "`TracksData` "
+                                                          "(`DirectoryID`, "
+                                                          "`BaseName`, "
+                                                          "`FileModifiedTime`, "
+                                                          "`ImportDate`, "
+                                                          "`PlayCounter`) "
+                                                          "SELECT `ID`, :baseName, :mtime, :importDate, 0 "
+                                                          "FROM `Directories` "
+                                                          "WHERE `Path` = :directory");
 
-        auto result = prepareQuery(d->mClearTracksDataTable, clearTracksDataTableText);
+        auto result = prepareQuery(d->mInsertTrackMapping, insertTrackMappingQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearTracksDataTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearTracksDataTable.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackMapping.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackMapping.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto clearTracksTableText = QStringLiteral("DELETE FROM `Tracks`");
+        auto initialUpdateTracksValidityQueryText = QStringLiteral("UPDATE `TracksData` "
+                                                                   "SET "
+                                                                   "`FileModifiedTime` = :mtime "
+                                                                   "WHERE `DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :directory) AND "
+                                                                   "`BaseName` = :baseName");
 
-        auto result = prepareQuery(d->mClearTracksTable, clearTracksTableText);
+        auto result = prepareQuery(d->mUpdateTrackFileModifiedTime, initialUpdateTracksValidityQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearTracksTable.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearTracksTable.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFileModifiedTime.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFileModifiedTime.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectAllTracksShortText = QStringLiteral("SELECT "
-                                                       "tracks.`ID`, "
-                                                       "tracks.`Title`, "
-                                                       "tracks.`ArtistName`, "
-                                                       "tracks.`AlbumTitle`, "
-                                                       "( "
-                                                       "SELECT "
-                                                       "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                       "FROM "
-                                                       "`Tracks` tracksFromAlbum1 "
-                                                       "WHERE "
-                                                       "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                       "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                       "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                       "album.`ArtistName` IS NULL "
-                                                       ") "
-                                                       ") AND "
-                                                       "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                       ") AS ArtistsCount, "
-                                                       "( "
-                                                       "SELECT "
-                                                       "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
-                                                       "FROM "
-                                                       "`Tracks` tracksFromAlbum2 "
-                                                       "WHERE "
-                                                       "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                       "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                       "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                       "album.`ArtistName` IS NULL "
-                                                       ") "
-                                                       ") AND "
-                                                       "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
-                                                       ") AS AllArtists, "
-                                                       "tracks.`AlbumArtistName`, "
-                                                       "tracks.`Duration`, "
-                                                       "album.`CoverFileName`, "
-                                                       "tracks.`TrackNumber`, "
-                                                       "tracks.`DiscNumber`, "
-                                                       "tracks.`Rating` "
-                                                       "FROM "
-                                                       "`Tracks` tracks "
-                                                       "LEFT JOIN "
-                                                       "`Albums` album "
-                                                       "ON "
-                                                       "tracks.`AlbumTitle` = album.`Title` AND "
-                                                       "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                       "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                       "");
+        auto initialUpdateTracksValidityQueryText = QStringLiteral("UPDATE `Tracks` "
+                                                                   "SET "
+                                                                   "`Priority` = :priority "
+                                                                   "WHERE `FileID` = ("
+                                                                   "SELECT trackData.`ID` "
+                                                                   "FROM `TracksData` trackData, `Directories` trackDirectory "
+                                                                   "WHERE trackDirectory.`Path` = :directory AND "
+                                                                   "trackData.`DirectoryID` = trackDirectory.`ID` AND "
+                                                                   "trackData.`BaseName` = :baseName)");
 
-        auto result = prepareQuery(d->mSelectAllTracksShortQuery, selectAllTracksShortText);
+        auto result = prepareQuery(d->mUpdateTrackPriority, initialUpdateTracksValidityQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksShortQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksShortQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackPriority.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackPriority.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectArtistByNameText = QStringLiteral("SELECT `ID`, "
-                                                     "`Name` "
-                                                     "FROM `Artists` "
-                                                     "WHERE "
-                                                     "`Name` = :name");
+        auto removeTracksMappingFromSourceQueryText = QStringLiteral("DELETE FROM `TracksData` "
+                                                                     "WHERE `DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :directory) AND "
+                                                                     "`BaseName` = :baseName");
 
-        auto result = prepareQuery(d->mSelectArtistByNameQuery, selectArtistByNameText);
+        auto result = prepareQuery(d->mRemoveTracksMappingFromSource, removeTracksMappingFromSourceQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistByNameQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistByNameQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMappingFromSource.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMappingFromSource.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectComposerByNameText = QStringLiteral("SELECT `ID`, "
-                                                       "`Name` "
-                                                       "FROM `Composer` "
-                                                       "WHERE "
-                                                       "`Name` = :name");
+        auto removeTracksMappingQueryText = QStringLiteral("DELETE FROM `TracksData` "
+                                                           "WHERE `DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :directory) AND "
+                                                           "`BaseName` = :baseName");
 
-        auto result = prepareQuery(d->mSelectComposerByNameQuery, selectComposerByNameText);
+        auto result = prepareQuery(d->mRemoveTracksMapping, removeTracksMappingQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerByNameQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerByNameQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMapping.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMapping.lastError();
+
+            Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectLyricistByNameText = QStringLiteral("SELECT `ID`, "
-                                                       "`Name` "
-                                                       "FROM `Lyricist` "
-                                                       "WHERE "
-                                                       "`Name` = :name");
+        auto removeUnusedDirectoryQueryText = QStringLiteral("DELETE FROM `Directories` "
+                                                             "WHERE `Path` = :directory AND "
+                                                             "NOT EXISTS (SELECT 1 FROM `TracksData` trackData WHERE trackData.`DirectoryID` = `Directories`.`ID`)");
 
-        auto result = prepareQuery(d->mSelectLyricistByNameQuery, selectLyricistByNameText);
+        auto result = prepareQuery(d->mRemoveUnusedDirectory, removeUnusedDirectoryQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistByNameQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistByNameQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveUnusedDirectory.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveUnusedDirectory.lastError();
+
+            Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectGenreByNameText = QStringLiteral("SELECT `ID`, "
-                                                    "`Name` "
-                                                    "FROM `Genre` "
-                                                    "WHERE "
-                                                    "`Name` = :name");
+        auto updateTrackFileNameQueryText = QStringLiteral("UPDATE `TracksData` "
+                                                           "SET "
+                                                           "`DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :newDirectory), "
+                                                           "`BaseName` = :newBaseName "
+                                                           "WHERE "
+                                                           "`DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :directory) AND "
+                                                           "`BaseName` = :baseName");
 
-        auto result = prepareQuery(d->mSelectGenreByNameQuery, selectGenreByNameText);
+        auto result = prepareQuery(d->mUpdateTrackFileNameQuery, updateTrackFileNameQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreByNameQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreByNameQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFileNameQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFileNameQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto insertArtistsText = QStringLiteral("INSERT INTO `Artists` (`ID`, `Name`) "
-                                                "VALUES (:artistId, :name)");
+        auto selectTracksWithoutMappingQueryText = QStringLiteral("SELECT "
+                                                                  "tracks.`Id`, "
+                                                                  "tracks.`Title`, "
+                                                                  "album.`ID`, "
+                                                                  "tracks.`ArtistName`, "
+                                                                  "( "
+                                                                  "SELECT "
+                                                                  "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                                  "FROM "
+                                                                  "`Tracks` tracksFromAlbum1 "
+                                                                  "WHERE "
+                                                                  "tracksFromAlbum1.`AlbumID` = album.`ID` "
+                                                                  ") AS ArtistsCount, "
+                                                                  "( "
+                                                                  "SELECT "
+                                                                  "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                                  "FROM "
+                                                                  "`Tracks` tracksFromAlbum2 "
+                                                                  "WHERE "
+                                                                  "tracksFromAlbum2.`AlbumID` = album.`ID` "
+                                                                  ") AS AllArtists, "
+                                                                  "tracks.`AlbumArtistName`, "
+                                                                  "\"\" as FileName, "
+                                                                  "NULL as FileModifiedTime, "
+                                                                  "tracks.`TrackNumber`, "
+                                                                  "tracks.`DiscNumber`, "
+                                                                  "tracks.`Duration`, "
+                                                                  "tracks.`AlbumTitle`, "
+                                                                  "tracks.`Rating`, "
+                                                                  "album.`CoverFileName`, "
+                                                                  "("
+                                                                  "SELECT "
+                                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                                  "FROM "
+                                                                  "`Tracks` tracks2 "
+                                                                  "WHERE "
+                                                                  "tracks2.`AlbumID` = album.`ID` "
+                                                                  ") as `IsSingleDiscAlbum`, "
+                                                                  "trackGenre.`Name`, "
+                                                                  "trackComposer.`Name`, "
+                                                                  "trackLyricist.`Name`, "
+                                                                  "tracks.`Comment`, "
+                                                                  "tracks.`Year`, "
+                                                                  "tracks.`Channels`, "
+                                                                  "tracks.`BitRate`, "
+                                                                  "tracks.`SampleRate`, "
+                                                                  "tracks.`HasEmbeddedCover`, "
+                                                                  "tracksMapping.`ImportDate`, "
+                                                                  "tracksMapping.`FirstPlayDate`, "
+                                                                  "tracksMapping.`LastPlayDate`, "
+                                                                  "tracksMapping.`PlayCounter`, "
+                                                                  "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                                  "( "
+                                                                  "SELECT ("
+                                                                  "SELECT coverDirectory.`Path` || coverData.`BaseName` "
+                                                                  "FROM "
+                                                                  "`TracksData` coverData, "
+                                                                  "`Directories` coverDirectory "
+                                                                  "WHERE "
+                                                                  "coverData.`ID` = tracksCover.`FileID` AND "
+                                                                  "coverDirectory.`ID` = coverData.`DirectoryID`"
+                                                                  ") "
+                                                                  "FROM "
+                                                                  "`Tracks` tracksCover "
+                                                                  "WHERE "
+                                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                                  "tracksCover.`AlbumID` = album.`ID` "
+                                                                  ") as EmbeddedCover "
+                                                                  "FROM "
+                                                                  "`Tracks` tracks, "
+                                                                  "`TracksData` tracksMapping "
+                                                                  "LEFT JOIN "
+                                                                  "`Albums` album "
+                                                                  "ON "
+                                                                  "tracks.`AlbumID` = album.`ID` "
+                                                                  "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                                                                  "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID` "
+                                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                                  "WHERE "
+                                                                  "tracks.`FileID` = tracksMapping.`ID` AND "
+                                                                  "tracks.`FileID` NOT IN (SELECT tracksMapping2.`ID` FROM `TracksData` tracksMapping2)");
 
-        auto result = prepareQuery(d->mInsertArtistsQuery, insertArtistsText);
+        auto result = prepareQuery(d->mSelectTracksWithoutMappingQuery, selectTracksWithoutMappingQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertArtistsQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertArtistsQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksWithoutMappingQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksWithoutMappingQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto insertGenreText = QStringLiteral("INSERT INTO `Genre` (`ID`, `Name`) "
-                                              "VALUES (:genreId, :name)");
+        auto selectTracksMappingQueryText = QStringLiteral("SELECT "
+                                                           "track.`ID`, "
+                                                           "(trackDirectory.`Path` || trackData.`BaseName`), "
+                                                           "track.`Priority`, "
+                                                           "trackData.`FileModifiedTime` "
+                                                           "FROM "
+                                                           "`Directories` trackDirectory, "
+                                                           "`TracksData` trackData "
+                                                           "LEFT JOIN "
+                                                           "`Tracks` track "
+                                                           "ON "
+                                                           "track.`FileID` = trackData.`ID` "
+                                                           "WHERE "
+                                                           "trackDirectory.`Path` = :directory AND "
+                                                           "trackData.`DirectoryID` = trackDirectory.`ID` AND "
+                                                           "trackData.`BaseName` = :baseName");
 
-        auto result = prepareQuery(d->mInsertGenreQuery, insertGenreText);
+        auto result = prepareQuery(d->mSelectTracksMapping, selectTracksMappingQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertGenreQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertGenreQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMapping.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMapping.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto insertComposerText = QStringLiteral("INSERT INTO `Composer` (`ID`, `Name`) "
-                                                 "VALUES (:composerId, :name)");
+        auto selectRadioIdFromHttpAddress = QStringLiteral("SELECT "
+                                                           "`ID` "
+                                                           "FROM "
+                                                           "`Radios` "
+                                                           "WHERE "
+                                                           "`HttpAddress` = :httpAddress");
 
-        auto result = prepareQuery(d->mInsertComposerQuery, insertComposerText);
+        auto result = prepareQuery(d->mSelectRadioIdFromHttpAddress, selectRadioIdFromHttpAddress);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertComposerQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertComposerQuery.lastError();
-        }
-    }
-
-    {
-        auto insertLyricistText = QStringLiteral("INSERT INTO `Lyricist` (`ID`, `Name`) "
-                                                 "VALUES (:lyricistId, :name)");
-
-        auto result = prepareQuery(d->mInsertLyricistQuery, insertLyricistText);
+            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectRadioIdFromHttpAddress.lastQuery();
+            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectRadioIdFromHttpAddress.lastError();
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertLyricistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertLyricistQuery.lastError();
+            Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTrackQueryText = QStringLiteral("SELECT "
-                                                   "tracks.`ID`, "
-                                                   "tracks.`Title`, "
-                                                   "album.`ID`, "
-                                                   "tracks.`ArtistName`, "
-                                                   "( "
-                                                   "SELECT "
-                                                   "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                   "FROM "
-                                                   "`Tracks` tracksFromAlbum1 "
-                                                   "WHERE "
-                                                   "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL "
-                                                   ") "
-                                                   ") AND "
-                                                   "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                   ") AS ArtistsCount, "
-                                                   "( "
-                                                   "SELECT "
-                                                   "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
-                                                   "FROM "
-                                                   "`Tracks` tracksFromAlbum2 "
-                                                   "WHERE "
-                                                   "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL "
-                                                   ") "
-                                                   ") AND "
-                                                   "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
-                                                   ") AS AllArtists, "
-                                                   "tracks.`AlbumArtistName`, "
-                                                   "tracksMapping.`FileName`, "
-                                                   "tracksMapping.`FileModifiedTime`, "
-                                                   "tracks.`TrackNumber`, "
-                                                   "tracks.`DiscNumber`, "
-                                                   "tracks.`Duration`, "
-                                                   "tracks.`AlbumTitle`, "
-                                                   "tracks.`Rating`, "
-                                                   "album.`CoverFileName`, "
-                                                   "("
-                                                   "SELECT "
-                                                   "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                   "FROM "
-                                                   "`Tracks` tracks2 "
-                                                   "WHERE "
-                                                   "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                   ") as `IsSingleDiscAlbum`, "
-                                                   "trackGenre.`Name`, "
-                                                   "trackComposer.`Name`, "
-                                                   "trackLyricist.`Name`, "
-                                                   "tracks.`Comment`, "
-                                                   "tracks.`Year`, "
-                                                   "tracks.`Channels`, "
-                                                   "tracks.`BitRate`, "
-                                                   "tracks.`SampleRate`, "
-                                                   "tracks.`HasEmbeddedCover`, "
-                                                   "tracksMapping.`ImportDate`, "
-                                                   "tracksMapping.`FirstPlayDate`, "
-                                                   "tracksMapping.`LastPlayDate`, "
-                                                   "tracksMapping.`PlayCounter`, "
-                                                   "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
-                                                   "( "
-                                                   "SELECT tracksCover.`FileName` "
-                                                   "FROM "
-                                                   "`Tracks` tracksCover "
-                                                   "WHERE "
-                                                   "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                   "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL "
-                                                   ") "
-                                                   ") AND "
-                                                   "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                   ") as EmbeddedCover "
-                                                   "FROM "
-                                                   "`Tracks` tracks, "
-                                                   "`TracksData` tracksMapping "
-                                                   "LEFT JOIN "
-                                                   "`Albums` album "
-                                                   "ON "
-                                                   "album.`ID` = :albumId AND "
-                                                   "tracks.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                   "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                   "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
-                                                   "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                   "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                   "WHERE "
-                                                   "tracksMapping.`FileName` = tracks.`FileName` AND "
-                                                   "album.`ID` = :albumId AND "
-                                                   "tracks.`Priority` = ("
-                                                   "     SELECT "
-                                                   "     MIN(`Priority`) "
-                                                   "     FROM "
-                                                   "     `Tracks` tracks2 "
-                                                   "     WHERE "
-                                                   "     tracks.`Title` = tracks2.`Title` AND "
-                                                   "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
-                                                   "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
-                                                   "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
-                                                   "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
-                                                   ")"
-                                                   "ORDER BY tracks.`DiscNumber` ASC, "
-                                                   "tracks.`TrackNumber` ASC");
+        auto selectTracksMappingPriorityQueryText = QStringLiteral("SELECT "
+                                                                   "max(tracks.`Priority`) AS Priority "
+                                                                   "FROM "
+                                                                   "`Tracks` tracks, "
+                                                                   "`Albums` albums "
+                                                                   "WHERE "
+                                                                   "tracks.`Title` = :title AND "
+                                                                   "(tracks.`ArtistName` = :trackArtist OR tracks.`ArtistName` IS NULL) AND "
+                                                                   "(tracks.`AlbumTitle` = :album OR tracks.`AlbumTitle` IS NULL) AND "
+                                                                   "(tracks.`AlbumArtistName` = :albumArtist OR tracks.`AlbumArtistName` IS NULL) AND "
+                                                                   "(tracks.`AlbumPath` = :albumPath OR tracks.`AlbumPath` IS NULL)");
 
-        auto result = prepareQuery(d->mSelectTrackQuery, selectTrackQueryText);
+        auto result = prepareQuery(d->mSelectTracksMappingPriority, selectTracksMappingPriorityQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriority.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriority.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTrackQueryText = QStringLiteral("SELECT "
-                                                   "tracks.`ID` "
-                                                   "FROM "
-                                                   "`Tracks` tracks, "
-                                                   "`TracksData` tracksMapping "
-                                                   "LEFT JOIN "
-                                                   "`Albums` album "
-                                                   "ON "
-                                                   "album.`ID` = :albumId AND "
-                                                   "tracks.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                   "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                   "WHERE "
-                                                   "tracksMapping.`FileName` = tracks.`FileName` AND "
-                                                   "album.`ID` = :albumId AND "
-                                                   "tracks.`Priority` = ("
-                                                   "     SELECT "
-                                                   "     MIN(`Priority`) "
-                                                   "     FROM "
-                                                   "     `Tracks` tracks2 "
-                                                   "     WHERE "
-                                                   "     tracks.`Title` = tracks2.`Title` AND "
-                                                   "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
-                                                   "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
-                                                   "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
-                                                   "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
-                                                   ")"
-                                                   "ORDER BY tracks.`DiscNumber` ASC, "
-                                                   "tracks.`TrackNumber` ASC");
+        auto selectTracksMappingPriorityQueryByTrackIdText = QStringLiteral("SELECT "
+                                                                            "MAX(track.`Priority`) "
+                                                                            "FROM "
+                                                                            "`TracksData` trackData, "
+                                                                            "`Tracks` track "
+                                                                            "WHERE "
+                                                                            "track.`ID` = :trackId AND "
+                                                                            "trackData.`ID` = track.`FileID`");
 
-        auto result = prepareQuery(d->mSelectTrackIdQuery, selectTrackQueryText);
+        auto result = prepareQuery(d->mSelectTracksMappingPriorityByTrackId, selectTracksMappingPriorityQueryByTrackIdText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriorityByTrackId.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriorityByTrackId.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTrackFromIdQueryText = QStringLiteral("SELECT "
-                                                         "tracks.`Id`, "
-                                                         "tracks.`Title`, "
-                                                         "album.`ID`, "
-                                                         "tracks.`ArtistName`, "
-                                                         "( "
-                                                         "SELECT "
-                                                         "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                         "FROM "
-                                                         "`Tracks` tracksFromAlbum1 "
-                                                         "WHERE "
-                                                         "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                         "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                         "album.`ArtistName` IS NULL "
-                                                         ") "
-                                                         ") AND "
-                                                         "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                         ") AS ArtistsCount, "
-                                                         "( "
-                                                         "SELECT "
-                                                         "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
-                                                         "FROM "
-                                                         "`Tracks` tracksFromAlbum2 "
-                                                         "WHERE "
-                                                         "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                         "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                         "album.`ArtistName` IS NULL "
-                                                         ") "
-                                                         ") AND "
-                                                         "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
-                                                         ") AS AllArtists, "
-                                                         "tracks.`AlbumArtistName`, "
-                                                         "tracksMapping.`FileName`, "
-                                                         "tracksMapping.`FileModifiedTime`, "
-                                                         "tracks.`TrackNumber`, "
-                                                         "tracks.`DiscNumber`, "
-                                                         "tracks.`Duration`, "
-                                                         "tracks.`AlbumTitle`, "
-                                                         "tracks.`Rating`, "
-                                                         "album.`CoverFileName`, "
-                                                         "("
-                                                         "SELECT "
-                                                         "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                         "FROM "
-                                                         "`Tracks` tracks2 "
-                                                         "WHERE "
-                                                         "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                         "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                         "album.`ArtistName` IS NULL"
-                                                         ")"
-                                                         ") AND "
-                                                         "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                         ") as `IsSingleDiscAlbum`, "
-                                                         "trackGenre.`Name`, "
-                                                         "trackComposer.`Name`, "
-                                                         "trackLyricist.`Name`, "
-                                                         "tracks.`Comment`, "
-                                                         "tracks.`Year`, "
-                                                         "tracks.`Channels`, "
-                                                         "tracks.`BitRate`, "
-                                                         "tracks.`SampleRate`, "
-                                                         "tracks.`HasEmbeddedCover`, "
-                                                         "tracksMapping.`ImportDate`, "
-                                                         "tracksMapping.`FirstPlayDate`, "
-                                                         "tracksMapping.`LastPlayDate`, "
-                                                         "tracksMapping.`PlayCounter`, "
-                                                         "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
-                                                         "( "
-                                                         "SELECT tracksCover.`FileName` "
-                                                         "FROM "
-                                                         "`Tracks` tracksCover "
-                                                         "WHERE "
-                                                         "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                         "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                         "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                         "album.`ArtistName` IS NULL "
-                                                         ") "
-                                                         ") AND "
-                                                         "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                         ") as EmbeddedCover "
-                                                         "FROM "
-                                                         "`Tracks` tracks, "
-                                                         "`TracksData` tracksMapping "
-                                                         "LEFT JOIN "
-                                                         "`Albums` album "
-                                                         "ON "
-                                                         "tracks.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                         "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                         "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
-                                                         "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                         "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                         "WHERE "
-                                                         "tracks.`ID` = :trackId AND "
-                                                         "tracksMapping.`FileName` = tracks.`FileName` AND "
-                                                         "tracks.`Priority` = ("
-                                                         "     SELECT "
-                                                         "     MIN(`Priority`) "
-                                                         "     FROM "
-                                                         "     `Tracks` tracks2 "
-                                                         "     WHERE "
-                                                         "     tracks.`Title` = tracks2.`Title` AND "
-                                                         "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
-                                                         "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
-                                                         "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
-                                                         "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
-                                                         ")"
-                                                         "");
+        auto selectAllTrackFilesFromSourceQueryText = QStringLiteral("SELECT "
+                                                                     "(trackDirectory.`Path` || tracksMapping.`BaseName`) AS FileName, "
+                                                                     "tracksMapping.`FileModifiedTime` "
+                                                                     "FROM "
+                                                                     "`TracksData` tracksMapping "
+                                                                     "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = tracksMapping.`DirectoryID`");
 
-        auto result = prepareQuery(d->mSelectTrackFromIdQuery, selectTrackFromIdQueryText);
+        auto result = prepareQuery(d->mSelectAllTrackFilesQuery, selectAllTrackFilesFromSourceQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTrackFilesQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTrackFilesQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTrackFromIdAndUrlQueryText = QStringLiteral("SELECT "
-                                                         "tracks.`Id`, "
-                                                         "tracks.`Title`, "
-                                                         "album.`ID`, "
-                                                         "tracks.`ArtistName`, "
-                                                         "( "
-                                                         "SELECT "
-                                                         "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                         "FROM "
-                                                         "`Tracks` tracksFromAlbum1 "
-                                                         "WHERE "
-                                                         "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                         "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                         "album.`ArtistName` IS NULL "
-                                                         ") "
-                                                         ") AND "
-                                                         "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                         ") AS ArtistsCount, "
-                                                         "( "
-                                                         "SELECT "
-                                                         "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
-                                                         "FROM "
-                                                         "`Tracks` tracksFromAlbum2 "
-                                                         "WHERE "
-                                                         "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                         "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                         "album.`ArtistName` IS NULL "
-                                                         ") "
-                                                         ") AND "
-                                                         "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
-                                                         ") AS AllArtists, "
-                                                         "tracks.`AlbumArtistName`, "
-                                                         "tracksMapping.`FileName`, "
-                                                         "tracksMapping.`FileModifiedTime`, "
-                                                         "tracks.`TrackNumber`, "
-                                                         "tracks.`DiscNumber`, "
-                                                         "tracks.`Duration`, "
-                                                         "tracks.`AlbumTitle`, "
-                                                         "tracks.`Rating`, "
-                                                         "album.`CoverFileName`, "
-                                                         "("
-                                                         "SELECT "
-                                                         "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                         "FROM "
-                                                         "`Tracks` tracks2 "
-                                                         "WHERE "
-                                                         "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                         "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                         "album.`ArtistName` IS NULL"
-                                                         ")"
-                                                         ") AND "
-                                                         "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                         ") as `IsSingleDiscAlbum`, "
-                                                         "trackGenre.`Name`, "
-                                                         "trackComposer.`Name`, "
-                                                         "trackLyricist.`Name`, "
-                                                         "tracks.`Comment`, "
-                                                         "tracks.`Year`, "
-                                                         "tracks.`Channels`, "
-                                                         "tracks.`BitRate`, "
-                                                         "tracks.`SampleRate`, "
-                                                         "tracks.`HasEmbeddedCover`, "
-                                                         "tracksMapping.`ImportDate`, "
-                                                         "tracksMapping.`FirstPlayDate`, "
-                                                         "tracksMapping.`LastPlayDate`, "
-                                                         "tracksMapping.`PlayCounter`, "
-                                                         "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
-                                                         "( "
-                                                         "SELECT tracksCover.`FileName` "
-                                                         "FROM "
-                                                         "`Tracks` tracksCover "
-                                                         "WHERE "
-                                                         "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                         "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                         "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                         "album.`ArtistName` IS NULL "
-                                                         ") "
-                                                         ") AND "
-                                                         "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                         ") as EmbeddedCover "
-                                                         "FROM "
-                                                         "`Tracks` tracks, "
-                                                         "`TracksData` tracksMapping "
-                                                         "LEFT JOIN "
-                                                         "`Albums` album "
-                                                         "ON "
-                                                         "tracks.`AlbumTitle` = album.`Title` AND "
-                                                         "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                         "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                         "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
-                                                         "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                         "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                         "WHERE "
-                                                         "tracks.`ID` = :trackId AND "
-                                                         "tracksMapping.`FileName` = tracks.`FileName` AND "
-                                                         "tracksMapping.`FileName` = :trackUrl "
-                                                         "");
+        auto insertMusicSourceQueryText = QStringLiteral("INSERT OR IGNORE INTO `DiscoverSource` (`ID`, `Name`) "
+                                                         "VALUES (:discoverId, :name)");
 
-        auto result = prepareQuery(d->mSelectTrackFromIdAndUrlQuery, selectTrackFromIdAndUrlQueryText);
+        auto result = prepareQuery(d->mInsertMusicSource, insertMusicSourceQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdAndUrlQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackFromIdAndUrlQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertMusicSource.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertMusicSource.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectRadioFromIdQueryText = QStringLiteral("SELECT "
-                                                  "radios.`ID`, "
-                                                  "radios.`Title`, "
-                                                  "radios.`HttpAddress`, "
-                                                  "radios.`ImageAddress`, "
-                                                  "radios.`Rating`, "
-                                                  "trackGenre.`Name`, "
-                                                  "radios.`Comment` "
-                                                  "FROM "
-                                                  "`Radios` radios "
-                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = radios.`Genre` "
-                                                  "WHERE "
-                                                  "radios.`ID` = :radioId "
-                                                  "");
+        auto selectMusicSourceQueryText = QStringLiteral("SELECT `ID` FROM `DiscoverSource` WHERE `Name` = :name");
 
-        auto result = prepareQuery(d->mSelectRadioFromIdQuery, selectRadioFromIdQueryText);
+        auto result = prepareQuery(d->mSelectMusicSource, selectMusicSourceQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectRadioFromIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectRadioFromIdQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectMusicSource.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectMusicSource.lastError();
 
             Q_EMIT databaseError();
         }
     }
+
     {
-        auto selectCountAlbumsQueryText = QStringLiteral("SELECT count(*) "
-                                                         "FROM `Albums` album "
-                                                         "WHERE album.`ArtistName` = :artistName ");
+        auto selectTrackQueryText = QStringLiteral("SELECT "
+                                                   "tracks.`ID`,  (trackDirectory.`Path` || tracksMapping.`BaseName`) "
+                                                   "FROM "
+                                                   "`Tracks` tracks, "
+                                                   "`Albums` album, "
+                                                   "`TracksData` tracksMapping "
+                                                   "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = tracksMapping.`DirectoryID` "
+                                                   "WHERE "
+                                                   "tracks.`Title` = :title AND "
+                                                   "album.`ID` = :album AND "
+                                                   "tracks.`AlbumID` = album.`ID` AND "
+                                                   "tracks.`ArtistName` = :artist AND "
+                                                   "tracksMapping.`ID` = tracks.`FileID` AND "
+                                                   "tracks.`Priority` = ("
+                                                   "     SELECT "
+                                                   "     MIN(`Priority`) "
+                                                   "     FROM "
+                                                   "     `Tracks` tracks2 "
+                                                   "     WHERE "
+                                                   "     tracks.`Title` = tracks2.`Title` AND "
+                                                   "     (tracks.`ArtistID` IS NULL OR tracks.`ArtistID` = tracks2.`ArtistID`) AND "
+                                                   "     (tracks.`AlbumID` IS NULL OR tracks.`AlbumID` = tracks2.`AlbumID`)"
+                                                   ")"
+                                                   "");
 
-        const auto result = prepareQuery(d->mSelectCountAlbumsForArtistQuery, selectCountAlbumsQueryText);
+        auto result = prepareQuery(d->mSelectTrackIdFromTitleAlbumIdArtistQuery, selectTrackQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForArtistQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumIdArtistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumIdArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectGenreForArtistQueryText = QStringLiteral("SELECT DISTINCT trackGenre.`Name` "
-                                                            "FROM "
-                                                            "`Tracks` tracks "
-                                                            "LEFT JOIN "
-                                                            "`Albums` album "
-                                                            "ON "
-                                                            "tracks.`AlbumTitle` = album.`Title` AND "
-                                                            "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                            "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                            "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                            "WHERE "
-                                                            "album.`ArtistName` = :artistName");
+        auto insertTrackQueryText = QStringLiteral("INSERT INTO `Tracks` "
+                                                   "("
+                                                   "`ID`, "
+                                                   "`FileID`, "
+                                                   "`Priority`, "
+                                                   "`Title`, "
+                                                   "`ArtistName`, "
+                                                   "`AlbumTitle`, "
+                                                   "`AlbumArtistName`, "
+                                                   "`AlbumPath`, "
+                                                   "`Comment`, "
+                                                   "`TrackNumber`, "
+                                                   "`DiscNumber`, "
+                                                   "`Channels`, "
+                                                   "`BitRate`, "
+                                                   "`SampleRate`, "
+                                                   "`Year`,  "
+                                                   "`Duration`, "
+                                                   "`Rating`, "
+                                                   "`HasEmbeddedCover`, "
+                                                   "`ArtistID`, "
+                                                   "`AlbumID`, "
+                                                   "`GenreID`, "
+                                                   "`ComposerID`, "
+                                                   "`LyricistID`) "
+                                                   "VALUES "
+                                                   "("
+                                                   ":trackId, "
+                                                   "(SELECT trackData.`ID` "
+                                                   "FROM `TracksData` trackData, `Directories` trackDirectory "
+                                                   "WHERE trackDirectory.`Path` = :directory AND "
+                                                   "trackData.`DirectoryID` = trackDirectory.`ID` AND "
+                                                   "trackData.`BaseName` = :baseName), "
+                                                   ":priority, "
+                                                   ":title, "
+                                                   ":artistName, "
+                                                   ":albumTitle, "
+                                                   ":albumArtistName, "
+                                                   ":albumPath, "
+                                                   ":comment, "
+                                                   ":trackNumber, "
+                                                   ":discNumber, "
+                                                   ":channels, "
+                                                   ":bitRate, "
+                                                   ":sampleRate, "
+                                                   ":year, "
+                                                   ":trackDuration, "
+                                                   ":trackRating, "
+                                                   ":hasEmbeddedCover, "
+                                                   ":artistId, "
+                                                   ":albumId, "
+                                                   ":genreId, "
+                                                   ":composerId, "
+                                                   ":lyricistId)");
 
-        const auto result = prepareQuery(d->mSelectGenreForArtistQuery, selectGenreForArtistQueryText);
+        auto result = prepareQuery(d->mInsertTrackQuery, insertTrackQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForArtistQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectGenreForAlbumQueryText = QStringLiteral("SELECT DISTINCT trackGenre.`Name` "
-                                                           "FROM "
-                                                           "`Tracks` tracks "
-                                                           "LEFT JOIN "
-                                                           "`Albums` album "
-                                                           "ON "
-                                                           "tracks.`AlbumTitle` = album.`Title` AND "
-                                                           "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                           "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                           "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                           "WHERE "
-                                                           "album.`ID` = :albumId");
+        auto updateTrackQueryText = QStringLiteral("UPDATE `Tracks` "
+                                                   "SET "
+                                                   "`FileID` = ("
+                                                   "SELECT trackData.`ID` "
+                                                   "FROM `TracksData` trackData, `Directories` trackDirectory "
+                                                   "WHERE trackDirectory.`Path` = :directory AND "
+                                                   "trackData.`DirectoryID` = trackDirectory.`ID` AND "
+                                                   "trackData.`BaseName` = :baseName), "
+                                                   "`Title` = :title, "
+                                                   "`ArtistName` = :artistName, "
+                                                   "`AlbumTitle` = :albumTitle, "
+                                                   "`AlbumArtistName` = :albumArtistName, "
+                                                   "`AlbumPath` = :albumPath, "
+                                                   "`Comment` = :comment, "
+                                                   "`TrackNumber` = :trackNumber, "
+                                                   "`DiscNumber` = :discNumber, "
+                                                   "`Channels` = :channels, "
+                                                   "`BitRate` = :bitRate, "
+                                                   "`SampleRate` = :sampleRate, "
+                                                   "`Year` = :year, "
+                                                   " `Duration` = :trackDuration, "
+                                                   "`Rating` = :trackRating, "
+                                                   "`ArtistID` = :artistId, "
+                                                   "`AlbumID` = :albumId, "
+                                                   "`GenreID` = :genreId, "
+                                                   "`ComposerID` = :composerId, "
+                                                   "`LyricistID` = :lyricistId "
+                                                   "WHERE "
+                                                   "`ID` = :trackId");
 
-        const auto result = prepareQuery(d->mSelectGenreForAlbumQuery, selectGenreForAlbumQueryText);
+        auto result = prepareQuery(d->mUpdateTrackQuery, updateTrackQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForAlbumQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreForAlbumQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectCountAlbumsQueryText = QStringLiteral("SELECT distinct count(album.`ID`) "
-                                                         "FROM "
-                                                         "`Tracks` tracks, "
-                                                         "`Albums` album "
-                                                         "LEFT JOIN `Composer` albumComposer ON albumComposer.`Name` = tracks.`Composer` "
-                                                         "WHERE "
-                                                         "(tracks.`AlbumTitle` = album.`Title` OR tracks.`AlbumTitle` IS NULL ) AND "
-                                                         "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                         "(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND "
-                                                         "albumComposer.`Name` = :artistName");
+        auto insertRadioQueryText = QStringLiteral("INSERT INTO `Radios` "
+                                                   "("
+                                                   "`Title`, "
+                                                   "`httpAddress`, "
+                                                   "`Comment`, "
+                                                   "`Rating`, "
+                                                   "`ImageAddress`) "
+                                                   "VALUES "
+                                                   "("
+                                                   ":title, "
+                                                   ":httpAddress, "
+                                                   ":comment, "
+                                                   ":trackRating,"
+                                                   ":imageAddress)");
+
+        auto result = prepareQuery(d->mInsertRadioQuery, insertRadioQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertRadioQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertRadioQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto deleteRadioQueryText = QStringLiteral("DELETE FROM `Radios` "
+                                                   "WHERE `ID` = :radioId");
+
+        auto result = prepareQuery(d->mDeleteRadioQuery, deleteRadioQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mDeleteRadioQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mDeleteRadioQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
 
-        const auto result = prepareQuery(d->mSelectCountAlbumsForComposerQuery, selectCountAlbumsQueryText);
+    {
+        auto updateRadioQueryText = QStringLiteral("UPDATE `Radios` "
+                                                   "SET "
+                                                   "`HttpAddress` = :httpAddress, "
+                                                   "`Title` = :title, "
+                                                   "`Comment` = :comment, "
+                                                   "`Rating` = :trackRating, "
+                                                   "`ImageAddress` = :imageAddress "
+                                                   "WHERE "
+                                                   "`ID` = :radioId");
+
+        auto result = prepareQuery(d->mUpdateRadioQuery, updateRadioQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForComposerQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForComposerQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateRadioQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateRadioQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectCountAlbumsQueryText = QStringLiteral("SELECT distinct count(album.`ID`) "
-                                                         "FROM "
-                                                         "`Tracks` tracks, "
-                                                         "`Albums` album "
-                                                         "LEFT JOIN `Lyricist` albumLyricist ON albumLyricist.`Name` = tracks.`Lyricist` "
+        auto updateAlbumArtistQueryText = QStringLiteral("UPDATE `Albums` "
+                                                         "SET "
+                                                         "`ArtistName` = :artistName "
                                                          "WHERE "
-                                                         "(tracks.`AlbumTitle` = album.`Title` OR tracks.`AlbumTitle` IS NULL ) AND "
-                                                         "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                         "(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND "
-                                                         "albumLyricist.`Name` = :artistName");
+                                                         "`ID` = :albumId");
 
-        const auto result = prepareQuery(d->mSelectCountAlbumsForLyricistQuery, selectCountAlbumsQueryText);
+        auto result = prepareQuery(d->mUpdateAlbumArtistQuery, updateAlbumArtistQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForLyricistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCountAlbumsForLyricistQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectAlbumIdFromTitleQueryText = QStringLiteral("SELECT "
-                                                              "album.`ID` "
-                                                              "FROM "
-                                                              "`Albums` album "
-                                                              "WHERE "
-                                                              "album.`ArtistName` = :artistName AND "
-                                                              "album.`Title` = :title");
+        auto updateAlbumArtistInTracksQueryText = QStringLiteral("UPDATE `Tracks` "
+                                                                 "SET "
+                                                                 "`AlbumArtistName` = :artistName "
+                                                                 "WHERE "
+                                                                 "`AlbumID` = :albumId AND "
+                                                                 "`AlbumArtistName` IS NULL");
 
-        auto result = prepareQuery(d->mSelectAlbumIdFromTitleQuery, selectAlbumIdFromTitleQueryText);
+        auto result = prepareQuery(d->mUpdateAlbumArtistInTracksQuery, updateAlbumArtistInTracksQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistInTracksQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistInTracksQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectAlbumIdFromTitleAndArtistQueryText = QStringLiteral("SELECT "
-                                                                       "album.`ID` "
-                                                                       "FROM "
-                                                                       "`Albums` album "
-                                                                       "WHERE "
-                                                                       "(album.`ArtistName` = :artistName OR :artistName IS NULL OR album.`ArtistName` IS NULL) AND "
-                                                                       "album.`Title` = :title AND "
-                                                                       "album.`AlbumPath` = :albumPath");
+        auto queryMaximumTrackIdQueryText = QStringLiteral("SELECT MAX(tracks.`ID`)"
+                                                           "FROM "
+                                                           "`Tracks` tracks");
 
-        auto result = prepareQuery(d->mSelectAlbumIdFromTitleAndArtistQuery, selectAlbumIdFromTitleAndArtistQueryText);
+        auto result = prepareQuery(d->mQueryMaximumTrackIdQuery, queryMaximumTrackIdQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleAndArtistQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumTrackIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumTrackIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectAlbumIdFromTitleWithoutArtistQueryText = QStringLiteral("SELECT "
-                                                                           "album.`ID` "
-                                                                           "FROM "
-                                                                           "`Albums` album "
-                                                                           "WHERE "
-                                                                           "album.`AlbumPath` = :albumPath AND "
-                                                                           "album.`Title` = :title AND "
-                                                                           "album.`ArtistName` IS NULL");
+        auto queryMaximumAlbumIdQueryText = QStringLiteral("SELECT MAX(albums.`ID`)"
+                                                           "FROM "
+                                                           "`Albums` albums");
 
-        auto result = prepareQuery(d->mSelectAlbumIdFromTitleWithoutArtistQuery, selectAlbumIdFromTitleWithoutArtistQueryText);
+        auto result = prepareQuery(d->mQueryMaximumAlbumIdQuery, queryMaximumAlbumIdQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdFromTitleWithoutArtistQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumAlbumIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumAlbumIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto insertAlbumQueryText = QStringLiteral("INSERT INTO `Albums` "
-                                                   "(`ID`, "
-                                                   "`Title`, "
-                                                   "`ArtistName`, "
-                                                   "`AlbumPath`, "
-                                                   "`CoverFileName`) "
-                                                   "VALUES "
-                                                   "(:albumId, "
-                                                   ":title, "
-                                                   ":albumArtist, "
-                                                   ":albumPath, "
-                                                   ":coverFileName)");
+        auto queryMaximumArtistIdQueryText = QStringLiteral("SELECT MAX(artists.`ID`)"
+                                                            "FROM "
+                                                            "`Artists` artists");
 
-        auto result = prepareQuery(d->mInsertAlbumQuery, insertAlbumQueryText);
+        auto result = prepareQuery(d->mQueryMaximumArtistIdQuery, queryMaximumArtistIdQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertAlbumQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertAlbumQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumArtistIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumArtistIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto insertTrackMappingQueryText = QStringLiteral("INSERT INTO "
-                                                          "`TracksData` "
-                                                          "(`FileName`, "
-                                                          "`FileModifiedTime`, "
-                                                          "`ImportDate`, "
-                                                          "`PlayCounter`) "
-                                                          "VALUES (:fileName, :mtime, :importDate, 0)");
+        auto queryMaximumLyricistIdQueryText = QStringLiteral("SELECT MAX(lyricists.`ID`)"
+                                                              "FROM "
+                                                              "`Lyricist` lyricists");
 
-        auto result = prepareQuery(d->mInsertTrackMapping, insertTrackMappingQueryText);
+        auto result = prepareQuery(d->mQueryMaximumLyricistIdQuery, queryMaximumLyricistIdQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackMapping.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackMapping.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumLyricistIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumLyricistIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto initialUpdateTracksValidityQueryText = QStringLiteral("UPDATE `TracksData` "
-                                                                   "SET "
-                                                                   "`FileModifiedTime` = :mtime "
-                                                                   "WHERE `FileName` = :fileName");
+        auto queryMaximumComposerIdQueryText = QStringLiteral("SELECT MAX(composers.`ID`)"
+                                                              "FROM "
+                                                              "`Composer` composers");
 
-        auto result = prepareQuery(d->mUpdateTrackFileModifiedTime, initialUpdateTracksValidityQueryText);
+        auto result = prepareQuery(d->mQueryMaximumComposerIdQuery, queryMaximumComposerIdQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFileModifiedTime.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFileModifiedTime.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumComposerIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumComposerIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto initialUpdateTracksValidityQueryText = QStringLiteral("UPDATE `Tracks` "
-                                                                   "SET "
-                                                                   "`Priority` = :priority "
-                                                                   "WHERE `FileName` = :fileName");
+        auto queryMaximumGenreIdQueryText = QStringLiteral("SELECT MAX(genres.`ID`)"
+                                                           "FROM "
+                                                           "`Genre` genres");
 
-        auto result = prepareQuery(d->mUpdateTrackPriority, initialUpdateTracksValidityQueryText);
+        auto result = prepareQuery(d->mQueryMaximumGenreIdQuery, queryMaximumGenreIdQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackPriority.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackPriority.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumGenreIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumGenreIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto removeTracksMappingFromSourceQueryText = QStringLiteral("DELETE FROM `TracksData` "
-                                                                     "WHERE `FileName` = :fileName");
+        auto selectTrackQueryText = QStringLiteral("SELECT "
+                                                   "tracks.ID "
+                                                   "FROM "
+                                                   "`Tracks` tracks "
+                                                   "WHERE "
+                                                   "tracks.`Title` = :title AND "
+                                                   "(tracks.`AlbumTitle` = :album OR (:album IS NULL AND tracks.`AlbumTitle` IS NULL)) AND "
+                                                   "(tracks.`TrackNumber` = :trackNumber OR (:trackNumber IS NULL AND tracks.`TrackNumber` IS NULL)) AND "
+                                                   "(tracks.`DiscNumber` = :discNumber OR (:discNumber IS NULL AND tracks.`DiscNumber` IS NULL)) AND "
+                                                   "tracks.`ArtistName` = :artist");
 
-        auto result = prepareQuery(d->mRemoveTracksMappingFromSource, removeTracksMappingFromSourceQueryText);
+        auto result = prepareQuery(d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery, selectTrackQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMappingFromSource.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMappingFromSource.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto removeTracksMappingQueryText = QStringLiteral("DELETE FROM `TracksData` "
-                                                           "WHERE `FileName` = :fileName");
+        auto selectTrackQueryText = QStringLiteral("SELECT "
+                                                   "tracks.ID "
+                                                   "FROM "
+                                                   "`Tracks` tracks, "
+                                                   "`Albums` albums "
+                                                   "WHERE "
+                                                   "tracks.`Title` = :title AND "
+                                                   "tracks.`Priority` = :priority AND "
+                                                   "(tracks.`ArtistName` = :trackArtist OR tracks.`ArtistName` IS NULL) AND "
+                                                   "(tracks.`AlbumTitle` = :album OR tracks.`AlbumTitle` IS NULL) AND "
+                                                   "(tracks.`AlbumArtistName` = :albumArtist OR tracks.`AlbumArtistName` IS NULL) AND "
+                                                   "(tracks.`AlbumPath` = :albumPath OR tracks.`AlbumPath` IS NULL) AND "
+                                                   "(tracks.`TrackNumber` = :trackNumber OR tracks.`TrackNumber` IS NULL) AND "
+                                                   "(tracks.`DiscNumber` = :discNumber OR tracks.`DiscNumber` IS NULL) "
+                                                   "");
 
-        auto result = prepareQuery(d->mRemoveTracksMapping, removeTracksMappingQueryText);
+        auto result = prepareQuery(d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery, selectTrackQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMapping.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTracksMapping.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTracksWithoutMappingQueryText = QStringLiteral("SELECT "
-                                                                  "tracks.`Id`, "
-                                                                  "tracks.`Title`, "
-                                                                  "album.`ID`, "
-                                                                  "tracks.`ArtistName`, "
-                                                                  "( "
-                                                                  "SELECT "
-                                                                  "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                                  "FROM "
-                                                                  "`Tracks` tracksFromAlbum1 "
-                                                                  "WHERE "
-                                                                  "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                                  "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                                  "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                                  "album.`ArtistName` IS NULL "
-                                                                  ") "
-                                                                  ") AND "
-                                                                  "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                                  ") AS ArtistsCount, "
-                                                                  "( "
-                                                                  "SELECT "
-                                                                  "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
-                                                                  "FROM "
-                                                                  "`Tracks` tracksFromAlbum2 "
-                                                                  "WHERE "
-                                                                  "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                                  "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                                  "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                                  "album.`ArtistName` IS NULL "
-                                                                  ") "
-                                                                  ") AND "
-                                                                  "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
-                                                                  ") AS AllArtists, "
-                                                                  "tracks.`AlbumArtistName`, "
-                                                                  "\"\" as FileName, "
-                                                                  "NULL as FileModifiedTime, "
-                                                                  "tracks.`TrackNumber`, "
-                                                                  "tracks.`DiscNumber`, "
-                                                                  "tracks.`Duration`, "
-                                                                  "tracks.`AlbumTitle`, "
-                                                                  "tracks.`Rating`, "
-                                                                  "album.`CoverFileName`, "
-                                                                  "("
-                                                                  "SELECT "
-                                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                                  "FROM "
-                                                                  "`Tracks` tracks2 "
-                                                                  "WHERE "
-                                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                                  "album.`ArtistName` IS NULL"
-                                                                  ")"
-                                                                  ") AND "
-                                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                                  ") as `IsSingleDiscAlbum`, "
-                                                                  "trackGenre.`Name`, "
-                                                                  "trackComposer.`Name`, "
-                                                                  "trackLyricist.`Name`, "
-                                                                  "tracks.`Comment`, "
-                                                                  "tracks.`Year`, "
-                                                                  "tracks.`Channels`, "
-                                                                  "tracks.`BitRate`, "
-                                                                  "tracks.`SampleRate`, "
-                                                                  "tracks.`HasEmbeddedCover`, "
-                                                                  "tracksMapping.`ImportDate`, "
-                                                                  "tracksMapping.`FirstPlayDate`, "
-                                                                  "tracksMapping.`LastPlayDate`, "
-                                                                  "tracksMapping.`PlayCounter`, "
-                                                                  "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
-                                                                  "( "
-                                                                  "SELECT tracksCover.`FileName` "
-                                                                  "FROM "
-                                                                  "`Tracks` tracksCover "
-                                                                  "WHERE "
-                                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                                  "album.`ArtistName` IS NULL "
-                                                                  ") "
-                                                                  ") AND "
-                                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                                  ") as EmbeddedCover "
-                                                                  "FROM "
-                                                                  "`Tracks` tracks, "
-                                                                  "`TracksData` tracksMapping "
-                                                                  "LEFT JOIN "
-                                                                  "`Albums` album "
-                                                                  "ON "
-                                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                                  "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
-                                                                  "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                                  "WHERE "
-                                                                  "tracks.`FileName` = tracksMapping.`FileName` AND "
-                                                                  "tracks.`FileName` NOT IN (SELECT tracksMapping2.`FileName` FROM `TracksData` tracksMapping2)");
+        auto selectAlbumArtUriFromAlbumIdQueryText = QStringLiteral("SELECT `CoverFileName`"
+                                                                    "FROM "
+                                                                    "`Albums` "
+                                                                    "WHERE "
+                                                                    "`ID` = :albumId");
 
-        auto result = prepareQuery(d->mSelectTracksWithoutMappingQuery, selectTracksWithoutMappingQueryText);
+        auto result = prepareQuery(d->mSelectAlbumArtUriFromAlbumIdQuery, selectAlbumArtUriFromAlbumIdQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksWithoutMappingQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksWithoutMappingQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTracksMappingQueryText = QStringLiteral("SELECT "
-                                                           "track.`ID`, "
-                                                           "trackData.`FileName`, "
-                                                           "track.`Priority`, "
-                                                           "trackData.`FileModifiedTime` "
-                                                           "FROM "
-                                                           "`TracksData` trackData "
-                                                           "LEFT JOIN "
-                                                           "`Tracks` track "
-                                                           "ON "
-                                                           "track.`FileName` = trackData.`FileName` "
-                                                           "WHERE "
-                                                           "trackData.`FileName` = :fileName");
+        auto updateAlbumArtUriFromAlbumIdQueryText = QStringLiteral("UPDATE `Albums` "
+                                                                    "SET `CoverFileName` = :coverFileName "
+                                                                    "WHERE "
+                                                                    "`ID` = :albumId");
 
-        auto result = prepareQuery(d->mSelectTracksMapping, selectTracksMappingQueryText);
+        auto result = prepareQuery(d->mUpdateAlbumArtUriFromAlbumIdQuery, updateAlbumArtUriFromAlbumIdQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMapping.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMapping.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectRadioIdFromHttpAddress = QStringLiteral("SELECT "
-                                                           "`ID` "
-                                                           "FROM "
-                                                           "`Radios` "
-                                                           "WHERE "
-                                                           "`HttpAddress` = :httpAddress");
+        auto selectTracksFromArtistQueryText = QStringLiteral("SELECT "
+                                                              "tracks.`ID`, "
+                                                              "tracks.`Title`, "
+                                                              "album.`ID`, "
+                                                              "tracks.`ArtistName`, "
+                                                              "( "
+                                                              "SELECT "
+                                                              "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                              "FROM "
+                                                              "`Tracks` tracksFromAlbum1 "
+                                                              "WHERE "
+                                                              "tracksFromAlbum1.`AlbumID` = album.`ID` "
+                                                              ") AS ArtistsCount, "
+                                                              "( "
+                                                              "SELECT "
+                                                              "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                              "FROM "
+                                                              "`Tracks` tracksFromAlbum2 "
+                                                              "WHERE "
+                                                              "tracksFromAlbum2.`AlbumID` = album.`ID` "
+                                                              ") AS AllArtists, "
+                                                              "tracks.`AlbumArtistName`, "
+                                                              "(trackDirectory.`Path` || tracksMapping.`BaseName`) AS FileName, "
+                                                              "tracksMapping.`FileModifiedTime`, "
+                                                              "tracks.`TrackNumber`, "
+                                                              "tracks.`DiscNumber`, "
+                                                              "tracks.`Duration`, "
+                                                              "tracks.`AlbumTitle`, "
+                                                              "tracks.`Rating`, "
+                                                              "album.`CoverFileName`, "
+                                                              "("
+                                                              "SELECT "
+                                                              "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                              "FROM "
+                                                              "`Tracks` tracks2 "
+                                                              "WHERE "
+                                                              "tracks2.`AlbumID` = album.`ID` "
+                                                              ") as `IsSingleDiscAlbum`, "
+                                                              "trackGenre.`Name`, "
+                                                              "trackComposer.`Name`, "
+                                                              "trackLyricist.`Name`, "
+                                                              "tracks.`Comment`, "
+                                                              "tracks.`Year`, "
+                                                              "tracks.`Channels`, "
+                                                              "tracks.`BitRate`, "
+                                                              "tracks.`SampleRate`, "
+                                                              "tracks.`HasEmbeddedCover`, "
+                                                              "tracksMapping.`ImportDate`, "
+                                                              "tracksMapping.`FirstPlayDate`, "
+                                                              "tracksMapping.`LastPlayDate`, "
+                                                              "tracksMapping.`PlayCounter`, "
+                                                              "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                              "( "
+                                                              "SELECT ("
+                                                              "SELECT coverDirectory.`Path` || coverData.`BaseName` "
+                                                              "FROM "
+                                                              "`TracksData` coverData, "
+                                                              "`Directories` coverDirectory "
+                                                              "WHERE "
+                                                              "coverData.`ID` = tracksCover.`FileID` AND "
+                                                              "coverDirectory.`ID` = coverData.`DirectoryID`"
+                                                              ") "
+                                                              "FROM "
+                                                              "`Tracks` tracksCover "
+                                                              "WHERE "
+                                                              "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                              "tracksCover.`AlbumID` = album.`ID` "
+                                                              ") as EmbeddedCover "
+                                                              "FROM "
+                                                              "`Tracks` tracks, "
+                                                              "`TracksData` tracksMapping "
+                                                              "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = tracksMapping.`DirectoryID` "
+                                                              "LEFT JOIN "
+                                                              "`Albums` album "
+                                                              "ON "
+                                                              "tracks.`AlbumID` = album.`ID` "
+                                                              "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                                                              "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID` "
+                                                              "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                              "WHERE "
+                                                              "tracks.`ArtistID` = (SELECT artist.`ID` FROM `Artists` artist WHERE artist.`Name` = :artistName) AND "
+                                                              "tracksMapping.`ID` = tracks.`FileID` AND "
+                                                              "tracks.`Priority` = ("
+                                                              "     SELECT "
+                                                              "     MIN(`Priority`) "
+                                                              "     FROM "
+                                                              "     `Tracks` tracks2 "
+                                                              "     WHERE "
+                                                              "     tracks.`Title` = tracks2.`Title` AND "
+                                                              "     (tracks.`ArtistID` IS NULL OR tracks.`ArtistID` = tracks2.`ArtistID`) AND "
+                                                              "     (tracks.`AlbumID` IS NULL OR tracks.`AlbumID` = tracks2.`AlbumID`)"
+                                                              ")"
+                                                              "ORDER BY "
+                                                              "album.`Title` ASC, "
+                                                              "tracks.`DiscNumber` ASC, "
+                                                              "tracks.`TrackNumber` ASC, "
+                                                              "tracks.`Title` ASC"
+                                                              "");
 
-        auto result = prepareQuery(d->mSelectRadioIdFromHttpAddress, selectRadioIdFromHttpAddress);
+        auto result = prepareQuery(d->mSelectTracksFromArtist, selectTracksFromArtistQueryText);
 
         if (!result) {
-            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectRadioIdFromHttpAddress.lastQuery();
-            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectRadioIdFromHttpAddress.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromArtist.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromArtist.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTracksMappingPriorityQueryText = QStringLiteral("SELECT "
-                                                                   "max(tracks.`Priority`) AS Priority "
-                                                                   "FROM "
-                                                                   "`Tracks` tracks, "
-                                                                   "`Albums` albums "
-                                                                   "WHERE "
-                                                                   "tracks.`Title` = :title AND "
-                                                                   "(tracks.`ArtistName` = :trackArtist OR tracks.`ArtistName` IS NULL) AND "
-                                                                   "(tracks.`AlbumTitle` = :album OR tracks.`AlbumTitle` IS NULL) AND "
-                                                                   "(tracks.`AlbumArtistName` = :albumArtist OR tracks.`AlbumArtistName` IS NULL) AND "
-                                                                   "(tracks.`AlbumPath` = :albumPath OR tracks.`AlbumPath` IS NULL)");
+        auto selectTracksFromGenreQueryText = QStringLiteral("SELECT "
+                                                             "tracks.`ID`, "
+                                                             "tracks.`Title`, "
+                                                             "album.`ID`, "
+                                                             "tracks.`ArtistName`, "
+                                                             "( "
+                                                             "SELECT "
+                                                             "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                             "FROM "
+                                                             "`Tracks` tracksFromAlbum1 "
+                                                             "WHERE "
+                                                             "tracksFromAlbum1.`AlbumID` = album.`ID` "
+                                                             ") AS ArtistsCount, "
+                                                             "( "
+                                                             "SELECT "
+                                                             "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                             "FROM "
+                                                             "`Tracks` tracksFromAlbum2 "
+                                                             "WHERE "
+                                                             "tracksFromAlbum2.`AlbumID` = album.`ID` "
+                                                             ") AS AllArtists, "
+                                                             "tracks.`AlbumArtistName`, "
+                                                             "(trackDirectory.`Path` || tracksMapping.`BaseName`) AS FileName, "
+                                                             "tracksMapping.`FileModifiedTime`, "
+                                                             "tracks.`TrackNumber`, "
+                                                             "tracks.`DiscNumber`, "
+                                                             "tracks.`Duration`, "
+                                                             "tracks.`AlbumTitle`, "
+                                                             "tracks.`Rating`, "
+                                                             "album.`CoverFileName`, "
+                                                             "("
+                                                             "SELECT "
+                                                             "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                             "FROM "
+                                                             "`Tracks` tracks2 "
+                                                             "WHERE "
+                                                             "tracks2.`AlbumID` = album.`ID` "
+                                                             ") as `IsSingleDiscAlbum`, "
+                                                             "trackGenre.`Name`, "
+                                                             "trackComposer.`Name`, "
+                                                             "trackLyricist.`Name`, "
+                                                             "tracks.`Comment`, "
+                                                             "tracks.`Year`, "
+                                                             "tracks.`Channels`, "
+                                                             "tracks.`BitRate`, "
+                                                             "tracks.`SampleRate`, "
+                                                             "tracks.`HasEmbeddedCover`, "
+                                                             "tracksMapping.`ImportDate`, "
+                                                             "tracksMapping.`FirstPlayDate`, "
+                                                             "tracksMapping.`LastPlayDate`, "
+                                                             "tracksMapping.`PlayCounter`, "
+                                                             "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                             "( "
+                                                             "SELECT ("
+                                                             "SELECT coverDirectory.`Path` || coverData.`BaseName` "
+                                                             "FROM "
+                                                             "`TracksData` coverData, "
+                                                             "`Directories` coverDirectory "
+                                                             "WHERE "
+                                                             "coverData.`ID` = tracksCover.`FileID` AND "
+                                                             "coverDirectory.`ID` = coverData.`DirectoryID`"
+                                                             ") "
+                                                             "FROM "
+                                                             "`Tracks` tracksCover "
+                                                             "WHERE "
+                                                             "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                             "tracksCover.`AlbumID` = album.`ID` "
+                                                             ") as EmbeddedCover "
+                                                             "FROM "
+                                                             "`Tracks` tracks, "
+                                                             "`TracksData` tracksMapping "
+                                                             "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = tracksMapping.`DirectoryID` "
+                                                             "LEFT JOIN "
+                                                             "`Albums` album "
+                                                             "ON "
+                                                             "tracks.`AlbumID` = album.`ID` "
+                                                             "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                                                             "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID` "
+                                                             "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                             "WHERE "
+                                                             "tracks.`GenreID` = (SELECT genre.`ID` FROM `Genre` genre WHERE genre.`Name` = :genre) AND "
+                                                             "tracksMapping.`ID` = tracks.`FileID` AND "
+                                                             "tracks.`Priority` = ("
+                                                             "     SELECT "
+                                                             "     MIN(`Priority`) "
+                                                             "     FROM "
+                                                             "     `Tracks` tracks2 "
+                                                             "     WHERE "
+                                                             "     tracks.`Title` = tracks2.`Title` AND "
+                                                             "     (tracks.`ArtistID` IS NULL OR tracks.`ArtistID` = tracks2.`ArtistID`) AND "
+                                                             "     (tracks.`AlbumID` IS NULL OR tracks.`AlbumID` = tracks2.`AlbumID`)"
+                                                             ")"
+                                                             "ORDER BY "
+                                                             "album.`Title` ASC, "
+                                                             "tracks.`DiscNumber` ASC, "
+                                                             "tracks.`TrackNumber` ASC, "
+                                                             "tracks.`Title` ASC"
+                                                             "");
 
-        auto result = prepareQuery(d->mSelectTracksMappingPriority, selectTracksMappingPriorityQueryText);
+        auto result = prepareQuery(d->mSelectTracksFromGenre, selectTracksFromGenreQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriority.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriority.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromGenre.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromGenre.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTracksMappingPriorityQueryByTrackIdText = QStringLiteral("SELECT "
-                                                                            "MAX(track.`Priority`) "
-                                                                            "FROM "
-                                                                            "`TracksData` trackData, "
-                                                                            "`Tracks` track "
-                                                                            "WHERE "
-                                                                            "track.`ID` = :trackId AND "
-                                                                            "trackData.`FileName` = track.`FileName`");
+        auto selectAlbumIdsFromArtistQueryText = QStringLiteral("SELECT "
+                                                                "album.`ID` "
+                                                                "FROM "
+                                                                "`Albums` album "
+                                                                "WHERE "
+                                                                "album.`ArtistName` = :artistName");
 
-        auto result = prepareQuery(d->mSelectTracksMappingPriorityByTrackId, selectTracksMappingPriorityQueryByTrackIdText);
+        auto result = prepareQuery(d->mSelectAlbumIdsFromArtist, selectAlbumIdsFromArtistQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriorityByTrackId.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksMappingPriorityByTrackId.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdsFromArtist.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdsFromArtist.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectAllTrackFilesFromSourceQueryText = QStringLiteral("SELECT "
-                                                                     "tracksMapping.`FileName`, "
-                                                                     "tracksMapping.`FileModifiedTime` "
-                                                                     "FROM "
-                                                                     "`TracksData` tracksMapping");
+        auto selectArtistQueryText = QStringLiteral("SELECT `ID`, "
+                                                    "`Name` "
+                                                    "FROM `Artists` "
+                                                    "WHERE "
+                                                    "`ID` = :artistId");
 
-        auto result = prepareQuery(d->mSelectAllTrackFilesQuery, selectAllTrackFilesFromSourceQueryText);
+        auto result = prepareQuery(d->mSelectArtistQuery, selectArtistQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTrackFilesQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTrackFilesQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto updateTrackStatisticsQueryText = QStringLiteral("UPDATE `TracksData` "
+                                                             "SET "
+                                                             "`LastPlayDate` = :playDate, "
+                                                             "`PlayCounter` = `PlayCounter` + :playCount "
+                                                             "WHERE "
+                                                             "`DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :directory) AND "
+                                                             "`BaseName` = :baseName");
+
+        auto result = prepareQuery(d->mUpdateTrackStatistics, updateTrackStatisticsQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto insertMusicSourceQueryText = QStringLiteral("INSERT OR IGNORE INTO `DiscoverSource` (`ID`, `Name`) "
-                                                         "VALUES (:discoverId, :name)");
+        auto updateTrackFirstPlayStatisticsQueryText = QStringLiteral("UPDATE `TracksData` "
+                                                                      "SET "
+                                                                      "`FirstPlayDate` = :playDate "
+                                                                      "WHERE "
+                                                                      "`DirectoryID` = (SELECT `ID` FROM `Directories` WHERE `Path` = :directory) AND "
+                                                                      "`BaseName` = :baseName AND "
+                                                                      "`FirstPlayDate` IS NULL");
 
-        auto result = prepareQuery(d->mInsertMusicSource, insertMusicSourceQueryText);
+        auto result = prepareQuery(d->mUpdateTrackFirstPlayStatistics, updateTrackFirstPlayStatisticsQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertMusicSource.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertMusicSource.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectMusicSourceQueryText = QStringLiteral("SELECT `ID` FROM `DiscoverSource` WHERE `Name` = :name");
+        auto selectGenreQueryText = QStringLiteral("SELECT `ID`, "
+                                                   "`Name` "
+                                                   "FROM `Genre` "
+                                                   "WHERE "
+                                                   "`ID` = :genreId");
 
-        auto result = prepareQuery(d->mSelectMusicSource, selectMusicSourceQueryText);
+        auto result = prepareQuery(d->mSelectGenreQuery, selectGenreQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectMusicSource.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectMusicSource.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTrackQueryText = QStringLiteral("SELECT "
-                                                   "tracks.`ID`,  tracksMapping.`FileName` "
-                                                   "FROM "
-                                                   "`Tracks` tracks, "
-                                                   "`Albums` album, "
-                                                   "`TracksData` tracksMapping "
-                                                   "WHERE "
-                                                   "tracks.`Title` = :title AND "
-                                                   "album.`ID` = :album AND "
-                                                   "(tracks.`AlbumTitle` = album.`Title` OR tracks.`AlbumTitle` IS NULL ) AND "
-                                                   "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                   "(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND "
-                                                   "tracks.`ArtistName` = :artist AND "
-                                                   "tracksMapping.`FileName` = tracks.`FileName` AND "
-                                                   "tracks.`Priority` = ("
-                                                   "     SELECT "
-                                                   "     MIN(`Priority`) "
-                                                   "     FROM "
-                                                   "     `Tracks` tracks2 "
-                                                   "     WHERE "
-                                                   "     tracks.`Title` = tracks2.`Title` AND "
-                                                   "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
-                                                   "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
-                                                   "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
-                                                   "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
-                                                   ")"
-                                                   "");
+        auto selectComposerQueryText = QStringLiteral("SELECT `ID`, "
+                                                      "`Name` "
+                                                      "FROM `Composer` "
+                                                      "WHERE "
+                                                      "`ID` = :composerId");
 
-        auto result = prepareQuery(d->mSelectTrackIdFromTitleAlbumIdArtistQuery, selectTrackQueryText);
+        auto result = prepareQuery(d->mSelectComposerQuery, selectComposerQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumIdArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumIdArtistQuery.lastError();
-
-            Q_EMIT databaseError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastError();
         }
     }
 
     {
-        auto insertTrackQueryText = QStringLiteral("INSERT INTO `Tracks` "
-                                                   "("
-                                                   "`ID`, "
-                                                   "`FileName`, "
-                                                   "`Priority`, "
-                                                   "`Title`, "
-                                                   "`ArtistName`, "
-                                                   "`AlbumTitle`, "
-                                                   "`AlbumArtistName`, "
-                                                   "`AlbumPath`, "
-                                                   "`Genre`, "
-                                                   "`Composer`, "
-                                                   "`Lyricist`, "
-                                                   "`Comment`, "
-                                                   "`TrackNumber`, "
-                                                   "`DiscNumber`, "
-                                                   "`Channels`, "
-                                                   "`BitRate`, "
-                                                   "`SampleRate`, "
-                                                   "`Year`,  "
-                                                   "`Duration`, "
-                                                   "`Rating`, "
-                                                   "`HasEmbeddedCover`) "
-                                                   "VALUES "
-                                                   "("
-                                                   ":trackId, "
-                                                   ":fileName, "
-                                                   ":priority, "
-                                                   ":title, "
-                                                   ":artistName, "
-                                                   ":albumTitle, "
-                                                   ":albumArtistName, "
-                                                   ":albumPath, "
-                                                   ":genre, "
-                                                   ":composer, "
-                                                   ":lyricist, "
-                                                   ":comment, "
-                                                   ":trackNumber, "
-                                                   ":discNumber, "
-                                                   ":channels, "
-                                                   ":bitRate, "
-                                                   ":sampleRate, "
-                                                   ":year, "
-                                                   ":trackDuration, "
-                                                   ":trackRating, "
-                                                   ":hasEmbeddedCover)");
+        auto selectLyricistQueryText = QStringLiteral("SELECT `ID`, "
+                                                      "`Name` "
+                                                      "FROM `Lyricist` "
+                                                      "WHERE "
+                                                      "`ID` = :lyricistId");
 
-        auto result = prepareQuery(d->mInsertTrackQuery, insertTrackQueryText);
+        auto result = prepareQuery(d->mSelectLyricistQuery, selectLyricistQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackQuery.lastError();
-
-            Q_EMIT databaseError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastError();
         }
     }
 
     {
-        auto updateTrackQueryText = QStringLiteral("UPDATE `Tracks` "
-                                                   "SET "
-                                                   "`FileName` = :fileName, "
-                                                   "`Title` = :title, "
-                                                   "`ArtistName` = :artistName, "
-                                                   "`AlbumTitle` = :albumTitle, "
-                                                   "`AlbumArtistName` = :albumArtistName, "
-                                                   "`AlbumPath` = :albumPath, "
-                                                   "`Genre` = :genre, "
-                                                   "`Composer` = :composer, "
-                                                   "`Lyricist` = :lyricist, "
-                                                   "`Comment` = :comment, "
-                                                   "`TrackNumber` = :trackNumber, "
-                                                   "`DiscNumber` = :discNumber, "
-                                                   "`Channels` = :channels, "
-                                                   "`BitRate` = :bitRate, "
-                                                   "`SampleRate` = :sampleRate, "
-                                                   "`Year` = :year, "
-                                                   " `Duration` = :trackDuration, "
-                                                   "`Rating` = :trackRating "
+        auto removeTrackQueryText = QStringLiteral("DELETE FROM `Tracks` "
                                                    "WHERE "
                                                    "`ID` = :trackId");
 
-        auto result = prepareQuery(d->mUpdateTrackQuery, updateTrackQueryText);
+        auto result = prepareQuery(d->mRemoveTrackQuery, removeTrackQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto insertRadioQueryText = QStringLiteral("INSERT INTO `Radios` "
-                                                   "("
-                                                   "`Title`, "
-                                                   "`httpAddress`, "
-                                                   "`Comment`, "
-                                                   "`Rating`, "
-                                                   "`ImageAddress`) "
-                                                   "VALUES "
-                                                   "("
-                                                   ":title, "
-                                                   ":httpAddress, "
-                                                   ":comment, "
-                                                   ":trackRating,"
-                                                   ":imageAddress)");
+        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Albums` "
+                                                   "WHERE "
+                                                   "`ID` = :albumId");
 
-        auto result = prepareQuery(d->mInsertRadioQuery, insertRadioQueryText);
+        auto result = prepareQuery(d->mRemoveAlbumQuery, removeAlbumQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertRadioQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertRadioQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto deleteRadioQueryText = QStringLiteral("DELETE FROM `Radios` "
-                                                   "WHERE `ID` = :radioId");
+        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Artists` "
+                                                   "WHERE "
+                                                   "`ID` = :artistId");
 
-        auto result = prepareQuery(d->mDeleteRadioQuery, deleteRadioQueryText);
+        auto result = prepareQuery(d->mRemoveArtistQuery, removeAlbumQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mDeleteRadioQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mDeleteRadioQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto updateRadioQueryText = QStringLiteral("UPDATE `Radios` "
-                                                   "SET "
-                                                   "`HttpAddress` = :httpAddress, "
-                                                   "`Title` = :title, "
-                                                   "`Comment` = :comment, "
-                                                   "`Rating` = :trackRating, "
-                                                   "`ImageAddress` = :imageAddress "
-                                                   "WHERE "
-                                                   "`ID` = :radioId");
+        auto insertAlbumSummaryText = QStringLiteral("INSERT INTO `AlbumSummary` "
+                                                     "(`AlbumID`, `TracksCount`, `ArtistsCount`, `AllArtists`, `HighestRating`, `AllGenres`, `IsSingleDiscAlbum`, `EmbeddedCover`) "
+                                                     "SELECT "
+                                                     "album.`ID`, "
+                                                     "COUNT(tracks.`ID`), "
+                                                     "COUNT(DISTINCT tracks.`ArtistName`), "
+                                                     "GROUP_CONCAT(tracks.`ArtistName`, ', '), "
+                                                     "MAX(tracks.`Rating`), "
+                                                     "GROUP_CONCAT(genres.`Name`, ', '), "
+                                                     "COUNT(DISTINCT tracks.`DiscNumber`) <= 1, "
+                                                     "MIN(CASE WHEN tracks.`HasEmbeddedCover` = 1 THEN trackDirectory.`Path` || trackData.`BaseName` END) "
+                                                     "FROM "
+                                                     "`Albums` album, "
+                                                     "`Tracks` tracks LEFT JOIN "
+                                                     "`Genre` genres ON genres.`ID` = tracks.`GenreID` "
+                                                     "JOIN `TracksData` trackData ON trackData.`ID` = tracks.`FileID` "
+                                                     "JOIN `Directories` trackDirectory ON trackDirectory.`ID` = trackData.`DirectoryID` "
+                                                     "WHERE "
+                                                     "tracks.`AlbumID` = album.`ID` AND "
+                                                     "album.`ID` = :albumId "
+                                                     "GROUP BY album.`ID`");
 
-        auto result = prepareQuery(d->mUpdateRadioQuery, updateRadioQueryText);
+        auto result = prepareQuery(d->mInsertAlbumSummaryQuery, insertAlbumSummaryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateRadioQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateRadioQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertAlbumSummaryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertAlbumSummaryQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto updateAlbumArtistQueryText = QStringLiteral("UPDATE `Albums` "
-                                                         "SET "
-                                                         "`ArtistName` = :artistName "
-                                                         "WHERE "
-                                                         "`ID` = :albumId");
+        auto removeAlbumSummaryText = QStringLiteral("DELETE FROM `AlbumSummary` "
+                                                     "WHERE "
+                                                     "`AlbumID` = :albumId");
 
-        auto result = prepareQuery(d->mUpdateAlbumArtistQuery, updateAlbumArtistQueryText);
+        auto result = prepareQuery(d->mRemoveAlbumSummaryQuery, removeAlbumSummaryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumSummaryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumSummaryQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
-    {
-        auto updateAlbumArtistInTracksQueryText = QStringLiteral("UPDATE `Tracks` "
-                                                                 "SET "
-                                                                 "`AlbumArtistName` = :artistName "
-                                                                 "WHERE "
-                                                                 "`AlbumTitle` = :albumTitle AND "
-                                                                 "`AlbumPath` = :albumPath AND "
-                                                                 "`AlbumArtistName` IS NULL");
+    if (d->mHasSearchIndex) {
+        {
+            auto insertTrackSearchText = QStringLiteral("INSERT INTO `TracksSearch` "
+                                                        "(`rowid`, `Title`, `ArtistName`, `AlbumArtistName`, `AlbumTitle`, `Genre`, `Composer`, `Lyricist`) "
+                                                        "SELECT "
+                                                        "tracks.`ID`, "
+                                                        "tracks.`Title`, "
+                                                        "tracks.`ArtistName`, "
+                                                        "tracks.`AlbumArtistName`, "
+                                                        "tracks.`AlbumTitle`, "
+                                                        "trackGenre.`Name`, "
+                                                        "trackComposer.`Name`, "
+                                                        "trackLyricist.`Name` "
+                                                        "FROM "
+                                                        "`Tracks` tracks "
+                                                        "LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreID` "
+                                                        "LEFT JOIN `Composer` trackComposer ON trackComposer.`ID` = tracks.`ComposerID` "
+                                                        "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`ID` = tracks.`LyricistID` "
+                                                        "WHERE "
+                                                        "tracks.`ID` = :trackId");
 
-        auto result = prepareQuery(d->mUpdateAlbumArtistInTracksQuery, updateAlbumArtistInTracksQueryText);
+            auto result = prepareQuery(d->mInsertTrackSearchQuery, insertTrackSearchText);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistInTracksQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtistInTracksQuery.lastError();
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackSearchQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackSearchQuery.lastError();
 
-            Q_EMIT databaseError();
+                Q_EMIT databaseError();
+            }
         }
-    }
 
-    {
-        auto queryMaximumTrackIdQueryText = QStringLiteral("SELECT MAX(tracks.`ID`)"
-                                                           "FROM "
-                                                           "`Tracks` tracks");
+        {
+            auto removeTrackSearchText = QStringLiteral("DELETE FROM `TracksSearch` "
+                                                        "WHERE "
+                                                        "`rowid` = :trackId");
 
-        auto result = prepareQuery(d->mQueryMaximumTrackIdQuery, queryMaximumTrackIdQueryText);
+            auto result = prepareQuery(d->mRemoveTrackSearchQuery, removeTrackSearchText);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumTrackIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumTrackIdQuery.lastError();
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackSearchQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackSearchQuery.lastError();
 
-            Q_EMIT databaseError();
+                Q_EMIT databaseError();
+            }
         }
-    }
 
-    {
-        auto queryMaximumAlbumIdQueryText = QStringLiteral("SELECT MAX(albums.`ID`)"
-                                                           "FROM "
-                                                           "`Albums` albums");
+        {
+            auto insertAlbumSearchText = QStringLiteral("INSERT INTO `AlbumsSearch` "
+                                                        "(`rowid`, `Title`, `ArtistName`, `AllArtists`, `AllGenres`) "
+                                                        "SELECT "
+                                                        "album.`ID`, "
+                                                        "album.`Title`, "
+                                                        "album.`ArtistName`, "
+                                                        "GROUP_CONCAT(DISTINCT tracks.`ArtistName`), "
+                                                        "GROUP_CONCAT(DISTINCT albumGenre.`Name`) "
+                                                        "FROM "
+                                                        "`Albums` album "
+                                                        "LEFT JOIN "
+                                                        "`Tracks` tracks "
+                                                        "ON "
+                                                        "tracks.`AlbumID` = album.`ID` "
+                                                        "LEFT JOIN `Genre` albumGenre ON albumGenre.`ID` = tracks.`GenreID` "
+                                                        "WHERE "
+                                                        "album.`ID` = :albumId "
+                                                        "GROUP BY album.`ID`");
 
-        auto result = prepareQuery(d->mQueryMaximumAlbumIdQuery, queryMaximumAlbumIdQueryText);
+            auto result = prepareQuery(d->mInsertAlbumSearchQuery, insertAlbumSearchText);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumAlbumIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumAlbumIdQuery.lastError();
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertAlbumSearchQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertAlbumSearchQuery.lastError();
 
-            Q_EMIT databaseError();
+                Q_EMIT databaseError();
+            }
         }
-    }
 
-    {
-        auto queryMaximumArtistIdQueryText = QStringLiteral("SELECT MAX(artists.`ID`)"
-                                                            "FROM "
-                                                            "`Artists` artists");
+        {
+            auto removeAlbumSearchText = QStringLiteral("DELETE FROM `AlbumsSearch` "
+                                                        "WHERE "
+                                                        "`rowid` = :albumId");
 
-        auto result = prepareQuery(d->mQueryMaximumArtistIdQuery, queryMaximumArtistIdQueryText);
+            auto result = prepareQuery(d->mRemoveAlbumSearchQuery, removeAlbumSearchText);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumArtistIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumArtistIdQuery.lastError();
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumSearchQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumSearchQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        {
+            auto searchTracksText = QStringLiteral("SELECT "
+                                                   "`rowid` "
+                                                   "FROM "
+                                                   "`TracksSearch` "
+                                                   "WHERE "
+                                                   "`TracksSearch` MATCH :searchText "
+                                                   "ORDER BY `rank` "
+                                                   "LIMIT :maximumCount");
+
+            auto result = prepareQuery(d->mSearchTracksQuery, searchTracksText);
 
-            Q_EMIT databaseError();
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchTracksQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchTracksQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
         }
-    }
 
-    {
-        auto queryMaximumLyricistIdQueryText = QStringLiteral("SELECT MAX(lyricists.`ID`)"
-                                                              "FROM "
-                                                              "`Lyricist` lyricists");
+        {
+            auto searchAlbumsText = QStringLiteral("SELECT "
+                                                   "`rowid` "
+                                                   "FROM "
+                                                   "`AlbumsSearch` "
+                                                   "WHERE "
+                                                   "`AlbumsSearch` MATCH :searchText "
+                                                   "ORDER BY `rank` "
+                                                   "LIMIT :maximumCount");
 
-        auto result = prepareQuery(d->mQueryMaximumLyricistIdQuery, queryMaximumLyricistIdQueryText);
+            auto result = prepareQuery(d->mSearchAlbumsQuery, searchAlbumsText);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumLyricistIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumLyricistIdQuery.lastError();
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchAlbumsQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchAlbumsQuery.lastError();
 
-            Q_EMIT databaseError();
+                Q_EMIT databaseError();
+            }
         }
     }
 
     {
-        auto queryMaximumComposerIdQueryText = QStringLiteral("SELECT MAX(composers.`ID`)"
-                                                              "FROM "
-                                                              "`Composer` composers");
+        auto updateGenerationText = QStringLiteral("UPDATE `DatabaseGeneration` "
+                                                   "SET `Generation` = :generation");
 
-        auto result = prepareQuery(d->mQueryMaximumComposerIdQuery, queryMaximumComposerIdQueryText);
+        auto result = prepareQuery(d->mUpdateGenerationQuery, updateGenerationText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumComposerIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumComposerIdQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateGenerationQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateGenerationQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto queryMaximumGenreIdQueryText = QStringLiteral("SELECT MAX(genres.`ID`)"
-                                                           "FROM "
-                                                           "`Genre` genres");
+        auto updatePlayStatisticsSequenceText = QStringLiteral("UPDATE `PlayStatisticsJournalState` "
+                                                               "SET `LastAppliedSequence` = :sequence");
 
-        auto result = prepareQuery(d->mQueryMaximumGenreIdQuery, queryMaximumGenreIdQueryText);
+        auto result = prepareQuery(d->mUpdatePlayStatisticsSequenceQuery, updatePlayStatisticsSequenceText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumGenreIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mQueryMaximumGenreIdQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdatePlayStatisticsSequenceQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdatePlayStatisticsSequenceQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTrackQueryText = QStringLiteral("SELECT "
-                                                   "tracks.ID "
-                                                   "FROM "
-                                                   "`Tracks` tracks "
-                                                   "WHERE "
-                                                   "tracks.`Title` = :title AND "
-                                                   "(tracks.`AlbumTitle` = :album OR (:album IS NULL AND tracks.`AlbumTitle` IS NULL)) AND "
-                                                   "(tracks.`TrackNumber` = :trackNumber OR (:trackNumber IS NULL AND tracks.`TrackNumber` IS NULL)) AND "
-                                                   "(tracks.`DiscNumber` = :discNumber OR (:discNumber IS NULL AND tracks.`DiscNumber` IS NULL)) AND "
-                                                   "tracks.`ArtistName` = :artist");
+        auto selectGenerationText = QStringLiteral("SELECT `Generation` FROM `DatabaseGeneration`");
 
-        auto result = prepareQuery(d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery, selectTrackQueryText);
+        auto result = prepareQuery(d->mSelectGenerationQuery, selectGenerationText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenerationQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenerationQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTrackQueryText = QStringLiteral("SELECT "
-                                                   "tracks.ID "
-                                                   "FROM "
-                                                   "`Tracks` tracks, "
-                                                   "`Albums` albums "
-                                                   "WHERE "
-                                                   "tracks.`Title` = :title AND "
-                                                   "tracks.`Priority` = :priority AND "
-                                                   "(tracks.`ArtistName` = :trackArtist OR tracks.`ArtistName` IS NULL) AND "
-                                                   "(tracks.`AlbumTitle` = :album OR tracks.`AlbumTitle` IS NULL) AND "
-                                                   "(tracks.`AlbumArtistName` = :albumArtist OR tracks.`AlbumArtistName` IS NULL) AND "
-                                                   "(tracks.`AlbumPath` = :albumPath OR tracks.`AlbumPath` IS NULL) AND "
-                                                   "(tracks.`TrackNumber` = :trackNumber OR tracks.`TrackNumber` IS NULL) AND "
-                                                   "(tracks.`DiscNumber` = :discNumber OR tracks.`DiscNumber` IS NULL) "
-                                                   "");
+        auto selectDataVersionText = QStringLiteral("PRAGMA data_version");
 
-        auto result = prepareQuery(d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery, selectTrackQueryText);
+        auto result = prepareQuery(d->mSelectDataVersionQuery, selectDataVersionText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectDataVersionQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectDataVersionQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectAlbumArtUriFromAlbumIdQueryText = QStringLiteral("SELECT `CoverFileName`"
-                                                                    "FROM "
-                                                                    "`Albums` "
-                                                                    "WHERE "
-                                                                    "`ID` = :albumId");
+        auto insertChangesJournalText = QStringLiteral("INSERT INTO `DatabaseChangesJournal` (`Generation`, `Kind`, `ID`) "
+                                                       "VALUES (:generation, :kind, :id)");
 
-        auto result = prepareQuery(d->mSelectAlbumArtUriFromAlbumIdQuery, selectAlbumArtUriFromAlbumIdQueryText);
+        auto result = prepareQuery(d->mInsertChangesJournalQuery, insertChangesJournalText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumArtUriFromAlbumIdQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertChangesJournalQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertChangesJournalQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto updateAlbumArtUriFromAlbumIdQueryText = QStringLiteral("UPDATE `Albums` "
-                                                                    "SET `CoverFileName` = :coverFileName "
-                                                                    "WHERE "
-                                                                    "`ID` = :albumId");
+        auto pruneChangesJournalText = QStringLiteral("DELETE FROM `DatabaseChangesJournal` "
+                                                      "WHERE `Generation` <= :generation");
 
-        auto result = prepareQuery(d->mUpdateAlbumArtUriFromAlbumIdQuery, updateAlbumArtUriFromAlbumIdQueryText);
+        auto result = prepareQuery(d->mPruneChangesJournalQuery, pruneChangesJournalText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateAlbumArtUriFromAlbumIdQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mPruneChangesJournalQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mPruneChangesJournalQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTracksFromArtistQueryText = QStringLiteral("SELECT "
-                                                              "tracks.`ID`, "
-                                                              "tracks.`Title`, "
-                                                              "album.`ID`, "
-                                                              "tracks.`ArtistName`, "
-                                                              "( "
-                                                              "SELECT "
-                                                              "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                              "FROM "
-                                                              "`Tracks` tracksFromAlbum1 "
-                                                              "WHERE "
-                                                              "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                              "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                              "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                              "album.`ArtistName` IS NULL "
-                                                              ") "
-                                                              ") AND "
-                                                              "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                              ") AS ArtistsCount, "
-                                                              "( "
-                                                              "SELECT "
-                                                              "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
-                                                              "FROM "
-                                                              "`Tracks` tracksFromAlbum2 "
-                                                              "WHERE "
-                                                              "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                              "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                              "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                              "album.`ArtistName` IS NULL "
-                                                              ") "
-                                                              ") AND "
-                                                              "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
-                                                              ") AS AllArtists, "
-                                                              "tracks.`AlbumArtistName`, "
-                                                              "tracksMapping.`FileName`, "
-                                                              "tracksMapping.`FileModifiedTime`, "
-                                                              "tracks.`TrackNumber`, "
-                                                              "tracks.`DiscNumber`, "
-                                                              "tracks.`Duration`, "
-                                                              "tracks.`AlbumTitle`, "
-                                                              "tracks.`Rating`, "
-                                                              "album.`CoverFileName`, "
-                                                              "("
-                                                              "SELECT "
-                                                              "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                              "FROM "
-                                                              "`Tracks` tracks2 "
-                                                              "WHERE "
-                                                              "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                              "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                              "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                              "album.`ArtistName` IS NULL"
-                                                              ")"
-                                                              ") AND "
-                                                              "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                              ") as `IsSingleDiscAlbum`, "
-                                                              "trackGenre.`Name`, "
-                                                              "trackComposer.`Name`, "
-                                                              "trackLyricist.`Name`, "
-                                                              "tracks.`Comment`, "
-                                                              "tracks.`Year`, "
-                                                              "tracks.`Channels`, "
-                                                              "tracks.`BitRate`, "
-                                                              "tracks.`SampleRate`, "
-                                                              "tracks.`HasEmbeddedCover`, "
-                                                              "tracksMapping.`ImportDate`, "
-                                                              "tracksMapping.`FirstPlayDate`, "
-                                                              "tracksMapping.`LastPlayDate`, "
-                                                              "tracksMapping.`PlayCounter`, "
-                                                              "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
-                                                              "( "
-                                                              "SELECT tracksCover.`FileName` "
-                                                              "FROM "
-                                                              "`Tracks` tracksCover "
-                                                              "WHERE "
-                                                              "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                              "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                              "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                              "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                              "album.`ArtistName` IS NULL "
-                                                              ") "
-                                                              ") AND "
-                                                              "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                              ") as EmbeddedCover "
-                                                              "FROM "
-                                                              "`Tracks` tracks, "
-                                                              "`TracksData` tracksMapping "
-                                                              "LEFT JOIN "
-                                                              "`Albums` album "
-                                                              "ON "
-                                                              "tracks.`AlbumTitle` = album.`Title` AND "
-                                                              "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                              "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                              "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
-                                                              "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                              "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                              "WHERE "
-                                                              "tracks.`ArtistName` = :artistName AND "
-                                                              "tracksMapping.`FileName` = tracks.`FileName` AND "
-                                                              "tracks.`Priority` = ("
-                                                              "     SELECT "
-                                                              "     MIN(`Priority`) "
-                                                              "     FROM "
-                                                              "     `Tracks` tracks2 "
-                                                              "     WHERE "
-                                                              "     tracks.`Title` = tracks2.`Title` AND "
-                                                              "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
-                                                              "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
-                                                              "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
-                                                              "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
-                                                              ")"
-                                                              "ORDER BY "
-                                                              "album.`Title` ASC, "
-                                                              "tracks.`DiscNumber` ASC, "
-                                                              "tracks.`TrackNumber` ASC, "
-                                                              "tracks.`Title` ASC"
-                                                              "");
+        auto selectChangesJournalText = QStringLiteral("SELECT `Generation`, `Kind`, `ID` "
+                                                       "FROM `DatabaseChangesJournal` "
+                                                       "WHERE `Generation` > :firstGeneration AND `Generation` <= :lastGeneration "
+                                                       "ORDER BY `Generation`, `rowid`");
 
-        auto result = prepareQuery(d->mSelectTracksFromArtist, selectTracksFromArtistQueryText);
+        auto result = prepareQuery(d->mSelectChangesJournalQuery, selectChangesJournalText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromArtist.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromArtist.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectChangesJournalQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectChangesJournalQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectTracksFromGenreQueryText = QStringLiteral("SELECT "
-                                                             "tracks.`ID`, "
-                                                             "tracks.`Title`, "
-                                                             "album.`ID`, "
-                                                             "tracks.`ArtistName`, "
-                                                             "( "
-                                                             "SELECT "
-                                                             "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                             "FROM "
-                                                             "`Tracks` tracksFromAlbum1 "
-                                                             "WHERE "
-                                                             "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                             "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                             "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                             "album.`ArtistName` IS NULL "
-                                                             ") "
-                                                             ") AND "
-                                                             "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                             ") AS ArtistsCount, "
-                                                             "( "
-                                                             "SELECT "
-                                                             "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
-                                                             "FROM "
-                                                             "`Tracks` tracksFromAlbum2 "
-                                                             "WHERE "
-                                                             "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                             "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                             "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                             "album.`ArtistName` IS NULL "
-                                                             ") "
-                                                             ") AND "
-                                                             "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
-                                                             ") AS AllArtists, "
-                                                             "tracks.`AlbumArtistName`, "
-                                                             "tracksMapping.`FileName`, "
-                                                             "tracksMapping.`FileModifiedTime`, "
-                                                             "tracks.`TrackNumber`, "
-                                                             "tracks.`DiscNumber`, "
-                                                             "tracks.`Duration`, "
-                                                             "tracks.`AlbumTitle`, "
-                                                             "tracks.`Rating`, "
-                                                             "album.`CoverFileName`, "
-                                                             "("
-                                                             "SELECT "
-                                                             "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                             "FROM "
-                                                             "`Tracks` tracks2 "
-                                                             "WHERE "
-                                                             "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                             "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                             "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                             "album.`ArtistName` IS NULL"
-                                                             ")"
-                                                             ") AND "
-                                                             "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                             ") as `IsSingleDiscAlbum`, "
-                                                             "trackGenre.`Name`, "
-                                                             "trackComposer.`Name`, "
-                                                             "trackLyricist.`Name`, "
-                                                             "tracks.`Comment`, "
-                                                             "tracks.`Year`, "
-                                                             "tracks.`Channels`, "
-                                                             "tracks.`BitRate`, "
-                                                             "tracks.`SampleRate`, "
-                                                             "tracks.`HasEmbeddedCover`, "
-                                                             "tracksMapping.`ImportDate`, "
-                                                             "tracksMapping.`FirstPlayDate`, "
-                                                             "tracksMapping.`LastPlayDate`, "
-                                                             "tracksMapping.`PlayCounter`, "
-                                                             "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
-                                                             "( "
-                                                             "SELECT tracksCover.`FileName` "
-                                                             "FROM "
-                                                             "`Tracks` tracksCover "
-                                                             "WHERE "
-                                                             "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                             "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                             "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                             "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                             "album.`ArtistName` IS NULL "
-                                                             ") "
-                                                             ") AND "
-                                                             "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                             ") as EmbeddedCover "
-                                                             "FROM "
-                                                             "`Tracks` tracks, "
-                                                             "`TracksData` tracksMapping "
-                                                             "LEFT JOIN "
-                                                             "`Albums` album "
-                                                             "ON "
-                                                             "tracks.`AlbumTitle` = album.`Title` AND "
-                                                             "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                             "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                             "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
-                                                             "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                             "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                             "WHERE "
-                                                             "tracks.`Genre` = :genre AND "
-                                                             "tracksMapping.`FileName` = tracks.`FileName` AND "
-                                                             "tracks.`Priority` = ("
-                                                             "     SELECT "
-                                                             "     MIN(`Priority`) "
-                                                             "     FROM "
-                                                             "     `Tracks` tracks2 "
-                                                             "     WHERE "
-                                                             "     tracks.`Title` = tracks2.`Title` AND "
-                                                             "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
-                                                             "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
-                                                             "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
-                                                             "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
-                                                             ")"
-                                                             "ORDER BY "
-                                                             "album.`Title` ASC, "
-                                                             "tracks.`DiscNumber` ASC, "
-                                                             "tracks.`TrackNumber` ASC, "
-                                                             "tracks.`Title` ASC"
-                                                             "");
+        auto selectAllDirectoriesStateText = QStringLiteral("SELECT `Path`, `ModifiedTime`, `EntriesCount` "
+                                                            "FROM `DirectoriesState`");
 
-        auto result = prepareQuery(d->mSelectTracksFromGenre, selectTracksFromGenreQueryText);
+        auto result = prepareQuery(d->mSelectAllDirectoriesStateQuery, selectAllDirectoriesStateText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromGenre.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromGenre.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllDirectoriesStateQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllDirectoriesStateQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectAlbumIdsFromArtistQueryText = QStringLiteral("SELECT "
-                                                                "album.`ID` "
-                                                                "FROM "
-                                                                "`Albums` album "
-                                                                "WHERE "
-                                                                "album.`ArtistName` = :artistName");
+        auto insertDirectoryStateText = QStringLiteral("INSERT OR REPLACE INTO `DirectoriesState` (`Path`, `ModifiedTime`, `EntriesCount`) "
+                                                       "VALUES (:path, :modifiedTime, :entriesCount)");
 
-        auto result = prepareQuery(d->mSelectAlbumIdsFromArtist, selectAlbumIdsFromArtistQueryText);
+        auto result = prepareQuery(d->mInsertDirectoryStateQuery, insertDirectoryStateText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdsFromArtist.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumIdsFromArtist.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertDirectoryStateQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertDirectoryStateQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectArtistQueryText = QStringLiteral("SELECT `ID`, "
-                                                    "`Name` "
-                                                    "FROM `Artists` "
-                                                    "WHERE "
-                                                    "`ID` = :artistId");
+        auto removeDirectoryStateText = QStringLiteral("DELETE FROM `DirectoriesState` "
+                                                       "WHERE `Path` = :path");
 
-        auto result = prepareQuery(d->mSelectArtistQuery, selectArtistQueryText);
+        auto result = prepareQuery(d->mRemoveDirectoryStateQuery, removeDirectoryStateText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectArtistQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveDirectoryStateQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveDirectoryStateQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto updateTrackStatisticsQueryText = QStringLiteral("UPDATE `TracksData` "
-                                                             "SET "
-                                                             "`LastPlayDate` = :playDate, "
-                                                             "`PlayCounter` = `PlayCounter` + 1 "
-                                                             "WHERE "
-                                                             "`FileName` = :fileName");
+        auto clearDirectoriesStateText = QStringLiteral("DELETE FROM `DirectoriesState`");
 
-        auto result = prepareQuery(d->mUpdateTrackStatistics, updateTrackStatisticsQueryText);
+        auto result = prepareQuery(d->mClearDirectoriesStateQuery, clearDirectoriesStateText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearDirectoriesStateQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearDirectoriesStateQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto updateTrackFirstPlayStatisticsQueryText = QStringLiteral("UPDATE `TracksData` "
-                                                                      "SET "
-                                                                      "`FirstPlayDate` = :playDate "
-                                                                      "WHERE "
-                                                                      "`FileName` = :fileName AND "
-                                                                      "`FirstPlayDate` IS NULL");
+        auto insertTrackPlayScoreText = QStringLiteral("INSERT OR IGNORE INTO `TracksPlayScore` (`FileID`, `Score`) "
+                                                       "SELECT trackData.`ID`, 0 "
+                                                       "FROM `TracksData` trackData, `Directories` trackDirectory "
+                                                       "WHERE trackDirectory.`Path` = :directory AND "
+                                                       "trackData.`DirectoryID` = trackDirectory.`ID` AND "
+                                                       "trackData.`BaseName` = :baseName");
 
-        auto result = prepareQuery(d->mUpdateTrackFirstPlayStatistics, updateTrackFirstPlayStatisticsQueryText);
+        auto result = prepareQuery(d->mInsertTrackPlayScoreQuery, insertTrackPlayScoreText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackPlayScoreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertTrackPlayScoreQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectGenreQueryText = QStringLiteral("SELECT `ID`, "
-                                                   "`Name` "
-                                                   "FROM `Genre` "
-                                                   "WHERE "
-                                                   "`ID` = :genreId");
+        auto updateTrackPlayScoreText = QStringLiteral("UPDATE `TracksPlayScore` "
+                                                       "SET `Score` = `Score` + :scoreIncrement "
+                                                       "WHERE `FileID` = ("
+                                                       "SELECT trackData.`ID` "
+                                                       "FROM `TracksData` trackData, `Directories` trackDirectory "
+                                                       "WHERE trackDirectory.`Path` = :directory AND "
+                                                       "trackData.`DirectoryID` = trackDirectory.`ID` AND "
+                                                       "trackData.`BaseName` = :baseName)");
 
-        auto result = prepareQuery(d->mSelectGenreQuery, selectGenreQueryText);
+        auto result = prepareQuery(d->mUpdateTrackPlayScoreQuery, updateTrackPlayScoreText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackPlayScoreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackPlayScoreQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
-    {
-        auto selectComposerQueryText = QStringLiteral("SELECT `ID`, "
-                                                      "`Name` "
-                                                      "FROM `Composer` "
-                                                      "WHERE "
-                                                      "`ID` = :composerId");
+    finishTransaction();
 
-        auto result = prepareQuery(d->mSelectComposerQuery, selectComposerQueryText);
+    d->mInitFinished = true;
+    Q_EMIT requestsInitDone();
+}
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastError();
+bool DatabaseInterface::prepareTracksListInsertion(const DataTypes::ListTrackDataType &tracks,
+                                                   QHash<QString, qulonglong> &existingTracks,
+                                                   QStringList &newTrackFiles)
+{
+    auto allFileNames = QStringList{};
+    auto allModifiedTimes = QHash<QString, QDateTime>{};
+    auto allArtists = QStringList{};
+    auto allGenres = QStringList{};
+    auto allComposers = QStringList{};
+    auto allLyricists = QStringList{};
+
+    for (const auto &oneTrack : tracks) {
+        const auto &fileName = oneTrack.resourceURI().toString();
+        if (!allModifiedTimes.contains(fileName)) {
+            allFileNames.push_back(fileName);
+            allModifiedTimes[fileName] = oneTrack.fileModificationTime();
+        }
+
+        if (!oneTrack.album().isEmpty() && oneTrack.hasAlbumArtist() && !oneTrack.albumArtist().isEmpty()) {
+            allArtists.push_back(oneTrack.albumArtist());
+        }
+
+        if (oneTrack.title().isEmpty()) {
+            continue;
+        }
+
+        if (!oneTrack.artist().isEmpty()) {
+            allArtists.push_back(oneTrack.artist());
+        }
+        if (!oneTrack.genre().isEmpty()) {
+            allGenres.push_back(oneTrack.genre());
+        }
+        if (!oneTrack.composer().isEmpty()) {
+            allComposers.push_back(oneTrack.composer());
+        }
+        if (!oneTrack.lyricist().isEmpty()) {
+            allLyricists.push_back(oneTrack.lyricist());
         }
     }
 
-    {
-        auto selectLyricistQueryText = QStringLiteral("SELECT `ID`, "
-                                                      "`Name` "
-                                                      "FROM `Lyricist` "
-                                                      "WHERE "
-                                                      "`ID` = :lyricistId");
+    allArtists.removeDuplicates();
+    allGenres.removeDuplicates();
+    allComposers.removeDuplicates();
+    allLyricists.removeDuplicates();
 
-        auto result = prepareQuery(d->mSelectLyricistQuery, selectLyricistQueryText);
+    auto existingFileIds = QHash<QString, qulonglong>{};
+    if (!internalTrackIdsFromFileNames(allFileNames, existingFileIds, existingTracks)) {
+        return false;
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastError();
+    for (const auto &oneFileName : qAsConst(allFileNames)) {
+        if (!existingTracks.contains(oneFileName)) {
+            newTrackFiles.push_back(oneFileName);
         }
     }
 
-    {
-        auto removeTrackQueryText = QStringLiteral("DELETE FROM `Tracks` "
-                                                   "WHERE "
-                                                   "`ID` = :trackId");
+    const auto importDate = QDateTime::currentDateTime().toMSecsSinceEpoch();
 
-        auto result = prepareQuery(d->mRemoveTrackQuery, removeTrackQueryText);
+    for (int chunkStart = 0; chunkStart < newTrackFiles.size(); chunkStart += DatabaseInterfacePrivate::BulkQueryChunkSize) {
+        const auto chunk = newTrackFiles.mid(chunkStart, DatabaseInterfacePrivate::BulkQueryChunkSize);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastError();
+        auto chunkDirectories = QStringList{};
+        for (const auto &oneFileName : chunk) {
+            chunkDirectories.push_back(DatabaseInterfacePrivate::splitFileName(oneFileName).first);
+        }
+        chunkDirectories.removeDuplicates();
+
+        QSqlQuery insertDirectoriesQuery(d->mTracksDatabase);
+
+        auto insertDirectoriesText = QStringLiteral("INSERT OR IGNORE INTO `Directories` (`Path`) "
+                                                    "VALUES %1").arg(bulkPlaceholders(chunkDirectories.size(), QStringLiteral("(?)")));
+
+        auto result = prepareQuery(insertDirectoriesQuery, insertDirectoriesText);
+
+        if (result) {
+            for (const auto &oneDirectory : qAsConst(chunkDirectories)) {
+                insertDirectoriesQuery.addBindValue(oneDirectory);
+            }
+
+            result = execQuery(insertDirectoriesQuery);
+        }
+
+        if (!result || !insertDirectoriesQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareTracksListInsertion" << insertDirectoriesQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareTracksListInsertion" << insertDirectoriesQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareTracksListInsertion" << insertDirectoriesQuery.lastError();
+
+            return false;
+        }
+
+        insertDirectoriesQuery.finish();
+
+        QSqlQuery insertTracksOriginQuery(d->mTracksDatabase);
+
+        auto insertTracksOriginText = QStringLiteral("INSERT INTO `TracksData` "
+                                                     "(`DirectoryID`, "
+                                                     "`BaseName`, "
+                                                     "`FileModifiedTime`, "
+                                                     "`ImportDate`, "
+                                                     "`PlayCounter`) "
+                                                     "VALUES %1").arg(bulkPlaceholders(chunk.size(), QStringLiteral("((SELECT `ID` FROM `Directories` WHERE `Path` = ?), ?, ?, ?, 0)")));
+
+        result = prepareQuery(insertTracksOriginQuery, insertTracksOriginText);
 
+        if (result) {
+            for (const auto &oneFileName : chunk) {
+                const auto &[directory, baseName] = DatabaseInterfacePrivate::splitFileName(oneFileName);
+
+                insertTracksOriginQuery.addBindValue(directory);
+                insertTracksOriginQuery.addBindValue(baseName);
+                insertTracksOriginQuery.addBindValue(allModifiedTimes[oneFileName]);
+                insertTracksOriginQuery.addBindValue(importDate);
+            }
+
+            result = execQuery(insertTracksOriginQuery);
+        }
+
+        if (!result || !insertTracksOriginQuery.isActive()) {
             Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareTracksListInsertion" << insertTracksOriginQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareTracksListInsertion" << insertTracksOriginQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareTracksListInsertion" << insertTracksOriginQuery.lastError();
+
+            return false;
+        }
+
+        insertTracksOriginQuery.finish();
+    }
+
+    auto newArtistIds = QList<qulonglong>{};
+    if (!internalBulkInsertNames(QStringLiteral("Artists"), allArtists, d->mArtistId, d->mArtistIdCache, newArtistIds)) {
+        return false;
+    }
+    for (auto oneArtistId : qAsConst(newArtistIds)) {
+        d->mInsertedArtists.insert(oneArtistId);
+    }
+
+    auto newGenreIds = QList<qulonglong>{};
+    if (!internalBulkInsertNames(QStringLiteral("Genre"), allGenres, d->mGenreId, d->mGenreIdCache, newGenreIds)) {
+        return false;
+    }
+    if (!newGenreIds.isEmpty()) {
+        auto newGenres = DataTypes::ListGenreDataType{};
+        for (auto oneGenreId : qAsConst(newGenreIds)) {
+            newGenres.push_back({{DataTypes::DatabaseIdRole, oneGenreId}});
         }
+        Q_EMIT genresAdded(newGenres);
     }
 
-    {
-        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Albums` "
-                                                   "WHERE "
-                                                   "`ID` = :albumId");
+    auto newComposerIds = QList<qulonglong>{};
+    if (!internalBulkInsertNames(QStringLiteral("Composer"), allComposers, d->mComposerId, d->mComposerIdCache, newComposerIds)) {
+        return false;
+    }
+    if (!newComposerIds.isEmpty()) {
+        Q_EMIT composersAdded(internalAllComposersPartialData());
+    }
 
-        auto result = prepareQuery(d->mRemoveAlbumQuery, removeAlbumQueryText);
+    auto newLyricistIds = QList<qulonglong>{};
+    if (!internalBulkInsertNames(QStringLiteral("Lyricist"), allLyricists, d->mLyricistId, d->mLyricistIdCache, newLyricistIds)) {
+        return false;
+    }
+    if (!newLyricistIds.isEmpty()) {
+        Q_EMIT lyricistsAdded(internalAllLyricistsPartialData());
+    }
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastError();
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareTracksListInsertion" << tracks.size() << "tracks" << newTrackFiles.size() << "new files"
+                                 << newArtistIds.size() << "new artists" << newGenreIds.size() << "new genres"
+                                 << newComposerIds.size() << "new composers" << newLyricistIds.size() << "new lyricists";
+
+    return true;
+}
+
+bool DatabaseInterface::internalTrackIdsFromFileNames(const QStringList &fileNames, QHash<QString, qulonglong> &fileIds,
+                                                      QHash<QString, qulonglong> &trackIds)
+{
+    for (int chunkStart = 0; chunkStart < fileNames.size(); chunkStart += DatabaseInterfacePrivate::BulkQueryChunkSize) {
+        const auto chunk = fileNames.mid(chunkStart, DatabaseInterfacePrivate::BulkQueryChunkSize);
+
+        auto chunkFileNames = QSet<QString>{};
+        auto chunkDirectories = QStringList{};
+        auto chunkBaseNames = QStringList{};
+        for (const auto &oneFileName : chunk) {
+            const auto &[directory, baseName] = DatabaseInterfacePrivate::splitFileName(oneFileName);
+
+            chunkFileNames.insert(oneFileName);
+            chunkDirectories.push_back(directory);
+            chunkBaseNames.push_back(baseName);
+        }
+        chunkDirectories.removeDuplicates();
+        chunkBaseNames.removeDuplicates();
+
+        QSqlQuery selectTracksMappingQuery(d->mTracksDatabase);
+
+        // both lists match a superset of the requested files, the exact pairs are kept below
+        auto selectTracksMappingText = QStringLiteral("SELECT "
+                                                      "(trackDirectory.`Path` || trackData.`BaseName`), "
+                                                      "track.`ID`, "
+                                                      "trackData.`ID` "
+                                                      "FROM "
+                                                      "`Directories` trackDirectory "
+                                                      "JOIN "
+                                                      "`TracksData` trackData "
+                                                      "ON "
+                                                      "trackData.`DirectoryID` = trackDirectory.`ID` "
+                                                      "LEFT JOIN "
+                                                      "`Tracks` track "
+                                                      "ON "
+                                                      "track.`FileID` = trackData.`ID` "
+                                                      "WHERE "
+                                                      "trackDirectory.`Path` IN (%1) AND "
+                                                      "trackData.`BaseName` IN (%2)").arg(bulkPlaceholders(chunkDirectories.size(), QStringLiteral("?")),
+                                                                                          bulkPlaceholders(chunkBaseNames.size(), QStringLiteral("?")));
+
+        auto result = prepareQuery(selectTracksMappingQuery, selectTracksMappingText);
+
+        if (result) {
+            for (const auto &oneDirectory : qAsConst(chunkDirectories)) {
+                selectTracksMappingQuery.addBindValue(oneDirectory);
+            }
+            for (const auto &oneBaseName : qAsConst(chunkBaseNames)) {
+                selectTracksMappingQuery.addBindValue(oneBaseName);
+            }
+
+            result = execQuery(selectTracksMappingQuery);
+        }
+
+        if (!result || !selectTracksMappingQuery.isSelect() || !selectTracksMappingQuery.isActive()) {
+            Q_EMIT databaseError();
 
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdsFromFileNames" << selectTracksMappingQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdsFromFileNames" << selectTracksMappingQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdsFromFileNames" << selectTracksMappingQuery.lastError();
+
+            return false;
+        }
+
+        while (selectTracksMappingQuery.next()) {
+            const auto &currentRecord = selectTracksMappingQuery.record();
+            const auto &fileName = currentRecord.value(0).toString();
+
+            if (!chunkFileNames.contains(fileName)) {
+                continue;
+            }
+
+            trackIds[fileName] = currentRecord.value(1).toULongLong();
+            fileIds[fileName] = currentRecord.value(2).toULongLong();
+        }
+
+        selectTracksMappingQuery.finish();
+    }
+
+    return true;
+}
+
+bool DatabaseInterface::internalBulkInsertNames(const QString &tableName, const QStringList &names, qulonglong &nextId,
+                                                DatabaseIdCache<QString> &knownIds, QList<qulonglong> &insertedIds)
+{
+    auto unknownNames = QStringList{};
+
+    for (const auto &oneName : names) {
+        auto knownId = qulonglong(0);
+        if (!knownIds.find(oneName, knownId)) {
+            unknownNames.push_back(oneName);
+        }
+    }
+
+    for (int chunkStart = 0; chunkStart < unknownNames.size(); chunkStart += DatabaseInterfacePrivate::BulkQueryChunkSize) {
+        const auto chunk = unknownNames.mid(chunkStart, DatabaseInterfacePrivate::BulkQueryChunkSize);
+
+        QSqlQuery selectNamesQuery(d->mTracksDatabase);
+
+        auto selectNamesText = QStringLiteral("SELECT `ID`, `Name` FROM `%1` WHERE `Name` IN (%2)").arg(tableName, bulkPlaceholders(chunk.size(), QStringLiteral("?")));
+
+        auto result = prepareQuery(selectNamesQuery, selectNamesText);
+
+        if (result) {
+            for (const auto &oneName : chunk) {
+                selectNamesQuery.addBindValue(oneName);
+            }
+
+            result = execQuery(selectNamesQuery);
+        }
+
+        if (!result || !selectNamesQuery.isSelect() || !selectNamesQuery.isActive()) {
             Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertNames" << selectNamesQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertNames" << selectNamesQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertNames" << selectNamesQuery.lastError();
+
+            return false;
+        }
+
+        while (selectNamesQuery.next()) {
+            const auto &currentRecord = selectNamesQuery.record();
+
+            knownIds.insert(currentRecord.value(1).toString(), currentRecord.value(0).toULongLong());
+        }
+
+        selectNamesQuery.finish();
+    }
+
+    auto missingNames = QStringList{};
+
+    for (const auto &oneName : qAsConst(unknownNames)) {
+        if (!knownIds.contains(oneName)) {
+            missingNames.push_back(oneName);
         }
     }
 
-    {
-        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Artists` "
-                                                   "WHERE "
-                                                   "`ID` = :artistId");
+    for (int chunkStart = 0; chunkStart < missingNames.size(); chunkStart += DatabaseInterfacePrivate::BulkQueryChunkSize) {
+        const auto chunk = missingNames.mid(chunkStart, DatabaseInterfacePrivate::BulkQueryChunkSize);
 
-        auto result = prepareQuery(d->mRemoveArtistQuery, removeAlbumQueryText);
+        QSqlQuery insertNamesQuery(d->mTracksDatabase);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastError();
+        auto insertNamesText = QStringLiteral("INSERT INTO `%1` (`ID`, `Name`) VALUES %2").arg(tableName, bulkPlaceholders(chunk.size(), QStringLiteral("(?, ?)")));
+
+        auto result = prepareQuery(insertNamesQuery, insertNamesText);
+
+        if (result) {
+            auto currentId = nextId;
+            for (const auto &oneName : chunk) {
+                insertNamesQuery.addBindValue(currentId);
+                insertNamesQuery.addBindValue(oneName);
+                ++currentId;
+            }
+
+            result = execQuery(insertNamesQuery);
+        }
 
+        if (!result || !insertNamesQuery.isActive()) {
             Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertNames" << insertNamesQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertNames" << insertNamesQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertNames" << insertNamesQuery.lastError();
+
+            return false;
+        }
+
+        insertNamesQuery.finish();
+
+        for (const auto &oneName : chunk) {
+            knownIds.insert(oneName, nextId);
+            insertedIds.push_back(nextId);
+            ++nextId;
         }
     }
 
-    finishTransaction();
+    return true;
+}
 
-    d->mInitFinished = true;
-    Q_EMIT requestsInitDone();
+QString DatabaseInterface::bulkPlaceholders(int count, const QString &onePlaceholder) const
+{
+    auto result = QString{};
+
+    for (int i = 0; i < count; ++i) {
+        if (i != 0) {
+            result += QStringLiteral(", ");
+        }
+        result += onePlaceholder;
+    }
+
+    return result;
+}
+
+void DatabaseInterface::clearIdCaches() const
+{
+    // the caches are only used by the writer connection
+    if (QThread::currentThread() != d->mWriterThread) {
+        return;
+    }
+
+    d->mArtistIdCache.clear();
+    d->mGenreIdCache.clear();
+    d->mComposerIdCache.clear();
+    d->mLyricistIdCache.clear();
+    d->mAlbumIdCache.clear();
+    d->mAlbumLookupIdCache.clear();
+}
+
+void DatabaseInterface::logIdCachesStatistics() const
+{
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::logIdCachesStatistics" << "artists" << d->mArtistIdCache.mHits << "hits" << d->mArtistIdCache.mMisses << "misses";
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::logIdCachesStatistics" << "genres" << d->mGenreIdCache.mHits << "hits" << d->mGenreIdCache.mMisses << "misses";
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::logIdCachesStatistics" << "composers" << d->mComposerIdCache.mHits << "hits" << d->mComposerIdCache.mMisses << "misses";
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::logIdCachesStatistics" << "lyricists" << d->mLyricistIdCache.mHits << "hits" << d->mLyricistIdCache.mMisses << "misses";
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::logIdCachesStatistics" << "albums" << d->mAlbumIdCache.mHits << "hits" << d->mAlbumIdCache.mMisses << "misses";
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::logIdCachesStatistics" << "album lookups" << d->mAlbumLookupIdCache.mHits << "hits" << d->mAlbumLookupIdCache.mMisses << "misses";
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::logIdCachesStatistics" << qPrintable(d->mTrackDataCache.report());
 }
 
 qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &albumArtist,
@@ -6305,6 +10877,16 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
         return result;
     }
 
+    const auto albumKey = std::make_tuple(title, albumArtist, trackPath);
+
+    if (d->mAlbumIdCache.find(albumKey, result)) {
+        if (!albumArtist.isEmpty()) {
+            updateAlbumArtist(result, title, albumArtist);
+        }
+
+        return result;
+    }
+
     d->mSelectAlbumIdFromTitleAndArtistQuery.bindValue(QStringLiteral(":title"), title);
     d->mSelectAlbumIdFromTitleAndArtistQuery.bindValue(QStringLiteral(":albumPath"), trackPath);
     d->mSelectAlbumIdFromTitleAndArtistQuery.bindValue(QStringLiteral(":artistName"), albumArtist);
@@ -6328,9 +10910,10 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
 
         d->mSelectAlbumIdFromTitleAndArtistQuery.finish();
 
+        d->mAlbumIdCache.insert(albumKey, result);
+
         if (!albumArtist.isEmpty()) {
-            const auto similarAlbum = internalOneAlbumPartialData(result);
-            updateAlbumArtist(result, title, trackPath, albumArtist);
+            updateAlbumArtist(result, title, albumArtist);
         }
 
         return result;
@@ -6371,11 +10954,13 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
 
     d->mInsertedAlbums.insert(result);
 
+    d->mAlbumIdCache.insert(albumKey, result);
+
     return result;
 }
 
 bool DatabaseInterface::updateAlbumFromId(qulonglong albumId, const QUrl &albumArtUri,
-                                          const DataTypes::TrackDataType &currentTrack, const QString &albumPath)
+                                          const DataTypes::TrackDataType &currentTrack)
 {
     auto modifiedAlbum = false;
     modifiedAlbum = true;
@@ -6410,7 +10995,7 @@ bool DatabaseInterface::updateAlbumFromId(qulonglong albumId, const QUrl &albumA
     }
 
     if (!isValidArtist(albumId) && currentTrack.hasAlbum()) {
-        updateAlbumArtist(albumId, currentTrack.album(), albumPath, currentTrack.albumArtist());
+        updateAlbumArtist(albumId, currentTrack.album(), currentTrack.albumArtist());
 
         modifiedAlbum = true;
     }
@@ -6426,6 +11011,10 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
         return result;
     }
 
+    if (d->mArtistIdCache.find(name, result)) {
+        return result;
+    }
+
     d->mSelectArtistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
     auto queryResult = execQuery(d->mSelectArtistByNameQuery);
@@ -6447,6 +11036,8 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
 
         d->mSelectArtistByNameQuery.finish();
 
+        d->mArtistIdCache.insert(name, result);
+
         return result;
     }
 
@@ -6471,6 +11062,8 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
 
     result = d->mArtistId;
 
+    d->mArtistIdCache.insert(name, result);
+
     ++d->mArtistId;
 
     d->mInsertedArtists.insert(result);
@@ -6488,6 +11081,10 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
         return result;
     }
 
+    if (d->mComposerIdCache.find(name, result)) {
+        return result;
+    }
+
     d->mSelectComposerByNameQuery.bindValue(QStringLiteral(":name"), name);
 
     auto queryResult = execQuery(d->mSelectComposerByNameQuery);
@@ -6510,6 +11107,8 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
 
         d->mSelectComposerByNameQuery.finish();
 
+        d->mComposerIdCache.insert(name, result);
+
         return result;
     }
 
@@ -6534,6 +11133,8 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
 
     result = d->mComposerId;
 
+    d->mComposerIdCache.insert(name, result);
+
     ++d->mComposerId;
 
     d->mInsertComposerQuery.finish();
@@ -6551,6 +11152,10 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
         return result;
     }
 
+    if (d->mGenreIdCache.find(name, result)) {
+        return result;
+    }
+
     d->mSelectGenreByNameQuery.bindValue(QStringLiteral(":name"), name);
 
     auto queryResult = execQuery(d->mSelectGenreByNameQuery);
@@ -6572,6 +11177,8 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
 
         d->mSelectGenreByNameQuery.finish();
 
+        d->mGenreIdCache.insert(name, result);
+
         return result;
     }
 
@@ -6596,6 +11203,8 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
 
     result = d->mGenreId;
 
+    d->mGenreIdCache.insert(name, result);
+
     ++d->mGenreId;
 
     d->mInsertGenreQuery.finish();
@@ -6608,12 +11217,29 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
 void DatabaseInterface::insertTrackOrigin(const QUrl &fileNameURI, const QDateTime &fileModifiedTime,
                                           const QDateTime &importDate)
 {
-    d->mInsertTrackMapping.bindValue(QStringLiteral(":fileName"), fileNameURI);
-    d->mInsertTrackMapping.bindValue(QStringLiteral(":priority"), 1);
+    DatabaseInterfacePrivate::bindFileName(d->mInsertDirectory, fileNameURI);
+
+    auto queryResult = execQuery(d->mInsertDirectory);
+
+    if (!queryResult || !d->mInsertDirectory.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertTrackOrigin" << d->mInsertDirectory.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertTrackOrigin" << d->mInsertDirectory.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertTrackOrigin" << d->mInsertDirectory.lastError();
+
+        d->mInsertDirectory.finish();
+
+        return;
+    }
+
+    d->mInsertDirectory.finish();
+
+    DatabaseInterfacePrivate::bindFileName(d->mInsertTrackMapping, fileNameURI);
     d->mInsertTrackMapping.bindValue(QStringLiteral(":mtime"), fileModifiedTime);
     d->mInsertTrackMapping.bindValue(QStringLiteral(":importDate"), importDate.toMSecsSinceEpoch());
 
-    auto queryResult = execQuery(d->mInsertTrackMapping);
+    queryResult = execQuery(d->mInsertTrackMapping);
 
     if (!queryResult || !d->mInsertTrackMapping.isActive()) {
         Q_EMIT databaseError();
@@ -6632,7 +11258,7 @@ void DatabaseInterface::insertTrackOrigin(const QUrl &fileNameURI, const QDateTi
 
 void DatabaseInterface::updateTrackOrigin(const QUrl &fileName, const QDateTime &fileModifiedTime)
 {
-    d->mUpdateTrackFileModifiedTime.bindValue(QStringLiteral(":fileName"), fileName);
+    DatabaseInterfacePrivate::bindFileName(d->mUpdateTrackFileModifiedTime, fileName);
     d->mUpdateTrackFileModifiedTime.bindValue(QStringLiteral(":mtime"), fileModifiedTime);
 
     auto queryResult = execQuery(d->mUpdateTrackFileModifiedTime);
@@ -6644,12 +11270,47 @@ void DatabaseInterface::updateTrackOrigin(const QUrl &fileName, const QDateTime
         qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackOrigin" << d->mUpdateTrackFileModifiedTime.boundValues();
         qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackOrigin" << d->mUpdateTrackFileModifiedTime.lastError();
 
-        d->mUpdateTrackFileModifiedTime.finish();
+        d->mUpdateTrackFileModifiedTime.finish();
+
+        return;
+    }
+
+    d->mUpdateTrackFileModifiedTime.finish();
+}
+
+void DatabaseInterface::removeTrackOrigin(const QUrl &fileName)
+{
+    DatabaseInterfacePrivate::bindFileName(d->mRemoveTracksMapping, fileName);
+
+    auto queryResult = execQuery(d->mRemoveTracksMapping);
+
+    if (!queryResult || !d->mRemoveTracksMapping.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackOrigin" << d->mRemoveTracksMapping.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackOrigin" << d->mRemoveTracksMapping.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackOrigin" << d->mRemoveTracksMapping.lastError();
+
+        d->mRemoveTracksMapping.finish();
+
+        return;
+    }
+
+    d->mRemoveTracksMapping.finish();
+
+    d->mRemoveUnusedDirectory.bindValue(QStringLiteral(":directory"), DatabaseInterfacePrivate::splitFileName(fileName.toString()).first);
+
+    queryResult = execQuery(d->mRemoveUnusedDirectory);
 
-        return;
+    if (!queryResult || !d->mRemoveUnusedDirectory.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackOrigin" << d->mRemoveUnusedDirectory.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackOrigin" << d->mRemoveUnusedDirectory.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeTrackOrigin" << d->mRemoveUnusedDirectory.lastError();
     }
 
-    d->mUpdateTrackFileModifiedTime.finish();
+    d->mRemoveUnusedDirectory.finish();
 }
 
 qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType &oneTrack,
@@ -6729,9 +11390,10 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
 
         auto newTrack = oneTrack;
         newTrack[DataTypes::ColumnsRoles::DatabaseIdRole] = resultId;
+        newTrack[DataTypes::ColumnsRoles::AlbumIdRole] = albumId;
         updateTrackInDatabase(newTrack, trackPath);
         updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
-        updateAlbumFromId(albumId, oneTrack.albumCover(), oneTrack, trackPath);
+        updateAlbumFromId(albumId, oneTrack.albumCover(), oneTrack);
 
         recordModifiedTrack(existingTrackId);
         if (albumId != 0) {
@@ -6744,7 +11406,7 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
                 recordModifiedAlbum(oldAlbumId);
             } else {
                 removeAlbumInDatabase(oldAlbumId);
-                Q_EMIT albumRemoved(oldAlbumId);
+                d->mRemovedAlbums.insert(oldAlbumId);
             }
         }
 
@@ -6775,11 +11437,16 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
 
     if (!oneTrack.title().isEmpty()) {
         d->mInsertTrackQuery.bindValue(QStringLiteral(":trackId"), existingTrackId);
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
+        DatabaseInterfacePrivate::bindFileName(d->mInsertTrackQuery, oneTrack.resourceURI());
         d->mInsertTrackQuery.bindValue(QStringLiteral(":priority"), priority);
         d->mInsertTrackQuery.bindValue(QStringLiteral(":title"), oneTrack.title());
-        insertArtist(oneTrack.artist());
+        const auto artistId = insertArtist(oneTrack.artist());
         d->mInsertTrackQuery.bindValue(QStringLiteral(":artistName"), oneTrack.artist());
+        if (artistId != 0) {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":artistId"), artistId);
+        } else {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":artistId"), {});
+        }
         d->mInsertTrackQuery.bindValue(QStringLiteral(":albumTitle"), oneTrack.album());
         if (oneTrack.hasAlbumArtist()) {
             d->mInsertTrackQuery.bindValue(QStringLiteral(":albumArtistName"), oneTrack.albumArtist());
@@ -6787,6 +11454,11 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
             d->mInsertTrackQuery.bindValue(QStringLiteral(":albumArtistName"), {});
         }
         d->mInsertTrackQuery.bindValue(QStringLiteral(":albumPath"), trackPath);
+        if (albumId != 0) {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":albumId"), albumId);
+        } else {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":albumId"), {});
+        }
         if (oneTrack.hasTrackNumber()) {
             d->mInsertTrackQuery.bindValue(QStringLiteral(":trackNumber"), oneTrack.trackNumber());
         } else {
@@ -6799,20 +11471,23 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
         }
         d->mInsertTrackQuery.bindValue(QStringLiteral(":trackDuration"), QVariant::fromValue<qlonglong>(oneTrack.duration().msecsSinceStartOfDay()));
         d->mInsertTrackQuery.bindValue(QStringLiteral(":trackRating"), oneTrack.rating());
-        if (insertGenre(oneTrack.genre()) != 0) {
-            d->mInsertTrackQuery.bindValue(QStringLiteral(":genre"), oneTrack.genre());
+        const auto genreId = insertGenre(oneTrack.genre());
+        if (genreId != 0) {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":genreId"), genreId);
         } else {
-            d->mInsertTrackQuery.bindValue(QStringLiteral(":genre"), {});
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":genreId"), {});
         }
-        if (insertComposer(oneTrack.composer()) != 0) {
-            d->mInsertTrackQuery.bindValue(QStringLiteral(":composer"), oneTrack.composer());
+        const auto composerId = insertComposer(oneTrack.composer());
+        if (composerId != 0) {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":composerId"), composerId);
         } else {
-            d->mInsertTrackQuery.bindValue(QStringLiteral(":composer"), {});
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":composerId"), {});
         }
-        if (insertLyricist(oneTrack.lyricist()) != 0) {
-            d->mInsertTrackQuery.bindValue(QStringLiteral(":lyricist"), oneTrack.lyricist());
+        const auto lyricistId = insertLyricist(oneTrack.lyricist());
+        if (lyricistId != 0) {
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":lyricistId"), lyricistId);
         } else {
-            d->mInsertTrackQuery.bindValue(QStringLiteral(":lyricist"), {});
+            d->mInsertTrackQuery.bindValue(QStringLiteral(":lyricistId"), {});
         }
         d->mInsertTrackQuery.bindValue(QStringLiteral(":comment"), oneTrack.comment());
         d->mInsertTrackQuery.bindValue(QStringLiteral(":year"), oneTrack.year());
@@ -6856,7 +11531,7 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
             }
 
             if (albumId != 0) {
-                if (updateAlbumFromId(albumId, covers[oneTrack.resourceURI().toString()], oneTrack, trackPath)) {
+                if (updateAlbumFromId(albumId, covers[oneTrack.resourceURI().toString()], oneTrack)) {
                     auto modifiedTracks = fetchTrackIds(albumId);
                     for (auto oneModifiedTrack : modifiedTracks) {
                         if (oneModifiedTrack != resultId) {
@@ -7058,77 +11733,276 @@ DataTypes::TrackDataType DatabaseInterface::buildRadioDataFromDatabaseRecord(con
 
 void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTracks)
 {
-    QSet<qulonglong> modifiedAlbums;
-
-    QUrl::FormattingOptions currentOptions = QUrl::PreferLocalFile |
-            QUrl::RemoveAuthority | QUrl::RemoveFilename | QUrl::RemoveFragment |
-            QUrl::RemovePassword | QUrl::RemovePort | QUrl::RemoveQuery |
-            QUrl::RemoveScheme | QUrl::RemoveUserInfo;
+    auto removedFileNames = QStringList{};
 
     for (const auto &removedTrackFileName : removedTracks) {
-        auto removedTrackId = internalTrackIdFromFileName(removedTrackFileName);
+        removedFileNames.push_back(removedTrackFileName.toString());
+    }
 
-        Q_EMIT trackRemoved(removedTrackId);
+    auto removedFileIdsByName = QHash<QString, qulonglong>{};
+    auto removedTrackIdsByName = QHash<QString, qulonglong>{};
 
-        auto oneRemovedTrack = internalTrackFromDatabaseId(removedTrackId);
+    if (!internalTrackIdsFromFileNames(removedFileNames, removedFileIdsByName, removedTrackIdsByName)) {
+        return;
+    }
+
+    auto removedFileIds = QVariantList{};
+
+    for (auto oneFileId : qAsConst(removedFileIdsByName)) {
+        removedFileIds.push_back(oneFileId);
+    }
+
+    auto removedTracksRecords = QList<QSqlRecord>{};
+
+    auto result = execBulkQuery(QStringLiteral("SELECT "
+                                               "tracks.`ID`, "
+                                               "tracks.`ArtistName`, "
+                                               "album.`ID` "
+                                               "FROM "
+                                               "`Tracks` tracks "
+                                               "LEFT JOIN "
+                                               "`Albums` album "
+                                               "ON "
+                                               "tracks.`AlbumID` = album.`ID` "
+                                               "WHERE "
+                                               "tracks.`FileID` IN (%1)"), removedFileIds, removedTracksRecords);
+
+    if (!result) {
+        return;
+    }
+
+    auto removedTrackIds = QVariantList{};
+    auto modifiedAlbumIds = QVariantList{};
+    auto modifiedArtistNames = QSet<QString>{};
 
-        removeTrackInDatabase(removedTrackId);
+    for (const auto &oneRecord : qAsConst(removedTracksRecords)) {
+        const auto trackId = oneRecord.value(0).toULongLong();
 
-        const auto &trackPath = oneRemovedTrack.resourceURI().toString(currentOptions);
-        const auto &modifiedAlbumId = internalAlbumIdFromTitleAndArtist(oneRemovedTrack.album(), oneRemovedTrack.albumArtist(), trackPath);
-        const auto &allTracksFromArtist = internalTracksFromAuthor(oneRemovedTrack.artist());
-        const auto &allAlbumsFromArtist = internalAlbumIdsFromAuthor(oneRemovedTrack.artist());
-        const auto &removedArtistId = internalArtistIdFromName(oneRemovedTrack.artist());
+        removedTrackIds.push_back(trackId);
+        d->mRemovedTracks.insert(trackId);
 
-        if (modifiedAlbumId) {
-            recordModifiedAlbum(modifiedAlbumId);
-            modifiedAlbums.insert(modifiedAlbumId);
-            updateAlbumFromId(modifiedAlbumId, oneRemovedTrack.albumCover(), oneRemovedTrack, trackPath);
+        if (!oneRecord.value(1).isNull()) {
+            modifiedArtistNames.insert(oneRecord.value(1).toString());
         }
 
-        if (removedArtistId != 0 && allTracksFromArtist.isEmpty() && allAlbumsFromArtist.isEmpty()) {
-            removeArtistInDatabase(removedArtistId);
-            Q_EMIT artistRemoved(removedArtistId);
+        if (!oneRecord.value(2).isNull() && !modifiedAlbumIds.contains(oneRecord.value(2))) {
+            modifiedAlbumIds.push_back(oneRecord.value(2));
         }
+    }
 
-        d->mRemoveTracksMapping.bindValue(QStringLiteral(":fileName"), removedTrackFileName.toString());
+    auto removedDirectoriesRecords = QList<QSqlRecord>{};
 
-        auto result = execQuery(d->mRemoveTracksMapping);
+    result = execBulkQuery(QStringLiteral("SELECT DISTINCT "
+                                          "`DirectoryID` "
+                                          "FROM "
+                                          "`TracksData` "
+                                          "WHERE "
+                                          "`ID` IN (%1)"), removedFileIds, removedDirectoriesRecords);
 
-        if (!result || !d->mRemoveTracksMapping.isActive()) {
-            Q_EMIT databaseError();
+    if (!result) {
+        return;
+    }
+
+    auto removedDirectoryIds = QVariantList{};
+
+    for (const auto &oneRecord : qAsConst(removedDirectoriesRecords)) {
+        removedDirectoryIds.push_back(oneRecord.value(0));
+    }
+
+    auto noRecords = QList<QSqlRecord>{};
+
+    result = execBulkQuery(QStringLiteral("DELETE FROM `Tracks` "
+                                          "WHERE `FileID` IN (%1)"), removedFileIds, noRecords);
+
+    if (!result) {
+        return;
+    }
+
+    result = execBulkQuery(QStringLiteral("DELETE FROM `TracksData` "
+                                          "WHERE `ID` IN (%1)"), removedFileIds, noRecords);
+
+    if (!result) {
+        return;
+    }
+
+    /* the directories of the removed files are kept as long as other files are stored in them */
+    result = execBulkQuery(QStringLiteral("DELETE FROM `Directories` "
+                                          "WHERE `ID` IN (%1) AND "
+                                          "NOT EXISTS (SELECT 1 FROM `TracksData` trackData WHERE trackData.`DirectoryID` = `Directories`.`ID`)"),
+                           removedDirectoryIds, noRecords);
+
+    if (!result) {
+        return;
+    }
+
+    if (d->mHasSearchIndex) {
+        result = execBulkQuery(QStringLiteral("DELETE FROM `TracksSearch` "
+                                              "WHERE `rowid` IN (%1)"), removedTrackIds, noRecords);
+
+        if (!result) {
+            return;
+        }
+    }
+
+    auto modifiedAlbumsRecords = QList<QSqlRecord>{};
+
+    result = execBulkQuery(QStringLiteral("SELECT "
+                                          "album.`ID`, "
+                                          "album.`ArtistName`, "
+                                          "COUNT(tracks.`ID`) "
+                                          "FROM "
+                                          "`Albums` album "
+                                          "LEFT JOIN "
+                                          "`Tracks` tracks "
+                                          "ON "
+                                          "tracks.`AlbumID` = album.`ID` "
+                                          "WHERE "
+                                          "album.`ID` IN (%1) "
+                                          "GROUP BY album.`ID`"), modifiedAlbumIds, modifiedAlbumsRecords);
+
+    if (!result) {
+        return;
+    }
 
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.boundValues();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastError();
+    auto removedAlbumIds = QVariantList{};
+    auto albumsWithoutArtist = QVariantList{};
+
+    for (const auto &oneRecord : qAsConst(modifiedAlbumsRecords)) {
+        if (oneRecord.value(2).toInt() > 0 && !isValidArtist(oneRecord.value(0).toULongLong())) {
+            albumsWithoutArtist.push_back(oneRecord.value(0));
+        }
+    }
+
+    auto artistTracksRecords = QList<QSqlRecord>{};
+
+    result = execBulkQuery(QStringLiteral("SELECT "
+                                          "MIN(tracks.`ID`) "
+                                          "FROM "
+                                          "`Tracks` tracks "
+                                          "WHERE "
+                                          "tracks.`AlbumID` IN (%1) AND "
+                                          "IFNULL(tracks.`AlbumArtistName`, '') <> '' "
+                                          "GROUP BY tracks.`AlbumID`"), albumsWithoutArtist, artistTracksRecords);
+
+    if (!result) {
+        return;
+    }
+
+    /* the album artist may have been defined by a removed track, resolve it again from the remaining ones */
+    for (const auto &oneRecord : qAsConst(artistTracksRecords)) {
+        const auto &oneTrack = internalTrackFromDatabaseId(oneRecord.value(0).toULongLong());
+
+        updateAlbumFromId(oneTrack.albumId(), oneTrack.albumCover(), oneTrack);
+    }
+
+    for (const auto &oneRecord : qAsConst(modifiedAlbumsRecords)) {
+        const auto albumId = oneRecord.value(0).toULongLong();
+
+        if (oneRecord.value(2).toInt() > 0) {
+            updateAlbumSummary(albumId);
+            updateAlbumSearchIndex(albumId);
+            d->mModifiedAlbumIds.insert(albumId);
 
             continue;
         }
 
-        d->mRemoveTracksMapping.finish();
+        removedAlbumIds.push_back(albumId);
+
+        if (!oneRecord.value(1).isNull()) {
+            modifiedArtistNames.insert(oneRecord.value(1).toString());
+        }
     }
 
-    for (auto modifiedAlbumId : modifiedAlbums) {
-        const auto &modifiedAlbumData = internalOneAlbumPartialData(modifiedAlbumId);
+    result = execBulkQuery(QStringLiteral("DELETE FROM `Albums` "
+                                          "WHERE `ID` IN (%1)"), removedAlbumIds, noRecords);
+
+    if (!result) {
+        return;
+    }
 
-        auto tracksCount = fetchTrackIds(modifiedAlbumId).count();
+    if (d->mHasSearchIndex) {
+        result = execBulkQuery(QStringLiteral("DELETE FROM `AlbumsSearch` "
+                                              "WHERE `rowid` IN (%1)"), removedAlbumIds, noRecords);
 
-        if (!modifiedAlbumData.isEmpty() && tracksCount) {
-            Q_EMIT albumModified({{DataTypes::DatabaseIdRole, modifiedAlbumId}}, modifiedAlbumId);
-        } else {
-            removeAlbumInDatabase(modifiedAlbumId);
-            Q_EMIT albumRemoved(modifiedAlbumId);
+        if (!result) {
+            return;
+        }
+    }
+
+    for (const auto &oneAlbumId : qAsConst(removedAlbumIds)) {
+        d->mAlbumIdCache.removeId(oneAlbumId.toULongLong());
+        d->mAlbumLookupIdCache.removeId(oneAlbumId.toULongLong());
+        d->mRemovedAlbums.insert(oneAlbumId.toULongLong());
+    }
+
+    auto artistNames = QVariantList{};
+
+    for (const auto &oneArtistName : qAsConst(modifiedArtistNames)) {
+        artistNames.push_back(oneArtistName);
+    }
+
+    auto removedArtistsRecords = QList<QSqlRecord>{};
 
-            const auto &allTracksFromArtist = internalTracksFromAuthor(modifiedAlbumData[DataTypes::AlbumDataType::key_type::ArtistRole].toString());
-            const auto &allAlbumsFromArtist = internalAlbumIdsFromAuthor(modifiedAlbumData[DataTypes::AlbumDataType::key_type::ArtistRole].toString());
-            const auto &removedArtistId = internalArtistIdFromName(modifiedAlbumData[DataTypes::AlbumDataType::key_type::ArtistRole].toString());
+    result = execBulkQuery(QStringLiteral("SELECT "
+                                          "artist.`ID` "
+                                          "FROM "
+                                          "`Artists` artist "
+                                          "WHERE "
+                                          "artist.`Name` IN (%1) AND "
+                                          "NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`ArtistID` = artist.`ID`) AND "
+                                          "NOT EXISTS (SELECT 1 FROM `Albums` album WHERE album.`ArtistName` = artist.`Name`)"), artistNames, removedArtistsRecords);
 
-            if (removedArtistId != 0 && allTracksFromArtist.isEmpty() && allAlbumsFromArtist.isEmpty()) {
-                removeArtistInDatabase(removedArtistId);
-                Q_EMIT artistRemoved(removedArtistId);
+    if (!result) {
+        return;
+    }
+
+    for (const auto &oneRecord : qAsConst(removedArtistsRecords)) {
+        const auto artistId = oneRecord.value(0).toULongLong();
+
+        removeArtistInDatabase(artistId);
+        d->mRemovedArtists.insert(artistId);
+    }
+
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << removedTracks.size() << "files"
+                                 << removedTracksRecords.size() << "tracks" << removedAlbumIds.size() << "albums"
+                                 << removedArtistsRecords.size() << "artists";
+}
+
+bool DatabaseInterface::execBulkQuery(const QString &queryText, const QVariantList &values, QList<QSqlRecord> &records)
+{
+    for (int chunkStart = 0; chunkStart < values.size(); chunkStart += DatabaseInterfacePrivate::BulkQueryChunkSize) {
+        const auto chunk = values.mid(chunkStart, DatabaseInterfacePrivate::BulkQueryChunkSize);
+
+        QSqlQuery bulkQuery(d->mTracksDatabase);
+
+        auto result = prepareQuery(bulkQuery, queryText.arg(bulkPlaceholders(chunk.size(), QStringLiteral("?"))));
+
+        if (result) {
+            for (const auto &oneValue : chunk) {
+                bulkQuery.addBindValue(oneValue);
             }
+
+            result = execQuery(bulkQuery);
+        }
+
+        if (!result || !bulkQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::execBulkQuery" << bulkQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::execBulkQuery" << bulkQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::execBulkQuery" << bulkQuery.lastError();
+
+            return false;
+        }
+
+        while (bulkQuery.isSelect() && bulkQuery.next()) {
+            records.push_back(bulkQuery.record());
         }
+
+        bulkQuery.finish();
     }
+
+    return true;
 }
 
 QUrl DatabaseInterface::internalAlbumArtUriFromAlbumId(qulonglong albumId)
@@ -7233,6 +12107,10 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
         return result;
     }
 
+    if (d->mLyricistIdCache.find(name, result)) {
+        return result;
+    }
+
     d->mSelectLyricistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
     auto queryResult = execQuery(d->mSelectLyricistByNameQuery);
@@ -7254,6 +12132,8 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
 
         d->mSelectLyricistByNameQuery.finish();
 
+        d->mLyricistIdCache.insert(name, result);
+
         return result;
     }
 
@@ -7278,6 +12158,8 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
 
     result = d->mLyricistId;
 
+    d->mLyricistIdCache.insert(name, result);
+
     ++d->mLyricistId;
 
     d->mInsertLyricistQuery.finish();
@@ -7317,6 +12199,36 @@ QHash<QUrl, QDateTime> DatabaseInterface::internalAllFileName()
     return allFileNames;
 }
 
+DataTypes::DirectoriesStateType DatabaseInterface::internalAllDirectoriesState()
+{
+    auto allDirectories = DataTypes::DirectoriesStateType{};
+
+    auto queryResult = execQuery(d->mSelectAllDirectoriesStateQuery);
+
+    if (!queryResult || !d->mSelectAllDirectoriesStateQuery.isSelect() || !d->mSelectAllDirectoriesStateQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalAllDirectoriesState" << d->mSelectAllDirectoriesStateQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalAllDirectoriesState" << d->mSelectAllDirectoriesStateQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalAllDirectoriesState" << d->mSelectAllDirectoriesStateQuery.lastError();
+
+        d->mSelectAllDirectoriesStateQuery.finish();
+
+        return allDirectories;
+    }
+
+    while(d->mSelectAllDirectoriesStateQuery.next()) {
+        auto &directoryState = allDirectories[d->mSelectAllDirectoriesStateQuery.value(0).toString()];
+
+        directoryState.mModifiedTime = QDateTime::fromMSecsSinceEpoch(d->mSelectAllDirectoriesStateQuery.value(1).toLongLong());
+        directoryState.mEntriesCount = d->mSelectAllDirectoriesStateQuery.value(2).toInt();
+    }
+
+    d->mSelectAllDirectoriesStateQuery.finish();
+
+    return allDirectories;
+}
+
 qulonglong DatabaseInterface::internalArtistIdFromName(const QString &name)
 {
     auto result = qulonglong(0);
@@ -7325,6 +12237,10 @@ qulonglong DatabaseInterface::internalArtistIdFromName(const QString &name)
         return result;
     }
 
+    if (d->mArtistIdCache.find(name, result)) {
+        return result;
+    }
+
     d->mSelectArtistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
     auto queryResult = execQuery(d->mSelectArtistByNameQuery);
@@ -7351,6 +12267,8 @@ qulonglong DatabaseInterface::internalArtistIdFromName(const QString &name)
 
     d->mSelectArtistByNameQuery.finish();
 
+    d->mArtistIdCache.insert(name, result);
+
     return result;
 }
 
@@ -7369,15 +12287,22 @@ void DatabaseInterface::removeTrackInDatabase(qulonglong trackId)
     }
 
     d->mRemoveTrackQuery.finish();
+
+    removeTrackSearchIndex(trackId);
 }
 
 void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath)
 {
-    d->mUpdateTrackQuery.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
+    DatabaseInterfacePrivate::bindFileName(d->mUpdateTrackQuery, oneTrack.resourceURI());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":trackId"), oneTrack.databaseId());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":title"), oneTrack.title());
-    insertArtist(oneTrack.artist());
+    const auto artistId = insertArtist(oneTrack.artist());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistName"), oneTrack.artist());
+    if (artistId != 0) {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistId"), artistId);
+    } else {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistId"), {});
+    }
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumTitle"), oneTrack.album());
     if (oneTrack.hasAlbumArtist()) {
         d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumArtistName"), oneTrack.albumArtist());
@@ -7385,6 +12310,11 @@ void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &on
         d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumArtistName"), {});
     }
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumPath"), albumPath);
+    if (oneTrack.albumId() != 0) {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumId"), oneTrack.albumId());
+    } else {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumId"), {});
+    }
     if (oneTrack.hasTrackNumber()) {
         d->mUpdateTrackQuery.bindValue(QStringLiteral(":trackNumber"), oneTrack.trackNumber());
     } else {
@@ -7397,20 +12327,23 @@ void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &on
     }
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":trackDuration"), QVariant::fromValue<qlonglong>(oneTrack.duration().msecsSinceStartOfDay()));
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":trackRating"), oneTrack.rating());
-    if (insertGenre(oneTrack.genre()) != 0) {
-        d->mUpdateTrackQuery.bindValue(QStringLiteral(":genre"), oneTrack.genre());
+    const auto genreId = insertGenre(oneTrack.genre());
+    if (genreId != 0) {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":genreId"), genreId);
     } else {
-        d->mUpdateTrackQuery.bindValue(QStringLiteral(":genre"), {});
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":genreId"), {});
     }
-    if (insertComposer(oneTrack.composer()) != 0) {
-        d->mUpdateTrackQuery.bindValue(QStringLiteral(":composer"), oneTrack.composer());
+    const auto composerId = insertComposer(oneTrack.composer());
+    if (composerId != 0) {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":composerId"), composerId);
     } else {
-        d->mUpdateTrackQuery.bindValue(QStringLiteral(":composer"), {});
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":composerId"), {});
     }
-    if (insertLyricist(oneTrack.lyricist()) != 0) {
-        d->mUpdateTrackQuery.bindValue(QStringLiteral(":lyricist"), oneTrack.lyricist());
+    const auto lyricistId = insertLyricist(oneTrack.lyricist());
+    if (lyricistId != 0) {
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":lyricistId"), lyricistId);
     } else {
-        d->mUpdateTrackQuery.bindValue(QStringLiteral(":lyricist"), {});
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":lyricistId"), {});
     }
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":comment"), oneTrack.comment());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":year"), oneTrack.year());
@@ -7504,6 +12437,9 @@ void DatabaseInterface::removeRadio(qulonglong radioId)
 
 void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
 {
+    d->mAlbumIdCache.removeId(albumId);
+    d->mAlbumLookupIdCache.removeId(albumId);
+
     d->mRemoveAlbumQuery.bindValue(QStringLiteral(":albumId"), albumId);
 
     auto result = execQuery(d->mRemoveAlbumQuery);
@@ -7517,10 +12453,14 @@ void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
     }
 
     d->mRemoveAlbumQuery.finish();
+
+    removeAlbumSearchIndex(albumId);
 }
 
 void DatabaseInterface::removeArtistInDatabase(qulonglong artistId)
 {
+    d->mArtistIdCache.removeId(artistId);
+
     d->mRemoveArtistQuery.bindValue(QStringLiteral(":artistId"), artistId);
 
     auto result = execQuery(d->mRemoveArtistQuery);
@@ -7540,6 +12480,20 @@ void DatabaseInterface::reloadExistingDatabase()
 {
     qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::reloadExistingDatabase";
 
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    reloadIdCounters();
+
+    d->mDataVersion = currentDataVersion();
+
+    finishTransaction();
+}
+
+void DatabaseInterface::reloadIdCounters()
+{
     d->mArtistId = genericInitialId(d->mQueryMaximumArtistIdQuery);
     d->mComposerId = genericInitialId(d->mQueryMaximumComposerIdQuery);
     d->mLyricistId = genericInitialId(d->mQueryMaximumLyricistIdQuery);
@@ -7552,27 +12506,17 @@ qulonglong DatabaseInterface::genericInitialId(QSqlQuery &request)
 {
     auto result = qulonglong(0);
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return result;
-    }
-
     auto queryResult = execQuery(request);
 
     if (!queryResult || !request.isSelect() || !request.isActive()) {
         Q_EMIT databaseError();
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << request.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << request.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertMusicSource" << request.lastError();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::genericInitialId" << request.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::genericInitialId" << request.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::genericInitialId" << request.lastError();
 
         request.finish();
 
-        transactionResult = finishTransaction();
-        if (!transactionResult) {
-            return result;
-        }
-
         return result;
     }
 
@@ -7582,11 +12526,6 @@ qulonglong DatabaseInterface::genericInitialId(QSqlQuery &request)
         request.finish();
     }
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return result;
-    }
-
     return result;
 }
 
@@ -7621,6 +12560,12 @@ qulonglong DatabaseInterface::internalAlbumIdFromTitleAndArtist(const QString &t
 {
     auto result = qulonglong(0);
 
+    const auto albumKey = std::make_tuple(title, artist, albumPath);
+
+    if (d->mAlbumLookupIdCache.find(albumKey, result)) {
+        return result;
+    }
+
     d->mSelectAlbumIdFromTitleQuery.bindValue(QStringLiteral(":title"), title);
     d->mSelectAlbumIdFromTitleQuery.bindValue(QStringLiteral(":artistName"), artist);
 
@@ -7669,6 +12614,10 @@ qulonglong DatabaseInterface::internalAlbumIdFromTitleAndArtist(const QString &t
         d->mSelectAlbumIdFromTitleWithoutArtistQuery.finish();
     }
 
+    if (result != 0) {
+        d->mAlbumLookupIdCache.insert(albumKey, result);
+    }
+
     return result;
 }
 
@@ -7816,30 +12765,32 @@ qulonglong DatabaseInterface::internalTrackIdFromFileName(const QUrl &fileName)
         return result;
     }
 
-    d->mSelectTracksMapping.bindValue(QStringLiteral(":fileName"), fileName.toString());
+    auto &currentQuery = queryForCurrentThread(d->mSelectTracksMapping);
 
-    auto queryResult = execQuery(d->mSelectTracksMapping);
+    DatabaseInterfacePrivate::bindFileName(currentQuery, fileName);
 
-    if (!queryResult || !d->mSelectTracksMapping.isSelect() || !d->mSelectTracksMapping.isActive()) {
+    auto queryResult = execQuery(currentQuery);
+
+    if (!queryResult || !currentQuery.isSelect() || !currentQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMapping.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMapping.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectTracksMapping.lastError();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << currentQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << currentQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << currentQuery.lastError();
 
-        d->mSelectTracksMapping.finish();
+        currentQuery.finish();
 
         return result;
     }
 
-    if (d->mSelectTracksMapping.next()) {
-        const auto &currentRecordValue = d->mSelectTracksMapping.record().value(0);
+    if (currentQuery.next()) {
+        const auto &currentRecordValue = currentQuery.record().value(0);
         if (currentRecordValue.isValid()) {
             result = currentRecordValue.toULongLong();
         }
     }
 
-    d->mSelectTracksMapping.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -7852,30 +12803,32 @@ qulonglong DatabaseInterface::internalRadioIdFromHttpAddress(const QString &http
         return result;
     }
 
-    d->mSelectRadioIdFromHttpAddress.bindValue(QStringLiteral(":httpAddress"), httpAddress);
+    auto &currentQuery = queryForCurrentThread(d->mSelectRadioIdFromHttpAddress);
+
+    currentQuery.bindValue(QStringLiteral(":httpAddress"), httpAddress);
 
-    auto queryResult = execQuery(d->mSelectRadioIdFromHttpAddress);
+    auto queryResult = execQuery(currentQuery);
 
-    if (!queryResult || !d->mSelectRadioIdFromHttpAddress.isSelect() || !d->mSelectRadioIdFromHttpAddress.isActive()) {
+    if (!queryResult || !currentQuery.isSelect() || !currentQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectRadioIdFromHttpAddress.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectRadioIdFromHttpAddress.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << d->mSelectRadioIdFromHttpAddress.lastError();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << currentQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << currentQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdFromFileName" << currentQuery.lastError();
 
-        d->mSelectRadioIdFromHttpAddress.finish();
+        currentQuery.finish();
 
         return result;
     }
 
-    if (d->mSelectRadioIdFromHttpAddress.next()) {
-        const auto &currentRecordValue = d->mSelectRadioIdFromHttpAddress.record().value(0);
+    if (currentQuery.next()) {
+        const auto &currentRecordValue = currentQuery.record().value(0);
         if (currentRecordValue.isValid()) {
             result = currentRecordValue.toULongLong();
         }
     }
 
-    d->mSelectRadioIdFromHttpAddress.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -7884,27 +12837,29 @@ DataTypes::ListTrackDataType DatabaseInterface::internalTracksFromAuthor(const Q
 {
     auto allTracks = DataTypes::ListTrackDataType{};
 
-    d->mSelectTracksFromArtist.bindValue(QStringLiteral(":artistName"), ArtistName);
+    auto &currentQuery = queryForCurrentThread(d->mSelectTracksFromArtist);
 
-    auto result = execQuery(d->mSelectTracksFromArtist);
+    currentQuery.bindValue(QStringLiteral(":artistName"), ArtistName);
 
-    if (!result || !d->mSelectTracksFromArtist.isSelect() || !d->mSelectTracksFromArtist.isActive()) {
+    auto result = execQuery(currentQuery);
+
+    if (!result || !currentQuery.isSelect() || !currentQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectTracksFromArtist.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectTracksFromArtist.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << d->mSelectTracksFromArtist.lastError();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << currentQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << currentQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromAuthor" << currentQuery.lastError();
 
         return allTracks;
     }
 
-    while (d->mSelectTracksFromArtist.next()) {
-        const auto &currentRecord = d->mSelectTracksFromArtist.record();
+    while (currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
         allTracks.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
     }
 
-    d->mSelectTracksFromArtist.finish();
+    currentQuery.finish();
 
     return allTracks;
 }
@@ -7913,27 +12868,29 @@ DataTypes::ListTrackDataType DatabaseInterface::internalTracksFromGenre(const QS
 {
     auto allTracks = DataTypes::ListTrackDataType{};
 
-    d->mSelectTracksFromGenre.bindValue(QStringLiteral(":genre"), genre);
+    auto &currentQuery = queryForCurrentThread(d->mSelectTracksFromGenre);
+
+    currentQuery.bindValue(QStringLiteral(":genre"), genre);
 
-    auto result = execQuery(d->mSelectTracksFromGenre);
+    auto result = execQuery(currentQuery);
 
-    if (!result || !d->mSelectTracksFromGenre.isSelect() || !d->mSelectTracksFromGenre.isActive()) {
+    if (!result || !currentQuery.isSelect() || !currentQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromGenre" << d->mSelectTracksFromGenre.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromGenre" << d->mSelectTracksFromGenre.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromGenre" << d->mSelectTracksFromGenre.lastError();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromGenre" << currentQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromGenre" << currentQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromGenre" << currentQuery.lastError();
 
         return allTracks;
     }
 
-    while (d->mSelectTracksFromGenre.next()) {
-        const auto &currentRecord = d->mSelectTracksFromGenre.record();
+    while (currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
         allTracks.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
     }
 
-    d->mSelectTracksFromGenre.finish();
+    currentQuery.finish();
 
     return allTracks;
 }
@@ -7968,7 +12925,7 @@ QList<qulonglong> DatabaseInterface::internalAlbumIdsFromAuthor(const QString &A
     return allAlbumIds;
 }
 
-DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(QSqlQuery &artistsQuery)
+DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(DatabaseStatement &artistsQuery)
 {
     auto result = DataTypes::ListArtistDataType{};
 
@@ -7994,7 +12951,7 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(Q
     return result;
 }
 
-DataTypes::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(QSqlQuery &query)
+DataTypes::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(DatabaseStatement &query)
 {
     auto result = DataTypes::ListAlbumDataType{};
 
@@ -8046,14 +13003,16 @@ DataTypes::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglo
 {
     auto result = DataTypes::AlbumDataType{};
 
-    d->mSelectAlbumQuery.bindValue(QStringLiteral(":albumId"), databaseId);
+    auto &currentQuery = queryForCurrentThread(d->mSelectAlbumQuery);
 
-    if (!internalGenericPartialData(d->mSelectAlbumQuery)) {
+    currentQuery.bindValue(QStringLiteral(":albumId"), databaseId);
+
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    if (d->mSelectAlbumQuery.next()) {
-        const auto &currentRecord = d->mSelectAlbumQuery.record();
+    if (currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
         result[DataTypes::DatabaseIdRole] = currentRecord.value(0);
         result[DataTypes::TitleRole] = currentRecord.value(1);
@@ -8086,7 +13045,7 @@ DataTypes::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglo
 
     }
 
-    d->mSelectAlbumQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8095,19 +13054,58 @@ DataTypes::ListTrackDataType DatabaseInterface::internalAllTracksPartialData()
 {
     auto result = DataTypes::ListTrackDataType{};
 
-    if (!internalGenericPartialData(d->mSelectAllTracksQuery)) {
+    auto &currentQuery = queryForCurrentThread(d->mSelectAllTracksQuery);
+
+    if (!internalGenericPartialData(currentQuery)) {
+        return result;
+    }
+
+    while(currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
+
+        auto newData = buildTrackDataFromDatabaseRecord(currentRecord);
+
+        result.push_back(newData);
+    }
+
+    currentQuery.finish();
+
+    return result;
+}
+
+DataTypes::ListAlbumDataType DatabaseInterface::internalAlbumsPagePartialData(const QString &lastTitle, qulonglong lastDatabaseId, int count)
+{
+    auto &currentQuery = queryForCurrentThread(d->mSelectAlbumsShortPageQuery);
+
+    currentQuery.bindValue(QStringLiteral(":lastTitle"), lastTitle);
+    currentQuery.bindValue(QStringLiteral(":lastAlbumId"), lastDatabaseId);
+    currentQuery.bindValue(QStringLiteral(":count"), count);
+
+    return internalAllAlbumsPartialData(currentQuery);
+}
+
+DataTypes::ListTrackDataType DatabaseInterface::internalTracksPagePartialData(const QString &lastFileName, int count)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    auto &currentQuery = queryForCurrentThread(d->mSelectTracksPageQuery);
+
+    currentQuery.bindValue(QStringLiteral(":lastFileName"), lastFileName);
+    currentQuery.bindValue(QStringLiteral(":count"), count);
+
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    while(d->mSelectAllTracksQuery.next()) {
-        const auto &currentRecord = d->mSelectAllTracksQuery.record();
+    while(currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
         auto newData = buildTrackDataFromDatabaseRecord(currentRecord);
 
         result.push_back(newData);
     }
 
-    d->mSelectAllTracksQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8116,19 +13114,21 @@ DataTypes::ListRadioDataType DatabaseInterface::internalAllRadiosPartialData()
 {
     auto result = DataTypes::ListRadioDataType{};
 
-    if (!internalGenericPartialData(d->mSelectAllRadiosQuery)) {
+    auto &currentQuery = queryForCurrentThread(d->mSelectAllRadiosQuery);
+
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    while(d->mSelectAllRadiosQuery.next()) {
-        const auto &currentRecord = d->mSelectAllRadiosQuery.record();
+    while(currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
         auto newData = buildRadioDataFromDatabaseRecord(currentRecord);
 
         result.push_back(newData);
     }
 
-    d->mSelectAllRadiosQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8137,21 +13137,23 @@ DataTypes::ListTrackDataType DatabaseInterface::internalRecentlyPlayedTracksData
 {
     auto result = DataTypes::ListTrackDataType{};
 
-    d->mSelectAllRecentlyPlayedTracksQuery.bindValue(QStringLiteral(":maximumResults"), count);
+    auto &currentQuery = queryForCurrentThread(d->mSelectAllRecentlyPlayedTracksQuery);
 
-    if (!internalGenericPartialData(d->mSelectAllRecentlyPlayedTracksQuery)) {
+    currentQuery.bindValue(QStringLiteral(":maximumResults"), count);
+
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    while(d->mSelectAllRecentlyPlayedTracksQuery.next()) {
-        const auto &currentRecord = d->mSelectAllRecentlyPlayedTracksQuery.record();
+    while(currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
         auto newData = buildTrackDataFromDatabaseRecord(currentRecord);
 
         result.push_back(newData);
     }
 
-    d->mSelectAllRecentlyPlayedTracksQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8160,21 +13162,23 @@ DataTypes::ListTrackDataType DatabaseInterface::internalFrequentlyPlayedTracksDa
 {
     auto result = DataTypes::ListTrackDataType{};
 
-    d->mSelectAllFrequentlyPlayedTracksQuery.bindValue(QStringLiteral(":maximumResults"), count);
+    auto &currentQuery = queryForCurrentThread(d->mSelectAllFrequentlyPlayedTracksQuery);
+
+    currentQuery.bindValue(QStringLiteral(":maximumResults"), count);
 
-    if (!internalGenericPartialData(d->mSelectAllFrequentlyPlayedTracksQuery)) {
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    while(d->mSelectAllFrequentlyPlayedTracksQuery.next()) {
-        const auto &currentRecord = d->mSelectAllFrequentlyPlayedTracksQuery.record();
+    while(currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
         auto newData = buildTrackDataFromDatabaseRecord(currentRecord);
 
         result.push_back(newData);
     }
 
-    d->mSelectAllFrequentlyPlayedTracksQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8183,19 +13187,21 @@ DataTypes::TrackDataType DatabaseInterface::internalOneTrackPartialData(qulonglo
 {
     auto result = DataTypes::TrackDataType{};
 
-    d->mSelectTrackFromIdQuery.bindValue(QStringLiteral(":trackId"), databaseId);
+    auto &currentQuery = queryForCurrentThread(d->mSelectTrackFromIdQuery);
 
-    if (!internalGenericPartialData(d->mSelectTrackFromIdQuery)) {
+    currentQuery.bindValue(QStringLiteral(":trackId"), databaseId);
+
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    if (d->mSelectTrackFromIdQuery.next()) {
-        const auto &currentRecord = d->mSelectTrackFromIdQuery.record();
+    if (currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
         result = buildTrackDataFromDatabaseRecord(currentRecord);
     }
 
-    d->mSelectTrackFromIdQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8204,20 +13210,24 @@ DataTypes::TrackDataType DatabaseInterface::internalOneTrackPartialDataByIdAndUr
 {
     auto result = DataTypes::TrackDataType{};
 
-    d->mSelectTrackFromIdAndUrlQuery.bindValue(QStringLiteral(":trackId"), databaseId);
-    d->mSelectTrackFromIdAndUrlQuery.bindValue(QStringLiteral(":trackUrl"), trackUrl);
+    auto &currentQuery = queryForCurrentThread(d->mSelectTrackFromIdAndUrlQuery);
 
-    if (!internalGenericPartialData(d->mSelectTrackFromIdAndUrlQuery)) {
+    currentQuery.bindValue(QStringLiteral(":trackId"), databaseId);
+    const auto &[trackDirectory, trackBaseName] = DatabaseInterfacePrivate::splitFileName(trackUrl.toString());
+    currentQuery.bindValue(QStringLiteral(":trackDirectory"), trackDirectory);
+    currentQuery.bindValue(QStringLiteral(":trackBaseName"), trackBaseName);
+
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    if (d->mSelectTrackFromIdAndUrlQuery.next()) {
-        const auto &currentRecord = d->mSelectTrackFromIdAndUrlQuery.record();
+    if (currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
         result = buildTrackDataFromDatabaseRecord(currentRecord);
     }
 
-    d->mSelectTrackFromIdAndUrlQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8226,19 +13236,21 @@ DataTypes::TrackDataType DatabaseInterface::internalOneRadioPartialData(qulonglo
 {
     auto result = DataTypes::TrackDataType{};
 
-    d->mSelectRadioFromIdQuery.bindValue(QStringLiteral(":radioId"), databaseId);
+    auto &currentQuery = queryForCurrentThread(d->mSelectRadioFromIdQuery);
+
+    currentQuery.bindValue(QStringLiteral(":radioId"), databaseId);
 
-    if (!internalGenericPartialData(d->mSelectRadioFromIdQuery)) {
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    if (d->mSelectRadioFromIdQuery.next()) {
-        const auto &currentRecord = d->mSelectRadioFromIdQuery.record();
+    if (currentQuery.next()) {
+        const auto &currentRecord = currentQuery.record();
 
         result = buildRadioDataFromDatabaseRecord(currentRecord);
     }
 
-    d->mSelectRadioFromIdQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8247,14 +13259,16 @@ DataTypes::ListGenreDataType DatabaseInterface::internalAllGenresPartialData()
 {
     DataTypes::ListGenreDataType result;
 
-    if (!internalGenericPartialData(d->mSelectAllGenresQuery)) {
+    auto &currentQuery = queryForCurrentThread(d->mSelectAllGenresQuery);
+
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    while(d->mSelectAllGenresQuery.next()) {
+    while(currentQuery.next()) {
         auto newData = DataTypes::GenreDataType{};
 
-        const auto &currentRecord = d->mSelectAllGenresQuery.record();
+        const auto &currentRecord = currentQuery.record();
 
         newData[DataTypes::DatabaseIdRole] = currentRecord.value(0);
         newData[DataTypes::TitleRole] = currentRecord.value(1);
@@ -8263,7 +13277,7 @@ DataTypes::ListGenreDataType DatabaseInterface::internalAllGenresPartialData()
         result.push_back(newData);
     }
 
-    d->mSelectAllGenresQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8272,14 +13286,16 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllComposersPartialData
 {
     DataTypes::ListArtistDataType result;
 
-    if (!internalGenericPartialData(d->mSelectAllComposersQuery)) {
+    auto &currentQuery = queryForCurrentThread(d->mSelectAllComposersQuery);
+
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    while(d->mSelectAllComposersQuery.next()) {
+    while(currentQuery.next()) {
         auto newData = DataTypes::ArtistDataType{};
 
-        const auto &currentRecord = d->mSelectAllComposersQuery.record();
+        const auto &currentRecord = currentQuery.record();
 
         newData[DataTypes::DatabaseIdRole] = currentRecord.value(0);
         newData[DataTypes::TitleRole] = currentRecord.value(1);
@@ -8288,7 +13304,7 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllComposersPartialData
         result.push_back(newData);
     }
 
-    d->mSelectAllComposersQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8297,14 +13313,16 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllLyricistsPartialData
 {
     DataTypes::ListArtistDataType result;
 
-    if (!internalGenericPartialData(d->mSelectAllLyricistsQuery)) {
+    auto &currentQuery = queryForCurrentThread(d->mSelectAllLyricistsQuery);
+
+    if (!internalGenericPartialData(currentQuery)) {
         return result;
     }
 
-    while(d->mSelectAllLyricistsQuery.next()) {
+    while(currentQuery.next()) {
         auto newData = DataTypes::ArtistDataType{};
 
-        const auto &currentRecord = d->mSelectAllLyricistsQuery.record();
+        const auto &currentRecord = currentQuery.record();
 
         newData[DataTypes::DatabaseIdRole] = currentRecord.value(0);
         newData[DataTypes::TitleRole] = currentRecord.value(1);
@@ -8313,7 +13331,7 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllLyricistsPartialData
         result.push_back(newData);
     }
 
-    d->mSelectAllLyricistsQuery.finish();
+    currentQuery.finish();
 
     return result;
 }
@@ -8324,15 +13342,34 @@ bool DatabaseInterface::prepareQuery(QSqlQuery &query, const QString &queryText)
     return query.prepare(queryText);
 }
 
+bool DatabaseInterface::prepareQuery(DatabaseStatement &statement, const QString &queryText) const
+{
+    statement.setQueryText(queryText);
+    return true;
+}
+
 bool DatabaseInterface::execQuery(QSqlQuery &query)
 {
+    const auto isStatisticsEnabled = d->mStatistics.isEnabled();
+
 #if !defined NDEBUG
-    auto timer = QElapsedTimer{};
-    timer.start();
+    const auto isTimed = true;
+#else
+    const auto isTimed = isStatisticsEnabled;
 #endif
 
+    auto timer = QElapsedTimer{};
+    if (isTimed) {
+        timer.start();
+    }
+
     auto result = query.exec();
 
+    if (isStatisticsEnabled) {
+        d->mStatistics.addExecution(query.lastQuery(), timer.nsecsElapsed(),
+                                    (result && !query.isSelect()) ? std::max(query.numRowsAffected(), 0) : 0);
+    }
+
 #if !defined NDEBUG
     if (timer.nsecsElapsed() > 10000000) {
         qCDebug(orgKdeElisaDatabase) << "[[" << timer.nsecsElapsed() << "]]" << query.lastQuery();
@@ -8343,9 +13380,14 @@ bool DatabaseInterface::execQuery(QSqlQuery &query)
 }
 
 void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &title,
-                                          const QString &albumPath,
                                           const QString &artistName)
 {
+    auto &albumLookupIds = d->mAlbumLookupIdCache.mIds;
+    for (auto itAlbum = albumLookupIds.lower_bound(std::make_tuple(title, QString{}, QString{}));
+         itAlbum != albumLookupIds.end() && std::get<0>(itAlbum->first) == title; ) {
+        itAlbum = albumLookupIds.erase(itAlbum);
+    }
+
     d->mUpdateAlbumArtistQuery.bindValue(QStringLiteral(":albumId"), albumId);
     insertArtist(artistName);
     d->mUpdateAlbumArtistQuery.bindValue(QStringLiteral(":artistName"), artistName);
@@ -8366,8 +13408,7 @@ void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &tit
 
     d->mUpdateAlbumArtistQuery.finish();
 
-    d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":albumTitle"), title);
-    d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":albumPath"), albumPath);
+    d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":albumId"), albumId);
     d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":artistName"), artistName);
 
     queryResult = execQuery(d->mUpdateAlbumArtistInTracksQuery);
@@ -8387,10 +13428,12 @@ void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &tit
     d->mUpdateAlbumArtistInTracksQuery.finish();
 }
 
-void DatabaseInterface::updateTrackStatistics(const QUrl &fileName, const QDateTime &time)
+void DatabaseInterface::updateTrackStatistics(const QUrl &fileName, const QDateTime &firstPlayTime,
+                                              const QDateTime &lastPlayTime, int playCount)
 {
-    d->mUpdateTrackStatistics.bindValue(QStringLiteral(":fileName"), fileName);
-    d->mUpdateTrackStatistics.bindValue(QStringLiteral(":playDate"), time.toMSecsSinceEpoch());
+    DatabaseInterfacePrivate::bindFileName(d->mUpdateTrackStatistics, fileName);
+    d->mUpdateTrackStatistics.bindValue(QStringLiteral(":playDate"), lastPlayTime.toMSecsSinceEpoch());
+    d->mUpdateTrackStatistics.bindValue(QStringLiteral(":playCount"), playCount);
 
     auto queryResult = execQuery(d->mUpdateTrackStatistics);
 
@@ -8408,8 +13451,8 @@ void DatabaseInterface::updateTrackStatistics(const QUrl &fileName, const QDateT
 
     d->mUpdateTrackStatistics.finish();
 
-    d->mUpdateTrackFirstPlayStatistics.bindValue(QStringLiteral(":fileName"), fileName);
-    d->mUpdateTrackFirstPlayStatistics.bindValue(QStringLiteral(":playDate"), time.toMSecsSinceEpoch());
+    DatabaseInterfacePrivate::bindFileName(d->mUpdateTrackFirstPlayStatistics, fileName);
+    d->mUpdateTrackFirstPlayStatistics.bindValue(QStringLiteral(":playDate"), firstPlayTime.toMSecsSinceEpoch());
 
     queryResult = execQuery(d->mUpdateTrackFirstPlayStatistics);
 
@@ -8426,6 +13469,51 @@ void DatabaseInterface::updateTrackStatistics(const QUrl &fileName, const QDateT
     }
 
     d->mUpdateTrackFirstPlayStatistics.finish();
+
+    if (lastPlayTime.toMSecsSinceEpoch() - d->mPlayScoreReference > DatabaseInterfacePrivate::MaximumPlayScoreAge) {
+        decayPlayScores(lastPlayTime.toMSecsSinceEpoch());
+    }
+
+    DatabaseInterfacePrivate::bindFileName(d->mInsertTrackPlayScoreQuery, fileName);
+
+    queryResult = execQuery(d->mInsertTrackPlayScoreQuery);
+
+    if (!queryResult || !d->mInsertTrackPlayScoreQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mInsertTrackPlayScoreQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mInsertTrackPlayScoreQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mInsertTrackPlayScoreQuery.lastError();
+
+        d->mInsertTrackPlayScoreQuery.finish();
+
+        return;
+    }
+
+    d->mInsertTrackPlayScoreQuery.finish();
+
+    const auto playWeight = [this](const QDateTime &playTime) {
+        return std::exp2(double(playTime.toMSecsSinceEpoch() - d->mPlayScoreReference) / DatabaseInterfacePrivate::PlayScoreHalfLife);
+    };
+
+    DatabaseInterfacePrivate::bindFileName(d->mUpdateTrackPlayScoreQuery, fileName);
+    d->mUpdateTrackPlayScoreQuery.bindValue(QStringLiteral(":scoreIncrement"), playWeight(firstPlayTime) + (playCount - 1) * playWeight(lastPlayTime));
+
+    queryResult = execQuery(d->mUpdateTrackPlayScoreQuery);
+
+    if (!queryResult || !d->mUpdateTrackPlayScoreQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackPlayScoreQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackPlayScoreQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdateTrackPlayScoreQuery.lastError();
+
+        d->mUpdateTrackPlayScoreQuery.finish();
+
+        return;
+    }
+
+    d->mUpdateTrackPlayScoreQuery.finish();
 }
 
 
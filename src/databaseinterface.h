@@ -30,10 +30,16 @@
 #include <QUrl>
 #include <QDateTime>
 
+#include <functional>
 #include <memory>
 #include <optional>
 
 class DatabaseInterfacePrivate;
+class DatabaseReadConnection;
+class DatabaseStatement;
+template <typename Key>
+class DatabaseIdCache;
+class QSqlDatabase;
 class QSqlRecord;
 class QSqlQuery;
 
@@ -50,19 +56,44 @@ public:
         V13 = 13,
         V14 = 14,
         V15 = 15,
-        V16 = 16, //Does not exist yet, for testing purpose only.
+        V16 = 16,
+        V17 = 17,
+        V18 = 18,
+        V19 = 19,
+        V20 = 20,
+        V21 = 21,
+        V22 = 22,
+        V23 = 23,
+        V24 = 24,
+        V25 = 25,
+        V26 = 26,
+    };
+
+    // negative values are sized at init from the database file size and the physical memory
+    struct StorageSettings
+    {
+        qlonglong mCacheSize = -1; // KiB per connection
+
+        qlonglong mMemoryMapSize = -1; // bytes, 0 disables memory mapping
+
+        int mTempStore = -1; // SQLite temp_store: 0 default, 1 file, 2 memory
     };
 
     explicit DatabaseInterface(QObject *parent = nullptr);
 
     ~DatabaseInterface() override;
 
-    Q_INVOKABLE void init(const QString &dbName, const QString &databaseFileName = {});
+    Q_INVOKABLE void init(const QString &dbName, const QString &databaseFileName = {},
+                          const DatabaseInterface::StorageSettings &storageSettings = {});
 
     qulonglong albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath);
 
     DataTypes::ListTrackDataType allTracksData();
 
+    DataTypes::ListTrackDataType allTracksDataAfter(const QString &lastFileName, int count);
+
+    qulonglong allTracksDataByPages(int count, const std::function<void(const DataTypes::ListTrackDataType&)> &pageReady);
+
     DataTypes::ListRadioDataType allRadiosData();
 
     DataTypes::ListTrackDataType recentlyPlayedTracksData(int count);
@@ -71,6 +102,10 @@ public:
 
     DataTypes::ListAlbumDataType allAlbumsData();
 
+    DataTypes::ListAlbumDataType allAlbumsDataAfter(const QString &lastTitle, qulonglong lastDatabaseId, int count);
+
+    qulonglong allAlbumsDataByPages(int count, const std::function<void(const DataTypes::ListAlbumDataType&)> &pageReady);
+
     DataTypes::ListAlbumDataType allAlbumsDataByGenreAndArtist(const QString &genre, const QString &artist);
 
     DataTypes::ListAlbumDataType allAlbumsDataByArtist(const QString &artist);
@@ -81,6 +116,8 @@ public:
 
     DataTypes::ListArtistDataType allArtistsData();
 
+    DataTypes::ListArtistDataType allArtistsData(qulonglong &generation);
+
     DataTypes::ListArtistDataType allArtistsDataByGenre(const QString &genre);
 
     DataTypes::ListGenreDataType allGenresData();
@@ -103,22 +140,49 @@ public:
 
     qulonglong radioIdFromFileName(const QUrl &fileName);
 
+    DataTypes::ListTrackDataType tracksDataFromDatabaseIds(const QList<qulonglong> &ids);
+
+    qulonglong databaseGeneration() const;
+
+    bool changesSince(qulonglong sequenceNumber, DataTypes::DatabaseChanges &changes) const;
+
+    bool journaledChangesSince(qulonglong generation, DataTypes::DatabaseChanges &changes);
+
+    bool isStatisticsEnabled() const;
+
+    void setStatisticsEnabled(bool enabled);
+
+    void resetStatistics();
+
+    QString statisticsReport() const;
+
+    void dumpStatistics() const;
+
+    bool hasSearchIndex() const;
+
+    QList<qulonglong> searchTracks(const QString &searchText, int maximumCount = -1);
+
+    QList<qulonglong> searchAlbums(const QString &searchText, int maximumCount = -1);
+
     void applicationAboutToQuit();
 
+    void setMaintenanceAllowed(bool allowed);
+
 Q_SIGNALS:
 
-    void artistsAdded(const DataTypes::ListArtistDataType &newArtists);
+    void artistsAdded(const DataTypes::ListArtistDataType &newArtists, qulonglong sequenceNumber);
 
     void composersAdded(const DataTypes::ListArtistDataType &newComposers);
 
     void lyricistsAdded(const DataTypes::ListArtistDataType &newLyricists);
 
-    void albumsAdded(const DataTypes::ListAlbumDataType &newAlbums);
+    void albumsAdded(const DataTypes::ListAlbumDataType &newAlbums, qulonglong sequenceNumber);
 
-    void tracksAdded(const DataTypes::ListTrackDataType &allTracks);
+    void tracksAdded(const DataTypes::ListTrackDataType &allTracks, qulonglong sequenceNumber);
 
     void genresAdded(const DataTypes::ListGenreDataType &allGenres);
 
+    /* deprecated: the models follow databaseChanged, these are only emitted while one of them is connected */
     void artistRemoved(qulonglong removedArtistId);
 
     void albumRemoved(qulonglong removedAlbumId);
@@ -129,12 +193,18 @@ Q_SIGNALS:
 
     void trackModified(const DataTypes::TrackDataType &modifiedTrack);
 
+    void databaseChanged(const DataTypes::DatabaseChanges &changes);
+
+    void maintenanceFinished(qlonglong freedPages, qint64 duration, bool statisticsRebuilt);
+
     void requestsInitDone();
 
     void databaseError();
 
     void restoredTracks(const QHash<QUrl, QDateTime> &allFiles);
 
+    void restoredDirectoriesState(const DataTypes::DirectoriesStateType &allDirectories);
+
     void cleanedDatabase();
 
     void finishInsertingTracksList();
@@ -153,12 +223,18 @@ public Q_SLOTS:
 
     void removeTracksList(const QList<QUrl> &removedTracks);
 
+    void moveTrackFile(const QUrl &oldFileName, const QUrl &newFileName);
+
     void askRestoredTracks();
 
+    void updateDirectoriesState(const DataTypes::DirectoriesStateType &modifiedDirectories, const QStringList &removedDirectories);
+
     void trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time);
 
     void clearData();
 
+    void startMaintenance();
+
     void insertRadio(const DataTypes::TrackDataType &oneTrack);
 
     void removeRadio(qulonglong radioId);
@@ -176,12 +252,43 @@ private:
 
     void recordModifiedAlbum(qulonglong albumId);
 
+    DataTypes::DatabaseChanges collectChanges() const;
+
+    void publishChanges(DataTypes::DatabaseChanges changes);
+
+    void appendPublishedChanges(const DataTypes::DatabaseChanges &changes);
+
+    void publishAddedData(const DataTypes::DatabaseChanges &changes);
+
+    void publishEntityChanges(const DataTypes::DatabaseChanges &changes);
+
+    void journalChanges(const DataTypes::DatabaseChanges &changes);
+
+    void publishExternalChanges(qulonglong lastGeneration);
+
+    bool internalChangesJournal(qulonglong firstGeneration, qulonglong lastGeneration,
+                                QList<DataTypes::DatabaseChanges> &journaledChanges, bool &isDatabaseCleared);
+
+    qulonglong internalCommittedGeneration();
+
     bool startTransaction() const;
 
+    bool startWriteTransaction();
+
+    bool startOrDelayWriteTransaction(const std::function<void()> &write, bool &isDelayed);
+
+    void retryDelayedWrites();
+
     bool finishTransaction() const;
 
     bool rollBackTransaction() const;
 
+    DatabaseReadConnection *readConnectionForCurrentThread() const;
+
+    QSqlDatabase databaseForCurrentThread() const;
+
+    DatabaseStatement &queryForCurrentThread(DatabaseStatement &statement);
+
     QList<qulonglong> fetchTrackIds(qulonglong albumId);
 
     qulonglong internalAlbumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath);
@@ -205,15 +312,71 @@ private:
 
     QList<qulonglong> internalAlbumIdsFromAuthor(const QString &artistName);
 
+    void initStorageSettings(const StorageSettings &storageSettings);
+
+    void applyStorageSettings(QSqlDatabase &database) const;
+
     void initDatabase();
 
     void initRequest();
 
+    void rebuildAlbumSummary();
+
+    void updateAlbumSummary(qulonglong albumId);
+
+    void updateAlbumSummariesForChanges();
+
+    void initSearchIndex();
+
+    void initGeneration();
+
+    void initPlayScore();
+
+    void decayPlayScores(qint64 referenceTime);
+
+    void increaseGeneration();
+
+    qlonglong currentDataVersion();
+
+    bool synchronizeWithExternalCommits();
+
+    void checkExternalCommits();
+
+    void scheduleModelSnapshot();
+
+    void writeModelSnapshot();
+
+    bool buildModelSnapshot();
+
+    void initPlayStatisticsJournal();
+
+    void syncPlayStatisticsJournal();
+
+    void flushPlayStatistics();
+
+    void runMaintenanceStep();
+
+    void rebuildSearchIndex();
+
+    void updateTrackSearchIndex(qulonglong trackId);
+
+    void removeTrackSearchIndex(qulonglong trackId);
+
+    void updateAlbumSearchIndex(qulonglong albumId);
+
+    void removeAlbumSearchIndex(qulonglong albumId);
+
+    void updateSearchIndexForChanges();
+
+    QString searchExpression(const QString &searchText) const;
+
+    QList<qulonglong> internalSearch(DatabaseStatement &searchQuery, const QString &searchText, int maximumCount);
+
     qulonglong insertAlbum(const QString &title, const QString &albumArtist,
                            const QString &trackPath, const QUrl &albumArtURI);
 
     bool updateAlbumFromId(qulonglong albumId, const QUrl &albumArtUri,
-                           const DataTypes::TrackDataType &currentTrack, const QString &albumPath);
+                           const DataTypes::TrackDataType &currentTrack);
 
     qulonglong insertArtist(const QString &name);
 
@@ -231,12 +394,33 @@ private:
 
     void reloadExistingDatabase();
 
+    void reloadIdCounters();
+
     qulonglong genericInitialId(QSqlQuery &request);
 
     void insertTrackOrigin(const QUrl &fileNameURI, const QDateTime &fileModifiedTime, const QDateTime &importDate);
 
     void updateTrackOrigin(const QUrl &fileName, const QDateTime &fileModifiedTime);
 
+    void removeTrackOrigin(const QUrl &fileName);
+
+    bool prepareTracksListInsertion(const DataTypes::ListTrackDataType &tracks,
+                                    QHash<QString, qulonglong> &existingTracks, QStringList &newTrackFiles);
+
+    bool internalTrackIdsFromFileNames(const QStringList &fileNames, QHash<QString, qulonglong> &fileIds,
+                                       QHash<QString, qulonglong> &trackIds);
+
+    bool internalBulkInsertNames(const QString &tableName, const QStringList &names, qulonglong &nextId,
+                                 DatabaseIdCache<QString> &knownIds, QList<qulonglong> &insertedIds);
+
+    QString bulkPlaceholders(int count, const QString &onePlaceholder) const;
+
+    bool execBulkQuery(const QString &queryText, const QVariantList &values, QList<QSqlRecord> &records);
+
+    void clearIdCaches() const;
+
+    void logIdCachesStatistics() const;
+
     qulonglong internalInsertTrack(const DataTypes::TrackDataType &oneModifiedTrack,
                                    const QHash<QString, QUrl> &covers, bool &isInserted);
 
@@ -260,16 +444,22 @@ private:
 
     QHash<QUrl, QDateTime> internalAllFileName();
 
+    DataTypes::DirectoriesStateType internalAllDirectoriesState();
+
     bool internalGenericPartialData(QSqlQuery &query);
 
-    DataTypes::ListArtistDataType internalAllArtistsPartialData(QSqlQuery &artistsQuery);
+    DataTypes::ListArtistDataType internalAllArtistsPartialData(DatabaseStatement &artistsQuery);
 
-    DataTypes::ListAlbumDataType internalAllAlbumsPartialData(QSqlQuery &query);
+    DataTypes::ListAlbumDataType internalAllAlbumsPartialData(DatabaseStatement &query);
 
     DataTypes::AlbumDataType internalOneAlbumPartialData(qulonglong databaseId);
 
     DataTypes::ListTrackDataType internalAllTracksPartialData();
 
+    DataTypes::ListTrackDataType internalTracksPagePartialData(const QString &lastFileName, int count);
+
+    DataTypes::ListAlbumDataType internalAlbumsPagePartialData(const QString &lastTitle, qulonglong lastDatabaseId, int count);
+
     DataTypes::ListRadioDataType internalAllRadiosPartialData();
 
     DataTypes::ListTrackDataType internalRecentlyPlayedTracksData(int count);
@@ -290,12 +480,14 @@ private:
 
     bool prepareQuery(QSqlQuery &query, const QString &queryText) const;
 
+    bool prepareQuery(DatabaseStatement &statement, const QString &queryText) const;
+
     bool execQuery(QSqlQuery &query);
 
-    void updateAlbumArtist(qulonglong albumId, const QString &title, const QString &albumPath,
-                           const QString &artistName);
+    void updateAlbumArtist(qulonglong albumId, const QString &title, const QString &artistName);
 
-    void updateTrackStatistics(const QUrl &fileName, const QDateTime &time);
+    void updateTrackStatistics(const QUrl &fileName, const QDateTime &firstPlayTime,
+                               const QDateTime &lastPlayTime, int playCount);
 
     void createDatabaseV9();
 
@@ -313,6 +505,26 @@ private:
 
     void upgradeDatabaseV16();
 
+    void upgradeDatabaseV17();
+
+    void upgradeDatabaseV18();
+
+    void upgradeDatabaseV19();
+
+    void upgradeDatabaseV20();
+
+    void upgradeDatabaseV21();
+
+    void upgradeDatabaseV22();
+
+    void upgradeDatabaseV23();
+
+    void upgradeDatabaseV24();
+
+    void upgradeDatabaseV25();
+
+    void upgradeDatabaseV26();
+
     void checkDatabaseSchema();
 
     void checkAlbumsTableSchema();
@@ -349,4 +561,6 @@ private:
 
 };
 
+Q_DECLARE_METATYPE(DatabaseInterface::StorageSettings)
+
 #endif // DATABASEINTERFACE_H
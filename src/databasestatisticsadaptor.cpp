@@ -0,0 +1,53 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "databasestatisticsadaptor.h"
+
+#include "databaseinterface.h"
+
+DatabaseStatisticsAdaptor::DatabaseStatisticsAdaptor(DatabaseInterface *database)
+    : QDBusAbstractAdaptor(database), mDatabase(database)
+{
+}
+
+DatabaseStatisticsAdaptor::~DatabaseStatisticsAdaptor()
+= default;
+
+bool DatabaseStatisticsAdaptor::IsEnabled() const
+{
+    return mDatabase->isStatisticsEnabled();
+}
+
+void DatabaseStatisticsAdaptor::SetEnabled(bool enabled)
+{
+    mDatabase->setStatisticsEnabled(enabled);
+}
+
+void DatabaseStatisticsAdaptor::Reset()
+{
+    mDatabase->resetStatistics();
+}
+
+QString DatabaseStatisticsAdaptor::Report() const
+{
+    return mDatabase->statisticsReport();
+}
+
+void DatabaseStatisticsAdaptor::Dump() const
+{
+    mDatabase->dumpStatistics();
+}
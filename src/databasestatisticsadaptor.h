@@ -0,0 +1,58 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATABASESTATISTICSADAPTOR_H
+#define DATABASESTATISTICSADAPTOR_H
+
+#include "elisaLib_export.h"
+
+#include <QDBusAbstractAdaptor>
+#include <QString>
+
+class DatabaseInterface;
+
+/* lets a running instance be profiled: statement and transaction timings of the music database */
+class ELISALIB_EXPORT DatabaseStatisticsAdaptor : public QDBusAbstractAdaptor
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.elisa.DatabaseStatistics")
+
+public:
+
+    explicit DatabaseStatisticsAdaptor(DatabaseInterface *database);
+
+    ~DatabaseStatisticsAdaptor() override;
+
+public Q_SLOTS:
+
+    bool IsEnabled() const;
+
+    void SetEnabled(bool enabled);
+
+    void Reset();
+
+    QString Report() const;
+
+    void Dump() const;
+
+private:
+
+    DatabaseInterface *mDatabase;
+
+};
+
+#endif // DATABASESTATISTICSADAPTOR_H
@@ -18,5 +18,82 @@
 
 #include "datatypes.h"
 
+#include <QSet>
+
+#include <algorithm>
+
+namespace {
+
+QSet<qulonglong> idsSet(const QList<qulonglong> &ids)
+{
+    auto result = QSet<qulonglong>{};
+    result.reserve(ids.size());
+
+    for (auto oneId : ids) {
+        result.insert(oneId);
+    }
+
+    return result;
+}
+
+void mergeIds(QList<qulonglong> &ids, const QList<qulonglong> &newIds, const QSet<qulonglong> &excludedIds = {})
+{
+    auto knownIds = idsSet(ids);
+
+    for (auto oneId : newIds) {
+        if (!excludedIds.contains(oneId) && !knownIds.contains(oneId)) {
+            knownIds.insert(oneId);
+            ids.push_back(oneId);
+        }
+    }
+}
+
+void removeIds(QList<qulonglong> &addedIds, QList<qulonglong> &modifiedIds, QList<qulonglong> &removedIds,
+               const QList<qulonglong> &newRemovedIds)
+{
+    if (newRemovedIds.isEmpty()) {
+        return;
+    }
+
+    const auto removedIdsSet = idsSet(newRemovedIds);
+    const auto isRemoved = [&removedIdsSet](qulonglong oneId) {return removedIdsSet.contains(oneId);};
+
+    modifiedIds.erase(std::remove_if(modifiedIds.begin(), modifiedIds.end(), isRemoved), modifiedIds.end());
+
+    // an entity added and removed in between is not reported at all
+    const auto addedAndRemovedIds = idsSet(addedIds).intersect(removedIdsSet);
+
+    addedIds.erase(std::remove_if(addedIds.begin(), addedIds.end(), isRemoved), addedIds.end());
+
+    mergeIds(removedIds, newRemovedIds, addedAndRemovedIds);
+}
+
+}
+
+bool DataTypes::DatabaseChanges::isEmpty() const
+{
+    return mAddedTracks.isEmpty() && mModifiedTracks.isEmpty() && mRemovedTracks.isEmpty() &&
+            mAddedAlbums.isEmpty() && mModifiedAlbums.isEmpty() && mRemovedAlbums.isEmpty() &&
+            mAddedArtists.isEmpty() && mRemovedArtists.isEmpty();
+}
+
+void DataTypes::DatabaseChanges::merge(const DatabaseChanges &other)
+{
+    mSequenceNumber = std::max(mSequenceNumber, other.mSequenceNumber);
+
+    auto noModifiedArtists = QList<qulonglong>{};
+
+    removeIds(mAddedTracks, mModifiedTracks, mRemovedTracks, other.mRemovedTracks);
+    removeIds(mAddedAlbums, mModifiedAlbums, mRemovedAlbums, other.mRemovedAlbums);
+    removeIds(mAddedArtists, noModifiedArtists, mRemovedArtists, other.mRemovedArtists);
+
+    mergeIds(mAddedTracks, other.mAddedTracks);
+    mergeIds(mAddedAlbums, other.mAddedAlbums);
+    mergeIds(mAddedArtists, other.mAddedArtists);
+
+    mergeIds(mModifiedTracks, other.mModifiedTracks, idsSet(mAddedTracks));
+    mergeIds(mModifiedAlbums, other.mModifiedAlbums, idsSet(mAddedAlbums));
+}
+
 
 #include "moc_datatypes.cpp"
@@ -28,6 +28,16 @@
 #include <QUrl>
 #include <QDateTime>
 #include <QMap>
+#include <QHash>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include <QtAlgorithms>
+#include <QDebug>
+
+#include <array>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
 
 class ELISALIB_EXPORT DataTypes : public QObject
 {
@@ -87,29 +97,324 @@ private:
 
 public:
 
-    class TrackDataType : public DataType
+    class TrackDataType
     {
     public:
 
-        using DataType::DataType;
+        using key_type = ColumnsRoles;
+
+        using mapped_type = QVariant;
+
+        /* roles stored inline, in role order: anything else goes to mOtherRoles */
+        static constexpr ColumnsRoles StoredRoles[] = {
+            TitleRole, ImageUrlRole, DurationRole, ArtistRole, AlbumRole, AlbumArtistRole, IsValidAlbumArtistRole,
+            TrackNumberRole, DiscNumberRole, RatingRole, GenreRole, LyricistRole, ComposerRole, CommentRole, YearRole,
+            ChannelsRole, BitRateRole, SampleRateRole, ResourceRole, IdRole, ParentIdRole, DatabaseIdRole,
+            IsSingleDiscAlbumRole, AlbumIdRole, HasEmbeddedCover, FileModificationTime, FirstPlayDate, LastPlayDate,
+            PlayCounter, PlayFrequency, ElementTypeRole, LyricsRole,
+        };
+
+        static constexpr int StoredRolesCount = static_cast<int>(std::size(StoredRoles));
+
+        static_assert(StoredRolesCount <= 64, "presence of stored roles is tracked in a quint64");
+
+        static constexpr int RolesCount = FullDataRole - TitleRole + 1;
+
+        static constexpr std::array<qint8, RolesCount> RoleSlots = [] {
+            auto table = std::array<qint8, RolesCount>{};
+            for (auto &oneSlot : table) {
+                oneSlot = -1;
+            }
+            for (int slot = 0; slot < StoredRolesCount; ++slot) {
+                table[StoredRoles[slot] - TitleRole] = static_cast<qint8>(slot);
+            }
+            return table;
+        }();
+
+        static constexpr int slotForRole(key_type role)
+        {
+            return (role >= TitleRole && role <= FullDataRole) ? RoleSlots[role - TitleRole] : -1;
+        }
+
+    private:
+
+        struct TrackData : public QSharedData
+        {
+            std::array<QVariant, StoredRolesCount> mValues;
+
+            quint64 mPresentRoles = 0;
+
+            QMap<ColumnsRoles, QVariant> mOtherRoles;
+        };
+
+    public:
+
+        class const_iterator
+        {
+        public:
+
+            const_iterator() = default;
+
+            key_type key() const
+            {
+                return (mSlot < StoredRolesCount) ? StoredRoles[mSlot] : mOther.key();
+            }
+
+            const QVariant &value() const
+            {
+                return (mSlot < StoredRolesCount) ? mData->mValues[mSlot] : mOther.value();
+            }
+
+            const QVariant &operator*() const
+            {
+                return value();
+            }
+
+            const_iterator &operator++()
+            {
+                if (mSlot < StoredRolesCount) {
+                    mSlot = nextSlot(mData, mSlot + 1);
+                    if (mSlot == StoredRolesCount) {
+                        mOther = mData->mOtherRoles.constBegin();
+                    }
+                } else {
+                    ++mOther;
+                }
+
+                return *this;
+            }
+
+            bool operator==(const const_iterator &other) const
+            {
+                return mData == other.mData && mSlot == other.mSlot &&
+                        (mData == nullptr || mSlot < StoredRolesCount || mOther == other.mOther);
+            }
+
+            bool operator!=(const const_iterator &other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+
+            friend class TrackDataType;
+
+            const_iterator(const TrackData *data, int slot, QMap<ColumnsRoles, QVariant>::const_iterator other)
+                : mData(data), mSlot(slot), mOther(other)
+            {
+            }
+
+            static int nextSlot(const TrackData *data, int slot)
+            {
+                while (slot < StoredRolesCount && !(data->mPresentRoles & (quint64(1) << slot))) {
+                    ++slot;
+                }
+
+                return slot;
+            }
+
+            const TrackData *mData = nullptr;
+
+            int mSlot = StoredRolesCount;
+
+            QMap<ColumnsRoles, QVariant>::const_iterator mOther;
+
+        };
+
+        using iterator = const_iterator;
+
+        TrackDataType() = default;
+
+        TrackDataType(std::initializer_list<std::pair<key_type, mapped_type>> values)
+        {
+            for (const auto &oneValue : values) {
+                operator[](oneValue.first) = oneValue.second;
+            }
+        }
 
         TrackDataType(bool aValid, QString aId, QString aParentId, QString aTitle, QString aArtist, QString aAlbumName,
                       QString aAlbumArtist, int aTrackNumber, int aDiscNumber, QTime aDuration, QUrl aResourceURI,
                       const QDateTime &fileModificationTime, QUrl aAlbumCover, int rating, bool aIsSingleDiscAlbum,
                       QString aGenre, QString aComposer, QString aLyricist, bool aHasEmbeddedCover)
-            : DataType({{key_type::TitleRole, std::move(aTitle)}, {key_type::AlbumRole, std::move(aAlbumName)},
-                        {key_type::ArtistRole, std::move(aArtist)}, {key_type::AlbumArtistRole, std::move(aAlbumArtist)},
-                        {key_type::IdRole, std::move(aId)}, {key_type::ParentIdRole, std::move(aParentId)},
-                        {key_type::TrackNumberRole, aTrackNumber}, {key_type::DiscNumberRole, aDiscNumber},
-                        {key_type::DurationRole, aDuration}, {key_type::ResourceRole, std::move(aResourceURI)},
-                        {key_type::FileModificationTime, fileModificationTime}, {key_type::ImageUrlRole, std::move(aAlbumCover)},
-                        {key_type::RatingRole, rating}, {key_type::IsSingleDiscAlbumRole, aIsSingleDiscAlbum},
-                        {key_type::GenreRole, std::move(aGenre)}, {key_type::ComposerRole, std::move(aComposer)},
-                        {key_type::LyricistRole, std::move(aLyricist)}, {key_type::HasEmbeddedCover, aHasEmbeddedCover},})
+            : TrackDataType({{key_type::TitleRole, std::move(aTitle)}, {key_type::AlbumRole, std::move(aAlbumName)},
+                             {key_type::ArtistRole, std::move(aArtist)}, {key_type::AlbumArtistRole, std::move(aAlbumArtist)},
+                             {key_type::IdRole, std::move(aId)}, {key_type::ParentIdRole, std::move(aParentId)},
+                             {key_type::TrackNumberRole, aTrackNumber}, {key_type::DiscNumberRole, aDiscNumber},
+                             {key_type::DurationRole, aDuration}, {key_type::ResourceRole, std::move(aResourceURI)},
+                             {key_type::FileModificationTime, fileModificationTime}, {key_type::ImageUrlRole, std::move(aAlbumCover)},
+                             {key_type::RatingRole, rating}, {key_type::IsSingleDiscAlbumRole, aIsSingleDiscAlbum},
+                             {key_type::GenreRole, std::move(aGenre)}, {key_type::ComposerRole, std::move(aComposer)},
+                             {key_type::LyricistRole, std::move(aLyricist)}, {key_type::HasEmbeddedCover, aHasEmbeddedCover},})
         {
             Q_UNUSED(aValid)
         }
 
+        QVariant &operator[](key_type role)
+        {
+            if (!d) {
+                d = new TrackData;
+            }
+
+            const auto slot = slotForRole(role);
+            if (slot < 0) {
+                return d->mOtherRoles[role];
+            }
+
+            d->mPresentRoles |= quint64(1) << slot;
+            return d->mValues[slot];
+        }
+
+        const QVariant operator[](key_type role) const
+        {
+            return value(role);
+        }
+
+        QVariant value(key_type role) const
+        {
+            if (!d) {
+                return {};
+            }
+
+            const auto slot = slotForRole(role);
+            if (slot < 0) {
+                return d->mOtherRoles.value(role);
+            }
+
+            return d->mValues[slot];
+        }
+
+        iterator insert(key_type role, const QVariant &value)
+        {
+            operator[](role) = value;
+            return find(role);
+        }
+
+        int remove(key_type role)
+        {
+            if (!contains(role)) {
+                return 0;
+            }
+
+            const auto slot = slotForRole(role);
+            if (slot < 0) {
+                return d->mOtherRoles.remove(role);
+            }
+
+            d->mPresentRoles &= ~(quint64(1) << slot);
+            d->mValues[slot] = QVariant{};
+            return 1;
+        }
+
+        bool contains(key_type role) const
+        {
+            if (!d) {
+                return false;
+            }
+
+            const auto slot = slotForRole(role);
+            if (slot < 0) {
+                return d->mOtherRoles.contains(role);
+            }
+
+            return d->mPresentRoles & (quint64(1) << slot);
+        }
+
+        const_iterator find(key_type role) const
+        {
+            if (!contains(role)) {
+                return end();
+            }
+
+            const auto slot = slotForRole(role);
+            if (slot < 0) {
+                return {d.constData(), StoredRolesCount, d->mOtherRoles.constFind(role)};
+            }
+
+            return {d.constData(), slot, {}};
+        }
+
+        const_iterator constFind(key_type role) const
+        {
+            return find(role);
+        }
+
+        const_iterator begin() const
+        {
+            if (!d) {
+                return {};
+            }
+
+            const auto slot = const_iterator::nextSlot(d.constData(), 0);
+            return {d.constData(), slot, (slot < StoredRolesCount) ? QMap<ColumnsRoles, QVariant>::const_iterator{} : d->mOtherRoles.constBegin()};
+        }
+
+        const_iterator end() const
+        {
+            if (!d) {
+                return {};
+            }
+
+            return {d.constData(), StoredRolesCount, d->mOtherRoles.constEnd()};
+        }
+
+        const_iterator constBegin() const
+        {
+            return begin();
+        }
+
+        const_iterator constEnd() const
+        {
+            return end();
+        }
+
+        int count() const
+        {
+            return d ? static_cast<int>(qPopulationCount(d->mPresentRoles)) + d->mOtherRoles.count() : 0;
+        }
+
+        int size() const
+        {
+            return count();
+        }
+
+        bool isEmpty() const
+        {
+            return count() == 0;
+        }
+
+        void clear()
+        {
+            d = QSharedDataPointer<TrackData>{};
+        }
+
+        bool operator==(const TrackDataType &other) const
+        {
+            if (d.constData() == other.d.constData()) {
+                return true;
+            }
+
+            if (isEmpty() || other.isEmpty()) {
+                return isEmpty() && other.isEmpty();
+            }
+
+            if (d->mPresentRoles != other.d->mPresentRoles || d->mOtherRoles != other.d->mOtherRoles) {
+                return false;
+            }
+
+            for (int slot = 0; slot < StoredRolesCount; ++slot) {
+                if (d->mValues[slot] != other.d->mValues[slot]) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool operator!=(const TrackDataType &other) const
+        {
+            return !(*this == other);
+        }
+
         bool isValid() const
         {
             return !isEmpty() && duration().isValid();
@@ -117,159 +422,174 @@ public:
 
         qulonglong databaseId() const
         {
-            return operator[](key_type::DatabaseIdRole).toULongLong();
+            return storedValue<DatabaseIdRole>().toULongLong();
         }
 
         QString title() const
         {
-            return operator[](key_type::TitleRole).toString();
+            return storedValue<TitleRole>().toString();
         }
 
         QString artist() const
         {
-            return operator[](key_type::ArtistRole).toString();
+            return storedValue<ArtistRole>().toString();
         }
 
         qulonglong albumId() const
         {
-            return operator[](key_type::AlbumIdRole).toULongLong();
+            return storedValue<AlbumIdRole>().toULongLong();
         }
 
         bool hasAlbum() const
         {
-            return find(key_type::AlbumRole) != end();
+            return contains(key_type::AlbumRole);
         }
 
         QString album() const
         {
-            return operator[](key_type::AlbumRole).toString();
+            return storedValue<AlbumRole>().toString();
         }
 
         QString albumArtist() const
         {
-            return operator[](key_type::AlbumArtistRole).toString();
+            return storedValue<AlbumArtistRole>().toString();
         }
 
         bool hasAlbumArtist() const
         {
-            return find(key_type::AlbumArtistRole) != end();
+            return contains(key_type::AlbumArtistRole);
         }
 
         bool hasTrackNumber() const
         {
-            return find(key_type::TrackNumberRole) != end();
+            return contains(key_type::TrackNumberRole);
         }
 
         int trackNumber() const
         {
-            return operator[](key_type::TrackNumberRole).toInt();
+            return storedValue<TrackNumberRole>().toInt();
         }
 
         bool hasDiscNumber() const
         {
-            return find(key_type::DiscNumberRole) != end();
+            return contains(key_type::DiscNumberRole);
         }
 
         int discNumber() const
         {
-            return operator[](key_type::DiscNumberRole).toInt();
+            return storedValue<DiscNumberRole>().toInt();
         }
 
         QTime duration() const
         {
-            return operator[](key_type::DurationRole).toTime();
+            return storedValue<DurationRole>().toTime();
         }
 
         QUrl resourceURI() const
         {
-            return operator[](key_type::ResourceRole).toUrl();
+            return storedValue<ResourceRole>().toUrl();
         }
 
         QUrl albumCover() const
         {
-            return operator[](key_type::ImageUrlRole).toUrl();
+            return storedValue<ImageUrlRole>().toUrl();
         }
 
         bool isSingleDiscAlbum() const
         {
-            return operator[](key_type::IsSingleDiscAlbumRole).toBool();
+            return storedValue<IsSingleDiscAlbumRole>().toBool();
         }
 
         int rating() const
         {
-            return operator[](key_type::RatingRole).toInt();
+            return storedValue<RatingRole>().toInt();
         }
 
         QString genre() const
         {
-            return operator[](key_type::GenreRole).toString();
+            return storedValue<GenreRole>().toString();
         }
 
         QString composer() const
         {
-            return operator[](key_type::ComposerRole).toString();
+            return storedValue<ComposerRole>().toString();
         }
 
         QString lyricist() const
         {
-            return operator[](key_type::LyricistRole).toString();
+            return storedValue<LyricistRole>().toString();
         }
 
         QString lyrics() const
         {
-            return operator[](key_type::LyricsRole).toString();
+            return storedValue<LyricsRole>().toString();
         }
 
         QString comment() const
         {
-            return operator[](key_type::CommentRole).toString();
+            return storedValue<CommentRole>().toString();
         }
 
         int year() const
         {
-            return operator[](key_type::YearRole).toInt();
+            return storedValue<YearRole>().toInt();
         }
 
         int channels() const
         {
-            return operator[](key_type::ChannelsRole).toInt();
+            return storedValue<ChannelsRole>().toInt();
         }
 
         bool hasChannels() const
         {
-            return find(key_type::ChannelsRole) != end();
+            return contains(key_type::ChannelsRole);
         }
 
         int bitRate() const
         {
-            return operator[](key_type::BitRateRole).toInt();
+            return storedValue<BitRateRole>().toInt();
         }
 
         bool hasBitRate() const
         {
-            return find(key_type::BitRateRole) != end();
+            return contains(key_type::BitRateRole);
         }
 
         int sampleRate() const
         {
-            return operator[](key_type::SampleRateRole).toInt();
+            return storedValue<SampleRateRole>().toInt();
         }
 
         bool hasSampleRate() const
         {
-            return find(key_type::SampleRateRole) != end();
+            return contains(key_type::SampleRateRole);
         }
 
 
         bool hasEmbeddedCover() const
         {
-            return operator[](key_type::HasEmbeddedCover).toBool();
+            return storedValue<HasEmbeddedCover>().toBool();
         }
 
         QDateTime fileModificationTime() const
         {
-            return operator[](key_type::FileModificationTime).toDateTime();
+            return storedValue<FileModificationTime>().toDateTime();
+        }
+
+    private:
+
+        template <ColumnsRoles role>
+        const QVariant &storedValue() const
+        {
+            constexpr auto slot = slotForRole(role);
+            static_assert(slot >= 0, "role is not stored inline");
+
+            static const QVariant emptyValue;
+            return d ? d->mValues[slot] : emptyValue;
         }
+
+        QSharedDataPointer<TrackData> d;
+
     };
 
     using ListTrackDataType = QList<TrackDataType>;
@@ -362,8 +682,64 @@ public:
 
     using ListGenreDataType = QList<GenreDataType>;
 
+    /* ids of the entities changed by one committed transaction, in order of their sequence numbers */
+    class DatabaseChanges
+    {
+    public:
+
+        bool isEmpty() const;
+
+        void merge(const DatabaseChanges &other);
+
+        qulonglong mSequenceNumber = 0;
+
+        QList<qulonglong> mAddedTracks;
+
+        QList<qulonglong> mModifiedTracks;
+
+        QList<qulonglong> mRemovedTracks;
+
+        QList<qulonglong> mAddedAlbums;
+
+        QList<qulonglong> mModifiedAlbums;
+
+        QList<qulonglong> mRemovedAlbums;
+
+        QList<qulonglong> mAddedArtists;
+
+        QList<qulonglong> mRemovedArtists;
+
+    };
+
+    /* modification time and number of entries of a directory when its content was last imported */
+    class DirectoryState
+    {
+    public:
+
+        QDateTime mModifiedTime;
+
+        int mEntriesCount = 0;
+
+    };
+
+    using DirectoriesStateType = QHash<QString, DirectoryState>;
+
 };
 
+Q_DECLARE_TYPEINFO(DataTypes::TrackDataType, Q_MOVABLE_TYPE);
+
+inline QDebug operator<<(QDebug stream, const DataTypes::TrackDataType &track)
+{
+    QDebugStateSaver saver(stream);
+    stream.nospace() << "TrackDataType(";
+    for (auto itValue = track.constBegin(); itValue != track.constEnd(); ++itValue) {
+        stream << '(' << itValue.key() << ", " << itValue.value() << ')';
+    }
+    stream << ')';
+
+    return stream;
+}
+
 Q_DECLARE_METATYPE(DataTypes::TrackDataType)
 Q_DECLARE_METATYPE(DataTypes::AlbumDataType)
 Q_DECLARE_METATYPE(DataTypes::ArtistDataType)
@@ -374,4 +750,8 @@ Q_DECLARE_METATYPE(DataTypes::ListAlbumDataType)
 Q_DECLARE_METATYPE(DataTypes::ListArtistDataType)
 Q_DECLARE_METATYPE(DataTypes::ListGenreDataType)
 
+Q_DECLARE_METATYPE(DataTypes::DatabaseChanges)
+
+Q_DECLARE_METATYPE(DataTypes::DirectoriesStateType)
+
 #endif // DATATYPES_H
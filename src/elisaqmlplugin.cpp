@@ -175,6 +175,8 @@ void ElisaQmlTestPlugin::registerTypes(const char *uri)
     qRegisterMetaType<DataTypes::ArtistDataType>("DataTypes::ArtistDataType");
     qRegisterMetaType<DataTypes::GenreDataType>("DataTypes::GenreDataType");
     qRegisterMetaType<DataTypes::ColumnsRoles>("DataTypes::ColumnsRoles");
+    qRegisterMetaType<DataTypes::DatabaseChanges>("DataTypes::DatabaseChanges");
+    qRegisterMetaType<DataTypes::DirectoriesStateType>("DataTypes::DirectoriesStateType");
     qRegisterMetaType<ModelDataLoader::TrackDataType>("ModelDataLoader::TrackDataType");
     qRegisterMetaType<TracksListener::TrackDataType>("TracksListener::TrackDataType");
     qRegisterMetaType<ViewManager::ViewsType>("ViewManager::ViewsType");
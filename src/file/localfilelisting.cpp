@@ -75,6 +75,8 @@ void LocalFileListing::triggerRefreshOfContent()
 
     checkFilesToRemove();
 
+    checkDirectoriesToRemove();
+
     if (!waitEndTrackRemoval()) {
         Q_EMIT indexingFinished();
     }
@@ -39,8 +39,12 @@ public:
 
     qulonglong mDatabaseId = 0;
 
+    qulonglong mSequenceNumber = 0;
+
     FileScanner mFileScanner;
 
+    static const int ChunkSize = 500;
+
 };
 
 ModelDataLoader::ModelDataLoader(QObject *parent) : QObject(parent), d(std::make_unique<ModelDataLoaderPrivate>())
@@ -52,25 +56,18 @@ ModelDataLoader::~ModelDataLoader() = default;
 void ModelDataLoader::setDatabase(DatabaseInterface *database)
 {
     d->mDatabase = database;
+    d->mSequenceNumber = database->databaseGeneration();
 
     connect(database, &DatabaseInterface::genresAdded,
             this, &ModelDataLoader::genresAdded);
     connect(database, &DatabaseInterface::albumsAdded,
             this, &ModelDataLoader::databaseAlbumsAdded);
-    connect(database, &DatabaseInterface::albumModified,
-            this, &ModelDataLoader::albumModified);
-    connect(database, &DatabaseInterface::albumRemoved,
-            this, &ModelDataLoader::albumRemoved);
     connect(database, &DatabaseInterface::tracksAdded,
             this, &ModelDataLoader::databaseTracksAdded);
-    connect(database, &DatabaseInterface::trackModified,
-            this, &ModelDataLoader::trackModified);
-    connect(database, &DatabaseInterface::trackRemoved,
-            this, &ModelDataLoader::trackRemoved);
     connect(database, &DatabaseInterface::artistsAdded,
             this, &ModelDataLoader::databaseArtistsAdded);
-    connect(database, &DatabaseInterface::artistRemoved,
-            this, &ModelDataLoader::artistRemoved);
+    connect(database, &DatabaseInterface::databaseChanged,
+            this, &ModelDataLoader::databaseChanged);
     connect(this, &ModelDataLoader::saveRadioModified,
             database, &DatabaseInterface::insertRadio);
     connect(this, &ModelDataLoader::removeRadio,
@@ -96,11 +93,18 @@ void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsData());
+        loadAllAlbumsByChunks();
         break;
     case ElisaUtils::Artist:
-        Q_EMIT allArtistsData(d->mDatabase->allArtistsData());
+    {
+        auto generation = qulonglong{0};
+        const auto allArtists = d->mDatabase->allArtistsData(generation);
+
+        loadedGeneration(generation);
+
+        Q_EMIT allArtistsData(allArtists);
         break;
+    }
     case ElisaUtils::Composer:
         break;
     case ElisaUtils::Genre:
@@ -109,7 +113,7 @@ void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
     case ElisaUtils::Lyricist:
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->allTracksData());
+        loadAllTracksByChunks();
         break;
     case ElisaUtils::FileName:
     case ElisaUtils::Unknown:
@@ -120,6 +124,91 @@ void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
     }
 }
 
+void ModelDataLoader::loadedGeneration(qulonglong generation)
+{
+    // the data added up to the loaded generation is already in the view
+    if (generation > d->mSequenceNumber) {
+        d->mSequenceNumber = generation;
+    }
+}
+
+void ModelDataLoader::loadDataAfterSnapshot(ElisaUtils::PlayListEntryType dataType, qulonglong snapshotGeneration)
+{
+    if (!d->mDatabase) {
+        return;
+    }
+
+    d->mFilterType = ModelDataLoader::FilterType::NoFilter;
+
+    if (d->mDatabase->databaseGeneration() == snapshotGeneration) {
+        return;
+    }
+
+    auto missedChanges = DataTypes::DatabaseChanges{};
+
+    // a full reload is only needed when the changes journal does not reach back to the snapshot
+    if (!d->mDatabase->journaledChangesSince(snapshotGeneration, missedChanges)) {
+        Q_EMIT snapshotOutdated();
+
+        loadData(dataType);
+
+        return;
+    }
+
+    // the additions go through the same checks as the ones published later, the generations already forwarded are skipped
+    if (!missedChanges.mAddedArtists.isEmpty()) {
+        auto newArtists = ListArtistDataType{};
+
+        for (auto artistId : qAsConst(missedChanges.mAddedArtists)) {
+            newArtists.push_back({{DataTypes::DatabaseIdRole, artistId}});
+        }
+
+        databaseArtistsAdded(newArtists, missedChanges.mSequenceNumber);
+    }
+
+    if (!missedChanges.mAddedAlbums.isEmpty()) {
+        auto newAlbums = ListAlbumDataType{};
+
+        for (auto albumId : qAsConst(missedChanges.mAddedAlbums)) {
+            auto oneAlbum = d->mDatabase->albumDataFromDatabaseId(albumId);
+
+            if (!oneAlbum.isEmpty()) {
+                newAlbums.push_back(oneAlbum);
+            }
+        }
+
+        databaseAlbumsAdded(newAlbums, missedChanges.mSequenceNumber);
+    }
+
+    if (!missedChanges.mAddedTracks.isEmpty()) {
+        databaseTracksAdded(d->mDatabase->tracksDataFromDatabaseIds(missedChanges.mAddedTracks), missedChanges.mSequenceNumber);
+    }
+
+    if (missedChanges.mSequenceNumber < d->mSequenceNumber) {
+        missedChanges.mSequenceNumber = d->mSequenceNumber;
+    }
+
+    applyDatabaseChanges(missedChanges);
+}
+
+void ModelDataLoader::loadAllAlbumsByChunks()
+{
+    const auto generation = d->mDatabase->allAlbumsDataByPages(ModelDataLoaderPrivate::ChunkSize, [this](const ListAlbumDataType &albumsChunk) {
+        Q_EMIT allAlbumsData(albumsChunk);
+    });
+
+    loadedGeneration(generation);
+}
+
+void ModelDataLoader::loadAllTracksByChunks()
+{
+    const auto generation = d->mDatabase->allTracksDataByPages(ModelDataLoaderPrivate::ChunkSize, [this](const ListTrackDataType &tracksChunk) {
+        Q_EMIT allTracksData(tracksChunk);
+    });
+
+    loadedGeneration(generation);
+}
+
 void ModelDataLoader::loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType, qulonglong databaseId)
 {
     if (!d->mDatabase) {
@@ -352,8 +441,37 @@ void ModelDataLoader::loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dat
     }
 }
 
-void ModelDataLoader::databaseTracksAdded(const ListTrackDataType &newData)
+void ModelDataLoader::searchData(ElisaUtils::PlayListEntryType dataType, const QString &searchText)
+{
+    if (!d->mDatabase || !d->mDatabase->hasSearchIndex()) {
+        return;
+    }
+
+    switch (dataType)
+    {
+    case ElisaUtils::Track:
+        Q_EMIT searchResults(dataType, searchText, d->mDatabase->searchTracks(searchText));
+        break;
+    case ElisaUtils::Album:
+        Q_EMIT searchResults(dataType, searchText, d->mDatabase->searchAlbums(searchText));
+        break;
+    case ElisaUtils::Artist:
+    case ElisaUtils::Composer:
+    case ElisaUtils::Genre:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Unknown:
+    case ElisaUtils::Radio:
+        break;
+    }
+}
+
+void ModelDataLoader::databaseTracksAdded(const ListTrackDataType &newData, qulonglong sequenceNumber)
 {
+    if (sequenceNumber <= d->mSequenceNumber) {
+        return;
+    }
+
     switch(d->mFilterType) {
     case ModelDataLoader::FilterType::NoFilter:
         Q_EMIT tracksAdded(newData);
@@ -379,8 +497,58 @@ void ModelDataLoader::databaseTracksAdded(const ListTrackDataType &newData)
     }
 }
 
-void ModelDataLoader::databaseArtistsAdded(const ListArtistDataType &newData)
+void ModelDataLoader::databaseChanged(const DataTypes::DatabaseChanges &changes)
 {
+    if (changes.mSequenceNumber <= d->mSequenceNumber) {
+        return;
+    }
+
+    auto missedChanges = DataTypes::DatabaseChanges{};
+
+    if (changes.mSequenceNumber > d->mSequenceNumber + 1 && d->mDatabase &&
+            d->mDatabase->changesSince(d->mSequenceNumber, missedChanges)) {
+        applyDatabaseChanges(missedChanges);
+        return;
+    }
+
+    applyDatabaseChanges(changes);
+}
+
+void ModelDataLoader::applyDatabaseChanges(const DataTypes::DatabaseChanges &changes)
+{
+    d->mSequenceNumber = changes.mSequenceNumber;
+
+    for (auto trackId : changes.mRemovedTracks) {
+        Q_EMIT trackRemoved(trackId);
+    }
+
+    for (auto albumId : changes.mRemovedAlbums) {
+        Q_EMIT albumRemoved(albumId);
+    }
+
+    for (auto artistId : changes.mRemovedArtists) {
+        Q_EMIT artistRemoved(artistId);
+    }
+
+    for (auto albumId : changes.mModifiedAlbums) {
+        Q_EMIT albumModified({{DataTypes::DatabaseIdRole, albumId}});
+    }
+
+    if (!changes.mModifiedTracks.isEmpty() && d->mDatabase) {
+        const auto modifiedTracks = d->mDatabase->tracksDataFromDatabaseIds(changes.mModifiedTracks);
+
+        for (const auto &oneTrack : modifiedTracks) {
+            Q_EMIT trackModified(oneTrack);
+        }
+    }
+}
+
+void ModelDataLoader::databaseArtistsAdded(const ListArtistDataType &newData, qulonglong sequenceNumber)
+{
+    if (sequenceNumber <= d->mSequenceNumber) {
+        return;
+    }
+
     switch(d->mFilterType) {
     case ModelDataLoader::FilterType::FilterByGenre:
     {
@@ -406,8 +574,12 @@ void ModelDataLoader::databaseArtistsAdded(const ListArtistDataType &newData)
     }
 }
 
-void ModelDataLoader::databaseAlbumsAdded(const ListAlbumDataType &newData)
+void ModelDataLoader::databaseAlbumsAdded(const ListAlbumDataType &newData, qulonglong sequenceNumber)
 {
+    if (sequenceNumber <= d->mSequenceNumber) {
+        return;
+    }
+
     switch(d->mFilterType) {
     case ModelDataLoader::FilterType::FilterByArtist:
     {
@@ -100,10 +100,17 @@ Q_SIGNALS:
 
     void clearedDatabase();
 
+    void snapshotOutdated();
+
+    void searchResults(ElisaUtils::PlayListEntryType dataType, const QString &searchText,
+                       const QList<qulonglong> &databaseIds);
+
 public Q_SLOTS:
 
     void loadData(ElisaUtils::PlayListEntryType dataType);
 
+    void loadDataAfterSnapshot(ElisaUtils::PlayListEntryType dataType, qulonglong snapshotGeneration);
+
     void loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType, qulonglong databaseId);
 
     void loadDataByGenre(ElisaUtils::PlayListEntryType dataType,
@@ -125,16 +132,28 @@ public Q_SLOTS:
 
     void loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
+    void searchData(ElisaUtils::PlayListEntryType dataType, const QString &searchText);
+
 private Q_SLOTS:
 
-    void databaseTracksAdded(const ModelDataLoader::ListTrackDataType &newData);
+    void databaseTracksAdded(const ModelDataLoader::ListTrackDataType &newData, qulonglong sequenceNumber);
+
+    void databaseArtistsAdded(const ModelDataLoader::ListArtistDataType &newData, qulonglong sequenceNumber);
 
-    void databaseArtistsAdded(const ModelDataLoader::ListArtistDataType &newData);
+    void databaseAlbumsAdded(const ModelDataLoader::ListAlbumDataType &newData, qulonglong sequenceNumber);
 
-    void databaseAlbumsAdded(const ModelDataLoader::ListAlbumDataType &newData);
+    void databaseChanged(const DataTypes::DatabaseChanges &changes);
 
 private:
 
+    void applyDatabaseChanges(const DataTypes::DatabaseChanges &changes);
+
+    void loadedGeneration(qulonglong generation);
+
+    void loadAllAlbumsByChunks();
+
+    void loadAllTracksByChunks();
+
     std::unique_ptr<ModelDataLoaderPrivate> d;
 
 };
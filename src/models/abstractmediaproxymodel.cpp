@@ -19,13 +19,23 @@
 #include "abstractmediaproxymodel.h"
 
 #include "mediaplaylist.h"
+#include "datatypes.h"
+#include "models/datamodel.h"
 
 #include <QWriteLocker>
+#include <QTimer>
 
 AbstractMediaProxyModel::AbstractMediaProxyModel(QObject *parent) : QSortFilterProxyModel(parent)
 {
     setFilterCaseSensitivity(Qt::CaseInsensitive);
     mThreadPool.setMaxThreadCount(1);
+
+    /* rows arrive by batches while the collection is scanned: the search runs again once for several of them */
+    mSearchRefreshTimer = new QTimer(this);
+    mSearchRefreshTimer->setSingleShot(true);
+    mSearchRefreshTimer->setInterval(500);
+    connect(mSearchRefreshTimer, &QTimer::timeout,
+            this, &AbstractMediaProxyModel::requestSearchResults);
 }
 
 AbstractMediaProxyModel::~AbstractMediaProxyModel()
@@ -54,6 +64,11 @@ void AbstractMediaProxyModel::setFilterText(const QString &filterText)
     mFilterExpression.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
     mFilterExpression.optimize();
 
+    mUseSearchResults = false;
+    mSearchResults.clear();
+
+    requestSearchResults();
+
     invalidate();
 
     Q_EMIT filterTextChanged(mFilterText);
@@ -104,6 +119,102 @@ void AbstractMediaProxyModel::setPlayList(MediaPlayList *playList)
     connectPlayList();
 }
 
+void AbstractMediaProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    auto oldDataModel = qobject_cast<DataModel*>(this->sourceModel());
+    if (oldDataModel) {
+        disconnect(this, &AbstractMediaProxyModel::needSearchResults,
+                   oldDataModel, &DataModel::searchData);
+        disconnect(oldDataModel, &DataModel::searchResults,
+                   this, &AbstractMediaProxyModel::searchResultsReceived);
+    }
+
+    if (this->sourceModel()) {
+        disconnect(this->sourceModel(), &QAbstractItemModel::rowsInserted,
+                   this, &AbstractMediaProxyModel::sourceRowsChanged);
+        disconnect(this->sourceModel(), &QAbstractItemModel::rowsRemoved,
+                   this, &AbstractMediaProxyModel::sourceRowsChanged);
+        disconnect(this->sourceModel(), &QAbstractItemModel::modelReset,
+                   this, &AbstractMediaProxyModel::sourceRowsChanged);
+    }
+
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+
+    auto newDataModel = qobject_cast<DataModel*>(sourceModel);
+    if (newDataModel) {
+        connect(this, &AbstractMediaProxyModel::needSearchResults,
+                newDataModel, &DataModel::searchData);
+        connect(newDataModel, &DataModel::searchResults,
+                this, &AbstractMediaProxyModel::searchResultsReceived, Qt::QueuedConnection);
+    }
+
+    if (sourceModel) {
+        connect(sourceModel, &QAbstractItemModel::rowsInserted,
+                this, &AbstractMediaProxyModel::sourceRowsChanged);
+        connect(sourceModel, &QAbstractItemModel::rowsRemoved,
+                this, &AbstractMediaProxyModel::sourceRowsChanged);
+        connect(sourceModel, &QAbstractItemModel::modelReset,
+                this, &AbstractMediaProxyModel::sourceRowsChanged);
+    }
+}
+
+ElisaUtils::PlayListEntryType AbstractMediaProxyModel::searchDataType() const
+{
+    return ElisaUtils::Unknown;
+}
+
+void AbstractMediaProxyModel::requestSearchResults()
+{
+    if (mFilterText.isEmpty() || searchDataType() == ElisaUtils::Unknown) {
+        return;
+    }
+
+    /* the query runs on the thread of the data loader, rows are filtered by the regular expression until it answers */
+    Q_EMIT needSearchResults(searchDataType(), mFilterText);
+}
+
+void AbstractMediaProxyModel::searchResultsReceived(ElisaUtils::PlayListEntryType dataType, const QString &searchText,
+                                                    const QList<qulonglong> &databaseIds)
+{
+    QWriteLocker writeLocker(&mDataLock);
+
+    if (dataType != searchDataType() || searchText != mFilterText) {
+        return;
+    }
+
+    mSearchResults.clear();
+    mSearchResults.reserve(databaseIds.size());
+    for (auto oneId : databaseIds) {
+        mSearchResults.insert(oneId);
+    }
+
+    mUseSearchResults = true;
+
+    invalidate();
+}
+
+void AbstractMediaProxyModel::sourceRowsChanged()
+{
+    if (mFilterText.isEmpty() || mSearchRefreshTimer->isActive()) {
+        return;
+    }
+
+    mSearchRefreshTimer->start();
+}
+
+bool AbstractMediaProxyModel::acceptsSearchResult(int source_row, const QModelIndex &source_parent, bool &isAccepted) const
+{
+    if (!mUseSearchResults) {
+        return false;
+    }
+
+    auto currentIndex = sourceModel()->index(source_row, 0, source_parent);
+
+    isAccepted = mSearchResults.contains(sourceModel()->data(currentIndex, DataTypes::DatabaseIdRole).toULongLong());
+
+    return true;
+}
+
 void AbstractMediaProxyModel::disconnectPlayList()
 {
     if (mPlayList) {
@@ -27,8 +27,10 @@
 #include <QRegularExpression>
 #include <QReadWriteLock>
 #include <QThreadPool>
+#include <QSet>
 
 class MediaPlayList;
+class QTimer;
 
 class ELISALIB_EXPORT AbstractMediaProxyModel : public QSortFilterProxyModel
 {
@@ -65,6 +67,8 @@ public:
 
     MediaPlayList* playList() const;
 
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
 public Q_SLOTS:
 
     void setFilterText(const QString &filterText);
@@ -85,6 +89,8 @@ Q_SIGNALS:
 
     void playListChanged();
 
+    void needSearchResults(ElisaUtils::PlayListEntryType dataType, const QString &searchText);
+
     void entriesToEnqueue(const ElisaUtils::EntryDataList &newEntries,
                           ElisaUtils::PlayListEntryType databaseIdType,
                           ElisaUtils::PlayListEnqueueMode enqueueMode,
@@ -98,6 +104,12 @@ protected:
 
     void connectPlayList();
 
+    virtual ElisaUtils::PlayListEntryType searchDataType() const;
+
+    void requestSearchResults();
+
+    bool acceptsSearchResult(int source_row, const QModelIndex &source_parent, bool &isAccepted) const;
+
     QString mFilterText;
 
     int mFilterRating = 0;
@@ -110,6 +122,19 @@ protected:
 
     MediaPlayList* mPlayList = nullptr;
 
+    QSet<qulonglong> mSearchResults;
+
+    bool mUseSearchResults = false;
+
+    QTimer *mSearchRefreshTimer = nullptr;
+
+private Q_SLOTS:
+
+    void searchResultsReceived(ElisaUtils::PlayListEntryType dataType, const QString &searchText,
+                               const QList<qulonglong> &databaseIds);
+
+    void sourceRowsChanged();
+
 };
 
 #endif // ABSTRACTMEDIAPROXYMODEL_H
@@ -29,6 +29,11 @@ AllTracksProxyModel::AllTracksProxyModel(QObject *parent) : AbstractMediaProxyMo
 
 AllTracksProxyModel::~AllTracksProxyModel() = default;
 
+ElisaUtils::PlayListEntryType AllTracksProxyModel::searchDataType() const
+{
+    return ElisaUtils::Track;
+}
+
 bool AllTracksProxyModel::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
 {
     bool result = false;
@@ -43,6 +48,10 @@ bool AllTracksProxyModel::filterAcceptsRow(int source_row, const QModelIndex &so
         return result;
     }
 
+    if (acceptsSearchResult(source_row, source_parent, result)) {
+        return result;
+    }
+
     if (mFilterExpression.match(titleValue).hasMatch()) {
         result = true;
     }
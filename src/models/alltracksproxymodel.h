@@ -46,6 +46,8 @@ protected:
 
     bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override;
 
+    ElisaUtils::PlayListEntryType searchDataType() const override;
+
 private:
 
     void genericEnqueueToPlayList(ElisaUtils::PlayListEnqueueMode enqueueMode,
@@ -19,6 +19,7 @@
 
 #include "modeldataloader.h"
 #include "musiclistenersmanager.h"
+#include "modelsnapshot.h"
 
 
 #include <algorithm>
@@ -55,6 +56,8 @@ public:
 
     bool mIsBusy = false;
 
+    QMetaObject::Connection mModelSnapshotConnection;
+
 };
 
 DataModel::DataModel(QObject *parent) : QAbstractListModel(parent), d(std::make_unique<DataModelPrivate>())
@@ -407,6 +410,8 @@ void DataModel::initializeModel(MusicListenersManager *manager, DatabaseInterfac
     case ElisaUtils::NoFilter:
         connect(this, &DataModel::needData,
                 d->mDataLoader, &ModelDataLoader::loadData);
+        connect(this, &DataModel::needDataAfterSnapshot,
+                d->mDataLoader, &ModelDataLoader::loadDataAfterSnapshot);
         break;
     case ElisaUtils::FilterById:
         connect(this, &DataModel::needDataById,
@@ -438,9 +443,73 @@ void DataModel::initializeModel(MusicListenersManager *manager, DatabaseInterfac
 
     setBusy(true);
 
+    if (manager && d->mFilterType == ElisaUtils::NoFilter && manager->isLoadingModelSnapshot()) {
+        /* the snapshot is read on another thread, waiting for it is shorter than loading everything from the database */
+        d->mModelSnapshotConnection = connect(manager, &MusicListenersManager::modelSnapshotLoaded, this, [this, manager]() {
+            disconnect(d->mModelSnapshotConnection);
+            askModelDataOrSnapshot(manager);
+        });
+        return;
+    }
+
+    askModelDataOrSnapshot(manager);
+}
+
+void DataModel::askModelDataOrSnapshot(MusicListenersManager *manager)
+{
+    if (manager && d->mFilterType == ElisaUtils::NoFilter && showModelSnapshot(manager->modelSnapshot())) {
+        Q_EMIT needDataAfterSnapshot(d->mModelType, manager->modelSnapshot().generation());
+        return;
+    }
+
     askModelData();
 }
 
+void DataModel::searchData(ElisaUtils::PlayListEntryType dataType, const QString &searchText)
+{
+    /* ids of another type of data would select unrelated rows */
+    if (dataType != d->mModelType) {
+        return;
+    }
+
+    Q_EMIT needSearchResults(dataType, searchText);
+}
+
+bool DataModel::showModelSnapshot(const ModelSnapshot &snapshot)
+{
+    if (!snapshot.hasData(d->mModelType)) {
+        return false;
+    }
+
+    beginResetModel();
+    switch (d->mModelType)
+    {
+    case ElisaUtils::Album:
+        d->mAllAlbumData = snapshot.albums();
+        break;
+    case ElisaUtils::Artist:
+        d->mAllArtistData = snapshot.artists();
+        break;
+    case ElisaUtils::Genre:
+        d->mAllGenreData = snapshot.genres();
+        break;
+    case ElisaUtils::Track:
+        d->mAllTrackData = snapshot.tracks();
+        break;
+    case ElisaUtils::Composer:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::Radio:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Unknown:
+        break;
+    }
+    endResetModel();
+
+    setBusy(false);
+
+    return true;
+}
+
 void DataModel::askModelData()
 {
     switch(d->mFilterType)
@@ -527,6 +596,12 @@ void DataModel::connectModel(DatabaseInterface *database)
             this, &DataModel::radioRemoved);
     connect(d->mDataLoader, &ModelDataLoader::clearedDatabase,
             this, &DataModel::cleanedDatabase);
+    connect(d->mDataLoader, &ModelDataLoader::snapshotOutdated,
+            this, &DataModel::cleanedDatabase);
+    connect(d->mDataLoader, &ModelDataLoader::searchResults,
+            this, &DataModel::searchResults);
+    connect(this, &DataModel::needSearchResults,
+            d->mDataLoader, &ModelDataLoader::searchData);
 }
 
 void DataModel::tracksAdded(ListTrackDataType newData)
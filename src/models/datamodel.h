@@ -32,6 +32,7 @@
 class DataModelPrivate;
 class MusicListenersManager;
 class DatabaseInterface;
+class ModelSnapshot;
 
 class ELISALIB_EXPORT DataModel : public QAbstractListModel
 {
@@ -99,6 +100,8 @@ Q_SIGNALS:
 
     void needData(ElisaUtils::PlayListEntryType dataType);
 
+    void needDataAfterSnapshot(ElisaUtils::PlayListEntryType dataType, qulonglong snapshotGeneration);
+
     void needDataById(ElisaUtils::PlayListEntryType dataType, qulonglong databaseId);
 
     void needDataByGenre(ElisaUtils::PlayListEntryType dataType, const QString &genre);
@@ -112,6 +115,11 @@ Q_SIGNALS:
 
     void needFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
+    void needSearchResults(ElisaUtils::PlayListEntryType dataType, const QString &searchText);
+
+    void searchResults(ElisaUtils::PlayListEntryType dataType, const QString &searchText,
+                       const QList<qulonglong> &databaseIds);
+
     void isBusyChanged();
 
 public Q_SLOTS:
@@ -142,6 +150,8 @@ public Q_SLOTS:
                     ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                     const QString &genre, const QString &artist, qulonglong databaseId);
 
+    void searchData(ElisaUtils::PlayListEntryType dataType, const QString &searchText);
+
 private Q_SLOTS:
 
     void cleanedDatabase();
@@ -163,6 +173,10 @@ private:
 
     void askModelData();
 
+    void askModelDataOrSnapshot(MusicListenersManager *manager);
+
+    bool showModelSnapshot(const ModelSnapshot &snapshot);
+
     void removeRadios();
 
     std::unique_ptr<DataModelPrivate> d;
@@ -38,6 +38,11 @@ ElisaUtils::PlayListEntryType GridViewProxyModel::dataType() const
 
 GridViewProxyModel::~GridViewProxyModel() = default;
 
+ElisaUtils::PlayListEntryType GridViewProxyModel::searchDataType() const
+{
+    return mDataType;
+}
+
 bool GridViewProxyModel::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
 {
     bool result = false;
@@ -54,6 +59,10 @@ bool GridViewProxyModel::filterAcceptsRow(int source_row, const QModelIndex &sou
         return result;
     }
 
+    if (acceptsSearchResult(source_row, source_parent, result)) {
+        return result;
+    }
+
     if (mFilterExpression.match(mainValue).hasMatch()) {
         result = true;
         return result;
@@ -138,6 +147,13 @@ void GridViewProxyModel::setDataType(ElisaUtils::PlayListEntryType newDataType)
 
     mDataType = newDataType;
 
+    mUseSearchResults = false;
+    mSearchResults.clear();
+
+    requestSearchResults();
+
+    invalidate();
+
     Q_EMIT dataTypeChanged();
 }
 
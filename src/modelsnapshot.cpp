@@ -0,0 +1,236 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "modelsnapshot.h"
+
+#include "databaseLogging.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QDebug>
+
+template <typename DataType>
+static void writeData(QDataStream &stream, const QList<DataType> &allData)
+{
+    stream << static_cast<quint32>(allData.size());
+
+    for (const auto &oneData : allData) {
+        auto storedValues = quint32{0};
+        for (auto itValue = oneData.constBegin(); itValue != oneData.constEnd(); ++itValue) {
+            if (itValue.value().userType() < QMetaType::User) {
+                ++storedValues;
+            }
+        }
+
+        stream << storedValues;
+
+        for (auto itValue = oneData.constBegin(); itValue != oneData.constEnd(); ++itValue) {
+            if (itValue.value().userType() < QMetaType::User) {
+                stream << static_cast<qint32>(itValue.key()) << itValue.value();
+            }
+        }
+    }
+}
+
+template <typename DataType>
+static bool readData(QDataStream &stream, QList<DataType> &allData)
+{
+    auto dataCount = quint32{0};
+    stream >> dataCount;
+
+    allData.clear();
+    allData.reserve(static_cast<int>(dataCount));
+
+    for (quint32 dataIndex = 0; dataIndex < dataCount && stream.status() == QDataStream::Ok; ++dataIndex) {
+        auto oneData = DataType{};
+
+        auto valuesCount = quint32{0};
+        stream >> valuesCount;
+
+        for (quint32 valueIndex = 0; valueIndex < valuesCount && stream.status() == QDataStream::Ok; ++valueIndex) {
+            auto role = qint32{0};
+            auto value = QVariant{};
+            stream >> role >> value;
+
+            oneData[static_cast<DataTypes::ColumnsRoles>(role)] = value;
+        }
+
+        allData.push_back(oneData);
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+QString ModelSnapshot::fileNameForDatabase(const QString &databaseFileName)
+{
+    return databaseFileName + QStringLiteral(".snapshot");
+}
+
+bool ModelSnapshot::read(const QString &fileName)
+{
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    QFile snapshotFile(fileName);
+
+    if (!snapshotFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream snapshotStream(&snapshotFile);
+    snapshotStream.setVersion(QDataStream::Qt_5_10);
+
+    auto magic = quint32{0};
+    auto formatVersion = quint32{0};
+    snapshotStream >> magic >> formatVersion;
+
+    if (magic != Magic || formatVersion != FormatVersion) {
+        qCDebug(orgKdeElisaDatabase) << "ModelSnapshot::read" << fileName << "unsupported snapshot" << magic << formatVersion;
+        return false;
+    }
+
+    auto result = ModelSnapshot{};
+    snapshotStream >> result.mGeneration;
+
+    if (!readData(snapshotStream, result.mAlbums) || !readData(snapshotStream, result.mArtists) ||
+            !readData(snapshotStream, result.mGenres) || !readData(snapshotStream, result.mTracks)) {
+        qCDebug(orgKdeElisaDatabase) << "ModelSnapshot::read" << fileName << "corrupted snapshot";
+        return false;
+    }
+
+    *this = result;
+
+    qCDebug(orgKdeElisaDatabase) << "ModelSnapshot::read" << fileName << "generation" << mGeneration
+                                 << mAlbums.size() << "albums" << mArtists.size() << "artists"
+                                 << mGenres.size() << "genres" << mTracks.size() << "tracks"
+                                 << "in" << timer.elapsed() << "ms";
+
+    return true;
+}
+
+bool ModelSnapshot::write(const QString &fileName) const
+{
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    QSaveFile snapshotFile(fileName);
+
+    if (!snapshotFile.open(QIODevice::WriteOnly)) {
+        qCDebug(orgKdeElisaDatabase) << "ModelSnapshot::write" << fileName << snapshotFile.errorString();
+        return false;
+    }
+
+    QDataStream snapshotStream(&snapshotFile);
+    snapshotStream.setVersion(QDataStream::Qt_5_10);
+
+    snapshotStream << Magic << FormatVersion << mGeneration;
+
+    writeData(snapshotStream, mAlbums);
+    writeData(snapshotStream, mArtists);
+    writeData(snapshotStream, mGenres);
+    writeData(snapshotStream, mTracks);
+
+    if (snapshotStream.status() != QDataStream::Ok || !snapshotFile.commit()) {
+        qCDebug(orgKdeElisaDatabase) << "ModelSnapshot::write" << fileName << snapshotFile.errorString();
+        return false;
+    }
+
+    qCDebug(orgKdeElisaDatabase) << "ModelSnapshot::write" << fileName << "generation" << mGeneration
+                                 << "in" << timer.elapsed() << "ms";
+
+    return true;
+}
+
+bool ModelSnapshot::isEmpty() const
+{
+    return mAlbums.isEmpty() && mArtists.isEmpty() && mGenres.isEmpty() && mTracks.isEmpty();
+}
+
+bool ModelSnapshot::hasData(ElisaUtils::PlayListEntryType dataType) const
+{
+    switch (dataType)
+    {
+    case ElisaUtils::Album:
+        return !mAlbums.isEmpty();
+    case ElisaUtils::Artist:
+        return !mArtists.isEmpty();
+    case ElisaUtils::Genre:
+        return !mGenres.isEmpty();
+    case ElisaUtils::Track:
+        return !mTracks.isEmpty();
+    case ElisaUtils::Composer:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::Radio:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Unknown:
+        break;
+    }
+
+    return false;
+}
+
+qulonglong ModelSnapshot::generation() const
+{
+    return mGeneration;
+}
+
+void ModelSnapshot::setGeneration(qulonglong generation)
+{
+    mGeneration = generation;
+}
+
+const DataTypes::ListAlbumDataType &ModelSnapshot::albums() const
+{
+    return mAlbums;
+}
+
+void ModelSnapshot::setAlbums(const DataTypes::ListAlbumDataType &albums)
+{
+    mAlbums = albums;
+}
+
+const DataTypes::ListArtistDataType &ModelSnapshot::artists() const
+{
+    return mArtists;
+}
+
+void ModelSnapshot::setArtists(const DataTypes::ListArtistDataType &artists)
+{
+    mArtists = artists;
+}
+
+const DataTypes::ListGenreDataType &ModelSnapshot::genres() const
+{
+    return mGenres;
+}
+
+void ModelSnapshot::setGenres(const DataTypes::ListGenreDataType &genres)
+{
+    mGenres = genres;
+}
+
+const DataTypes::ListTrackDataType &ModelSnapshot::tracks() const
+{
+    return mTracks;
+}
+
+void ModelSnapshot::setTracks(const DataTypes::ListTrackDataType &tracks)
+{
+    mTracks = tracks;
+}
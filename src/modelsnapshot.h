@@ -0,0 +1,81 @@
+/*
+ * Copyright 2020 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MODELSNAPSHOT_H
+#define MODELSNAPSHOT_H
+
+#include "elisaLib_export.h"
+
+#include "datatypes.h"
+#include "elisautils.h"
+
+#include <QString>
+
+/* the album, artist, genre and track lists of the database as they were at a given generation */
+class ELISALIB_EXPORT ModelSnapshot
+{
+public:
+
+    static QString fileNameForDatabase(const QString &databaseFileName);
+
+    bool read(const QString &fileName);
+
+    bool write(const QString &fileName) const;
+
+    bool isEmpty() const;
+
+    bool hasData(ElisaUtils::PlayListEntryType dataType) const;
+
+    qulonglong generation() const;
+
+    void setGeneration(qulonglong generation);
+
+    const DataTypes::ListAlbumDataType &albums() const;
+
+    void setAlbums(const DataTypes::ListAlbumDataType &albums);
+
+    const DataTypes::ListArtistDataType &artists() const;
+
+    void setArtists(const DataTypes::ListArtistDataType &artists);
+
+    const DataTypes::ListGenreDataType &genres() const;
+
+    void setGenres(const DataTypes::ListGenreDataType &genres);
+
+    const DataTypes::ListTrackDataType &tracks() const;
+
+    void setTracks(const DataTypes::ListTrackDataType &tracks);
+
+private:
+
+    static const quint32 Magic = 0x454c5341;
+
+    static const quint32 FormatVersion = 1;
+
+    qulonglong mGeneration = 0;
+
+    DataTypes::ListAlbumDataType mAlbums;
+
+    DataTypes::ListArtistDataType mArtists;
+
+    DataTypes::ListGenreDataType mGenres;
+
+    DataTypes::ListTrackDataType mTracks;
+
+};
+
+#endif // MODELSNAPSHOT_H
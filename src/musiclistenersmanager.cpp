@@ -42,6 +42,13 @@
 #include "elisaapplication.h"
 #include "elisa_settings.h"
 #include "modeldataloader.h"
+#include "modelsnapshot.h"
+
+#if defined Qt5DBus_FOUND && Qt5DBus_FOUND
+#include "databasestatisticsadaptor.h"
+
+#include <QDBusConnection>
+#endif
 
 #include <KI18n/KLocalizedString>
 
@@ -51,8 +58,11 @@
 #include <QCoreApplication>
 #include <QFileSystemWatcher>
 #include <QAction>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 #include <list>
+#include <array>
 
 class MusicListenersManagerPrivate
 {
@@ -62,6 +72,12 @@ public:
 
     QThread mListenerThread;
 
+    std::array<QThread, 2> mDatabaseReaderThreads;
+
+    int mNextDatabaseReaderThread = 0;
+
+    bool mUseDatabaseReaderThreads = false;
+
 #if defined UPNPQT_FOUND && UPNPQT_FOUND
     UpnpListener mUpnpListener;
 #endif
@@ -80,6 +96,12 @@ public:
 
     DatabaseInterface mDatabaseInterface;
 
+    ModelSnapshot mModelSnapshot;
+
+    QFutureWatcher<ModelSnapshot> mModelSnapshotWatcher;
+
+    bool mIsLoadingModelSnapshot = false;
+
     std::unique_ptr<TracksListener> mTracksListener;
 
     QFileSystemWatcher mConfigFileWatcher;
@@ -92,6 +114,10 @@ public:
 
     bool mIndexerBusy = false;
 
+    bool mDatabaseReady = false;
+
+    QMediaPlayer::State mPlayerPlaybackState = QMediaPlayer::StoppedState;
+
     bool mFileSystemIndexerActive = false;
 
     bool mBalooIndexerActive = false;
@@ -128,6 +154,11 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
     connect(&d->mConfigFileWatcher, &QFileSystemWatcher::fileChanged,
             this, &MusicListenersManager::configChanged);
 
+#if defined Qt5DBus_FOUND && Qt5DBus_FOUND
+    new DatabaseStatisticsAdaptor(&d->mDatabaseInterface);
+    QDBusConnection::sessionBus().registerObject(QStringLiteral("/org/kde/elisa/Database"), &d->mDatabaseInterface, QDBusConnection::ExportAdaptors);
+#endif
+
     d->mListenerThread.start();
     d->mDatabaseThread.start();
 
@@ -141,8 +172,42 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
         databaseFileName = localDataPaths.first() + QStringLiteral("/elisaDatabase.db");
     }
 
+    d->mUseDatabaseReaderThreads = !databaseFileName.isEmpty();
+
+    // views show the last known content until the database is ready to answer their requests
+    if (!databaseFileName.isEmpty()) {
+        connect(&d->mModelSnapshotWatcher, &QFutureWatcher<ModelSnapshot>::finished, this, [this]() {
+            d->mIsLoadingModelSnapshot = false;
+
+            /* the database may already answer the views */
+            if (!d->mDatabaseReady) {
+                d->mModelSnapshot = d->mModelSnapshotWatcher.result();
+            }
+
+            Q_EMIT modelSnapshotLoaded();
+        });
+
+        d->mIsLoadingModelSnapshot = true;
+
+        const auto snapshotFileName = ModelSnapshot::fileNameForDatabase(databaseFileName);
+        d->mModelSnapshotWatcher.setFuture(QtConcurrent::run(QThreadPool::globalInstance(), [snapshotFileName]() {
+            auto snapshot = ModelSnapshot{};
+            snapshot.read(snapshotFileName);
+            return snapshot;
+        }));
+    }
+
+    auto storageSettings = DatabaseInterface::StorageSettings{};
+    storageSettings.mCacheSize = Elisa::ElisaConfiguration::databaseCacheSize();
+    storageSettings.mMemoryMapSize = Elisa::ElisaConfiguration::databaseMemoryMapSize() < 0 ?
+                -1 : Elisa::ElisaConfiguration::databaseMemoryMapSize() * 1024LL * 1024;
+    storageSettings.mTempStore = Elisa::ElisaConfiguration::databaseTempStore();
+
+    qRegisterMetaType<DatabaseInterface::StorageSettings>("DatabaseInterface::StorageSettings");
+
     QMetaObject::invokeMethod(&d->mDatabaseInterface, "init", Qt::QueuedConnection,
-                              Q_ARG(QString, QStringLiteral("listeners")), Q_ARG(QString, databaseFileName));
+                              Q_ARG(QString, QStringLiteral("listeners")), Q_ARG(QString, databaseFileName),
+                              Q_ARG(DatabaseInterface::StorageSettings, storageSettings));
 
     qCInfo(orgKdeElisaIndexersManager) << "Local file system indexer is inactive";
     qCInfo(orgKdeElisaIndexersManager) << "Baloo indexer is unavailable";
@@ -157,6 +222,16 @@ DatabaseInterface *MusicListenersManager::viewDatabase() const
     return &d->mDatabaseInterface;
 }
 
+const ModelSnapshot &MusicListenersManager::modelSnapshot() const
+{
+    return d->mModelSnapshot;
+}
+
+bool MusicListenersManager::isLoadingModelSnapshot() const
+{
+    return d->mIsLoadingModelSnapshot;
+}
+
 void MusicListenersManager::subscribeForTracks(MediaPlayList *client)
 {
     createTracksListener();
@@ -229,6 +304,16 @@ auto MusicListenersManager::initializeRootPath()
 
 void MusicListenersManager::databaseReady()
 {
+    d->mModelSnapshot = ModelSnapshot{};
+
+    if (d->mUseDatabaseReaderThreads) {
+        for (auto &oneReaderThread : d->mDatabaseReaderThreads) {
+            if (!oneReaderThread.isRunning()) {
+                oneReaderThread.start();
+            }
+        }
+    }
+
     auto initialRootPath = Elisa::ElisaConfiguration::rootPath();
     if (initialRootPath.isEmpty()) {
         initializeRootPath();
@@ -237,6 +322,9 @@ void MusicListenersManager::databaseReady()
     d->mConfigFileWatcher.addPath(Elisa::ElisaConfiguration::self()->config()->name());
 
     configChanged();
+
+    d->mDatabaseReady = true;
+    updateDatabaseMaintenance();
 }
 
 void MusicListenersManager::applicationAboutToQuit()
@@ -245,6 +333,11 @@ void MusicListenersManager::applicationAboutToQuit()
 
     Q_EMIT applicationIsTerminating();
 
+    for (auto &oneReaderThread : d->mDatabaseReaderThreads) {
+        oneReaderThread.exit();
+        oneReaderThread.wait();
+    }
+
     d->mDatabaseThread.exit();
     d->mDatabaseThread.wait();
 
@@ -269,6 +362,12 @@ void MusicListenersManager::setElisaApplication(ElisaApplication *elisaApplicati
     emit elisaApplicationChanged();
 }
 
+void MusicListenersManager::setPlayerPlaybackState(QMediaPlayer::State playerPlaybackState)
+{
+    d->mPlayerPlaybackState = playerPlaybackState;
+    updateDatabaseMaintenance();
+}
+
 void MusicListenersManager::playBackError(const QUrl &sourceInError, QMediaPlayer::Error playerError)
 {
     qCDebug(orgKdeElisaIndexersManager) << "MusicListenersManager::playBackError" << sourceInError;
@@ -306,7 +405,14 @@ void MusicListenersManager::deleteElementById(ElisaUtils::PlayListEntryType entr
 
 void MusicListenersManager::connectModel(ModelDataLoader *dataLoader)
 {
-    dataLoader->moveToThread(&d->mDatabaseThread);
+    if (!d->mUseDatabaseReaderThreads) {
+        dataLoader->moveToThread(&d->mDatabaseThread);
+        return;
+    }
+
+    // reader threads are only started once the database is ready, queued requests wait until then
+    dataLoader->moveToThread(&d->mDatabaseReaderThreads[d->mNextDatabaseReaderThread]);
+    d->mNextDatabaseReaderThread = (d->mNextDatabaseReaderThread + 1) % static_cast<int>(d->mDatabaseReaderThreads.size());
 }
 
 void MusicListenersManager::resetMusicData()
@@ -430,12 +536,25 @@ void MusicListenersManager::monitorStartingListeners()
 {
     d->mIndexerBusy = true;
     Q_EMIT indexerBusyChanged();
+
+    updateDatabaseMaintenance();
 }
 
 void MusicListenersManager::monitorEndingListeners()
 {
     d->mIndexerBusy = false;
     Q_EMIT indexerBusyChanged();
+
+    updateDatabaseMaintenance();
+}
+
+void MusicListenersManager::updateDatabaseMaintenance()
+{
+    if (!d->mDatabaseReady) {
+        return;
+    }
+
+    d->mDatabaseInterface.setMaintenanceAllowed(!d->mIndexerBusy && d->mPlayerPlaybackState != QMediaPlayer::PlayingState);
 }
 
 void MusicListenersManager::cleanedDatabase()
@@ -545,9 +664,8 @@ void MusicListenersManager::createTracksListener()
         connect(this, &MusicListenersManager::removeTracksInError,
                 &d->mDatabaseInterface, &DatabaseInterface::removeTracksList);
 
-        connect(&d->mDatabaseInterface, &DatabaseInterface::trackRemoved, d->mTracksListener.get(), &TracksListener::trackRemoved);
         connect(&d->mDatabaseInterface, &DatabaseInterface::tracksAdded, d->mTracksListener.get(), &TracksListener::tracksAdded);
-        connect(&d->mDatabaseInterface, &DatabaseInterface::trackModified, d->mTracksListener.get(), &TracksListener::trackModified);
+        connect(&d->mDatabaseInterface, &DatabaseInterface::databaseChanged, d->mTracksListener.get(), &TracksListener::databaseChanged);
         Q_EMIT tracksListenerChanged();
     }
 }
@@ -34,6 +34,7 @@ class MediaPlayList;
 class ElisaApplication;
 class ModelDataLoader;
 class TracksListener;
+class ModelSnapshot;
 
 class ELISALIB_EXPORT MusicListenersManager : public QObject
 {
@@ -89,6 +90,10 @@ public:
 
     DatabaseInterface* viewDatabase() const;
 
+    const ModelSnapshot &modelSnapshot() const;
+
+    bool isLoadingModelSnapshot() const;
+
     void subscribeForTracks(MediaPlayList *client);
 
     int importedTracksCount() const;
@@ -113,6 +118,8 @@ Q_SIGNALS:
 
     void viewDatabaseChanged();
 
+    void modelSnapshotLoaded();
+
     void applicationIsTerminating();
 
     void tracksListenerChanged();
@@ -151,6 +158,8 @@ public Q_SLOTS:
 
     void setElisaApplication(ElisaApplication* elisaApplication);
 
+    void setPlayerPlaybackState(QMediaPlayer::State playerPlaybackState);
+
     void playBackError(const QUrl &sourceInError, QMediaPlayer::Error playerError);
 
     void deleteElementById(ElisaUtils::PlayListEntryType entryType, qulonglong databaseId);
@@ -189,6 +198,8 @@ private:
 
     void createTracksListener();
 
+    void updateDatabaseMaintenance();
+
 };
 
 #endif // MUSICLISTENERSMANAGER_H
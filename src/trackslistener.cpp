@@ -113,6 +113,31 @@ void TracksListener::trackModified(const TrackDataType &modifiedTrack)
     }
 }
 
+void TracksListener::databaseChanged(const DataTypes::DatabaseChanges &changes)
+{
+    for (auto trackId : changes.mRemovedTracks) {
+        trackRemoved(trackId);
+    }
+
+    auto listenedTrackIds = QList<qulonglong>{};
+
+    for (auto trackId : changes.mModifiedTracks) {
+        if (d->mTracksByIdSet.contains(trackId)) {
+            listenedTrackIds.push_back(trackId);
+        }
+    }
+
+    if (listenedTrackIds.isEmpty()) {
+        return;
+    }
+
+    const auto modifiedTracks = d->mDatabase->tracksDataFromDatabaseIds(listenedTrackIds);
+
+    for (const auto &oneTrack : modifiedTracks) {
+        Q_EMIT trackHasChanged(oneTrack);
+    }
+}
+
 void TracksListener::trackByNameInList(const QVariant &title, const QVariant &artist, const QVariant &album,
                                        const QVariant &trackNumber, const QVariant &discNumber)
 {
@@ -63,6 +63,8 @@ public Q_SLOTS:
 
     void trackModified(const TracksListener::TrackDataType &modifiedTrack);
 
+    void databaseChanged(const DataTypes::DatabaseChanges &changes);
+
     void trackByNameInList(const QVariant &title, const QVariant &artist, const QVariant &album, const QVariant &trackNumber, const QVariant &discNumber);
 
     void newEntryInList(qulonglong newDatabaseId,